@@ -8,6 +8,7 @@
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
 #include <mxl/platform.h>
+#include <mxl/rational.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -33,6 +34,14 @@ extern "C"
      */
     typedef struct mxlFabricsInitiator_t* mxlFabricsInitiator;
 
+    /** A multi-flow target session receives the grains of many flows over a single connection, \see mxlFabricsCreateTargetSession().
+     */
+    typedef struct mxlFabricsTargetSession_t* mxlFabricsTargetSession;
+
+    /** A multi-flow initiator session sends the grains of many flows to one or more target sessions, \see mxlFabricsCreateInitiatorSession().
+     */
+    typedef struct mxlFabricsInitiatorSession_t* mxlFabricsInitiatorSession;
+
     /** A collection of memory regions that can be the target or the source of remote write operations.
      * Can be obtained by using a flow reader or writer, and converting it to a regions collection
      * with mxlFabricsRegionsForFlowReader() or mxlFabricsRegionsForFlowWriter().
@@ -60,6 +69,28 @@ extern "C"
         char const* service;
     } mxlEndpointAddress;
 
+    /** The wait object of a completion queue, which determines how blocking calls wait for completions.
+     */
+    typedef enum mxlFabricsWaitObject
+    {
+        MXL_FABRICS_WAIT_OBJECT_DEFAULT = 0, /**< Let the provider select the wait object. */
+        MXL_FABRICS_WAIT_OBJECT_NONE = 1,    /**< No wait object, blocking calls busy-poll the queue. Required by some providers like EFA. */
+        MXL_FABRICS_WAIT_OBJECT_FD = 2,      /**< Blocking calls sleep on a file descriptor until the queue is signaled. */
+        MXL_FABRICS_WAIT_OBJECT_YIELD = 3,   /**< Blocking calls poll the queue and yield the CPU between polls. */
+    } mxlFabricsWaitObject;
+
+    /** Configuration of a completion queue. A zero-initialized object selects the defaults of the provider.
+     */
+    typedef struct mxlCompletionQueueConfig_t
+    {
+        uint32_t depth;                  /**< Minimum number of entries of the queue, or 0 for the default depth of the provider. The queue
+                                              should hold at least as many entries as there can be transfers in flight. */
+        uint32_t batchSize;              /**< Maximum number of completions read from the queue at once, or 0 for 64. */
+        mxlFabricsWaitObject waitObject; /**< How blocking calls wait for completions. */
+        bool pinInterrupts;              /**< Direct the interrupts of the queue to the CPU core given by signalingVector. */
+        uint32_t signalingVector;        /**< The CPU core that should handle the interrupts of the queue, if pinInterrupts is set. */
+    } mxlCompletionQueueConfig;
+
     /** Configuration object required to set up a new target.
      */
     typedef struct mxlTargetConfig_t
@@ -80,6 +111,178 @@ extern "C"
         bool deviceSupport;                 /**< Require support of transfers involving device memory. */
     } mxlInitiatorConfig;
 
+    /** The maximum number of flows a multi-flow session can carry.
+     */
+#define MXL_FABRICS_SESSION_MAX_FLOWS 1024
+
+    /** The maximum number of rails of a multi-flow session, \see mxlSessionConfig.
+     */
+#define MXL_FABRICS_SESSION_MAX_RAILS 8
+
+    /** How the endpoints of a multi-flow session reach their peers.
+     */
+    typedef enum mxlFabricsEndpointType
+    {
+        /** One connected endpoint per peer, set up with a connection handshake. */
+        MXL_FABRICS_ENDPOINT_TYPE_CONNECTED = 0,
+        /** A single reliable connectionless endpoint serves every peer. Peers are entries of an address vector, adding or removing one
+         *  doesn't involve a handshake or per-peer resources. Suited to distributing flows to many receivers. */
+        MXL_FABRICS_ENDPOINT_TYPE_RELIABLE_DATAGRAM = 1,
+    } mxlFabricsEndpointType;
+
+    /** Supervision of the links of an initiator session to its target sessions, \see mxlSessionConfig. A zero-initialized object disables
+     *  it.
+     */
+    typedef struct mxlLinkSupervisionConfig_t
+    {
+        bool enabled;             /**< Re-establish the links that fail rather than giving up on their target session. */
+        uint32_t retryIntervalMs; /**< Time between two attempts to re-establish a link, and between two liveness checks of the links of
+                                       reliable datagram sessions, or 0 for 100 ms. */
+        uint32_t catchUpGrains;   /**< Once a link is restored, write up to this many of the newest grains of each flow again, the grains
+                                       transferred during the outage included. 0 resumes with the next grain transferred. */
+    } mxlLinkSupervisionConfig;
+
+    /** The state of the link of an initiator session to a target session, \see mxlFabricsInitiatorSessionGetLinkStatus().
+     */
+    typedef enum mxlFabricsLinkState
+    {
+        MXL_FABRICS_LINK_STATE_CONNECTING = 0, /**< The link is being established for the first time. */
+        MXL_FABRICS_LINK_STATE_UP = 1,         /**< Grains are written to the target session. */
+        MXL_FABRICS_LINK_STATE_RECOVERING = 2, /**< The link failed and is being re-established. Grains are not written meanwhile. */
+        MXL_FABRICS_LINK_STATE_DOWN = 3,       /**< The link failed and is not supervised. */
+        MXL_FABRICS_LINK_STATE_STALE = 4,      /**< The target session was restarted, its remote keys are no longer valid. The target
+                                                    session must be disconnected, then connected and its flows added again with its new
+                                                    target info, \see mxlSessionConfig. */
+    } mxlFabricsLinkState;
+
+    /** The state and outage history of the link of an initiator session to a target session.
+     */
+    typedef struct mxlFabricsLinkStatus_t
+    {
+        mxlFabricsLinkState state;
+        uint32_t outages;       /**< Number of times the link failed. */
+        uint64_t lastOutageNs;  /**< Duration of the last outage, up to now if it is still ongoing. */
+        uint64_t totalOutageNs; /**< Cumulated duration of all the outages, the ongoing one included. */
+    } mxlFabricsLinkStatus;
+
+    /** Configuration object required to create a multi-flow target or initiator session.
+     *
+     * A session has one rail per endpoint address: the rail of endpointAddress, and one rail per entry of extraRails. Every rail has its
+     * own fabric, domain, queues and endpoints, usually on its own NIC port or provider instance, and the slices of every grain are
+     * striped across all of them. A target session only reports a grain once all its stripes arrived, a grain that misses some is never
+     * reported. A target session and the initiator sessions writing to it must have the same number of rails.
+     *
+     * An initiator session with a non-zero creditWindow applies flow control: it never writes a grain of a flow more than creditWindow
+     * grains ahead of the grains released by the consumers at the target (\see mxlFabricsTargetSessionReleaseGrains()), which it reads
+     * from the target with RDMA reads. Grains that are still being read at the target can then not be overwritten, which makes transfers
+     * faster than real time lossless.
+     *
+     * An initiator session with supervision enabled recovers from the failure of the link to a target session: a dropped connection is
+     * re-established, and connectionless links are checked periodically. Before grains are written again, the session reads the instance
+     * id of the target session to validate that its remote keys still hold. A target session that was restarted in the meantime is
+     * reported stale rather than written to.
+     *
+     * Supervision only resumes the links to the same instance of a target session. The regions of a restarted target session have new
+     * remote keys, which only its new target info carries, and the target info travels over the channel of the application, not over the
+     * fabric. The application resumes a stale link itself: it disconnects the target session, then connects it and adds its flows again
+     * with the new target info. The flows keep their ids in the initiator session, and their transfers resume from the next grain.
+     * \see mxlFabricsInitiatorSessionGetLinkStatus()
+     */
+    typedef struct mxlSessionConfig_t
+    {
+        mxlEndpointAddress endpointAddress;       /**< Bind address for the local endpoint of the first rail. */
+        mxlFabricsProvider provider;              /**< The provider that should be used. */
+        bool deviceSupport;                       /**< Require support of transfers involving device memory. */
+        mxlCompletionQueueConfig completionQueue; /**< The completion queue shared by all the connections of a rail of the session. */
+        mxlFabricsEndpointType endpointType;      /**< Must be the same for a target session and the initiator sessions writing to it. */
+        mxlEndpointAddress const* extraRails;     /**< Bind addresses of the endpoints of the other rails. May be NULL if extraRailCount is 0. */
+        uint32_t extraRailCount;                  /**< At most MXL_FABRICS_SESSION_MAX_RAILS - 1. */
+        uint32_t creditWindow;                    /**< Initiator sessions only. 0 disables flow control. */
+        mxlLinkSupervisionConfig supervision;     /**< Initiator sessions only. */
+    } mxlSessionConfig;
+
+    /** A grain received by a multi-flow target session.
+     */
+    typedef struct mxlSessionGrain_t
+    {
+        uint16_t flowId;      /**< Id of the flow in the session, as returned by mxlFabricsTargetSessionAddFlow(). */
+        uint16_t validSlices; /**< Number of slices of the grain that were valid when the initiator transferred it. */
+        uint64_t index;       /**< Index of the grain. */
+    } mxlSessionGrain;
+
+    /** Pacing of the transfers of a flow of an initiator session, \see mxlFabricsInitiatorSessionSetFlowPacing().
+     *
+     * A paced grain is written in bursts of whole slices, spread evenly over a share of the grain period like the narrow senders of SMPTE
+     * ST 2110-21, rather than in a single burst at line rate that fills the buffers of the switches it goes through. The target session
+     * reports the grain once its last burst arrived. Grains that can't be divided in slices and grains of which only the header is
+     * transferred are not paced.
+     */
+    typedef struct mxlFlowPacingConfig_t
+    {
+        mxlRational grainRate;   /**< The grain rate of the flow, which gives the grain period. A zero numerator disables pacing. */
+        uint32_t activePercent;  /**< Share of the grain period the bursts of a grain are spread over, in percent, or 0 for 90. */
+        uint32_t slicesPerBurst; /**< Number of slices written at once, or 0 for 16. A burst carries at least one slice per rail. */
+    } mxlFlowPacingConfig;
+
+    /** Metrics of the pacing of a flow of an initiator session, \see mxlFabricsInitiatorSessionGetFlowPacingStats().
+     */
+    typedef struct mxlFlowPacingStats_t
+    {
+        uint64_t grains;         /**< Number of grains written with pacing. */
+        uint64_t bursts;         /**< Number of bursts written. */
+        uint64_t lateBursts;     /**< Number of bursts written later than their due time by more than the interval between two bursts. */
+        uint64_t lastBurstBytes; /**< Bytes of the last burst written to a target session. */
+        uint64_t maxBurstBytes;  /**< Bytes of the largest burst written to a target session. */
+        uint64_t achievedRate;   /**< Rate of the last paced grain in bytes per second, from its first burst to the end of the interval of its
+                                      last burst. */
+    } mxlFlowPacingStats;
+
+    /** The number of buckets of the completion latency histogram of a link, \see mxlFabricsLinkStats.
+     */
+#define MXL_FABRICS_LATENCY_BUCKETS 16
+
+    /** The number of distinct error codes counted separately by the statistics of a link, \see mxlFabricsLinkStats.
+     */
+#define MXL_FABRICS_MAX_ERROR_CODES 8
+
+    /** The number of operations of a link that failed with a given error.
+     */
+    typedef struct mxlFabricsErrorCount_t
+    {
+        int32_t code;   /**< The positive fi_errno of the failures, such as FI_EIO or FI_ETRUNC. */
+        uint32_t count; /**< Number of operations that failed with it. */
+    } mxlFabricsErrorCount;
+
+    /** Cumulated counters of the transfers of an initiator session to a target session, or of all the transfers a target session received,
+     *  \see mxlFabricsInitiatorSessionGetStats() and mxlFabricsTargetSessionGetStats(). A degrading link shows as a latency histogram
+     *  that drifts towards its higher buckets, an in-flight depth that stays close to the depth of the completion queue, or errors, well
+     *  before grains are dropped.
+     */
+    typedef struct mxlFabricsLinkStats_t
+    {
+        uint64_t bytes;                                         /**< Bytes written to the target session, or received by it as reported by
+                                                                     the provider. */
+        uint64_t grains;                                        /**< Grains written to the target session, or complete grains received by
+                                                                     it. */
+        uint64_t writes;                                        /**< Writes posted, one per stripe or burst, or received. */
+        uint32_t inFlight;                                      /**< Writes posted that didn't complete yet. For a target session, grains
+                                                                     received that were not returned yet. */
+        uint32_t maxInFlight;                                   /**< The largest inFlight value seen. */
+        uint64_t latencyHistogram[MXL_FABRICS_LATENCY_BUCKETS]; /**< Initiator sessions only. Writes that completed successfully by the time
+                                                                     from their post to their completion: bucket 0 counts those under 1 us,
+                                                                     bucket i those under 2^i us, and the last bucket all the slower ones. */
+        uint64_t totalLatencyNs;                                /**< Initiator sessions only. Sum of the latencies of the writes counted in
+                                                                     latencyHistogram. */
+        uint64_t maxLatencyNs;                                  /**< Initiator sessions only. The longest of these latencies. */
+        uint64_t errors;                                        /**< Operations that completed with an error. */
+        mxlFabricsErrorCount errorCodes[MXL_FABRICS_MAX_ERROR_CODES]; /**< The errors by code, for the first codes seen. Unused entries
+                                                                           have a count of 0. */
+        uint32_t linkFailures;                                  /**< Times the link failed. For a target session, connections of initiators
+                                                                     that were shut down or failed. */
+        uint32_t reconnects;                                    /**< Initiator sessions only. Times the link was restored after a failure,
+                                                                     \see mxlLinkSupervisionConfig. */
+    } mxlFabricsLinkStats;
+
     /** Configuration for a memory region location.
      */
     typedef struct mxlFabricsMemoryRegionLocation_t
@@ -174,22 +377,26 @@ extern "C"
     /**
      * Configure the target. After the target has been configured, it is ready to receive transfers from an initiator.
      * If additional connection setup is required by the underlying implementation it might not happen during the call to
-     * mxlFabricsTargetSetup, but be deferred until the first call to mxlFabricsTargetTryNewGrain().
+     * mxlFabricsTargetSetup, but be deferred until the first call to mxlFabricsTargetTryNewGrain(). The target is a connected target
+     * session on a single rail that carries the flow alone, \see mxlFabricsCreateTargetSession().
      * \param in_target A valid fabrics target
      * \param in_config The target configuration. This will be used to create an endpoint and register a memory region. The memory region
      * corresponds to the one that will be written to by the initiator.
      * \param out_info An mxlTargetInfo_t object which should be shared to a remote initiator which this target should receive data from. The
      * object must be freed with mxlFabricsFreeTargetInfo().
-     * \return The result code. \see mxlStatus
+     * \return The result code. MXL_ERR_INVALID_STATE if the target is already set up. \see mxlStatus
      */
     MXL_EXPORT
     mxlStatus mxlFabricsTargetSetup(mxlFabricsTarget in_target, mxlTargetConfig* in_config, mxlTargetInfo* out_info);
 
     /**
      * Non-blocking accessor for a flow grain at a specific index.
+     * The grain header is transferred together with the payload, so if the flow carries grain checksums (\see MXL_FLOW_FLAG_GRAIN_CHECKSUM)
+     * the received grain can be verified end to end with mxlFlowReaderVerifyGrain().
      * \param in_target A valid fabrics target
      * \param out_index The index of the grain that is ready, if any.
-     * \return The result code. MXL_ERR_NOT_READY if no grain was available at the time of the call, and the call should be retried. \see mxlStatus
+     * \return The result code. MXL_ERR_NOT_READY if no grain was available at the time of the call, and the call should be retried,
+     * MXL_ERR_INVALID_STATE if the target is not set up. \see mxlStatus
      */
     MXL_EXPORT
     mxlStatus mxlFabricsTargetTryNewGrain(mxlFabricsTarget in_target, uint64_t* out_index);
@@ -224,8 +431,9 @@ extern "C"
      * Configure the initiator.
      * \param in_initiator A valid fabrics initiator
      * \param in_config The initiator configuration. This will be used to create an endpoint and register a memory region. The memory region
-     * corresponds to the one that will be shared with targets.
-     * \return The result code. \see mxlStatus
+     * corresponds to the one that will be shared with targets. The initiator is a connected initiator session on a single rail that writes
+     * the flow to all its targets, \see mxlFabricsCreateInitiatorSession().
+     * \return The result code. MXL_ERR_INVALID_STATE if the initiator is already set up. \see mxlStatus
      */
     MXL_EXPORT
     mxlStatus mxlFabricsInitiatorSetup(mxlFabricsInitiator in_initiator, mxlInitiatorConfig const* in_config);
@@ -254,9 +462,12 @@ extern "C"
     /**
      * Enqueue a transfer operation to all added targets. This function is always non-blocking. The transfer operation might be started right
      * away, but is only guaranteed to have completed after mxlFabricsInitiatorMakeProgress*() no longer returns MXL_ERR_NOT_READY.
+     * Grains flagged with MXL_GRAIN_FLAG_REPEAT only carry a reference to their source grain, so only their header needs to be transferred. The
+     * source grain must have been transferred before.
      * \param in_initiator A valid fabrics initiator
      * \param in_grainIndex The index of the grain to transfer.
-     * \return The result code. \see mxlStatus
+     * \return The result code. MXL_ERR_NOT_READY if no target was added yet or none is connected yet, or if the work queue is full.
+     * \see mxlStatus
      */
     MXL_EXPORT
     mxlStatus mxlFabricsInitiatorTransferGrain(mxlFabricsInitiator in_initiator, uint64_t in_grainIndex);
@@ -281,6 +492,295 @@ extern "C"
     MXL_EXPORT
     mxlStatus mxlFabricsInitiatorMakeProgressBlocking(mxlFabricsInitiator in_initiator, uint16_t in_timeoutMs);
 
+    /**
+     * Create a multi-flow target session.
+     *
+     * A session receives the grains of many flows through a single listening endpoint. Every initiator session that connects to it gets
+     * a single connection, and all connections share one completion queue, so neither the number of connections nor the cost of polling
+     * for new grains grows with the number of flows. Every write carries remote completion data identifying the flow, the grain and the
+     * number of valid slices it transferred. With MXL_FABRICS_ENDPOINT_TYPE_RELIABLE_DATAGRAM, the session has a single connectionless
+     * endpoint instead, which initiator sessions write to without connecting.
+     * \param in_fabricsInstance A valid mxl fabrics instance
+     * \param in_config The session configuration. The endpoint address is the address initiators connect to.
+     * \param out_session Returns the created session. It must be destroyed with mxlFabricsDestroyTargetSession().
+     * \return The result code. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsCreateTargetSession(mxlFabricsInstance in_fabricsInstance, mxlSessionConfig const* in_config,
+        mxlFabricsTargetSession* out_session);
+
+    /**
+     * Destroy a multi-flow target session and close all its connections.
+     * \param in_fabricsInstance The mxl fabrics instance the session was created from
+     * \param in_session A valid target session
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsDestroyTargetSession(mxlFabricsInstance in_fabricsInstance, mxlFabricsTargetSession in_session);
+
+    /**
+     * Register the memory regions of a flow with a target session, so that initiators can write grains to it.
+     * The regions must be the grains of a discrete flow, as returned by mxlFabricsRegionsForFlowWriter(), because the index of every
+     * received grain is read from its header. Flows can be added while initiators are connected. They need an updated target info
+     * (\see mxlFabricsTargetSessionGetInfo()) to write to the new flow.
+     * \param in_session A valid target session
+     * \param in_regions The regions of the flow. The object can be freed once the flow was added.
+     * \param out_flowId Returns the id of the flow in the session, which identifies the flow in received grains and in initiators.
+     * \return The result code. MXL_ERR_INVALID_ARG if the flow has more grains than a session supports (1024), MXL_ERR_EXISTS if the
+     * session already carries MXL_FABRICS_SESSION_MAX_FLOWS flows. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsTargetSessionAddFlow(mxlFabricsTargetSession in_session, mxlRegions in_regions, uint16_t* out_flowId);
+
+    /**
+     * Remove a flow from a target session and deregister its memory regions. Initiators should remove the flow first, as their pending
+     * writes to the flow will fail.
+     * \param in_session A valid target session
+     * \param in_flowId The id returned by mxlFabricsTargetSessionAddFlow().
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsTargetSessionRemoveFlow(mxlFabricsTargetSession in_session, uint16_t in_flowId);
+
+    /**
+     * Get the information initiators need to connect to the session and write to its current flows.
+     * \param in_session A valid target session
+     * \param out_info Returns the target info. The object must be freed with mxlFabricsFreeTargetInfo().
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsTargetSessionGetInfo(mxlFabricsTargetSession in_session, mxlTargetInfo* out_info);
+
+    /**
+     * Non-blocking accessor for the next grain received by a target session, of any of its flows. Connection requests of initiators are
+     * accepted during this call.
+     * \param in_session A valid target session
+     * \param out_grain The flow, index and valid slices of the received grain, if any.
+     * \return The result code. MXL_ERR_NOT_READY if no grain was available at the time of the call. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsTargetSessionTryNewGrain(mxlFabricsTargetSession in_session, mxlSessionGrain* out_grain);
+
+    /**
+     * Blocking accessor for the next grain received by a target session, of any of its flows.
+     * \param in_session A valid target session
+     * \param out_grain The flow, index and valid slices of the received grain, if any.
+     * \param in_timeoutMs How long should we wait for a grain (in milliseconds)
+     * \return The result code. MXL_ERR_NOT_READY if no grain was available before the timeout. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsTargetSessionWaitForNewGrain(mxlFabricsTargetSession in_session, mxlSessionGrain* out_grain, uint16_t in_timeoutMs);
+
+    /**
+     * Advertise that the consumers of a flow of a target session are done with its grains up to and including a given index. Initiator
+     * sessions with flow control only overwrite released grains, \see mxlSessionConfig. The index is typically the last grain read by
+     * the slowest local reader. Released indices must not decrease, and are reset when the flow is removed.
+     * \param in_session A valid target session
+     * \param in_flowId The id returned by mxlFabricsTargetSessionAddFlow().
+     * \param in_index The index of the last grain the consumers are done with.
+     * \return The result code. MXL_ERR_NOT_FOUND if the session has no such flow. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsTargetSessionReleaseGrains(mxlFabricsTargetSession in_session, uint16_t in_flowId, uint64_t in_index);
+
+    /**
+     * Get the counters of all the transfers a target session received since it was created.
+     * \param in_session A valid target session
+     * \param out_stats Returns the counters.
+     * \return The result code. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsTargetSessionGetStats(mxlFabricsTargetSession in_session, mxlFabricsLinkStats* out_stats);
+
+    /**
+     * Expose a flow of a target session for pulling. Pull instances (\see mxlFabricsCreatePullInstance()) read the grains and the head
+     * index of the flow with RDMA reads, so the source takes no part in the transfers, and grains that no remote reader asks for never
+     * cross the fabric. The flow is exposed read-only, initiator sessions can't write to it. Connection requests of pull instances are
+     * accepted while mxlFabricsTargetSessionTryNewGrain() or mxlFabricsTargetSessionWaitForNewGrain() are called.
+     * \param in_session A valid target session
+     * \param in_reader A reader of the discrete flow to expose, which must outlive the flow in the session.
+     * \param out_flowId Returns the id of the flow in the session, which pull instances use to pull it.
+     * \return The result code. MXL_ERR_INVALID_ARG if the flow is not discrete. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsTargetSessionAddPullFlow(mxlFabricsTargetSession in_session, mxlFlowReader in_reader, uint16_t* out_flowId);
+
+    /**
+     * Create a multi-flow initiator session, the sending side of a target session.
+     * \param in_fabricsInstance A valid mxl fabrics instance
+     * \param in_config The session configuration. The endpoint address is the local bind address.
+     * \param out_session Returns the created session. It must be destroyed with mxlFabricsDestroyInitiatorSession().
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsCreateInitiatorSession(mxlFabricsInstance in_fabricsInstance, mxlSessionConfig const* in_config,
+        mxlFabricsInitiatorSession* out_session);
+
+    /**
+     * Destroy a multi-flow initiator session. Its connection is shut down without waiting for pending transfers.
+     * \param in_fabricsInstance The mxl fabrics instance the session was created from
+     * \param in_session A valid initiator session
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsDestroyInitiatorSession(mxlFabricsInstance in_fabricsInstance, mxlFabricsInitiatorSession in_session);
+
+    /**
+     * Add a target session to an initiator session. An initiator session can write to many target sessions. This function is non-blocking.
+     * With connected endpoints, the connection is established during calls to mxlFabricsInitiatorSessionMakeProgress*(). With reliable
+     * datagram endpoints, the address of the target is inserted in the address vector of the session and the target can be written to
+     * immediately.
+     * \param in_session A valid initiator session
+     * \param in_targetInfo The target info of the target session.
+     * \return The result code. MXL_ERR_EXISTS if the session already writes to the target session, MXL_ERR_INVALID_ARG if the target
+     * session doesn't have as many rails as the initiator session. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionConnect(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo);
+
+    /**
+     * Remove a target session from an initiator session, along with the flows that were added for it. The transfers to the target should
+     * have completed, \see mxlFabricsInitiatorSessionMakeProgressBlocking().
+     * \param in_session A valid initiator session
+     * \param in_targetInfo The target info the target session was added with.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionDisconnect(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo);
+
+    /**
+     * Add a flow to an initiator session. The local regions of the flow are registered and associated with the remote regions of a flow
+     * of the target session. The local and remote flows must have the same number and size of grains. To distribute a flow to many target
+     * sessions, add it once per target session with the same local regions: they are only registered once, every transfer of the flow
+     * writes the grain to all of them, and the flow keeps the id it got in the initiator session whatever the id of its remote flow in
+     * each target session.
+     * \param in_session A valid initiator session
+     * \param in_targetInfo The target info of the target session. It must have been obtained after the flow was added to the target.
+     * \param in_remoteFlowId The id of the flow in the target session, as returned by mxlFabricsTargetSessionAddFlow().
+     * \param in_regions The local regions of the flow, as returned by mxlFabricsRegionsForFlowReader().
+     * \param out_flowId Returns the id of the flow in the initiator session, which identifies the flow in the other initiator functions.
+     * \return The result code. MXL_ERR_EXISTS if the flow is already written to the target session, or if the session already carries
+     * MXL_FABRICS_SESSION_MAX_FLOWS flows. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionAddFlow(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo,
+        uint16_t in_remoteFlowId, mxlRegions in_regions, uint16_t* out_flowId);
+
+    /**
+     * Remove a flow from an initiator session, for all the target sessions it was added for. No new transfers of the flow can be enqueued
+     * after this call.
+     * \param in_session A valid initiator session
+     * \param in_flowId The id returned by mxlFabricsInitiatorSessionAddFlow().
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionRemoveFlow(mxlFabricsInitiatorSession in_session, uint16_t in_flowId);
+
+    /**
+     * Enqueue the transfer of a grain of a flow of the session. This function is always non-blocking. The transfer is only guaranteed to
+     * have completed after mxlFabricsInitiatorSessionMakeProgress*() no longer returns MXL_ERR_NOT_READY. Like with
+     * mxlFabricsInitiatorTransferGrain(), only the header of grains flagged with MXL_GRAIN_FLAG_REPEAT is transferred.
+     * \param in_session A valid initiator session
+     * \param in_flowId The id returned by mxlFabricsInitiatorSessionAddFlow().
+     * \param in_grainIndex The index of the grain to transfer.
+     * \return The result code. MXL_ERR_NOT_READY if no target session of the flow is connected yet, if the work queue is full before
+     * any write of the grain could be posted, or, with flow control, if a connected target session of the flow didn't release enough
+     * grains yet. A target session whose work queue is full after the grain was written to others misses the grain, as do target sessions
+     * whose link is being recovered. The stripes of the grain that don't fit in the work queues of the other rails are queued and posted
+     * while making progress, as are the bursts of paced flows. MXL_ERR_NOT_READY is also returned when the bursts of the grains already
+     * scheduled end more than a grain period from now. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionTransferGrain(mxlFabricsInitiatorSession in_session, uint16_t in_flowId, uint64_t in_grainIndex);
+
+    /**
+     * Pace the transfers of a flow of an initiator session, or stop pacing them. \see mxlFlowPacingConfig
+     * \param in_session A valid initiator session
+     * \param in_flowId The id returned by mxlFabricsInitiatorSessionAddFlow().
+     * \param in_config The pacing of the flow. A zero grain rate numerator stops pacing the grains transferred from now on.
+     * \return The result code. MXL_ERR_NOT_FOUND if the flow is not part of the session, MXL_ERR_INVALID_ARG if the grain rate or the
+     * active share is invalid, MXL_ERR_INVALID_STATE if the provider of a rail of the session doesn't place the writes of an endpoint in
+     * order (FI_ORDER_WAW), which the bursts of a grain rely on. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionSetFlowPacing(mxlFabricsInitiatorSession in_session, uint16_t in_flowId,
+        mxlFlowPacingConfig const* in_config);
+
+    /**
+     * Get the pacing metrics of a flow of an initiator session.
+     * \param in_session A valid initiator session
+     * \param in_flowId The id returned by mxlFabricsInitiatorSessionAddFlow().
+     * \param out_stats Returns the metrics. They are all 0 if the flow was never paced.
+     * \return The result code. MXL_ERR_NOT_FOUND if the flow is not part of the session. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionGetFlowPacingStats(mxlFabricsInitiatorSession in_session, uint16_t in_flowId,
+        mxlFlowPacingStats* out_stats);
+
+    /**
+     * Make progress on the connection establishment, the recovery of failed links and the queued transfers of an initiator session.
+     * \param in_session The initiator session that should make progress.
+     * \return The result code. Returns MXL_ERR_NOT_READY if there is still progress to be made, which includes links being
+     * recovered and bursts of paced grains that were not written yet.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionMakeProgressNonBlocking(mxlFabricsInitiatorSession in_session);
+
+    /**
+     * Make progress on the connection establishment, the recovery of failed links and the queued transfers of an initiator session.
+     * \param in_session The initiator session that should make progress.
+     * \param in_timeoutMs The maximum time to wait for progress to be made (in milliseconds).
+     * \return The result code. Returns MXL_ERR_NOT_READY if there is still progress to be made before the timeout.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionMakeProgressBlocking(mxlFabricsInitiatorSession in_session, uint16_t in_timeoutMs);
+
+    /**
+     * Get the state of the link of an initiator session to a target session, and how long it was interrupted.
+     * \param in_session A valid initiator session
+     * \param in_targetInfo The target info the target session was added with.
+     * \param out_status Returns the status of the link.
+     * \return The result code. MXL_ERR_NOT_FOUND if the session doesn't write to the target session. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionGetLinkStatus(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo,
+        mxlFabricsLinkStatus* out_status);
+
+    /**
+     * Get the counters of the transfers of an initiator session to a target session since the target session was added. The completions
+     * of the writes of a connected link are matched with the writes in the order they were posted, those of a connectionless session in
+     * the order the writes were posted on each rail, whatever their target session.
+     * \param in_session A valid initiator session
+     * \param in_targetInfo The target info the target session was added with.
+     * \param out_stats Returns the counters.
+     * \return The result code. MXL_ERR_NOT_FOUND if the session doesn't write to the target session. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsInitiatorSessionGetStats(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo,
+        mxlFabricsLinkStats* out_stats);
+
+    /**
+     * Create an mxl instance that can pull some of its flows from remote target sessions. It behaves like an instance created with
+     * mxlCreateInstance(), except that the readers of pulled flows (\see mxlFabricsPullInstanceAddFlow()) fetch the grains they are asked
+     * for from the source with RDMA reads before returning them. A blocking read polls the source until its timeout expires.
+     * \param in_mxlDomain The mxl domain of the instance
+     * \param in_options Additional options, as for mxlCreateInstance(). May be NULL.
+     * \param in_config The configuration of the session the flows are pulled with. Only its first rail is used.
+     * \param out_instance Returns the created instance. It must be destroyed with mxlDestroyInstance().
+     * \return The result code. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsCreatePullInstance(char const* in_mxlDomain, char const* in_options, mxlSessionConfig const* in_config,
+        mxlInstance* out_instance);
+
+    /**
+     * Pull a flow exposed by a target session (\see mxlFabricsTargetSessionAddPullFlow()) into a local flow of a pull instance. The local
+     * flow must have been created with the same flow definition as the source. It holds the grains that were pulled, and is written by the
+     * instance, so it must not have another writer. Only the readers of the flow created after this call pull.
+     * \param in_instance A pull instance
+     * \param in_flowId The id of the local flow
+     * \param in_targetInfo The target info of the target session
+     * \param in_sourceFlowId The id of the flow in the target session
+     * \return The result code. MXL_ERR_INVALID_ARG if the instance is not a pull instance or the flow is not discrete, MXL_ERR_EXISTS if
+     * the flow is already pulled. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFabricsPullInstanceAddFlow(mxlInstance in_instance, char const* in_flowId, mxlTargetInfo const in_targetInfo,
+        uint16_t in_sourceFlowId);
+
     // Below are helper functions
 
     /**
@@ -302,7 +802,7 @@ extern "C"
     mxlStatus mxlFabricsProviderToString(mxlFabricsProvider in_provider, char* out_string, size_t* in_stringSize);
 
     /**
-     * Serialize a target info object obtained from mxlFabricsTargetSetup() into a string representation.
+     * Serialize a target info object obtained from mxlFabricsTargetSetup() or mxlFabricsTargetSessionGetInfo() into a string representation.
      * \param in_targetInfo A valid target info to serialize
      * \param out_string A user supplied buffer of the correct size. Initially you can pass a NULL pointer to obtain the size of the string.
      * \param in_stringSize The size of the output string.
@@ -319,7 +819,7 @@ extern "C"
     mxlStatus mxlFabricsTargetInfoFromString(char const* in_string, mxlTargetInfo* out_targetInfo);
 
     /**
-     * Free a mxlTargetInfo object obtained from mxlFabricsTargetSetup() or mxlFabricsTargetInfoFromString().
+     * Free a mxlTargetInfo object obtained from mxlFabricsTargetSetup(), mxlFabricsTargetSessionGetInfo() or mxlFabricsTargetInfoFromString().
      * \param in_info A mxlTargetInfo object
      * \return MXL_STATUS_OK if the mxlTargetInfo object was freed.
      */
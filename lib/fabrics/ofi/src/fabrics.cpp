@@ -3,150 +3,808 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <mxl/fabrics.h>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
 #include <mxl/mxl.h>
+#include <mxl-internal/DiscreteFlowWriter.hpp>
+#include <mxl-internal/Instance.hpp>
+#include <mxl-internal/Logging.hpp>
+#include "internal/Exception.hpp"
+#include "internal/FabricsInstance.hpp"
+#include "internal/Format.hpp"
+#include "internal/Initiator.hpp"
+#include "internal/InitiatorSession.hpp"
+#include "internal/Provider.hpp"
+#include "internal/PullFlowIoFactory.hpp"
+#include "internal/Region.hpp"
+#include "internal/Session.hpp"
+#include "internal/Target.hpp"
+#include "internal/TargetInfo.hpp"
+#include "internal/TargetSession.hpp"
 
-#define MXL_FABRICS_UNUSED(x) (void)x
+namespace ofi = mxl::lib::fabrics::ofi;
+
+namespace
+{
+    /** \brief Run the implementation of an API function, and convert the exceptions it throws to status codes.
+     */
+    template<typename F>
+    mxlStatus apiCall(char const* name, F&& f) noexcept
+    {
+        try
+        {
+            return f();
+        }
+        catch (ofi::Exception const& e)
+        {
+            if (e.status() != MXL_ERR_NOT_READY)
+            {
+                MXL_ERROR("{} failed: {}", name, e.what());
+            }
+            return e.status();
+        }
+        catch (std::exception const& e)
+        {
+            MXL_ERROR("{} failed: {}", name, e.what());
+        }
+        catch (...)
+        {
+            MXL_ERROR("{} failed: {}", name, "An unknown error occured.");
+        }
+        return MXL_ERR_UNKNOWN;
+    }
+
+    /** \brief Copy a string to a user supplied buffer, or return the size of the buffer it needs.
+     */
+    mxlStatus copyString(std::string const& s, char* out_string, size_t* io_stringSize) noexcept
+    {
+        auto const requiredSize = s.size() + 1; // +1 for the null terminator
+        if ((out_string == nullptr) || (*io_stringSize < requiredSize))
+        {
+            *io_stringSize = requiredSize;
+            return MXL_ERR_INVALID_ARG;
+        }
+        *io_stringSize = requiredSize;
+        std::strncpy(out_string, s.c_str(), requiredSize);
+        return MXL_STATUS_OK;
+    }
+
+    /** \brief Convert a received grain to the API structure, or report that there is none.
+     */
+    mxlStatus toAPI(std::optional<mxlSessionGrain> const& grain, mxlSessionGrain* out_grain) noexcept
+    {
+        if (!grain)
+        {
+            return MXL_ERR_NOT_READY;
+        }
+        *out_grain = *grain;
+        return MXL_STATUS_OK;
+    }
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsRegionsForFlowReader(mxlFlowReader in_reader, mxlRegions* out_regions)
+{
+    if ((in_reader == nullptr) || (out_regions == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsRegionsForFlowReader", [&]() {
+        auto& flowData = const_cast<mxl::lib::FlowData&>(mxl::lib::to_FlowReader(in_reader)->getFlowData());
+        *out_regions = (new ofi::MxlRegions{ofi::mxlRegionsFromFlow(flowData)})->toAPI();
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsRegionsForFlowWriter(mxlFlowWriter in_writer, mxlRegions* out_regions)
+{
+    if ((in_writer == nullptr) || (out_regions == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsRegionsForFlowWriter", [&]() {
+        auto& flowData = const_cast<mxl::lib::FlowData&>(mxl::lib::to_FlowWriter(in_writer)->getFlowData());
+        *out_regions = (new ofi::MxlRegions{ofi::mxlRegionsFromFlow(flowData)})->toAPI();
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsRegionsFromUserBuffers(mxlFabricsMemoryRegion const* in_regions, size_t in_count, mxlRegions* out_regions)
+{
+    if ((in_regions == nullptr) || (out_regions == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsRegionsFromUserBuffers", [&]() {
+        *out_regions = (new ofi::MxlRegions{ofi::mxlRegionsFromUser(in_regions, in_count)})->toAPI();
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsRegionsFree(mxlRegions in_regions)
+{
+    if (in_regions == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    delete ofi::MxlRegions::fromAPI(in_regions);
+    return MXL_STATUS_OK;
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsCreateInstance(mxlInstance in_instance, mxlFabricsInstance* out_fabricsInstance)
+{
+    if ((in_instance == nullptr) || (out_fabricsInstance == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsCreateInstance", [&]() {
+        *out_fabricsInstance = (new ofi::FabricsInstance{in_instance})->toAPI();
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsDestroyInstance(mxlFabricsInstance in_instance)
+{
+    if (in_instance == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsDestroyInstance", [&]() {
+        delete ofi::FabricsInstance::fromAPI(in_instance);
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsCreateTarget(mxlFabricsInstance in_fabricsInstance, mxlFabricsTarget* out_target)
+{
+    if ((in_fabricsInstance == nullptr) || (out_target == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsCreateTarget", [&]() {
+        *out_target = ofi::FabricsInstance::fromAPI(in_fabricsInstance)->createTarget().toAPI();
+        return MXL_STATUS_OK;
+    });
+}
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsRegionsForFlowReader(mxlFlowReader, mxlRegions*)
+mxlStatus mxlFabricsDestroyTarget(mxlFabricsInstance in_fabricsInstance, mxlFabricsTarget in_target)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_fabricsInstance == nullptr) || (in_target == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsDestroyTarget", [&]() {
+        ofi::FabricsInstance::fromAPI(in_fabricsInstance)->destroyTarget(*ofi::Target::fromAPI(in_target));
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsRegionsForFlowWriter(mxlFlowWriter, mxlRegions*)
+mxlStatus mxlFabricsTargetSetup(mxlFabricsTarget in_target, mxlTargetConfig* in_config, mxlTargetInfo* out_info)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_target == nullptr) || (in_config == nullptr) || (out_info == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetSetup", [&]() {
+        *out_info = (new ofi::TargetInfo{ofi::Target::fromAPI(in_target)->setup(*in_config)})->toAPI();
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsRegionsFromUserBuffers(mxlFabricsMemoryRegion const*, size_t, mxlRegions*)
+mxlStatus mxlFabricsTargetTryNewGrain(mxlFabricsTarget in_target, uint64_t* out_index)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_target == nullptr) || (out_index == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetTryNewGrain", [&]() {
+        auto const index = ofi::Target::fromAPI(in_target)->tryNewGrain();
+        if (!index)
+        {
+            return MXL_ERR_NOT_READY;
+        }
+        *out_index = *index;
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsRegionsFree(mxlRegions)
+mxlStatus mxlFabricsTargetWaitForNewGrain(mxlFabricsTarget in_target, uint64_t* out_index, uint16_t in_timeoutMs)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_target == nullptr) || (out_index == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetWaitForNewGrain", [&]() {
+        auto const index = ofi::Target::fromAPI(in_target)->waitForNewGrain(std::chrono::milliseconds{in_timeoutMs});
+        if (!index)
+        {
+            return MXL_ERR_NOT_READY;
+        }
+        *out_index = *index;
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsCreateInstance(mxlInstance, mxlFabricsInstance*)
+mxlStatus mxlFabricsCreateInitiator(mxlFabricsInstance in_fabricsInstance, mxlFabricsInitiator* out_initiator)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_fabricsInstance == nullptr) || (out_initiator == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsCreateInitiator", [&]() {
+        *out_initiator = ofi::FabricsInstance::fromAPI(in_fabricsInstance)->createInitiator().toAPI();
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsDestroyInstance(mxlFabricsInstance)
+mxlStatus mxlFabricsDestroyInitiator(mxlFabricsInstance in_fabricsInstance, mxlFabricsInitiator in_initiator)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_fabricsInstance == nullptr) || (in_initiator == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsDestroyInitiator", [&]() {
+        ofi::FabricsInstance::fromAPI(in_fabricsInstance)->destroyInitiator(*ofi::Initiator::fromAPI(in_initiator));
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsCreateTarget(mxlFabricsInstance, mxlFabricsTarget*)
+mxlStatus mxlFabricsInitiatorSetup(mxlFabricsInitiator in_initiator, mxlInitiatorConfig const* in_config)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_initiator == nullptr) || (in_config == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSetup", [&]() {
+        ofi::Initiator::fromAPI(in_initiator)->setup(*in_config);
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsDestroyTarget(mxlFabricsInstance, mxlFabricsTarget)
+mxlStatus mxlFabricsInitiatorAddTarget(mxlFabricsInitiator in_initiator, mxlTargetInfo const in_targetInfo)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_initiator == nullptr) || (in_targetInfo == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorAddTarget", [&]() {
+        ofi::Initiator::fromAPI(in_initiator)->addTarget(*ofi::TargetInfo::fromAPI(in_targetInfo));
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsTargetSetup(mxlFabricsTarget, mxlTargetConfig*, mxlTargetInfo*)
+mxlStatus mxlFabricsInitiatorRemoveTarget(mxlFabricsInitiator in_initiator, mxlTargetInfo const in_targetInfo)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_initiator == nullptr) || (in_targetInfo == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorRemoveTarget", [&]() {
+        ofi::Initiator::fromAPI(in_initiator)->removeTarget(*ofi::TargetInfo::fromAPI(in_targetInfo));
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsTargetTryNewGrain(mxlFabricsTarget, uint64_t*)
+mxlStatus mxlFabricsInitiatorTransferGrain(mxlFabricsInitiator in_initiator, uint64_t in_grainIndex)
 {
-    return MXL_ERR_INTERNAL;
+    if (in_initiator == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorTransferGrain", [&]() {
+        ofi::Initiator::fromAPI(in_initiator)->transferGrain(in_grainIndex);
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsTargetWaitForNewGrain(mxlFabricsTarget, uint64_t*, uint16_t)
+mxlStatus mxlFabricsInitiatorMakeProgressNonBlocking(mxlFabricsInitiator in_initiator)
 {
-    return MXL_ERR_INTERNAL;
+    if (in_initiator == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorMakeProgressNonBlocking",
+        [&]() { return ofi::Initiator::fromAPI(in_initiator)->makeProgress() ? MXL_STATUS_OK : MXL_ERR_NOT_READY; });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsCreateInitiator(mxlFabricsInstance, mxlFabricsInitiator*)
+mxlStatus mxlFabricsInitiatorMakeProgressBlocking(mxlFabricsInitiator in_initiator, uint16_t in_timeoutMs)
 {
-    return MXL_ERR_INTERNAL;
+    if (in_initiator == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorMakeProgressBlocking", [&]() {
+        auto const timeout = std::chrono::milliseconds{in_timeoutMs};
+        return ofi::Initiator::fromAPI(in_initiator)->makeProgressBlocking(timeout) ? MXL_STATUS_OK : MXL_ERR_NOT_READY;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsDestroyInitiator(mxlFabricsInstance, mxlFabricsInitiator)
+mxlStatus mxlFabricsCreateTargetSession(mxlFabricsInstance in_fabricsInstance, mxlSessionConfig const* in_config,
+    mxlFabricsTargetSession* out_session)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_fabricsInstance == nullptr) || (in_config == nullptr) || (out_session == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsCreateTargetSession", [&]() {
+        auto const config = ofi::SessionConfig::fromAPI(*in_config);
+        *out_session = ofi::FabricsInstance::fromAPI(in_fabricsInstance)->createTargetSession(config).toAPI();
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsInitiatorSetup(mxlFabricsInitiator, mxlInitiatorConfig const*)
+mxlStatus mxlFabricsDestroyTargetSession(mxlFabricsInstance in_fabricsInstance, mxlFabricsTargetSession in_session)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_fabricsInstance == nullptr) || (in_session == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsDestroyTargetSession", [&]() {
+        ofi::FabricsInstance::fromAPI(in_fabricsInstance)->destroyTargetSession(*ofi::TargetSession::fromAPI(in_session));
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsInitiatorAddTarget(mxlFabricsInitiator, mxlTargetInfo const)
+mxlStatus mxlFabricsTargetSessionAddFlow(mxlFabricsTargetSession in_session, mxlRegions in_regions, uint16_t* out_flowId)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_session == nullptr) || (in_regions == nullptr) || (out_flowId == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetSessionAddFlow", [&]() {
+        *out_flowId = static_cast<uint16_t>(ofi::TargetSession::fromAPI(in_session)->addFlow(*ofi::MxlRegions::fromAPI(in_regions)));
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsInitiatorRemoveTarget(mxlFabricsInitiator, mxlTargetInfo const)
+mxlStatus mxlFabricsTargetSessionAddPullFlow(mxlFabricsTargetSession in_session, mxlFlowReader in_reader, uint16_t* out_flowId)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_session == nullptr) || (in_reader == nullptr) || (out_flowId == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetSessionAddPullFlow", [&]() {
+        auto& flowData = const_cast<mxl::lib::FlowData&>(mxl::lib::to_FlowReader(in_reader)->getFlowData());
+        *out_flowId = static_cast<uint16_t>(ofi::TargetSession::fromAPI(in_session)->addPullFlow(flowData));
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsInitiatorTransferGrain(mxlFabricsInitiator, uint64_t)
+mxlStatus mxlFabricsTargetSessionRemoveFlow(mxlFabricsTargetSession in_session, uint16_t in_flowId)
 {
-    return MXL_ERR_INTERNAL;
+    if (in_session == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetSessionRemoveFlow", [&]() {
+        ofi::TargetSession::fromAPI(in_session)->removeFlow(in_flowId);
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsInitiatorMakeProgressNonBlocking(mxlFabricsInitiator)
+mxlStatus mxlFabricsTargetSessionGetInfo(mxlFabricsTargetSession in_session, mxlTargetInfo* out_info)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_session == nullptr) || (out_info == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetSessionGetInfo", [&]() {
+        *out_info = (new ofi::TargetInfo{ofi::TargetSession::fromAPI(in_session)->info()})->toAPI();
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsInitiatorMakeProgressBlocking(mxlFabricsInitiator, uint16_t)
+mxlStatus mxlFabricsTargetSessionTryNewGrain(mxlFabricsTargetSession in_session, mxlSessionGrain* out_grain)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_session == nullptr) || (out_grain == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetSessionTryNewGrain",
+        [&]() { return toAPI(ofi::TargetSession::fromAPI(in_session)->tryNewGrain(), out_grain); });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsProviderFromString(char const*, mxlFabricsProvider*)
+mxlStatus mxlFabricsTargetSessionWaitForNewGrain(mxlFabricsTargetSession in_session, mxlSessionGrain* out_grain, uint16_t in_timeoutMs)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_session == nullptr) || (out_grain == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetSessionWaitForNewGrain", [&]() {
+        auto const timeout = std::chrono::milliseconds{in_timeoutMs};
+        return toAPI(ofi::TargetSession::fromAPI(in_session)->waitForNewGrain(timeout), out_grain);
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsTargetSessionReleaseGrains(mxlFabricsTargetSession in_session, uint16_t in_flowId, uint64_t in_index)
+{
+    if (in_session == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetSessionReleaseGrains", [&]() {
+        ofi::TargetSession::fromAPI(in_session)->releaseGrains(in_flowId, in_index);
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsProviderToString(mxlFabricsProvider, char*, size_t*)
+mxlStatus mxlFabricsTargetSessionGetStats(mxlFabricsTargetSession in_session, mxlFabricsLinkStats* out_stats)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_session == nullptr) || (out_stats == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetSessionGetStats", [&]() {
+        *out_stats = ofi::TargetSession::fromAPI(in_session)->stats();
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsTargetInfoFromString(char const*, mxlTargetInfo*)
+mxlStatus mxlFabricsCreateInitiatorSession(mxlFabricsInstance in_fabricsInstance, mxlSessionConfig const* in_config,
+    mxlFabricsInitiatorSession* out_session)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_fabricsInstance == nullptr) || (in_config == nullptr) || (out_session == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsCreateInitiatorSession", [&]() {
+        auto const config = ofi::SessionConfig::fromAPI(*in_config);
+        *out_session = ofi::FabricsInstance::fromAPI(in_fabricsInstance)->createInitiatorSession(config).toAPI();
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsTargetInfoToString(mxlTargetInfo const, char*, size_t*)
+mxlStatus mxlFabricsDestroyInitiatorSession(mxlFabricsInstance in_fabricsInstance, mxlFabricsInitiatorSession in_session)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_fabricsInstance == nullptr) || (in_session == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsDestroyInitiatorSession", [&]() {
+        ofi::FabricsInstance::fromAPI(in_fabricsInstance)->destroyInitiatorSession(*ofi::InitiatorSession::fromAPI(in_session));
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionConnect(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo)
+{
+    if ((in_session == nullptr) || (in_targetInfo == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionConnect", [&]() {
+        ofi::InitiatorSession::fromAPI(in_session)->connect(*ofi::TargetInfo::fromAPI(in_targetInfo));
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionDisconnect(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo)
+{
+    if ((in_session == nullptr) || (in_targetInfo == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionDisconnect", [&]() {
+        ofi::InitiatorSession::fromAPI(in_session)->disconnect(*ofi::TargetInfo::fromAPI(in_targetInfo));
+        return MXL_STATUS_OK;
+    });
 }
 
 extern "C" MXL_EXPORT
-mxlStatus mxlFabricsFreeTargetInfo(mxlTargetInfo)
+mxlStatus mxlFabricsInitiatorSessionAddFlow(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo,
+    uint16_t in_remoteFlowId, mxlRegions in_regions, uint16_t* out_flowId)
 {
-    return MXL_ERR_INTERNAL;
+    if ((in_session == nullptr) || (in_targetInfo == nullptr) || (in_regions == nullptr) || (out_flowId == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionAddFlow", [&]() {
+        auto const& info = *ofi::TargetInfo::fromAPI(in_targetInfo);
+        auto const& regions = *ofi::MxlRegions::fromAPI(in_regions);
+        *out_flowId = static_cast<uint16_t>(ofi::InitiatorSession::fromAPI(in_session)->addFlow(info, in_remoteFlowId, regions));
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionRemoveFlow(mxlFabricsInitiatorSession in_session, uint16_t in_flowId)
+{
+    if (in_session == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionRemoveFlow", [&]() {
+        ofi::InitiatorSession::fromAPI(in_session)->removeFlow(in_flowId);
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionTransferGrain(mxlFabricsInitiatorSession in_session, uint16_t in_flowId, uint64_t in_grainIndex)
+{
+    if (in_session == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionTransferGrain", [&]() {
+        ofi::InitiatorSession::fromAPI(in_session)->transferGrain(in_flowId, in_grainIndex);
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionSetFlowPacing(mxlFabricsInitiatorSession in_session, uint16_t in_flowId,
+    mxlFlowPacingConfig const* in_config)
+{
+    if ((in_session == nullptr) || (in_config == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionSetFlowPacing", [&]() {
+        ofi::InitiatorSession::fromAPI(in_session)->setFlowPacing(in_flowId, *in_config);
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionGetFlowPacingStats(mxlFabricsInitiatorSession in_session, uint16_t in_flowId,
+    mxlFlowPacingStats* out_stats)
+{
+    if ((in_session == nullptr) || (out_stats == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionGetFlowPacingStats", [&]() {
+        *out_stats = ofi::InitiatorSession::fromAPI(in_session)->flowPacingStats(in_flowId);
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionMakeProgressNonBlocking(mxlFabricsInitiatorSession in_session)
+{
+    if (in_session == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionMakeProgressNonBlocking",
+        [&]() { return ofi::InitiatorSession::fromAPI(in_session)->makeProgress() ? MXL_STATUS_OK : MXL_ERR_NOT_READY; });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionMakeProgressBlocking(mxlFabricsInitiatorSession in_session, uint16_t in_timeoutMs)
+{
+    if (in_session == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionMakeProgressBlocking", [&]() {
+        auto const timeout = std::chrono::milliseconds{in_timeoutMs};
+        return ofi::InitiatorSession::fromAPI(in_session)->makeProgressBlocking(timeout) ? MXL_STATUS_OK : MXL_ERR_NOT_READY;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionGetLinkStatus(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo,
+    mxlFabricsLinkStatus* out_status)
+{
+    if ((in_session == nullptr) || (in_targetInfo == nullptr) || (out_status == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionGetLinkStatus", [&]() {
+        *out_status = ofi::InitiatorSession::fromAPI(in_session)->linkStatus(*ofi::TargetInfo::fromAPI(in_targetInfo));
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsInitiatorSessionGetStats(mxlFabricsInitiatorSession in_session, mxlTargetInfo const in_targetInfo,
+    mxlFabricsLinkStats* out_stats)
+{
+    if ((in_session == nullptr) || (in_targetInfo == nullptr) || (out_stats == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsInitiatorSessionGetStats", [&]() {
+        *out_stats = ofi::InitiatorSession::fromAPI(in_session)->stats(*ofi::TargetInfo::fromAPI(in_targetInfo));
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsCreatePullInstance(char const* in_mxlDomain, char const* in_options, mxlSessionConfig const* in_config,
+    mxlInstance* out_instance)
+{
+    if ((in_mxlDomain == nullptr) || (in_config == nullptr) || (out_instance == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsCreatePullInstance", [&]() {
+        auto const opts = (in_options != nullptr) ? in_options : "";
+        auto flowIoFactory = std::make_unique<ofi::PullFlowIoFactory>(ofi::SessionConfig::fromAPI(*in_config));
+        *out_instance = reinterpret_cast<mxlInstance>(new mxl::lib::Instance{in_mxlDomain, opts, std::move(flowIoFactory)});
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsPullInstanceAddFlow(mxlInstance in_instance, char const* in_flowId, mxlTargetInfo const in_targetInfo,
+    uint16_t in_sourceFlowId)
+{
+    if ((in_instance == nullptr) || (in_flowId == nullptr) || (in_targetInfo == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsPullInstanceAddFlow", [&]() {
+        auto const instance = mxl::lib::to_Instance(in_instance);
+        auto const factory = dynamic_cast<ofi::PullFlowIoFactory*>(&instance->getFlowIoFactory());
+        if (factory == nullptr)
+        {
+            throw ofi::Exception::invalidArgument("The instance was not created with mxlFabricsCreatePullInstance()");
+        }
+
+        // The instance keeps the writer of the mirror until it is destroyed.
+        auto const writer = instance->getFlowWriter(in_flowId);
+        try
+        {
+            auto const mirror = dynamic_cast<mxl::lib::DiscreteFlowWriter*>(writer);
+            if (mirror == nullptr)
+            {
+                throw ofi::Exception::invalidArgument("Only discrete flows can be pulled");
+            }
+            factory->addFlow(writer->getId(), *ofi::TargetInfo::fromAPI(in_targetInfo), in_sourceFlowId, *mirror);
+        }
+        catch (...)
+        {
+            instance->releaseWriter(writer);
+            throw;
+        }
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsProviderFromString(char const* in_string, mxlFabricsProvider* out_provider)
+{
+    if ((in_string == nullptr) || (out_provider == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    auto const provider = ofi::providerFromString(in_string);
+    if (!provider)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+    *out_provider = ofi::providerToAPI(*provider);
+    return MXL_STATUS_OK;
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsProviderToString(mxlFabricsProvider in_provider, char* out_string, size_t* in_stringSize)
+{
+    if (in_stringSize == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsProviderToString", [&]() { return copyString(fmt::format("{}", in_provider), out_string, in_stringSize); });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsTargetInfoFromString(char const* in_string, mxlTargetInfo* out_targetInfo)
+{
+    if ((in_string == nullptr) || (out_targetInfo == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetInfoFromString", [&]() {
+        *out_targetInfo = (new ofi::TargetInfo{ofi::TargetInfo::fromString(in_string)})->toAPI();
+        return MXL_STATUS_OK;
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsTargetInfoToString(mxlTargetInfo const in_targetInfo, char* out_string, size_t* in_stringSize)
+{
+    if ((in_targetInfo == nullptr) || (in_stringSize == nullptr))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    return apiCall("mxlFabricsTargetInfoToString", [&]() {
+        return copyString(ofi::TargetInfo::fromAPI(in_targetInfo)->toString(), out_string, in_stringSize);
+    });
+}
+
+extern "C" MXL_EXPORT
+mxlStatus mxlFabricsFreeTargetInfo(mxlTargetInfo in_info)
+{
+    if (in_info == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    delete ofi::TargetInfo::fromAPI(in_info);
+    return MXL_STATUS_OK;
 }
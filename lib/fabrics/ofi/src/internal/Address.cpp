@@ -8,7 +8,7 @@
 #include <rdma/fi_cm.h>
 #include <rdma/fi_errno.h>
 #include "mxl/mxl.h"
-#include "Base64.hpp"
+#include "mxl-internal/Base64.hpp"
 #include "Exception.hpp"
 
 namespace mxl::lib::fabrics::ofi
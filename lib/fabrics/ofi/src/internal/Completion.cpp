@@ -26,6 +26,11 @@ namespace mxl::lib::fabrics::ofi
         return _raw.data;
     }
 
+    std::size_t Completion::Data::length() const noexcept
+    {
+        return _raw.len;
+    }
+
     bool Completion::Data::isRemoteWrite() const noexcept
     {
         return (_raw.flags & FI_RMA) && (_raw.flags & FI_REMOTE_WRITE);
@@ -36,6 +41,11 @@ namespace mxl::lib::fabrics::ofi
         return (_raw.flags & FI_RMA) && (_raw.flags & FI_WRITE);
     }
 
+    bool Completion::Data::isLocalRead() const noexcept
+    {
+        return (_raw.flags & FI_RMA) && (_raw.flags & FI_READ);
+    }
+
     Completion::Error::Error(::fi_cq_err_entry const& raw, std::shared_ptr<CompletionQueue> cq)
         : _raw(raw)
         , _cq(std::move(cq))
@@ -46,11 +56,21 @@ namespace mxl::lib::fabrics::ofi
         return ::fi_cq_strerror(_cq->raw(), _raw.prov_errno, _raw.err_data, nullptr, 0);
     }
 
+    int Completion::Error::code() const noexcept
+    {
+        return _raw.err;
+    }
+
     ::fid_ep* Completion::Error::fid() const noexcept
     {
         return reinterpret_cast<::fid_ep*>(_raw.op_context);
     }
 
+    bool Completion::Error::isLocalRead() const noexcept
+    {
+        return (_raw.flags & FI_RMA) && (_raw.flags & FI_READ);
+    }
+
     Completion::Data Completion::data() const
     {
         if (auto data = std::get_if<Completion::Data>(&_inner); data)
@@ -123,4 +143,14 @@ namespace mxl::lib::fabrics::ofi
             },
             _inner);
     }
+
+    bool Completion::isLocalRead() const noexcept
+    {
+        return std::visit(
+            overloaded{
+                [](Completion::Data const& data) { return data.isLocalRead(); },
+                [](Completion::Error const& err) { return err.isLocalRead(); },
+            },
+            _inner);
+    }
 }
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -29,6 +31,11 @@ namespace mxl::lib::fabrics::ofi
             [[nodiscard]]
             std::optional<std::uint64_t> data() const noexcept;
 
+            /** \brief The number of bytes received, for receives and remote writes with remote completion data.
+             */
+            [[nodiscard]]
+            std::size_t length() const noexcept;
+
             /** \brief This used to associate a completion entry with an endpoint when multiple endpoints use the same completion queue.
              */
             [[nodiscard]]
@@ -44,6 +51,11 @@ namespace mxl::lib::fabrics::ofi
             [[nodiscard]]
             bool isLocalWrite() const noexcept;
 
+            /** \brief Indicates whether the completion entry represents a local read operation.
+             */
+            [[nodiscard]]
+            bool isLocalRead() const noexcept;
+
         private:
             friend class CompletionQueue;
 
@@ -65,11 +77,21 @@ namespace mxl::lib::fabrics::ofi
             [[nodiscard]]
             std::string toString() const;
 
+            /** \brief The positive fi_errno of the failed operation, such as FI_EIO.
+             */
+            [[nodiscard]]
+            int code() const noexcept;
+
             /** \brief This used to associate a completion entry with an endpoint when multiple endpoints use the same completion queue.
              */
             [[nodiscard]]
             ::fid_ep* fid() const noexcept;
 
+            /** \brief Indicates whether the failed operation was a local read operation.
+             */
+            [[nodiscard]]
+            bool isLocalRead() const noexcept;
+
         private:
             friend class CompletionQueue;
 
@@ -120,6 +142,11 @@ namespace mxl::lib::fabrics::ofi
         [[nodiscard]]
         ::fid_ep* fid() const noexcept;
 
+        /** \brief Whether this entry, data or error, is the completion of a local read operation.
+         */
+        [[nodiscard]]
+        bool isLocalRead() const noexcept;
+
     private:
         friend class CompletionQueue;
 
@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "CompletionQueue.hpp"
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -20,8 +22,31 @@ namespace mxl::lib::fabrics::ofi
     CompletionQueue::Attributes CompletionQueue::Attributes::defaults()
     {
         CompletionQueue::Attributes attr{};
-        attr.size = 8;                    // default size, this should be parameterized
-        attr.waitObject = FI_WAIT_UNSPEC; // TODO: EFA will require no wait object
+        attr.size = 0; // let the provider select a size that matches the size of the transmit and receive queues of the endpoints
+        attr.waitObject = FI_WAIT_UNSPEC;
+        attr.signalingVector = std::nullopt;
+        return attr;
+    }
+
+    CompletionQueue::Attributes CompletionQueue::Attributes::fromAPI(mxlCompletionQueueConfig const& config)
+    {
+        auto attr = defaults();
+        attr.size = config.depth;
+
+        switch (config.waitObject)
+        {
+            case MXL_FABRICS_WAIT_OBJECT_DEFAULT: attr.waitObject = FI_WAIT_UNSPEC; break;
+            case MXL_FABRICS_WAIT_OBJECT_NONE:    attr.waitObject = FI_WAIT_NONE; break;
+            case MXL_FABRICS_WAIT_OBJECT_FD:      attr.waitObject = FI_WAIT_FD; break;
+            case MXL_FABRICS_WAIT_OBJECT_YIELD:   attr.waitObject = FI_WAIT_YIELD; break;
+            default:                              throw Exception::invalidArgument("Invalid wait object {}", static_cast<int>(config.waitObject));
+        }
+
+        if (config.pinInterrupts)
+        {
+            attr.signalingVector = static_cast<int>(config.signalingVector);
+        }
+
         return attr;
     }
 
@@ -30,11 +55,11 @@ namespace mxl::lib::fabrics::ofi
         ::fi_cq_attr raw{};
         raw.size = size;
         raw.wait_obj = waitObject;
-        raw.format = FI_CQ_FORMAT_DATA;  // default format, this should be parameterized
-        raw.wait_cond = FI_CQ_COND_NONE; // default condition, this should be parameterized
+        raw.format = FI_CQ_FORMAT_DATA;  // the sessions need the remote CQ data of the writes they receive
+        raw.wait_cond = FI_CQ_COND_NONE; // blocking reads return as soon as a single entry is available
         raw.wait_set = nullptr;          // only used if wait_obj is FI_WAIT_SET
-        raw.flags = 0;                   // if signaling vector is required, this should use the flag "FI_AFFINITY"
-        raw.signaling_vector = 0;        // this should indicate the CPU core that interrupts associated with the cq should target.
+        raw.flags = signalingVector ? FI_AFFINITY : 0;
+        raw.signaling_vector = signalingVector.value_or(0);
         return raw;
     }
 
@@ -48,12 +73,12 @@ namespace mxl::lib::fabrics::ofi
         // expose the private constructor to std::make_shared inside this function
         struct MakeSharedEnabler : public CompletionQueue
         {
-            MakeSharedEnabler(::fid_cq* raw, std::shared_ptr<Domain> domain)
-                : CompletionQueue(raw, domain)
+            MakeSharedEnabler(::fid_cq* raw, std::shared_ptr<Domain> domain, enum fi_wait_obj waitObject)
+                : CompletionQueue(raw, domain, waitObject)
             {}
         };
 
-        return std::make_shared<MakeSharedEnabler>(cq, domain);
+        return std::make_shared<MakeSharedEnabler>(cq, domain, attr.waitObject);
     }
 
     std::optional<Completion> CompletionQueue::read()
@@ -73,15 +98,80 @@ namespace mxl::lib::fabrics::ofi
             return read();
         }
 
+        if (_waitObject == FI_WAIT_NONE)
+        {
+            // Without a wait object, fi_cq_sread is not supported.
+            auto const deadline = std::chrono::steady_clock::now() + timeout;
+            do
+            {
+                if (auto completion = read(); completion)
+                {
+                    return completion;
+                }
+            }
+            while (std::chrono::steady_clock::now() < deadline);
+
+            return std::nullopt;
+        }
+
         fi_cq_data_entry entry;
 
         ssize_t ret = fi_cq_sread(_raw, &entry, 1, nullptr, timeoutMs);
         return handleReadResult(ret, entry);
     }
 
-    CompletionQueue::CompletionQueue(::fid_cq* raw, std::shared_ptr<Domain> domain)
+    std::size_t CompletionQueue::readBatch(std::vector<Completion>& completions, std::size_t maxCount)
+    {
+        maxCount = std::max<std::size_t>(maxCount, 1);
+        if (_entries.size() < maxCount)
+        {
+            _entries.resize(maxCount);
+        }
+
+        ssize_t ret = fi_cq_read(_raw, _entries.data(), maxCount);
+        return handleBatchResult(ret, completions);
+    }
+
+    std::size_t CompletionQueue::readBatchBlocking(std::vector<Completion>& completions, std::size_t maxCount,
+        std::chrono::steady_clock::duration timeout)
+    {
+        auto timeoutMs = std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count();
+        if (timeoutMs == 0)
+        {
+            return readBatch(completions, maxCount);
+        }
+
+        if (_waitObject == FI_WAIT_NONE)
+        {
+            // Without a wait object, fi_cq_sread is not supported.
+            auto const deadline = std::chrono::steady_clock::now() + timeout;
+            do
+            {
+                if (auto count = readBatch(completions, maxCount); count > 0)
+                {
+                    return count;
+                }
+            }
+            while (std::chrono::steady_clock::now() < deadline);
+
+            return 0;
+        }
+
+        maxCount = std::max<std::size_t>(maxCount, 1);
+        if (_entries.size() < maxCount)
+        {
+            _entries.resize(maxCount);
+        }
+
+        // With FI_CQ_COND_NONE, fi_cq_sread returns as soon as one entry is available, along with all the others up to maxCount.
+        ssize_t ret = fi_cq_sread(_raw, _entries.data(), maxCount, nullptr, timeoutMs);
+        return handleBatchResult(ret, completions);
+    }
+
+    CompletionQueue::CompletionQueue(::fid_cq* raw, std::shared_ptr<Domain> domain, enum fi_wait_obj waitObject)
         : _raw(raw)
         , _domain(std::move(domain))
+        , _waitObject(waitObject)
     {}
 
     CompletionQueue::~CompletionQueue()
@@ -136,4 +226,24 @@ namespace mxl::lib::fabrics::ofi
 
         return Completion{Completion::Data{entry}};
     }
+
+    std::size_t CompletionQueue::handleBatchResult(ssize_t ret, std::vector<Completion>& completions)
+    {
+        if (ret < 0)
+        {
+            // Nothing available, or an entry of the error queue, which is read on its own.
+            if (auto completion = handleReadResult(ret, _entries.front()); completion)
+            {
+                completions.push_back(std::move(*completion));
+                return 1;
+            }
+            return 0;
+        }
+
+        auto const count = static_cast<std::size_t>(ret);
+        std::ranges::transform(_entries.begin(), _entries.begin() + ret, std::back_inserter(completions), [](auto const& entry) {
+            return Completion{Completion::Data{entry}};
+        });
+        return count;
+    }
 }
@@ -5,8 +5,11 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <optional>
+#include <vector>
+#include <mxl/fabrics.h>
 #include <rdma/fi_eq.h>
 #include "Completion.hpp"
 #include "Domain.hpp"
@@ -30,14 +33,19 @@ namespace mxl::lib::fabrics::ofi
              */
             static Attributes defaults();
 
+            /** \brief Convert from the external version of this type. Zero values select the defaults.
+             */
+            static Attributes fromAPI(mxlCompletionQueueConfig const& config);
+
             /** \brief Returns the raw libfabric version of this object.
              */
             [[nodiscard]]
             ::fi_cq_attr raw() const noexcept;
 
         public:
-            std::size_t size;            /**< Size of the queue. */
-            enum fi_wait_obj waitObject; /**< The underlying wait object that should be used. */
+            std::size_t size;                   /**< Size of the queue, 0 lets the provider select it. */
+            enum fi_wait_obj waitObject;        /**< The underlying wait object that should be used. */
+            std::optional<int> signalingVector; /**< The CPU core interrupts associated with the queue should target. */
         };
 
     public:
@@ -78,6 +86,22 @@ namespace mxl::lib::fabrics::ofi
          */
         std::optional<Completion> readBlocking(std::chrono::steady_clock::duration timeout);
 
+        /** \brief Perform a non-blocking read of up to maxCount entries with a single call into the provider.
+         *
+         * The completions are appended to `completions`, which can be reused across calls to avoid allocations. An entry of the error
+         * queue is returned on its own.
+         * \return The number of completions that were appended.
+         */
+        std::size_t readBatch(std::vector<Completion>& completions, std::size_t maxCount);
+
+        /** \brief Perform a blocking read of up to maxCount entries.
+         *
+         * Like readBlocking(), this blocks until at least one completion is available or the timeout elapsed, and then appends all the
+         * available completions, up to maxCount, to `completions`.
+         * \return The number of completions that were appended.
+         */
+        std::size_t readBatchBlocking(std::vector<Completion>& completions, std::size_t maxCount, std::chrono::steady_clock::duration timeout);
+
     private:
         /** \brief Releases all underlying resources. This is called from the destructor and the move-assignment operator.
          */
@@ -89,7 +113,7 @@ namespace mxl::lib::fabrics::ofi
          * completion queue. To prevent the queue from being released before all these events have be released, they own
          * a shared_ptr to the queue they have originated from.
          */
-        CompletionQueue(::fid_cq* raw, std::shared_ptr<Domain> domain);
+        CompletionQueue(::fid_cq* raw, std::shared_ptr<Domain> domain, enum fi_wait_obj waitObject);
 
         /** \brief Handle the result of a blocking or non-blocking read.
          *
@@ -97,8 +121,14 @@ namespace mxl::lib::fabrics::ofi
          */
         std::optional<Completion> handleReadResult(ssize_t ret, ::fi_cq_data_entry const& entry);
 
+        /** \brief Handle the result of a blocking or non-blocking batched read of the entries in _entries.
+         */
+        std::size_t handleBatchResult(ssize_t ret, std::vector<Completion>& completions);
+
     private:
-        ::fid_cq* _raw;                  /**< Raw resource reference. */
-        std::shared_ptr<Domain> _domain; /**< The domain this queue was created into. */
+        ::fid_cq* _raw;                           /**< Raw resource reference. */
+        std::shared_ptr<Domain> _domain;          /**< The domain this queue was created into. */
+        enum fi_wait_obj _waitObject;             /**< Without a wait object, blocking reads are emulated by polling. */
+        std::vector<::fi_cq_data_entry> _entries; /**< Raw entries of batched reads, kept to avoid allocations. */
     };
 }
@@ -361,9 +361,29 @@ namespace mxl::lib::fabrics::ofi
         return writeImpl(localGroup.asIovec(), localGroup.size(), const_cast<void**>(localGroup.desc()), &rmaIov, destAddr, immData);
     }
 
+    void Endpoint::read(LocalRegion const& local, RemoteRegion const& remote, ::fi_addr_t srcAddr)
+    {
+        auto msgIov = local.toIovec();
+        auto rmaIov = remote.toRmaIov();
+        void* desc = local.desc;
+
+        ::fi_msg_rma msg = {
+            .msg_iov = &msgIov,
+            .desc = &desc,
+            .iov_count = 1,
+            .addr = srcAddr,
+            .rma_iov = &rmaIov,
+            .rma_iov_count = 1,
+            .context = _raw,
+            .data = 0,
+        };
+
+        fiCall(::fi_readmsg, "Failed to push rma read to work queue.", _raw, &msg, FI_COMPLETION);
+    }
+
     void Endpoint::recv(LocalRegion region)
     {
         auto iovec = region.toIovec();
-        fiCall(::fi_recv, "Failed to push recv to work queue", _raw, iovec.iov_base, iovec.iov_len, nullptr, FI_ADDR_UNSPEC, nullptr);
+        fiCall(::fi_recv, "Failed to push recv to work queue", _raw, iovec.iov_base, iovec.iov_len, region.desc, FI_ADDR_UNSPEC, _raw);
     }
 }
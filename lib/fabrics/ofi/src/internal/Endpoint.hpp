@@ -236,12 +236,22 @@ namespace mxl::lib::fabrics::ofi
         void write(LocalRegionGroup const& localGroup, RemoteRegion const& remote, ::fi_addr_t destAddr = FI_ADDR_UNSPEC,
             std::optional<std::uint32_t> immData = std::nullopt);
 
+        /** \brief Push a remote read work request of a single contiguous buffer to the endpoint work queue.
+         *
+         * When the read is complete, a Completion::Data will be pushed to the completion queue associated with the endpoint. The remote
+         * region must have been registered for remote reads.
+         * \param local Destination memory region to read into
+         * \param remote Source memory region to read from
+         * \param srcAddr The address of the target endpoint. This is unused when using connected endpoints.
+         */
+        void read(LocalRegion const& local, RemoteRegion const& remote, ::fi_addr_t srcAddr = FI_ADDR_UNSPEC);
+
         /** \brief Push a recv work request to the endpoint work queue.
          *
          * If this is used to receive media data, a bounce buffer shall be used to receive the data into, following by a post completion operation to
          * copy the data back to the media buffers. This is required, because we only know the identification of the receive media data once it is
          * received. In the MXL context, this function can also be used to receive immediate data if domain function `usingRecvBufForCqData` returns
-         * true.
+         * true. The completion of the receive references this endpoint, like the completion of a write.
          * \param region Source memory region to receive data into
          */
         void recv(LocalRegion region);
@@ -140,4 +140,24 @@ namespace mxl::lib::fabrics::ofi
             },
             _event);
     }
+
+    Event::ConnectionRequested const& Event::connReq() const
+    {
+        if (auto connReq = std::get_if<ConnectionRequested>(&_event); connReq)
+        {
+            return *connReq;
+        }
+
+        throw Exception::invalidState("Failed to unwrap event queue entry as connection request.");
+    }
+
+    Event::Error const& Event::err() const
+    {
+        if (auto error = std::get_if<Error>(&_event); error)
+        {
+            return *error;
+        }
+
+        throw Exception::invalidState("Failed to unwrap event queue entry as error.");
+    }
 }
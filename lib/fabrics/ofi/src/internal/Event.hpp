@@ -147,6 +147,16 @@ namespace mxl::lib::fabrics::ofi
         [[nodiscard]]
         fid_t fid() noexcept;
 
+        /** \brief Accessor for the FI_CONNREQ variant. Calling this on any other event will throw
+         */
+        [[nodiscard]]
+        ConnectionRequested const& connReq() const;
+
+        /** \brief Accessor for the error variant. Calling this on any other event will throw
+         */
+        [[nodiscard]]
+        Error const& err() const;
+
     private:
         Event(Inner);
 
@@ -154,7 +154,8 @@ namespace mxl::lib::fabrics::ofi
         return FabricInfo::clone(_raw);
     }
 
-    FabricInfoList FabricInfoList::get(std::string node, std::string service, Provider provider, uint64_t caps, ::fi_ep_type epType)
+    FabricInfoList FabricInfoList::get(std::string node, std::string service, Provider provider, uint64_t caps, ::fi_ep_type epType,
+        std::uint64_t msgOrder)
     {
         ::fi_info* info;
         auto hints = FabricInfo::empty();
@@ -166,10 +167,20 @@ namespace mxl::lib::fabrics::ofi
         hints->caps = caps;
         hints->ep_attr->type = epType;
         hints->fabric_attr->prov_name = strdup(fmt::to_string(provider).c_str());
+        hints->tx_attr->msg_order = msgOrder;
+        hints->rx_attr->msg_order = msgOrder;
 
         // hints: add condition to append FI_HMEM capability if needed!
 
-        fiCall(::fi_getinfo, "Failed to get provider information", fiVersion(), node.c_str(), service.c_str(), FI_SOURCE, hints.raw(), &info);
+        // An empty node or service lets the provider pick a default one.
+        fiCall(::fi_getinfo,
+            "Failed to get provider information",
+            fiVersion(),
+            node.empty() ? nullptr : node.c_str(),
+            service.empty() ? nullptr : service.c_str(),
+            FI_SOURCE,
+            hints.raw(),
+            &info);
 
         return FabricInfoList{info};
     }
@@ -205,8 +205,11 @@ namespace mxl::lib::fabrics::ofi
         /**
          * \brief  Get a list of provider configurations supported to the specified
          * node/service
+         *
+         * \param msgOrder The FI_ORDER_* flags the transmit and receive contexts must guarantee, 0 for the default ordering of the provider.
          */
-        static FabricInfoList get(std::string node, std::string service, Provider provider, std::uint64_t caps, ::fi_ep_type epType);
+        static FabricInfoList get(std::string node, std::string service, Provider provider, std::uint64_t caps, ::fi_ep_type epType,
+            std::uint64_t msgOrder = 0);
 
         /** \brief Take ownership over a fi_info raw pointer.
          */
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "FabricsInstance.hpp"
+#include <algorithm>
+#include "Exception.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    namespace
+    {
+        template<typename T>
+        void destroyOwned(std::vector<std::unique_ptr<T>>& owned, T const& object)
+        {
+            auto const it = std::ranges::find_if(owned, [&](auto const& ptr) { return ptr.get() == &object; });
+            if (it == owned.end())
+            {
+                throw Exception::notFound("The object was not created by this instance");
+            }
+
+            owned.erase(it);
+        }
+    }
+
+    FabricsInstance::FabricsInstance(mxlInstance instance) noexcept
+        : _instance(instance)
+    {}
+
+    FabricsInstance* FabricsInstance::fromAPI(mxlFabricsInstance instance) noexcept
+    {
+        return reinterpret_cast<FabricsInstance*>(instance);
+    }
+
+    mxlFabricsInstance FabricsInstance::toAPI() noexcept
+    {
+        return reinterpret_cast<mxlFabricsInstance>(this);
+    }
+
+    mxlInstance FabricsInstance::instance() const noexcept
+    {
+        return _instance;
+    }
+
+    Target& FabricsInstance::createTarget()
+    {
+        return *_targets.emplace_back(std::make_unique<Target>());
+    }
+
+    void FabricsInstance::destroyTarget(Target const& target)
+    {
+        destroyOwned(_targets, target);
+    }
+
+    Initiator& FabricsInstance::createInitiator()
+    {
+        return *_initiators.emplace_back(std::make_unique<Initiator>());
+    }
+
+    void FabricsInstance::destroyInitiator(Initiator const& initiator)
+    {
+        destroyOwned(_initiators, initiator);
+    }
+
+    TargetSession& FabricsInstance::createTargetSession(SessionConfig const& config)
+    {
+        return *_targetSessions.emplace_back(std::make_unique<TargetSession>(config));
+    }
+
+    void FabricsInstance::destroyTargetSession(TargetSession const& session)
+    {
+        destroyOwned(_targetSessions, session);
+    }
+
+    InitiatorSession& FabricsInstance::createInitiatorSession(SessionConfig const& config)
+    {
+        return *_initiatorSessions.emplace_back(std::make_unique<InitiatorSession>(config));
+    }
+
+    void FabricsInstance::destroyInitiatorSession(InitiatorSession const& session)
+    {
+        destroyOwned(_initiatorSessions, session);
+    }
+}
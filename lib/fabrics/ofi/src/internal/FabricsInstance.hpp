@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <mxl/fabrics.h>
+#include <mxl/mxl.h>
+#include "Initiator.hpp"
+#include "InitiatorSession.hpp"
+#include "Session.hpp"
+#include "Target.hpp"
+#include "TargetSession.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief The fabrics instance of an MXL instance.
+     *
+     * The instance owns the sessions, targets and initiators created from it, they are destroyed with it if the user didn't destroy
+     * them. This is the internal
+     * structure representing the mxlFabricsInstance API type.
+     */
+    class FabricsInstance
+    {
+    public:
+        explicit FabricsInstance(mxlInstance instance) noexcept;
+
+        // No copying, no moving, the API handle is the address of the instance.
+        FabricsInstance(FabricsInstance const&) = delete;
+        void operator=(FabricsInstance const&) = delete;
+
+        /** \brief Convert between external and internal versions of this type
+         */
+        static FabricsInstance* fromAPI(mxlFabricsInstance) noexcept;
+        /** \copydoc fromAPI() */
+        [[nodiscard]]
+        mxlFabricsInstance toAPI() noexcept;
+
+        /** \brief The MXL instance this fabrics instance was created from.
+         */
+        [[nodiscard]]
+        mxlInstance instance() const noexcept;
+
+        /** \brief Create a single-flow target owned by this instance, to be set up.
+         */
+        Target& createTarget();
+
+        /** \brief Destroy a single-flow target created by this instance.
+         */
+        void destroyTarget(Target const& target);
+
+        /** \brief Create a single-flow initiator owned by this instance, to be set up.
+         */
+        Initiator& createInitiator();
+
+        /** \brief Destroy a single-flow initiator created by this instance.
+         */
+        void destroyInitiator(Initiator const& initiator);
+
+        /** \brief Create a target session owned by this instance.
+         */
+        TargetSession& createTargetSession(SessionConfig const& config);
+
+        /** \brief Destroy a target session created by this instance.
+         */
+        void destroyTargetSession(TargetSession const& session);
+
+        /** \brief Create an initiator session owned by this instance.
+         */
+        InitiatorSession& createInitiatorSession(SessionConfig const& config);
+
+        /** \brief Destroy an initiator session created by this instance.
+         */
+        void destroyInitiatorSession(InitiatorSession const& session);
+
+    private:
+        mxlInstance _instance;
+        std::vector<std::unique_ptr<Target>> _targets;
+        std::vector<std::unique_ptr<Initiator>> _initiators;
+        std::vector<std::unique_ptr<TargetSession>> _targetSessions;
+        std::vector<std::unique_ptr<InitiatorSession>> _initiatorSessions;
+    };
+}
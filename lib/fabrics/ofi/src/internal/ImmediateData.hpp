@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief The 32 bits of remote completion queue data that identify a grain written to a multi-flow session.
+     *
+     * Every write of a session carries the id of the flow in the session, the position of the grain in that flow, and the number of
+     * slices of the grain that were valid when the write was posted. Completion queue data is limited to 4 bytes by most providers, so
+     * the fields are packed as follows:
+     *
+     * | bits   | field          |
+     * |--------|----------------|
+     * | 31..22 | flow id        |
+     * | 21..12 | grain position |
+     * | 11..0  | slices         |
+     *
+     * The position is the grain index modulo as many turns of the ring buffer as fit in the field (\see positionOf()). It tells the slot of
+     * the grain, and the turn of the ring buffer the grain belongs to, so that the stripes of two grains written to the same slot are never
+     * mixed up.
+     *
+     * Slice counts that don't fit in 12 bits (e.g. the bytes of data flows) are sent as SlicesFromHeader, in which case the target reports
+     * the valid slices of the transferred grain header.
+     */
+    struct ImmediateData
+    {
+    public:
+        constexpr static auto const FlowIdBits = 10U;
+        constexpr static auto const SlotBits = 10U;
+        constexpr static auto const SliceBits = 12U;
+
+        /** \brief Number of flows a session can carry. */
+        constexpr static auto const MaxFlows = std::uint32_t{1} << FlowIdBits;
+        /** \brief Number of grains a flow of a session can have. */
+        constexpr static auto const MaxSlots = std::uint32_t{1} << SlotBits;
+        /** \brief Slice count meaning that the valid slices must be read from the transferred grain header. */
+        constexpr static auto const SlicesFromHeader = (std::uint32_t{1} << SliceBits) - 1U;
+
+        /** \brief Number of turns of a ring buffer of `slots` grains that positions tell apart, 1 for rings of more than MaxSlots / 2 grains.
+         */
+        [[nodiscard]]
+        constexpr static std::uint32_t turns(std::uint32_t slots) noexcept
+        {
+            return MaxSlots / slots;
+        }
+
+        /** \brief The position of grain `grainIndex` in a ring buffer of `slots` grains. Its slot is `position % slots`, and its turn
+         * `position / slots`.
+         */
+        [[nodiscard]]
+        constexpr static std::uint32_t positionOf(std::uint64_t grainIndex, std::uint32_t slots) noexcept
+        {
+            return static_cast<std::uint32_t>(grainIndex % (std::uint64_t{slots} * turns(slots)));
+        }
+
+        /** \brief Pack the fields. The slice count is saturated to SlicesFromHeader.
+         */
+        [[nodiscard]]
+        constexpr static std::uint32_t encode(std::uint32_t flowId, std::uint32_t position, std::uint32_t slices) noexcept
+        {
+            return ((flowId & (MaxFlows - 1U)) << (SlotBits + SliceBits)) | ((position & (MaxSlots - 1U)) << SliceBits) |
+                   std::min(slices, SlicesFromHeader);
+        }
+
+        /** \brief Unpack the fields.
+         */
+        [[nodiscard]]
+        constexpr static ImmediateData decode(std::uint64_t data) noexcept
+        {
+            auto const value = static_cast<std::uint32_t>(data);
+            return {
+                .flowId = value >> (SlotBits + SliceBits),
+                .position = (value >> SliceBits) & (MaxSlots - 1U),
+                .slices = value & SlicesFromHeader,
+            };
+        }
+
+    public:
+        std::uint32_t flowId;
+        std::uint32_t position;
+        std::uint32_t slices;
+    };
+
+    static_assert(ImmediateData::FlowIdBits + ImmediateData::SlotBits + ImmediateData::SliceBits == 32U);
+    static_assert(ImmediateData::decode(ImmediateData::encode(1023U, 517U, 1080U)).flowId == 1023U);
+    static_assert(ImmediateData::decode(ImmediateData::encode(1023U, 517U, 1080U)).position == 517U);
+    static_assert(ImmediateData::decode(ImmediateData::encode(1023U, 517U, 1080U)).slices == 1080U);
+    static_assert(ImmediateData::decode(ImmediateData::encode(3U, 0U, 100000U)).slices == ImmediateData::SlicesFromHeader);
+    static_assert(ImmediateData::positionOf(7U * 1020U + 15U, 10U) == 15U);
+    static_assert(ImmediateData::positionOf(1021U, 1000U) == 21U);
+}
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Initiator.hpp"
+#include "Exception.hpp"
+#include "Session.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    Initiator* Initiator::fromAPI(mxlFabricsInitiator initiator) noexcept
+    {
+        return reinterpret_cast<Initiator*>(initiator);
+    }
+
+    mxlFabricsInitiator Initiator::toAPI() noexcept
+    {
+        return reinterpret_cast<mxlFabricsInitiator>(this);
+    }
+
+    void Initiator::setup(mxlInitiatorConfig const& config)
+    {
+        if (_session)
+        {
+            throw Exception::invalidState("The initiator is already set up");
+        }
+        if (config.regions == nullptr)
+        {
+            throw Exception::invalidArgument("The initiator has no regions to send the flow from");
+        }
+
+        _regions = *MxlRegions::fromAPI(config.regions);
+        _session = std::make_unique<InitiatorSession>(
+            SessionConfig::singleFlow(config.endpointAddress, config.provider, config.deviceSupport));
+    }
+
+    void Initiator::addTarget(TargetInfo const& info)
+    {
+        auto& session = this->session();
+        if (info.flows().size() != 1)
+        {
+            throw Exception::invalidArgument("The target info of a single-flow target has {} flows", info.flows().size());
+        }
+
+        // Every target gets the same local regions, the flow keeps the id it got for the first one.
+        session.connect(info);
+        try
+        {
+            _flowId = session.addFlow(info, info.flows().front().id, *_regions);
+        }
+        catch (...)
+        {
+            session.disconnect(info);
+            throw;
+        }
+    }
+
+    void Initiator::removeTarget(TargetInfo const& info)
+    {
+        session().disconnect(info);
+    }
+
+    void Initiator::transferGrain(std::uint64_t grainIndex)
+    {
+        auto& session = this->session();
+        if (!_flowId)
+        {
+            throw Exception::make(MXL_ERR_NOT_READY, "The initiator has no target to write grain {} to", grainIndex);
+        }
+        session.transferGrain(*_flowId, grainIndex);
+    }
+
+    bool Initiator::makeProgress()
+    {
+        return session().makeProgress();
+    }
+
+    bool Initiator::makeProgressBlocking(std::chrono::steady_clock::duration timeout)
+    {
+        return session().makeProgressBlocking(timeout);
+    }
+
+    InitiatorSession& Initiator::session()
+    {
+        if (!_session)
+        {
+            throw Exception::invalidState("The initiator is not set up");
+        }
+        return *_session;
+    }
+}
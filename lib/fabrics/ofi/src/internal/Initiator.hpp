@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <mxl/fabrics.h>
+#include "InitiatorSession.hpp"
+#include "Region.hpp"
+#include "TargetInfo.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief The sending side of a single flow.
+     *
+     * Once set up, the initiator is an initiator session on a single rail that writes its flow to every target added to it. This is the
+     * internal structure representing the mxlFabricsInitiator API type.
+     */
+    class Initiator
+    {
+    public:
+        Initiator() = default;
+
+        // No copying, no moving, the API handle is the address of the initiator.
+        Initiator(Initiator const&) = delete;
+        void operator=(Initiator const&) = delete;
+
+        /** \brief Convert between external and internal versions of this type
+         */
+        static Initiator* fromAPI(mxlFabricsInitiator) noexcept;
+        /** \copydoc fromAPI() */
+        [[nodiscard]]
+        mxlFabricsInitiator toAPI() noexcept;
+
+        /** \brief Open the session of the initiator. Throws an MXL_ERR_INVALID_STATE exception if the initiator was already set up.
+         */
+        void setup(mxlInitiatorConfig const& config);
+
+        /** \brief Add a target, and write the flow to the single flow of its target info.
+         */
+        void addTarget(TargetInfo const& info);
+
+        /** \brief Remove a target, the flow is no longer written to it.
+         */
+        void removeTarget(TargetInfo const& info);
+
+        /** \brief Post the writes of a grain to all the connected targets. Throws an MXL_ERR_NOT_READY exception if no target was added
+         * yet, \see InitiatorSession::transferGrain().
+         */
+        void transferGrain(std::uint64_t grainIndex);
+
+        /** \copydoc InitiatorSession::makeProgress() */
+        bool makeProgress();
+
+        /** \copydoc InitiatorSession::makeProgressBlocking() */
+        bool makeProgressBlocking(std::chrono::steady_clock::duration timeout);
+
+    private:
+        /** \brief The session of the initiator. Throws an MXL_ERR_INVALID_STATE exception if the initiator was not set up yet.
+         */
+        InitiatorSession& session();
+
+    private:
+        std::unique_ptr<InitiatorSession> _session;
+        std::optional<MxlRegions> _regions;   /**< The local regions of the flow. */
+        std::optional<std::uint32_t> _flowId; /**< The id of the flow in the session, once a target was added. */
+    };
+}
@@ -0,0 +1,1425 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "InitiatorSession.hpp"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <mxl/time.h>
+#include <mxl-internal/Flow.hpp>
+#include <mxl-internal/Logging.hpp>
+#include "Exception.hpp"
+#include "ImmediateData.hpp"
+#include "MemoryRegion.hpp"
+#include "Stripe.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    namespace
+    {
+        /** Tick of the timer wheel of the paced grains, and number of its slots, which covers about 40 ms in one turn. */
+        constexpr auto PacerTick = std::uint64_t{10'000};
+        constexpr auto PacerSlots = std::size_t{4096};
+
+        /** Initiator sessions only read from their targets to get their credits or their instance id. */
+        bool readsTargets(SessionConfig const& config) noexcept
+        {
+            return (config.creditWindow != 0) || config.supervision.enabled;
+        }
+
+        /** Offset of the instance id of a target session in its credits, it follows the credits of the last flow id. */
+        constexpr auto InstanceOffset = std::size_t{ImmediateData::MaxFlows} * sizeof(std::uint64_t);
+
+        std::uint64_t toNanoseconds(std::chrono::steady_clock::duration duration) noexcept
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+    }
+
+    InitiatorSession::State InitiatorSession::Target::state() const noexcept
+    {
+        auto const isIn = [](State state) { return [state](Link const& link) { return link.state == state; }; };
+        if (std::ranges::any_of(links, isIn(State::Disconnected)))
+        {
+            return State::Disconnected;
+        }
+        if (std::ranges::any_of(links, isIn(State::Connecting)))
+        {
+            return State::Connecting;
+        }
+        return State::Connected;
+    }
+
+    InitiatorSession::InitiatorSession(SessionConfig const& config)
+        : _rails(SessionRails::open(config, readsTargets(config) ? (FI_RMA | FI_WRITE | FI_READ) : (FI_RMA | FI_WRITE)))
+        , _pendingWrites(0)
+        , _creditWindow(config.creditWindow)
+        , _supervision(config.supervision)
+        , _pacer(PacerTick, PacerSlots, mxlGetTime())
+        , _nextTimer(0)
+    {
+        if (readsTargets(config))
+        {
+            _creditBuffer.resize(ImmediateData::MaxFlows + 1U);
+            auto const credits = Region{reinterpret_cast<std::uintptr_t>(_creditBuffer.data()), _creditBuffer.size() * sizeof(std::uint64_t)};
+            _creditRegion.emplace(MemoryRegion::reg(*_rails[0].domain, credits, FI_READ), credits);
+        }
+
+        if (_rails.connectionless())
+        {
+            for (auto rail = std::size_t{0}; rail < _rails.size(); ++rail)
+            {
+                auto& resources = _rails[rail];
+                auto endpoint = Endpoint::create(resources.domain, resources.info.view());
+                endpoint.bind(resources.cq, FI_TRANSMIT | FI_RECV);
+                endpoint.bind(resources.av);
+                endpoint.enable();
+                _endpoints.push_back(std::move(endpoint));
+            }
+        }
+    }
+
+    InitiatorSession::~InitiatorSession()
+    {
+        for (auto& [key, target] : _targets)
+        {
+            for (auto& link : target.links)
+            {
+                if (link.endpoint && (link.state == State::Connected))
+                {
+                    try
+                    {
+                        link.endpoint->shutdown();
+                    }
+                    catch (Exception const& e)
+                    {
+                        MXL_WARN("Failed to shut the session connection down: {}", e.what());
+                    }
+                }
+            }
+        }
+    }
+
+    InitiatorSession* InitiatorSession::fromAPI(mxlFabricsInitiatorSession session) noexcept
+    {
+        return reinterpret_cast<InitiatorSession*>(session);
+    }
+
+    mxlFabricsInitiatorSession InitiatorSession::toAPI() noexcept
+    {
+        return reinterpret_cast<mxlFabricsInitiatorSession>(this);
+    }
+
+    void InitiatorSession::connect(TargetInfo const& info)
+    {
+        auto const& addresses = info.addresses();
+        if (addresses.size() != _rails.size())
+        {
+            throw Exception::invalidArgument("The target session has {} rails, the initiator session {}", addresses.size(), _rails.size());
+        }
+
+        auto key = targetKey(info);
+        if (_targets.contains(key))
+        {
+            throw Exception::exists("The session already writes to this target session");
+        }
+
+        if ((_creditWindow != 0) && !info.credits())
+        {
+            MXL_WARN("The target session doesn't advertise credits, its grains are written without flow control");
+        }
+
+        auto target = Target{
+            .links = {},
+            .addresses = addresses,
+            .credits = info.credits(),
+            .released = {},
+            .creditsWanted = false,
+            .instance = info.instance(),
+            .instanceWanted = false,
+            .phase = Phase::Connecting,
+            .outageStart = {},
+            .nextCheck = Clock::now() + _supervision.retryInterval,
+            .outages = 0,
+            .lastOutage = {},
+            .totalOutage = {},
+            .catchUpWanted = false,
+            .stripes = {},
+            .stats = {},
+        };
+        if (_supervision.enabled && !canValidate(target))
+        {
+            MXL_WARN("The target session doesn't advertise its instance id, its remote keys can't be validated when its links are restored");
+        }
+
+        for (auto rail = std::size_t{0}; rail < _rails.size(); ++rail)
+        {
+            auto& resources = _rails[rail];
+            if (resources.connectionless())
+            {
+                // Adding a target is a local operation, there is no handshake.
+                target.links.push_back(Link{
+                    .state = State::Connected,
+                    .endpoint = std::nullopt,
+                    .addr = resources.av->insert(addresses[rail]),
+                    .pendingWrites = 0,
+                });
+                continue;
+            }
+
+            auto endpoint = Endpoint::create(resources.domain);
+            endpoint.bind(resources.eq);
+            endpoint.bind(resources.cq, FI_TRANSMIT | FI_RECV);
+            endpoint.enable();
+            endpoint.connect(addresses[rail]);
+
+            target.links.push_back(Link{
+                .state = State::Connecting,
+                .endpoint = std::move(endpoint),
+                .addr = FI_ADDR_UNSPEC,
+                .pendingWrites = 0,
+            });
+        }
+
+        if (_rails.connectionless())
+        {
+            target.phase = Phase::Up;
+        }
+
+        // The links are referenced by their endpoint id once the target found its place in the map, which never moves it.
+        auto& added = _targets.emplace(std::move(key), std::move(target)).first->second;
+        for (auto& link : added.links)
+        {
+            if (link.endpoint)
+            {
+                _connections.emplace(link.endpoint->id(), Connection{.target = &added, .link = &link});
+            }
+        }
+    }
+
+    void InitiatorSession::disconnect(TargetInfo const& info)
+    {
+        auto const key = targetKey(info);
+        auto const it = _targets.find(key);
+        if (it == _targets.end())
+        {
+            throw Exception::notFound("The session doesn't write to this target session");
+        }
+
+        auto& links = it->second.links;
+        for (auto rail = std::size_t{0}; rail < links.size(); ++rail)
+        {
+            if (links[rail].endpoint && (links[rail].state == State::Connected))
+            {
+                links[rail].endpoint->shutdown();
+            }
+            if (links[rail].addr != FI_ADDR_UNSPEC)
+            {
+                _rails[rail].av->remove(links[rail].addr);
+            }
+            retire(links[rail]);
+        }
+
+        for (auto& flow : _flows)
+        {
+            if (flow)
+            {
+                flow->routes.erase(key);
+            }
+        }
+
+        if (_read && (_read->target == key) && !_rails.connectionless())
+        {
+            // The read was posted to a connection that is gone, its completion is ignored.
+            _read.reset();
+        }
+
+        // The writes to the target that are still in flight on the shared endpoints of a connectionless session complete without it.
+        for (auto& [id, writes] : _posted)
+        {
+            for (auto& write : writes)
+            {
+                if (write.target == &it->second)
+                {
+                    write.target = nullptr;
+                }
+            }
+        }
+
+        _targets.erase(it);
+    }
+
+    std::uint32_t InitiatorSession::addFlow(TargetInfo const& info, std::uint32_t remoteId, MxlRegions const& regions)
+    {
+        auto const& remote = info.flow(remoteId).regions;
+        auto const& grains = regions.regions();
+        if (remote.size() != _rails.size())
+        {
+            throw Exception::invalidArgument(
+                "Flow {} has regions on {} rails at the target, the session has {}", remoteId, remote.size(), _rails.size());
+        }
+        for (auto const& railRegions : remote)
+        {
+            if (grains.size() != railRegions.size())
+            {
+                throw Exception::invalidArgument(
+                    "Flow {} has {} grains locally and {} at the target", remoteId, grains.size(), railRegions.size());
+            }
+            for (auto i = std::size_t{0}; i < grains.size(); ++i)
+            {
+                if ((grains[i].size < sizeof(GrainHeader)) || (grains[i].size > railRegions[i].len))
+                {
+                    throw Exception::invalidArgument("Grain {} of flow {} doesn't fit in the remote grain", i, remoteId);
+                }
+            }
+        }
+
+        auto key = targetKey(info);
+        auto route = Route{.remoteId = remoteId, .regions = remote, .firstIndex = MXL_UNDEFINED_INDEX};
+
+        // A flow that is already written to other targets is recognized by its local regions, every target may give it another id.
+        auto const sameRegion = [](RegisteredRegion const& registered, Region const& region) {
+            auto const local = registered.toLocal();
+            return (local.addr == region.base) && (local.len == region.size);
+        };
+        for (auto flowId = std::uint32_t{0}; flowId < _flows.size(); ++flowId)
+        {
+            auto& flow = _flows[flowId];
+            if (!flow || !std::ranges::equal(flow->local.front(), grains, sameRegion))
+            {
+                continue;
+            }
+            if (flow->routes.contains(key))
+            {
+                throw Exception::exists("Flow {} is already written to this target session", flowId);
+            }
+
+            flow->routes.emplace(std::move(key), std::move(route));
+            MXL_INFO("Added target session {} to flow {}, as flow {} of the target", flow->routes.size(), flowId, remoteId);
+            return flowId;
+        }
+
+        // The ids of removed flows are reused.
+        auto slot = std::ranges::find_if(_flows, [](auto const& flow) { return !flow.has_value(); });
+        if (slot == _flows.end())
+        {
+            if (_flows.size() == ImmediateData::MaxFlows)
+            {
+                throw Exception::exists("The session already carries {} flows", ImmediateData::MaxFlows);
+            }
+            slot = _flows.emplace(_flows.end());
+        }
+        auto const flowId = static_cast<std::uint32_t>(std::distance(_flows.begin(), slot));
+
+        // Every rail has its own domain, in which the regions are registered separately.
+        auto flow = Flow{
+            .local = std::vector<std::vector<RegisteredRegion>>(_rails.size()),
+            .routes = {},
+            .newestIndex = MXL_UNDEFINED_INDEX,
+            .pacing = std::nullopt,
+            .pacingStats = {},
+        };
+        for (auto rail = std::size_t{0}; rail < _rails.size(); ++rail)
+        {
+            for (auto const& grain : grains)
+            {
+                flow.local[rail].emplace_back(MemoryRegion::reg(*_rails[rail].domain, grain, FI_WRITE), grain);
+            }
+        }
+        flow.routes.emplace(std::move(key), std::move(route));
+        *slot = std::move(flow);
+
+        MXL_INFO("Added flow {} with {} grains to the initiator session, as flow {} of the target", flowId, grains.size(), remoteId);
+        return flowId;
+    }
+
+    void InitiatorSession::removeFlow(std::uint32_t flowId)
+    {
+        if ((flowId >= _flows.size()) || !_flows[flowId])
+        {
+            throw Exception::notFound("Flow {} is not part of the session", flowId);
+        }
+
+        _flows[flowId].reset();
+        std::erase_if(_pacedGrains, [&](auto const& entry) { return entry.second.flowId == flowId; });
+        for (auto& [key, target] : _targets)
+        {
+            std::erase_if(target.stripes, [&](PendingStripe const& stripe) { return stripe.flowId == flowId; });
+        }
+        MXL_INFO("Removed flow {} from the initiator session", flowId);
+    }
+
+    void InitiatorSession::transferGrain(std::uint32_t flowId, std::uint64_t grainIndex)
+    {
+        if ((flowId >= _flows.size()) || !_flows[flowId])
+        {
+            throw Exception::notFound("Flow {} is not part of the session", flowId);
+        }
+
+        auto& flow = *_flows[flowId];
+        auto const& header = headerOf(flow, grainIndex);
+        if (header.index != grainIndex)
+        {
+            throw Exception::make((header.index > grainIndex) ? MXL_ERR_OUT_OF_RANGE_TOO_LATE : MXL_ERR_OUT_OF_RANGE_TOO_EARLY,
+                "Grain {} of flow {} is not in the ring buffer, the slot holds grain {}",
+                grainIndex,
+                flowId,
+                header.index);
+        }
+
+        // The newest grain is tracked even while no target is up, the links that are restored catch up from there.
+        if ((flow.newestIndex == MXL_UNDEFINED_INDEX) || (grainIndex > flow.newestIndex))
+        {
+            flow.newestIndex = grainIndex;
+        }
+
+        auto const grain = prepareWrite(flow, flowId, grainIndex);
+
+        // The credits are checked for all target sessions before anything is posted, so that the caller can retry the whole grain.
+        if ((_creditWindow != 0) && !checkCredits(flow, grainIndex))
+        {
+            throw Exception::make(MXL_ERR_NOT_READY, "A target session of flow {} has no credit left for grain {}", flowId, grainIndex);
+        }
+
+        if (flow.pacing && ((header.flags & MXL_GRAIN_FLAG_REPEAT) == 0) &&
+            sliceable(header, flow.local.front()[grain.slot].toLocal().len, _rails.size()))
+        {
+            auto targets = std::vector<std::string>{};
+            for (auto const& [key, route] : flow.routes)
+            {
+                if (auto const target = _targets.find(key); (target != _targets.end()) && (target->second.phase == Phase::Up))
+                {
+                    targets.push_back(key);
+                }
+            }
+            if (targets.empty())
+            {
+                throw Exception::make(MXL_ERR_NOT_READY, "No target session of flow {} is connected", flowId);
+            }
+
+            schedulePaced(flow, flowId, grainIndex, std::move(targets));
+            return;
+        }
+
+        auto posted = std::size_t{0};
+        for (auto& [key, route] : flow.routes)
+        {
+            auto const target = _targets.find(key);
+            if ((target == _targets.end()) || (target->second.phase != Phase::Up))
+            {
+                continue;
+            }
+
+            if (writeGrain(flow, route, target->second, grain))
+            {
+                route.firstIndex = std::min(route.firstIndex, grainIndex);
+                ++posted;
+                continue;
+            }
+            if (target->second.phase != Phase::Up)
+            {
+                // The link failed while the grain was written, the target catches up once it is restored.
+                continue;
+            }
+
+            // Until the first write is posted, the caller can retry the whole grain. After that, a retry would write the grain twice to the
+            // targets that already got it, so a target with a full queue misses the grain instead.
+            if (posted == 0)
+            {
+                throw Exception::make(MXL_ERR_NOT_READY, "The work queue of the session is full");
+            }
+            MXL_DEBUG("Grain {} of flow {} was not written to a target session with a full queue", grainIndex, flowId);
+        }
+
+        if (posted == 0)
+        {
+            throw Exception::make(MXL_ERR_NOT_READY, "No target session of flow {} is connected", flowId);
+        }
+    }
+
+    mxlFabricsLinkStatus InitiatorSession::linkStatus(TargetInfo const& info) const
+    {
+        auto const it = _targets.find(targetKey(info));
+        if (it == _targets.end())
+        {
+            throw Exception::notFound("The session doesn't write to this target session");
+        }
+
+        auto const& target = it->second;
+        auto state = MXL_FABRICS_LINK_STATE_CONNECTING;
+        switch (target.phase)
+        {
+            case Phase::Connecting: state = MXL_FABRICS_LINK_STATE_CONNECTING; break;
+            case Phase::Up:         state = MXL_FABRICS_LINK_STATE_UP; break;
+            case Phase::Recovering: state = MXL_FABRICS_LINK_STATE_RECOVERING; break;
+            case Phase::Down:       state = MXL_FABRICS_LINK_STATE_DOWN; break;
+            case Phase::Stale:      state = MXL_FABRICS_LINK_STATE_STALE; break;
+        }
+
+        // The outage of a target that is not up again lasts until now.
+        auto const ongoing = (target.outages != 0) && (target.phase != Phase::Up);
+        auto const current = ongoing ? Clock::now() - target.outageStart : Clock::duration::zero();
+
+        return mxlFabricsLinkStatus{
+            .state = state,
+            .outages = target.outages,
+            .lastOutageNs = toNanoseconds(ongoing ? current : target.lastOutage),
+            .totalOutageNs = toNanoseconds(target.totalOutage + current),
+        };
+    }
+
+    mxlFabricsLinkStats InitiatorSession::stats(TargetInfo const& info) const
+    {
+        auto const it = _targets.find(targetKey(info));
+        if (it == _targets.end())
+        {
+            throw Exception::notFound("The session doesn't write to this target session");
+        }
+        return it->second.stats.values();
+    }
+
+    void InitiatorSession::setFlowPacing(std::uint32_t flowId, mxlFlowPacingConfig const& config)
+    {
+        if ((flowId >= _flows.size()) || !_flows[flowId])
+        {
+            throw Exception::notFound("Flow {} is not part of the session", flowId);
+        }
+
+        auto& flow = *_flows[flowId];
+        auto const& rate = config.grainRate;
+        if (rate.numerator == 0)
+        {
+            // The bursts of the grains that are already scheduled are still written at their pace.
+            flow.pacing.reset();
+            MXL_INFO("Stopped pacing flow {}", flowId);
+            return;
+        }
+        if ((rate.numerator < 0) || (rate.denominator <= 0))
+        {
+            throw Exception::invalidArgument("Invalid grain rate {}/{} for flow {}", rate.numerator, rate.denominator, flowId);
+        }
+        if (config.activePercent > 100U)
+        {
+            throw Exception::invalidArgument("The bursts of flow {} can't be spread over {}% of the grain period", flowId, config.activePercent);
+        }
+        if (!_rails.orderedWrites())
+        {
+            // Only the last burst of a grain carries the completion data, the target would report grains before their earlier bursts landed.
+            throw Exception::invalidState("The provider of the session doesn't place writes in order, flow {} can't be paced", flowId);
+        }
+
+        flow.pacing = Pacing{
+            .grainRate = rate,
+            .activePercent = (config.activePercent == 0) ? 90U : config.activePercent,
+            .slicesPerBurst = (config.slicesPerBurst == 0) ? 16U : config.slicesPerBurst,
+            .busyUntil = flow.pacing ? flow.pacing->busyUntil : 0U,
+        };
+        MXL_INFO("Pacing flow {} at {}/{} grains per second over {}% of the grain period, {} slices per burst",
+            flowId,
+            rate.numerator,
+            rate.denominator,
+            flow.pacing->activePercent,
+            flow.pacing->slicesPerBurst);
+    }
+
+    mxlFlowPacingStats InitiatorSession::flowPacingStats(std::uint32_t flowId) const
+    {
+        if ((flowId >= _flows.size()) || !_flows[flowId])
+        {
+            throw Exception::notFound("Flow {} is not part of the session", flowId);
+        }
+
+        return _flows[flowId]->pacingStats;
+    }
+
+    bool InitiatorSession::makeProgress()
+    {
+        if (auto event = _rails.readQueues(_completions); event)
+        {
+            handleEvent(*event);
+        }
+
+        return done();
+    }
+
+    bool InitiatorSession::makeProgressBlocking(std::chrono::steady_clock::duration timeout)
+    {
+        if (done())
+        {
+            return true;
+        }
+
+        // The wait ends in time for the next burst of the paced grains, which done() writes.
+        if (!_pacedGrains.empty())
+        {
+            auto const now = mxlGetTime();
+            auto next = std::numeric_limits<std::uint64_t>::max();
+            for (auto const& [id, grain] : _pacedGrains)
+            {
+                next = std::min(next, grain.start + grain.next * grain.interval);
+            }
+            auto const wait = std::chrono::nanoseconds{static_cast<std::int64_t>((next > now) ? next - now : 0U)};
+            timeout = std::min(timeout, std::chrono::duration_cast<std::chrono::steady_clock::duration>(wait));
+        }
+
+        if (auto event = _rails.readQueuesBlocking(_completions, timeout); event)
+        {
+            handleEvent(*event);
+        }
+
+        return done();
+    }
+
+    std::string InitiatorSession::targetKey(TargetInfo const& info)
+    {
+        return info.addresses().front().toBase64();
+    }
+
+    Endpoint& InitiatorSession::endpointOf(Link& link, std::size_t rail)
+    {
+        return link.endpoint ? *link.endpoint : _endpoints[rail];
+    }
+
+    bool InitiatorSession::tryWrite(Target& target, std::size_t rail, LocalRegion const& local, RemoteRegion const& remote,
+        std::optional<std::uint32_t> data)
+    {
+        auto& link = target.links[rail];
+        try
+        {
+            auto& endpoint = endpointOf(link, rail);
+            endpoint.write(local, remote, link.addr, data);
+            ++link.pendingWrites;
+            ++_pendingWrites;
+            _posted[endpoint.id()].push_back(PostedWrite{.time = Clock::now(), .target = &target});
+            target.stats.posted(local.len);
+            return true;
+        }
+        catch (Exception const& e)
+        {
+            if (e.status() != MXL_ERR_NOT_READY)
+            {
+                throw;
+            }
+            return false;
+        }
+    }
+
+    mxlGrainInfo const& InitiatorSession::headerOf(Flow const& flow, std::uint64_t grainIndex) noexcept
+    {
+        auto const slot = grainIndex % flow.local.front().size();
+        return *reinterpret_cast<mxlGrainInfo const*>(flow.local.front()[slot].toLocal().addr);
+    }
+
+    InitiatorSession::GrainWrite InitiatorSession::prepareWrite(Flow const& flow, std::uint32_t flowId, std::uint64_t grainIndex) const
+    {
+        auto const slots = static_cast<std::uint32_t>(flow.local.front().size());
+        auto const slot = static_cast<std::uint32_t>(grainIndex % slots);
+        auto const& header = headerOf(flow, grainIndex);
+
+        // Repeated grains reference the payload of an earlier grain, only their header needs to be written.
+        auto const length = ((header.flags & MXL_GRAIN_FLAG_REPEAT) != 0) ? sizeof(GrainHeader) : flow.local.front()[slot].toLocal().len;
+
+        // The slices that were valid when the write is posted are guaranteed to be part of it, which is not the case of the valid slices of
+        // the header, which the writer may update while the transfer is in progress.
+        return GrainWrite{
+            .flowId = flowId,
+            .grainIndex = grainIndex,
+            .slot = slot,
+            .position = ImmediateData::positionOf(grainIndex, slots),
+            .bounds = stripeBounds(header, length, _rails.size()),
+            .slices = header.validSlices,
+        };
+    }
+
+    bool InitiatorSession::writeGrain(Flow const& flow, Route const& route, Target& target, GrainWrite const& grain)
+    {
+        // The writes of a rail must be posted in order, the stripes of earlier grains go first.
+        if (!postStripes(target))
+        {
+            return false;
+        }
+
+        // Every target identifies the flow by the id it gave it.
+        auto const data = grain.slices ? std::optional{ImmediateData::encode(route.remoteId, grain.position, *grain.slices)} : std::nullopt;
+        auto const stripe = [&](auto region, std::size_t rail) {
+            region.addr += grain.bounds[rail];
+            region.len = grain.bounds[rail + 1U] - grain.bounds[rail];
+            return region;
+        };
+
+        for (auto rail = std::size_t{0}; rail < _rails.size(); ++rail)
+        {
+            auto const local = stripe(flow.local[rail][grain.slot].toLocal(), rail);
+            auto const remote = stripe(route.regions[rail][grain.slot], rail);
+            if (target.stripes.empty() && tryWrite(target, rail, local, remote, data))
+            {
+                continue;
+            }
+
+            if (rail == 0)
+            {
+                return false;
+            }
+
+            // The target only reports the grain once every rail delivered its stripe, so the remaining stripes must be posted. They are
+            // queued until the work queues drain, as the completions of earlier writes are read, without blocking the caller. A link that
+            // fails in the meantime drops them, the target recovers by catching up once the link is restored.
+            target.stripes.push_back(PendingStripe{
+                .flowId = grain.flowId,
+                .grainIndex = grain.grainIndex,
+                .rail = rail,
+                .local = local,
+                .remote = remote,
+                .data = data,
+            });
+        }
+
+        // The bursts of a paced grain but the last carry no completion data, the grain is counted once.
+        if (grain.slices)
+        {
+            target.stats.grain();
+        }
+        return true;
+    }
+
+    bool InitiatorSession::postStripes(Target& target)
+    {
+        while (!target.stripes.empty())
+        {
+            auto const& stripe = target.stripes.front();
+
+            // The target never completes a grain that misses a stripe, the next grain written to the slot replaces it.
+            if (headerOf(*_flows[stripe.flowId], stripe.grainIndex).index != stripe.grainIndex)
+            {
+                MXL_DEBUG(
+                    "Grain {} of flow {} was overwritten before its stripe on rail {} was posted", stripe.grainIndex, stripe.flowId, stripe.rail);
+                target.stripes.pop_front();
+                continue;
+            }
+
+            if (!tryWrite(target, stripe.rail, stripe.local, stripe.remote, stripe.data))
+            {
+                return false;
+            }
+            target.stripes.pop_front();
+        }
+        return true;
+    }
+
+    void InitiatorSession::handleEvent(RailEvent& railEvent)
+    {
+        auto& event = railEvent.event;
+        auto const id = Endpoint::idFromFID(event.fid());
+
+        auto const it = _connections.find(id);
+        if (it == _connections.end())
+        {
+            // An event of a connection that was removed or replaced in the meantime.
+            return;
+        }
+        auto& [target, link] = it->second;
+
+        if (event.isConnected())
+        {
+            MXL_INFO("Session connection {} established on rail {}", id, railEvent.rail);
+            link->state = State::Connected;
+            if (target->state() != State::Connected)
+            {
+                return;
+            }
+
+            if (target->phase == Phase::Connecting)
+            {
+                target->phase = Phase::Up;
+            }
+            else if (target->phase == Phase::Recovering)
+            {
+                // Writes only resume once the target proved to be the same instance, with the same remote keys.
+                if (canValidate(*target))
+                {
+                    target->instanceWanted = true;
+                    postRead();
+                }
+                else
+                {
+                    linkRestored(*target);
+                }
+            }
+        }
+        else if (event.isShutdown())
+        {
+            MXL_WARN("Session connection {} on rail {} was shut down by the target", id, railEvent.rail);
+            link->state = State::Disconnected;
+            linkFailed(*target);
+        }
+        else if (event.isError())
+        {
+            MXL_ERROR("Error event on session connection {} on rail {}: {}", id, railEvent.rail, event.err().toString());
+            link->state = State::Disconnected;
+            linkFailed(*target);
+        }
+    }
+
+    void InitiatorSession::schedulePaced(Flow& flow, std::uint32_t flowId, std::uint64_t grainIndex, std::vector<std::string> targets)
+    {
+        auto& pacing = *flow.pacing;
+        auto const period = mxlIndexToTimestamp(&pacing.grainRate, grainIndex + 1U) - mxlIndexToTimestamp(&pacing.grainRate, grainIndex);
+        auto const now = mxlGetTime();
+        if (pacing.busyUntil > now + period)
+        {
+            throw Exception::make(
+                MXL_ERR_NOT_READY, "The bursts of the grains of flow {} scheduled so far end more than a grain period from now", flowId);
+        }
+
+        // Every burst carries whole slices, at least one per rail, and the bursts are evenly spaced over the active share of the period.
+        auto const& header = headerOf(flow, grainIndex);
+        auto const bursts = std::max(1U, header.totalSlices / std::max(pacing.slicesPerBurst, static_cast<std::uint32_t>(_rails.size())));
+        auto const window = period * pacing.activePercent / 100U;
+        auto const start = std::max(now, pacing.busyUntil);
+        pacing.busyUntil = start + window;
+
+        for (auto const& key : targets)
+        {
+            auto& route = flow.routes.at(key);
+            route.firstIndex = std::min(route.firstIndex, grainIndex);
+        }
+
+        auto const id = _nextTimer++;
+        _pacedGrains.emplace(id,
+            PacedGrain{
+                .flowId = flowId,
+                .grainIndex = grainIndex,
+                .validSlices = header.validSlices,
+                .targets = std::move(targets),
+                .slices = header.totalSlices,
+                .bursts = bursts,
+                .next = 0,
+                .start = start,
+                .interval = window / bursts,
+                .firstWritten = 0,
+            });
+        _pacer.schedule(start, id);
+
+        // The first burst is written right away if it is due.
+        pace();
+    }
+
+    void InitiatorSession::pace()
+    {
+        if (_pacer.empty())
+        {
+            return;
+        }
+
+        auto const now = mxlGetTime();
+        _expired.clear();
+        _pacer.advance(now, _expired);
+        for (auto const id : _expired)
+        {
+            // The grains of removed flows were dropped, their timers expire without effect.
+            auto const it = _pacedGrains.find(id);
+            if (it == _pacedGrains.end())
+            {
+                continue;
+            }
+
+            if (auto const due = writeBurst(it->second, now); due)
+            {
+                _pacer.schedule(*due, id);
+            }
+            else
+            {
+                _pacedGrains.erase(it);
+            }
+        }
+    }
+
+    std::optional<std::uint64_t> InitiatorSession::writeBurst(PacedGrain& grain, std::uint64_t now)
+    {
+        auto& flow = *_flows[grain.flowId];
+        auto const& header = headerOf(flow, grain.grainIndex);
+        if (header.index != grain.grainIndex)
+        {
+            MXL_DEBUG("Grain {} of flow {} was overwritten before its last burst was written", grain.grainIndex, grain.flowId);
+            return std::nullopt;
+        }
+
+        // Only the last burst carries the completion data, which relies on the writes of a connection being placed in order (FI_ORDER_WAW,
+        // which pacing requires): the target reports the grain once the stripes of the last burst arrived on every rail, when the earlier
+        // bursts arrived too.
+        auto const rails = _rails.size();
+        auto const slots = static_cast<std::uint32_t>(flow.local.front().size());
+        auto const slot = static_cast<std::uint32_t>(grain.grainIndex % slots);
+        auto const first = std::size_t{grain.next} * grain.slices / grain.bursts;
+        auto const last = std::size_t{grain.next + 1U} * grain.slices / grain.bursts;
+        auto const isLast = (grain.next + 1U) == grain.bursts;
+        auto const write = GrainWrite{
+            .flowId = grain.flowId,
+            .grainIndex = grain.grainIndex,
+            .slot = slot,
+            .position = ImmediateData::positionOf(grain.grainIndex, slots),
+            .bounds = burstBounds(header, flow.local.front()[slot].toLocal().len, first, last, rails),
+            .slices = isLast ? std::optional{grain.validSlices} : std::nullopt,
+        };
+
+        auto posted = std::size_t{0};
+        for (auto it = grain.targets.begin(); it != grain.targets.end();)
+        {
+            auto const target = _targets.find(*it);
+            auto const route = flow.routes.find(*it);
+            if ((target != _targets.end()) && (target->second.phase == Phase::Up) && (route != flow.routes.end()))
+            {
+                if (writeGrain(flow, route->second, target->second, write))
+                {
+                    ++posted;
+                    ++it;
+                    continue;
+                }
+
+                // Until the burst is posted to a target, it is retried on the next tick. After that, a target with a full queue misses
+                // the burst, and the grain with it.
+                if (posted == 0)
+                {
+                    return now;
+                }
+            }
+
+            MXL_DEBUG("Grain {} of flow {} was not written to a target session that is down or has a full queue", grain.grainIndex, grain.flowId);
+            it = grain.targets.erase(it);
+        }
+        if (grain.targets.empty())
+        {
+            return std::nullopt;
+        }
+
+        auto& stats = flow.pacingStats;
+        auto const bytes = std::uint64_t{write.bounds[rails] - write.bounds[0]};
+        auto const due = grain.start + grain.next * grain.interval;
+        ++stats.bursts;
+        stats.lastBurstBytes = bytes;
+        stats.maxBurstBytes = std::max(stats.maxBurstBytes, bytes);
+        if (now > due + grain.interval)
+        {
+            ++stats.lateBursts;
+        }
+        if (grain.next == 0)
+        {
+            grain.firstWritten = now;
+        }
+
+        if (++grain.next < grain.bursts)
+        {
+            return grain.start + grain.next * grain.interval;
+        }
+
+        // The last burst ends the grain, whose bytes all went out between its first burst and the end of the interval of its last one.
+        auto const elapsed = std::max(std::uint64_t{1}, now - grain.firstWritten + grain.interval);
+        ++stats.grains;
+        stats.achievedRate = std::uint64_t{write.bounds[rails]} * 1'000'000'000U / elapsed;
+        return std::nullopt;
+    }
+
+    bool InitiatorSession::hasCredit(Target& target, Route const& route, std::uint64_t grainIndex)
+    {
+        // Until the consumers release a grain, the window starts at the first grain written to the target.
+        auto const released = (route.remoteId < target.released.size()) ? target.released[route.remoteId] : 0U;
+        auto const start = (released != 0U) ? released : route.firstIndex;
+        if (start == MXL_UNDEFINED_INDEX)
+        {
+            return true;
+        }
+
+        // Credits are read again once half of the window is used, so that they are usually up to date before the window is exhausted.
+        if (grainIndex >= start + _creditWindow / 2U)
+        {
+            target.creditsWanted = true;
+        }
+        return grainIndex < start + _creditWindow;
+    }
+
+    bool InitiatorSession::checkCredits(Flow const& flow, std::uint64_t grainIndex)
+    {
+        auto granted = true;
+        for (auto const& [key, route] : flow.routes)
+        {
+            auto const it = _targets.find(key);
+            if ((it == _targets.end()) || !it->second.credits || (it->second.phase != Phase::Up))
+            {
+                continue;
+            }
+
+            granted = hasCredit(it->second, route, grainIndex) && granted;
+        }
+
+        postRead();
+        return granted;
+    }
+
+    void InitiatorSession::postRead()
+    {
+        if (!_creditRegion || _read)
+        {
+            return;
+        }
+
+        for (auto& [key, target] : _targets)
+        {
+            if (target.instanceWanted && (target.state() == State::Connected))
+            {
+                // Retried on the next call if the queue is full.
+                tryRead(key, target, true);
+                return;
+            }
+        }
+
+        if (_creditWindow == 0)
+        {
+            return;
+        }
+
+        // Start after the target that was read last, so that a target that always wants credits doesn't starve the others.
+        auto next = _targets.upper_bound(_creditCursor);
+        for (auto i = std::size_t{0}; i < _targets.size(); ++i, ++next)
+        {
+            if (next == _targets.end())
+            {
+                next = _targets.begin();
+            }
+
+            auto& [key, target] = *next;
+            if (target.creditsWanted && target.credits && (target.phase == Phase::Up))
+            {
+                // Retried when the next grain is checked if the queue is full.
+                tryRead(key, target, false);
+                return;
+            }
+        }
+    }
+
+    bool InitiatorSession::tryRead(std::string const& key, Target& target, bool instance)
+    {
+        auto local = _creditRegion->toLocal();
+        auto remote = *target.credits;
+        auto words = std::size_t{0};
+        if (instance)
+        {
+            local.addr += InstanceOffset;
+            remote.addr += InstanceOffset;
+            local.len = remote.len = sizeof(std::uint64_t);
+        }
+        else
+        {
+            // Only the words up to the highest id of the flows written to the target are read.
+            for (auto const& flow : _flows)
+            {
+                if (!flow)
+                {
+                    continue;
+                }
+                if (auto const route = flow->routes.find(key); route != flow->routes.end())
+                {
+                    words = std::max(words, std::size_t{route->second.remoteId} + 1U);
+                }
+            }
+            words = std::min({words, std::size_t{ImmediateData::MaxFlows}, target.credits->len / sizeof(std::uint64_t)});
+            local.len = remote.len = words * sizeof(std::uint64_t);
+        }
+
+        try
+        {
+            endpointOf(target.links.front(), 0).read(local, remote, target.links.front().addr);
+        }
+        catch (Exception const& e)
+        {
+            if (e.status() != MXL_ERR_NOT_READY)
+            {
+                throw;
+            }
+            return false;
+        }
+
+        _read = PendingRead{.target = key, .instance = instance, .words = words};
+        if (!instance)
+        {
+            _creditCursor = key;
+        }
+        return true;
+    }
+
+    void InitiatorSession::handleRead(Completion const& completion)
+    {
+        auto const read = *_read;
+        _read.reset();
+
+        // The target may have been removed while the read was in flight.
+        auto const it = _targets.find(read.target);
+        if (it == _targets.end())
+        {
+            postRead();
+            return;
+        }
+        auto& target = it->second;
+
+        if (auto error = completion.tryErr(); error)
+        {
+            if (!read.instance)
+            {
+                MXL_WARN("Failed to read the credits of a target session: {}", error->toString());
+            }
+            else if (target.phase == Phase::Up)
+            {
+                // A liveness check of a connectionless link.
+                MXL_WARN("Failed to reach a target session: {}", error->toString());
+                linkFailed(target);
+            }
+            else if ((target.phase == Phase::Recovering) && !_rails.connectionless() && (target.state() == State::Connected))
+            {
+                // The target accepted the connection but rejected the key of its own region: it is another instance.
+                MXL_ERROR("The remote keys of a target session are no longer valid, it must be added again: {}", error->toString());
+                target.phase = Phase::Stale;
+            }
+            else
+            {
+                MXL_DEBUG("Failed to validate the instance of a recovering target session: {}", error->toString());
+            }
+            target.instanceWanted = false;
+            postRead();
+            return;
+        }
+
+        if (read.instance)
+        {
+            target.instanceWanted = false;
+            if (_creditBuffer.back() != target.instance)
+            {
+                MXL_ERROR("The target session was restarted, it must be added again with its new target info");
+                target.phase = Phase::Stale;
+            }
+            else if (target.phase == Phase::Recovering)
+            {
+                linkRestored(target);
+            }
+        }
+        else
+        {
+            target.released.assign(_creditBuffer.begin(), _creditBuffer.begin() + static_cast<std::ptrdiff_t>(read.words));
+            target.creditsWanted = false;
+        }
+
+        // Serve the other targets that are waiting for a read.
+        postRead();
+    }
+
+    bool InitiatorSession::canValidate(Target const& target) noexcept
+    {
+        return (target.instance != 0U) && target.credits && (target.credits->len >= InstanceOffset + sizeof(std::uint64_t));
+    }
+
+    void InitiatorSession::linkFailed(Target& target)
+    {
+        auto const now = Clock::now();
+        target.instanceWanted = false;
+        target.stripes.clear();
+        if ((target.phase == Phase::Up) || (target.phase == Phase::Connecting))
+        {
+            target.outageStart = now;
+            ++target.outages;
+            target.stats.linkFailed();
+        }
+
+        switch (target.phase)
+        {
+            case Phase::Up:
+            case Phase::Connecting:
+                if (!_supervision.enabled)
+                {
+                    target.phase = Phase::Down;
+                    return;
+                }
+                MXL_WARN("Lost the link to a target session, recovering");
+                target.phase = Phase::Recovering;
+                target.nextCheck = now;
+                return;
+
+            case Phase::Recovering:
+                // The attempt failed, the next one waits for the retry interval.
+                target.nextCheck = now + _supervision.retryInterval;
+                return;
+
+            case Phase::Down:
+            case Phase::Stale: return;
+        }
+    }
+
+    void InitiatorSession::linkRestored(Target& target)
+    {
+        auto const now = Clock::now();
+        auto const outage = now - target.outageStart;
+        target.phase = Phase::Up;
+        target.lastOutage = outage;
+        target.totalOutage += outage;
+        target.nextCheck = now + _supervision.retryInterval;
+        target.catchUpWanted = (_supervision.catchUpGrains != 0);
+        target.stats.linkRestored();
+
+        MXL_INFO("Restored the link to a target session after an outage of {} ms",
+            std::chrono::duration_cast<std::chrono::milliseconds>(outage).count());
+    }
+
+    void InitiatorSession::reconnect(std::string const& key, Target& target)
+    {
+        target.nextCheck = Clock::now() + _supervision.retryInterval;
+
+        // There is no connection to re-establish with connectionless links, only the instance of the target to validate again. Without
+        // an instance id, the failure of such links can't even be detected.
+        if (_rails.connectionless() || (target.state() == State::Connected))
+        {
+            if (!canValidate(target))
+            {
+                linkRestored(target);
+            }
+            else if (!_read || (_read->target != key))
+            {
+                target.instanceWanted = true;
+            }
+            return;
+        }
+        if (target.state() == State::Connecting)
+        {
+            // The connection attempt fails with an error event if the target doesn't answer.
+            return;
+        }
+
+        for (auto rail = std::size_t{0}; rail < _rails.size(); ++rail)
+        {
+            auto& link = target.links[rail];
+            if (link.state != State::Disconnected)
+            {
+                continue;
+            }
+
+            if ((rail == 0) && _read && (_read->target == key))
+            {
+                // The read was posted to the failed connection, its completion is ignored.
+                _read.reset();
+            }
+            retire(link);
+
+            try
+            {
+                auto& resources = _rails[rail];
+                auto endpoint = Endpoint::create(resources.domain);
+                endpoint.bind(resources.eq);
+                endpoint.bind(resources.cq, FI_TRANSMIT | FI_RECV);
+                endpoint.enable();
+                endpoint.connect(target.addresses[rail]);
+
+                link.endpoint.emplace(std::move(endpoint));
+                link.state = State::Connecting;
+                _connections.emplace(link.endpoint->id(), Connection{.target = &target, .link = &link});
+                MXL_DEBUG("Reconnecting to a target session on rail {}", rail);
+            }
+            catch (Exception const& e)
+            {
+                MXL_DEBUG("Failed to reconnect to a target session on rail {}: {}", rail, e.what());
+                link.endpoint.reset();
+            }
+        }
+    }
+
+    void InitiatorSession::catchUp(std::string const& key, Target& target)
+    {
+        target.catchUpWanted = false;
+
+        for (auto flowId = std::uint32_t{0}; flowId < _flows.size(); ++flowId)
+        {
+            auto& flow = _flows[flowId];
+            if (!flow || (flow->newestIndex == MXL_UNDEFINED_INDEX))
+            {
+                continue;
+            }
+            auto const route = flow->routes.find(key);
+            if (route == flow->routes.end())
+            {
+                continue;
+            }
+
+            auto const count = std::min(std::uint64_t{_supervision.catchUpGrains}, flow->newestIndex + 1U);
+            for (auto index = flow->newestIndex + 1U - count; index <= flow->newestIndex; ++index)
+            {
+                // The grains that were overwritten in the ring buffer in the meantime are lost.
+                if (headerOf(*flow, index).index != index)
+                {
+                    continue;
+                }
+                if ((_creditWindow != 0) && target.credits && !hasCredit(target, route->second, index))
+                {
+                    break;
+                }
+                if (!writeGrain(*flow, route->second, target, prepareWrite(*flow, flowId, index)))
+                {
+                    MXL_DEBUG("The catch-up of a restored target session stopped at grain {} of flow {}, the work queue is full", index, flowId);
+                    return;
+                }
+                route->second.firstIndex = std::min(route->second.firstIndex, index);
+            }
+        }
+    }
+
+    void InitiatorSession::retire(Link& link)
+    {
+        if (!link.endpoint)
+        {
+            return;
+        }
+
+        if (auto const posted = _posted.find(link.endpoint->id()); posted != _posted.end())
+        {
+            for (auto const& write : posted->second)
+            {
+                if (write.target != nullptr)
+                {
+                    write.target->stats.abandoned();
+                }
+            }
+            _posted.erase(posted);
+        }
+
+        _connections.erase(link.endpoint->id());
+        _pendingWrites -= std::min(_pendingWrites, link.pendingWrites);
+        link.pendingWrites = 0;
+    }
+
+    void InitiatorSession::supervise()
+    {
+        if (!_supervision.enabled)
+        {
+            return;
+        }
+
+        auto const now = Clock::now();
+        for (auto& [key, target] : _targets)
+        {
+            if ((target.phase == Phase::Recovering) && (now >= target.nextCheck))
+            {
+                reconnect(key, target);
+            }
+            else if ((target.phase == Phase::Up) && target.catchUpWanted)
+            {
+                catchUp(key, target);
+            }
+            else if ((target.phase == Phase::Up) && _rails.connectionless() && canValidate(target) && (now >= target.nextCheck))
+            {
+                // Connectionless links have no connection events, their liveness is checked by reading the instance of the target.
+                target.instanceWanted = true;
+                target.nextCheck = now + _supervision.retryInterval;
+            }
+        }
+
+        postRead();
+    }
+
+    void InitiatorSession::handleCompletion(Completion const& completion)
+    {
+        // The completions of retired connections are ignored, their operations were written off when they were retired.
+        auto link = static_cast<Link*>(nullptr);
+        if (!_rails.connectionless())
+        {
+            auto const it = _connections.find(Endpoint::idFromFID(completion.fid()));
+            if (it == _connections.end())
+            {
+                return;
+            }
+            link = it->second.link;
+        }
+
+        if (completion.isLocalRead())
+        {
+            if (_read)
+            {
+                handleRead(completion);
+            }
+            return;
+        }
+
+        // The writes of an endpoint complete in the order they were posted.
+        auto write = std::optional<PostedWrite>{};
+        if (auto const posted = _posted.find(Endpoint::idFromFID(completion.fid())); (posted != _posted.end()) && !posted->second.empty())
+        {
+            write = posted->second.front();
+            posted->second.pop_front();
+        }
+        auto const target = write ? write->target : nullptr;
+
+        if (auto error = completion.tryErr(); error)
+        {
+            MXL_ERROR("A grain write of the session failed: {}", error->toString());
+            if (target != nullptr)
+            {
+                target->stats.failed(error->code(), true);
+            }
+        }
+        else if (target != nullptr)
+        {
+            target->stats.completed(Clock::now() - write->time);
+        }
+
+        if ((link != nullptr) && (link->pendingWrites > 0))
+        {
+            --link->pendingWrites;
+        }
+        if (_pendingWrites > 0)
+        {
+            --_pendingWrites;
+        }
+    }
+
+    void InitiatorSession::drainCompletions()
+    {
+        // Drain the queues, a batch at a time, so that completions don't accumulate while writes are posted faster than they are polled.
+        do
+        {
+            for (auto const& completion : _completions)
+            {
+                handleCompletion(completion);
+            }
+            _completions.clear();
+        }
+        while (_rails.readCompletions(_completions) > 0);
+    }
+
+    bool InitiatorSession::done()
+    {
+        drainCompletions();
+        supervise();
+        for (auto& [key, target] : _targets)
+        {
+            if (target.phase == Phase::Up)
+            {
+                postStripes(target);
+            }
+        }
+        pace();
+
+        if (_targets.empty())
+        {
+            throw Exception::invalidState("The session is not connected");
+        }
+
+        auto const isIn = [](Phase a, Phase b) {
+            return [a, b](auto const& entry) { return (entry.second.phase == a) || (entry.second.phase == b); };
+        };
+        if (std::ranges::any_of(_targets, isIn(Phase::Connecting, Phase::Recovering)))
+        {
+            return false;
+        }
+        if (std::ranges::all_of(_targets, isIn(Phase::Down, Phase::Stale)))
+        {
+            throw Exception::invalidState("The connections of the session were closed");
+        }
+
+        return _pacedGrains.empty() && (_pendingWrites == 0) &&
+               std::ranges::all_of(_targets, [](auto const& entry) { return entry.second.stripes.empty(); });
+    }
+}
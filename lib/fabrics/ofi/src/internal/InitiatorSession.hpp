@@ -0,0 +1,424 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include <mxl/fabrics.h>
+#include <mxl/flow.h>
+#include <rdma/fabric.h>
+#include "Address.hpp"
+#include "Completion.hpp"
+#include "Endpoint.hpp"
+#include "Event.hpp"
+#include "LinkStats.hpp"
+#include "LocalRegion.hpp"
+#include "Region.hpp"
+#include "RegisteredRegion.hpp"
+#include "RemoteRegion.hpp"
+#include "Session.hpp"
+#include "Stripe.hpp"
+#include "TargetInfo.hpp"
+#include "TimerWheel.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief The sending side of a multi-flow session.
+     *
+     * The session writes the grains of all its flows to one or more target sessions. A connected session has one connection per target
+     * session, a connectionless session a single endpoint that reaches every target session through its address vector. Both exist once
+     * per rail of the session, and every grain is striped across all rails. Every write carries the remote completion data that
+     * identifies the grain at the target (\see ImmediateData). With flow control, the session reads the credits of its target sessions on
+     * the first rail, and doesn't write grains beyond the window they grant. With supervision, the session re-establishes the links that
+     * fail, validates the instance id of the target session before writing to it again, and reports the outages of every link. The grains
+     * of paced flows are written in bursts scheduled on a timer wheel that follows the TAI clock of the grain indices. The transfers to every
+     * target session are counted, and the latency of every write is measured from its post to its completion. This is the internal
+     * structure representing the mxlFabricsInitiatorSession API type.
+     */
+    class InitiatorSession
+    {
+    public:
+        /** \brief Open the resources of the session. The session doesn't write to any target before connect() is called.
+         */
+        explicit InitiatorSession(SessionConfig const& config);
+
+        /** \brief Shut the connections down, without waiting for pending writes.
+         */
+        ~InitiatorSession();
+
+        // No copying, no moving, the API handle is the address of the session.
+        InitiatorSession(InitiatorSession const&) = delete;
+        void operator=(InitiatorSession const&) = delete;
+
+        /** \brief Convert between external and internal versions of this type
+         */
+        static InitiatorSession* fromAPI(mxlFabricsInitiatorSession) noexcept;
+        /** \copydoc fromAPI() */
+        [[nodiscard]]
+        mxlFabricsInitiatorSession toAPI() noexcept;
+
+        /** \brief Add a target session. A connected session starts connecting to it, the connection is established while making progress.
+         * A connectionless session inserts its address in the address vector, and can write to it immediately. The target session must
+         * have as many rails as the session.
+         */
+        void connect(TargetInfo const& info);
+
+        /** \brief Remove a target session, and the flows that were added for it.
+         */
+        void disconnect(TargetInfo const& info);
+
+        /** \brief Register the local regions of a flow, and associate them with the remote regions of the flow `remoteId` of a target
+         * session. A flow added for many target sessions is registered once, and each of its grains is written to all of them, whatever the
+         * id they gave it.
+         *
+         * \return The id of the flow in the session, the same for all the target sessions of the flow.
+         */
+        std::uint32_t addFlow(TargetInfo const& info, std::uint32_t remoteId, MxlRegions const& regions);
+
+        /** \brief Deregister the local regions of a flow, for all the target sessions it was added for.
+         */
+        void removeFlow(std::uint32_t flowId);
+
+        /** \brief Post the writes of a grain of a flow to all the connected target sessions of the flow, one stripe per rail.
+         *
+         * Throws an MXL_ERR_NOT_READY exception if none of the target sessions of the flow is connected yet, if the work queue is full
+         * before the first write could be posted, or if a target session of the flow has no credit left for the grain.
+         */
+        void transferGrain(std::uint32_t flowId, std::uint64_t grainIndex);
+
+        /** \brief Pace the transfers of a flow, or stop pacing them if the numerator of the grain rate is 0.
+         */
+        void setFlowPacing(std::uint32_t flowId, mxlFlowPacingConfig const& config);
+
+        /** \brief The pacing metrics of a flow.
+         */
+        [[nodiscard]]
+        mxlFlowPacingStats flowPacingStats(std::uint32_t flowId) const;
+
+        /** \brief The state of the link to a target session and its outages.
+         */
+        [[nodiscard]]
+        mxlFabricsLinkStatus linkStatus(TargetInfo const& info) const;
+
+        /** \brief The counters of the transfers to a target session.
+         */
+        [[nodiscard]]
+        mxlFabricsLinkStats stats(TargetInfo const& info) const;
+
+        /** \brief Handle the entries of the queues of the session without blocking.
+         *
+         * \return true once all target sessions are connected and all posted writes have completed.
+         */
+        bool makeProgress();
+
+        /** \brief Handle the entries of the queues of the session, blocking until there is at least one or the timeout elapsed.
+         *
+         * \return true once all target sessions are connected and all posted writes have completed.
+         */
+        bool makeProgressBlocking(std::chrono::steady_clock::duration timeout);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /** \brief The states of the connection to a target session on one rail.
+         */
+        enum class State
+        {
+            Connecting,   /**< Waiting for the target to accept the connection. */
+            Connected,    /**< Writes can be posted. */
+            Disconnected, /**< The connection was refused or shut down. */
+        };
+
+        /** \brief The supervision states of a target session as a whole, \see mxlFabricsLinkState.
+         */
+        enum class Phase
+        {
+            Connecting, /**< The links are being established for the first time. */
+            Up,         /**< Grains are written to the target. */
+            Recovering, /**< A link failed, it is being re-established and the instance of the target validated. */
+            Down,       /**< A link failed and the session isn't supervised. */
+            Stale,      /**< The target was restarted, its remote keys are invalid. */
+        };
+
+        /** \brief The path to a target session on one rail.
+         */
+        struct Link
+        {
+            State state;
+            std::optional<Endpoint> endpoint; /**< The connection to the target, connected sessions only. */
+            ::fi_addr_t addr;                 /**< The address vector entry of the target, connectionless sessions only. */
+            std::size_t pendingWrites;        /**< Writes posted to the connection that didn't complete, connected sessions only. */
+        };
+
+        /** \brief The stripe of a grain that waits for room in the work queue of its rail.
+         */
+        struct PendingStripe
+        {
+            std::uint32_t flowId;
+            std::uint64_t grainIndex;
+            std::size_t rail;
+            LocalRegion local;
+            RemoteRegion remote;
+            std::optional<std::uint32_t> data; /**< The remote completion data of the write, if any. */
+        };
+
+        /** \brief A target session the session writes to.
+         */
+        struct Target
+        {
+            std::vector<Link> links;              /**< One per rail. */
+            std::vector<FabricAddress> addresses; /**< Per rail, the address the links are re-established with. */
+            std::optional<RemoteRegion> credits;  /**< The credits of the target, if it advertises them. */
+            std::vector<std::uint64_t> released;  /**< Per flow id, the credits of the last read, \see TargetInfo::credits(). */
+            bool creditsWanted;                   /**< The credits should be read again. */
+            std::uint64_t instance;               /**< The instance id of the target when it was added, 0 if unknown. */
+            bool instanceWanted;                  /**< The instance id should be read, to validate or check the liveness of the links. */
+            Phase phase;                          /**< The supervision state of the target. */
+            Clock::time_point outageStart;        /**< When the last outage started. */
+            Clock::time_point nextCheck;          /**< When the links should next be re-established or checked. */
+            std::uint32_t outages;                /**< Number of outages. */
+            Clock::duration lastOutage;           /**< Duration of the last outage, once it ended. */
+            Clock::duration totalOutage;          /**< Cumulated duration of the outages that ended. */
+            bool catchUpWanted;                   /**< The newest grains should be written again, the link was just restored. */
+            std::deque<PendingStripe> stripes;    /**< The stripes that wait for room in the work queues, in the order they are posted. */
+            LinkStats stats;                      /**< The counters of the transfers to the target. */
+
+            /** \brief The state of the target as a whole: a grain can only be written to it if it is reachable on every rail.
+             */
+            [[nodiscard]]
+            State state() const noexcept;
+        };
+
+        /** \brief The remote side of a flow at one target session.
+         */
+        struct Route
+        {
+            std::uint32_t remoteId;                         /**< The id of the flow in the target session. */
+            std::vector<std::vector<RemoteRegion>> regions; /**< Per rail, the remote region of every grain. */
+            std::uint64_t firstIndex;                       /**< The first grain written, the window starts there until grains are released. */
+        };
+
+        /** \brief The pacing of a flow, \see mxlFlowPacingConfig.
+         */
+        struct Pacing
+        {
+            mxlRational grainRate;
+            std::uint32_t activePercent;
+            std::uint32_t slicesPerBurst;
+            std::uint64_t busyUntil; /**< TAI time at which the bursts of the grains scheduled so far end. */
+        };
+
+        /** \brief A flow of the session.
+         */
+        struct Flow
+        {
+            std::vector<std::vector<RegisteredRegion>> local; /**< Per rail, the local region of every grain. */
+            std::map<std::string, Route> routes;              /**< By target. */
+            std::uint64_t newestIndex;                        /**< The newest grain transferred, the catch-up of restored links ends there. */
+            std::optional<Pacing> pacing;                     /**< Set if the grains of the flow are paced. */
+            mxlFlowPacingStats pacingStats;
+        };
+
+        /** \brief What is written to every target session of a flow for one grain.
+         */
+        struct GrainWrite
+        {
+            std::uint32_t flowId;
+            std::uint64_t grainIndex;
+            std::uint32_t slot;                  /**< The slot of the grain in the ring buffer. */
+            std::uint32_t position;              /**< The position of the grain in the remote completion data, \see ImmediateData. */
+            StripeBounds bounds;                 /**< The offsets of the stripes of the grain. */
+            std::optional<std::uint32_t> slices; /**< The valid slices in the remote completion data, none if the writes carry none. */
+        };
+
+        /** \brief A grain of a paced flow whose bursts are being written.
+         */
+        struct PacedGrain
+        {
+            std::uint32_t flowId;
+            std::uint64_t grainIndex;
+            std::uint32_t validSlices;        /**< The valid slices in the remote completion data of the last burst. */
+            std::vector<std::string> targets; /**< The targets the grain is written to. A target that misses a burst misses the grain. */
+            std::uint32_t slices;             /**< Number of slices of the grain. */
+            std::uint32_t bursts;             /**< Number of bursts the slices are split into. */
+            std::uint32_t next;               /**< The next burst to write. */
+            std::uint64_t start;              /**< TAI time at which the first burst is due. */
+            std::uint64_t interval;           /**< Nanoseconds between two bursts. */
+            std::uint64_t firstWritten;       /**< TAI time at which the first burst was written. */
+        };
+
+        /** \brief A link of a connected session, found by the id of its endpoint.
+         */
+        struct Connection
+        {
+            Target* target;
+            Link* link;
+        };
+
+        /** \brief A write in flight, whose completion is matched with it to measure its latency.
+         */
+        struct PostedWrite
+        {
+            Clock::time_point time; /**< When the write was posted. */
+            Target* target;         /**< The target the write goes to, or nullptr if it was removed in the meantime. */
+        };
+
+        /** \brief An RDMA read of a target session in flight.
+         */
+        struct PendingRead
+        {
+            std::string target; /**< The key of the target. */
+            bool instance;      /**< The instance id of the target is read rather than its credits. */
+            std::size_t words;  /**< Number of credit words read, up to the highest id of the flows written to the target. */
+        };
+
+        /** \brief The key of a target session in _targets, the address of its first rail.
+         */
+        static std::string targetKey(TargetInfo const& info);
+
+        /** \brief The endpoint that writes to a target on a rail.
+         */
+        Endpoint& endpointOf(Link& link, std::size_t rail);
+
+        /** \brief Post the write of a stripe of a grain to a target. \return false if the work queue of the rail is full.
+         */
+        bool tryWrite(Target& target, std::size_t rail, LocalRegion const& local, RemoteRegion const& remote, std::optional<std::uint32_t> data);
+
+        /** \brief The header of the grain in the slot of a grain of a flow, which holds another grain if the ring buffer wrapped.
+         */
+        static mxlGrainInfo const& headerOf(Flow const& flow, std::uint64_t grainIndex) noexcept;
+
+        /** \brief Split a grain of a flow into stripes. The slot of the grain must hold it.
+         */
+        GrainWrite prepareWrite(Flow const& flow, std::uint32_t flowId, std::uint64_t grainIndex) const;
+
+        /** \brief Post the writes of the stripes of a grain to one target session.
+         *
+         * Once the first stripe is posted, the stripes that don't fit in the work queues of their rails are queued, and posted while making
+         * progress (\see postStripes()).
+         *
+         * \return false if the work queue of the first rail is full or stripes of earlier grains are still queued, in which case nothing
+         * was posted.
+         */
+        bool writeGrain(Flow const& flow, Route const& route, Target& target, GrainWrite const& grain);
+
+        /** \brief Post the queued stripes of a target session, in order, until a work queue is full. The stripes of grains that were
+         * overwritten in the ring buffer in the meantime are dropped.
+         *
+         * \return true once no stripe is queued anymore.
+         */
+        bool postStripes(Target& target);
+
+        /** \brief Schedule the bursts of a grain of a paced flow. Throws an MXL_ERR_NOT_READY exception if the bursts of the grains
+         * scheduled earlier end more than a grain period from now.
+         */
+        void schedulePaced(Flow& flow, std::uint32_t flowId, std::uint64_t grainIndex, std::vector<std::string> targets);
+
+        /** \brief Write the bursts of paced grains that are due.
+         */
+        void pace();
+
+        /** \brief Write the next burst of a paced grain.
+         *
+         * \return When the following burst is due, which is now if the burst must be retried, or nothing once the grain is done.
+         */
+        std::optional<std::uint64_t> writeBurst(PacedGrain& grain, std::uint64_t now);
+
+        /** \brief Check the credits a target session granted to a flow, and mark them as wanted when they run low.
+         *
+         * \return true if the target session granted enough credits to write the grain.
+         */
+        bool hasCredit(Target& target, Route const& route, std::uint64_t grainIndex);
+
+        /** \brief Check the credits of all the target sessions of a flow before a grain is written, and read them again when they run low.
+         *
+         * \return true if every connected target session of the flow granted enough credits to write the grain.
+         */
+        bool checkCredits(Flow const& flow, std::uint64_t grainIndex);
+
+        /** \brief Post a read of the instance id or of the credits of the next target session that wants them, unless a read is already in
+         * flight. Instance ids are read first, they gate the recovery of links.
+         */
+        void postRead();
+
+        /** \brief Post a read of a target session. \return false if the work queue of the first rail is full.
+         */
+        bool tryRead(std::string const& key, Target& target, bool instance);
+
+        void handleRead(Completion const& completion);
+
+        /** \brief Whether the instance id of a target session can be read to validate its links, which requires a target info that
+         * carries it.
+         */
+        [[nodiscard]]
+        static bool canValidate(Target const& target) noexcept;
+
+        /** \brief Record the failure of a link of a target session, and start an outage or give up on the target.
+         */
+        void linkFailed(Target& target);
+
+        /** \brief End the outage of a target session whose links were validated.
+         */
+        void linkRestored(Target& target);
+
+        /** \brief Re-establish the failed links of a recovering target session, or validate them again.
+         */
+        void reconnect(std::string const& key, Target& target);
+
+        /** \brief Write the newest grains of every flow to a target session whose link was just restored.
+         */
+        void catchUp(std::string const& key, Target& target);
+
+        /** \brief Retire the endpoint of a link, the writes it didn't complete are no longer waited for.
+         */
+        void retire(Link& link);
+
+        /** \brief Drive the recovery of failed links and the liveness checks of connectionless links.
+         */
+        void supervise();
+
+        void handleEvent(RailEvent& railEvent);
+
+        void handleCompletion(Completion const& completion);
+
+        /** \brief Handle the completions that were read, and those of the completion queues of all rails.
+         */
+        void drainCompletions();
+
+        /** \brief Drain the completion queues and report whether the session is done.
+         */
+        bool done();
+
+    private:
+        SessionRails _rails;
+        std::vector<Endpoint> _endpoints; /**< One per rail, connectionless sessions only. */
+
+        std::map<std::string, Target> _targets;
+        std::map<Endpoint::Id, Connection> _connections; /**< The links of connected sessions, by the id of their endpoint. */
+        std::vector<std::optional<Flow>> _flows;         /**< Indexed by the id of the flow in the session. */
+        std::size_t _pendingWrites;
+        std::map<Endpoint::Id, std::deque<PostedWrite>> _posted; /**< Per endpoint, the writes in flight in the order they were posted. */
+
+        std::uint32_t _creditWindow;                   /**< 0 if the session doesn't apply flow control. */
+        SessionConfig::LinkSupervision _supervision;   /**< How failed links are recovered. */
+        std::vector<std::uint64_t> _creditBuffer;      /**< Destination of the credit and instance reads. Never resized. */
+        std::optional<RegisteredRegion> _creditRegion; /**< _creditBuffer, registered on the first rail. */
+        std::optional<PendingRead> _read;              /**< The read in flight. There is one at most. */
+        std::string _creditCursor;                     /**< The target whose credits were read last, targets take turns. */
+
+        TimerWheel _pacer;                                /**< Schedules the next burst of every paced grain. */
+        std::map<std::uint64_t, PacedGrain> _pacedGrains; /**< By timer id. */
+        std::uint64_t _nextTimer;                         /**< The id of the next paced grain. */
+        std::vector<std::uint64_t> _expired;              /**< Timers that expired on the last tick, kept to avoid allocations. */
+
+        std::vector<Completion> _completions; /**< Completions of the last read, kept to avoid allocations. */
+    };
+}
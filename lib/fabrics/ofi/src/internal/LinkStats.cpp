@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "LinkStats.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace mxl::lib::fabrics::ofi
+{
+    LinkStats::LinkStats() noexcept
+        : _values{}
+    {}
+
+    void LinkStats::posted(std::size_t bytes) noexcept
+    {
+        _values.bytes += bytes;
+        ++_values.writes;
+        ++_values.inFlight;
+        _values.maxInFlight = std::max(_values.maxInFlight, _values.inFlight);
+    }
+
+    void LinkStats::completed(std::chrono::steady_clock::duration latency) noexcept
+    {
+        auto const ns = static_cast<std::uint64_t>(std::max<std::int64_t>(0, std::chrono::nanoseconds{latency}.count()));
+        ++_values.latencyHistogram[latencyBucket(latency)];
+        _values.totalLatencyNs += ns;
+        _values.maxLatencyNs = std::max(_values.maxLatencyNs, ns);
+        abandoned();
+    }
+
+    void LinkStats::failed(int code, bool write) noexcept
+    {
+        ++_values.errors;
+        if (write)
+        {
+            abandoned();
+        }
+
+        // The first codes seen get an entry of their own, the others only count in the total.
+        for (auto& entry : _values.errorCodes)
+        {
+            if ((entry.count == 0U) || (entry.code == code))
+            {
+                entry.code = code;
+                ++entry.count;
+                return;
+            }
+        }
+    }
+
+    void LinkStats::abandoned() noexcept
+    {
+        if (_values.inFlight > 0U)
+        {
+            --_values.inFlight;
+        }
+    }
+
+    void LinkStats::received(std::size_t bytes) noexcept
+    {
+        _values.bytes += bytes;
+        ++_values.writes;
+    }
+
+    void LinkStats::grain() noexcept
+    {
+        ++_values.grains;
+    }
+
+    void LinkStats::linkFailed() noexcept
+    {
+        ++_values.linkFailures;
+    }
+
+    void LinkStats::linkRestored() noexcept
+    {
+        ++_values.reconnects;
+    }
+
+    void LinkStats::inFlight(std::size_t depth) noexcept
+    {
+        _values.inFlight = static_cast<std::uint32_t>(depth);
+        _values.maxInFlight = std::max(_values.maxInFlight, _values.inFlight);
+    }
+
+    mxlFabricsLinkStats LinkStats::values() const noexcept
+    {
+        return _values;
+    }
+
+    std::size_t LinkStats::latencyBucket(std::chrono::steady_clock::duration latency) noexcept
+    {
+        auto const us = std::max<std::int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+        return std::min<std::size_t>(std::bit_width(static_cast<std::uint64_t>(us)), MXL_FABRICS_LATENCY_BUCKETS - 1U);
+    }
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mxl/fabrics.h>
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief The counters of the transfers of a link, \see mxlFabricsLinkStats.
+     *
+     * The counters are updated as operations are posted and completed, without allocating, and handed out as a copy.
+     */
+    class LinkStats
+    {
+    public:
+        LinkStats() noexcept;
+
+        /** \brief Count a write of `bytes` bytes that was posted and is now in flight.
+         */
+        void posted(std::size_t bytes) noexcept;
+
+        /** \brief Count a write that completed successfully `latency` after it was posted.
+         */
+        void completed(std::chrono::steady_clock::duration latency) noexcept;
+
+        /** \brief Count an operation that completed with the error `code`. A write is no longer in flight.
+         */
+        void failed(int code, bool write) noexcept;
+
+        /** \brief Forget a write that is no longer waited for, its connection was retired.
+         */
+        void abandoned() noexcept;
+
+        /** \brief Count a write of `bytes` bytes received by a target session.
+         */
+        void received(std::size_t bytes) noexcept;
+
+        /** \brief Count a grain written to, or received from, the peer.
+         */
+        void grain() noexcept;
+
+        /** \brief Count a failure of the link.
+         */
+        void linkFailed() noexcept;
+
+        /** \brief Count a restoration of the link after a failure.
+         */
+        void linkRestored() noexcept;
+
+        /** \brief Set the in-flight depth, for owners that track it themselves.
+         */
+        void inFlight(std::size_t depth) noexcept;
+
+        /** \brief The counters.
+         */
+        [[nodiscard]]
+        mxlFabricsLinkStats values() const noexcept;
+
+        /** \brief The bucket of the latency histogram of a latency.
+         */
+        [[nodiscard]]
+        static std::size_t latencyBucket(std::chrono::steady_clock::duration latency) noexcept;
+
+    private:
+        mxlFabricsLinkStats _values;
+    };
+}
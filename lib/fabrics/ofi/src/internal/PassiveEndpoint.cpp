@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PassiveEndpoint.hpp"
+#include <memory>
+#include <utility>
+#include <mxl-internal/Logging.hpp>
+#include <rdma/fabric.h>
+#include <rdma/fi_cm.h>
+#include <rdma/fi_endpoint.h>
+#include "Exception.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    PassiveEndpoint PassiveEndpoint::create(std::shared_ptr<Fabric> fabric, FabricInfoView info)
+    {
+        ::fid_pep* raw;
+
+        fiCall(::fi_passive_ep, "Failed to create passive endpoint", fabric->raw(), info.raw(), &raw, nullptr);
+
+        return {raw, std::move(fabric)};
+    }
+
+    PassiveEndpoint::PassiveEndpoint(::fid_pep* raw, std::shared_ptr<Fabric> fabric)
+        : _raw(raw)
+        , _fabric(std::move(fabric))
+    {}
+
+    PassiveEndpoint::~PassiveEndpoint()
+    {
+        close();
+    }
+
+    PassiveEndpoint::PassiveEndpoint(PassiveEndpoint&& other) noexcept
+        : _raw(other._raw)
+        , _fabric(std::move(other._fabric))
+        , _eq(std::move(other._eq))
+    {
+        other._raw = nullptr;
+    }
+
+    PassiveEndpoint& PassiveEndpoint::operator=(PassiveEndpoint&& other)
+    {
+        close();
+
+        _raw = other._raw;
+        other._raw = nullptr;
+
+        _fabric = std::move(other._fabric);
+        _eq = std::move(other._eq);
+
+        return *this;
+    }
+
+    void PassiveEndpoint::close()
+    {
+        if (_raw)
+        {
+            MXL_DEBUG("Closing passive endpoint");
+
+            fiCall(::fi_close, "Failed to close passive endpoint", &_raw->fid);
+            _raw = nullptr;
+        }
+    }
+
+    void PassiveEndpoint::bind(std::shared_ptr<EventQueue> eq)
+    {
+        fiCall(::fi_pep_bind, "Failed to bind event queue to passive endpoint", _raw, &eq->raw()->fid, 0);
+
+        _eq = std::move(eq);
+    }
+
+    void PassiveEndpoint::listen()
+    {
+        fiCall(::fi_listen, "Failed to listen on passive endpoint", _raw);
+    }
+
+    FabricAddress PassiveEndpoint::localAddress() const
+    {
+        return FabricAddress::fromFid(&_raw->fid);
+    }
+
+    std::shared_ptr<EventQueue> PassiveEndpoint::eventQueue() const
+    {
+        if (!_eq)
+        {
+            throw Exception::internal("No event queue bound to the passive endpoint");
+        }
+
+        return *_eq;
+    }
+
+    ::fid_pep* PassiveEndpoint::raw() noexcept
+    {
+        return _raw;
+    }
+
+    ::fid_pep const* PassiveEndpoint::raw() const noexcept
+    {
+        return _raw;
+    }
+}
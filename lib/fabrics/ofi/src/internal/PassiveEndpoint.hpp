@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <rdma/fabric.h>
+#include <rdma/fi_endpoint.h>
+#include "Address.hpp"
+#include "EventQueue.hpp"
+#include "Fabric.hpp"
+#include "FabricInfo.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief RAII Wrapper around a libfabric passive endpoint (`fi_pep`).
+     *
+     * A passive endpoint listens for connection requests of connection-oriented (FI_EP_MSG) endpoints. Every request is reported as an
+     * Event::ConnectionRequested on the bound event queue, and is accepted by creating an active Endpoint with the fabric information of
+     * the event.
+     */
+    class PassiveEndpoint
+    {
+    public:
+        /** \brief Allocates a new passive endpoint bound to the source address of the fabric information.
+         */
+        static PassiveEndpoint create(std::shared_ptr<Fabric> fabric, FabricInfoView info);
+
+        ~PassiveEndpoint();
+
+        // Copy constructor is deleted
+        PassiveEndpoint(PassiveEndpoint const&) = delete;
+        void operator=(PassiveEndpoint const&) = delete;
+
+        // Implements proper move semantics. A passive endpoint in a moved-from state can no longer be used.
+        PassiveEndpoint(PassiveEndpoint&&) noexcept;
+        PassiveEndpoint& operator=(PassiveEndpoint&&);
+
+        /** \brief Bind the passive endpoint to the event queue that connection requests will be reported to.
+         */
+        void bind(std::shared_ptr<EventQueue> eq);
+
+        /** \brief Start listening for connection requests.
+         */
+        void listen();
+
+        /** \brief Obtain the local fabric address for this endpoint, which active endpoints connect to.
+         */
+        [[nodiscard]]
+        FabricAddress localAddress() const;
+
+        /** \brief Get the associated event queue. Throws an exception if no event queue is bound.
+         */
+        [[nodiscard]]
+        std::shared_ptr<EventQueue> eventQueue() const;
+
+        /** \brief Get the raw libfabric handle to this endpoint.
+         */
+        ::fid_pep* raw() noexcept;
+
+        /** \copydoc raw() */
+        [[nodiscard]]
+        ::fid_pep const* raw() const noexcept;
+
+    private:
+        void close();
+
+        PassiveEndpoint(::fid_pep* raw, std::shared_ptr<Fabric> fabric);
+
+    private:
+        ::fid_pep* _raw;                                /**< Raw resource reference */
+        std::shared_ptr<Fabric> _fabric;                /**< Fabric in which the endpoint was created */
+        std::optional<std::shared_ptr<EventQueue>> _eq; /**< Event queue lives here after PassiveEndpoint::bind() */
+    };
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PullFlowIoFactory.hpp"
+#include <utility>
+#include "Exception.hpp"
+#include "PullFlowReader.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    PullFlowIoFactory::PullFlowIoFactory(SessionConfig const& config)
+        : _session(std::make_unique<PullSession>(config))
+    {}
+
+    void PullFlowIoFactory::addFlow(uuids::uuid const& mirrorId, TargetInfo const& info, std::uint32_t flowId, DiscreteFlowWriter& mirror)
+    {
+        auto const lock = std::lock_guard{_mutex};
+        if (_sources.contains(mirrorId))
+        {
+            throw Exception::exists("Flow {} is already pulled", uuids::to_string(mirrorId));
+        }
+
+        auto const pullId = _session->addFlow(info, flowId, const_cast<FlowData&>(mirror.getFlowData()));
+        auto& source = _sources[mirrorId];
+        source.pullId = pullId;
+        source.mirror = &mirror;
+    }
+
+    std::unique_ptr<DiscreteFlowReader> PullFlowIoFactory::createDiscreteFlowReader(FlowManager const& manager, uuids::uuid const& flowId,
+        std::unique_ptr<DiscreteFlowData>&& data) const
+    {
+        auto local = _local.createDiscreteFlowReader(manager, flowId, std::move(data));
+
+        auto const lock = std::lock_guard{_mutex};
+        if (auto const it = _sources.find(flowId); it != _sources.end())
+        {
+            auto& source = it->second;
+            return std::make_unique<PullDiscreteFlowReader>(flowId, std::move(local), *_session, source.pullId, *source.mirror, source.mirrorMutex);
+        }
+        return local;
+    }
+
+    std::unique_ptr<ContinuousFlowReader> PullFlowIoFactory::createContinuousFlowReader(FlowManager const& manager, uuids::uuid const& flowId,
+        std::unique_ptr<ContinuousFlowData>&& data) const
+    {
+        return _local.createContinuousFlowReader(manager, flowId, std::move(data));
+    }
+
+    std::unique_ptr<DiscreteFlowWriter> PullFlowIoFactory::createDiscreteFlowWriter(FlowManager const& manager, uuids::uuid const& flowId,
+        std::unique_ptr<DiscreteFlowData>&& data) const
+    {
+        return _local.createDiscreteFlowWriter(manager, flowId, std::move(data));
+    }
+
+    std::unique_ptr<ContinuousFlowWriter> PullFlowIoFactory::createContinuousFlowWriter(FlowManager const& manager, uuids::uuid const& flowId,
+        std::unique_ptr<ContinuousFlowData>&& data) const
+    {
+        return _local.createContinuousFlowWriter(manager, flowId, std::move(data));
+    }
+}
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <uuid.h>
+#include <mxl-internal/DiscreteFlowWriter.hpp>
+#include <mxl-internal/PosixFlowIoFactory.hpp>
+#include "PullSession.hpp"
+#include "TargetInfo.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief The flow I/O factory of instances that pull some of their flows from remote sources.
+     *
+     * Readers of the flows registered with addFlow() pull the grains they are asked for into the local mirror of the flow
+     * (\see PullDiscreteFlowReader). Every other reader and writer is a regular POSIX one.
+     */
+    class PullFlowIoFactory : public FlowIoFactory
+    {
+    public:
+        /** \brief Create a factory whose flows are pulled with a session of the given configuration.
+         */
+        explicit PullFlowIoFactory(SessionConfig const& config);
+
+        /** \brief Pull the flow `flowId` of a target session into the local flow `mirrorId`, written by `mirror`.
+         *
+         * Only the readers created afterwards pull. Throws an MXL_ERR_EXISTS exception if the local flow is already pulled.
+         */
+        void addFlow(uuids::uuid const& mirrorId, TargetInfo const& info, std::uint32_t flowId, DiscreteFlowWriter& mirror);
+
+        /** \see FlowReaderFactory::createDiscreteFlowReader() */
+        virtual std::unique_ptr<DiscreteFlowReader> createDiscreteFlowReader(FlowManager const& manager, uuids::uuid const& flowId,
+            std::unique_ptr<DiscreteFlowData>&& data) const override;
+
+        /** \see FlowReaderFactory::createContinuousFlowReader() */
+        virtual std::unique_ptr<ContinuousFlowReader> createContinuousFlowReader(FlowManager const& manager, uuids::uuid const& flowId,
+            std::unique_ptr<ContinuousFlowData>&& data) const override;
+
+        /** \see FlowWriterFactory::createDiscreteFlowWriter() */
+        virtual std::unique_ptr<DiscreteFlowWriter> createDiscreteFlowWriter(FlowManager const& manager, uuids::uuid const& flowId,
+            std::unique_ptr<DiscreteFlowData>&& data) const override;
+
+        /** \see FlowWriterFactory::createContinuousFlowWriter() */
+        virtual std::unique_ptr<ContinuousFlowWriter> createContinuousFlowWriter(FlowManager const& manager, uuids::uuid const& flowId,
+            std::unique_ptr<ContinuousFlowData>&& data) const override;
+
+    private:
+        /** \brief A local flow pulled from a target session.
+         */
+        struct Source
+        {
+            std::uint32_t pullId;           /**< The id of the flow in the pull session. */
+            DiscreteFlowWriter* mirror;     /**< Writes the pulled grains to the local flow. */
+            std::mutex mutable mirrorMutex; /**< Serializes the accesses to the mirror of every reader of the flow, it has a single writer. */
+        };
+
+    private:
+        PosixFlowIoFactory _local;
+        std::unique_ptr<PullSession> _session;
+        std::map<uuids::uuid, Source> _sources; /**< By the id of the local flow. */
+        std::mutex mutable _mutex;
+    };
+}
@@ -0,0 +1,271 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PullFlowReader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <mxl/time.h>
+#include <mxl-internal/Logging.hpp>
+#include "Exception.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    namespace
+    {
+        /** How long a blocking read waits between two pulls of a grain that the source doesn't hold yet. */
+        constexpr auto PullInterval = std::chrono::microseconds{200};
+
+        /** \brief Whether the mirror holds enough slices of grain `index`.
+         */
+        bool holds(mxlGrainInfo const& held, std::uint64_t index, std::uint16_t minValidSlices, bool allValid)
+        {
+            if (held.index != index)
+            {
+                return false;
+            }
+            if (((held.flags & MXL_GRAIN_FLAG_INVALID) != 0) || (held.validSlices >= held.totalSlices))
+            {
+                return true;
+            }
+            return !allValid && (held.validSlices >= minValidSlices);
+        }
+
+        /** \brief The payload bytes of the slices [first, last) of a grain.
+         *
+         * Slices are evenly sized when they divide the payload. Otherwise the whole payload is read, which only formats with several planes
+         * pay for.
+         */
+        std::pair<std::size_t, std::size_t> payloadBytes(mxlGrainInfo const& info, std::uint16_t first, std::uint16_t last)
+        {
+            if ((info.totalSlices == 0) || ((info.grainSize % info.totalSlices) != 0))
+            {
+                return {0U, info.grainSize};
+            }
+            auto const sliceSize = std::size_t{info.grainSize / info.totalSlices};
+            return {first * sliceSize, last * sliceSize};
+        }
+    }
+
+    PullDiscreteFlowReader::PullDiscreteFlowReader(uuids::uuid const& flowId, std::unique_ptr<DiscreteFlowReader>&& local, PullSession& session,
+        std::uint32_t pullId, DiscreteFlowWriter& mirror, std::mutex& mirrorMutex)
+        : DiscreteFlowReader(flowId, local->getDomain())
+        , _local(std::move(local))
+        , _session(session)
+        , _pullId(pullId)
+        , _mirror(mirror)
+        , _mirrorMutex(mirrorMutex)
+    {}
+
+    FlowData const& PullDiscreteFlowReader::getFlowData() const
+    {
+        return _local->getFlowData();
+    }
+
+    mxlFlowInfo PullDiscreteFlowReader::getFlowInfo() const
+    {
+        return _local->getFlowInfo();
+    }
+
+    mxlFlowConfigInfo PullDiscreteFlowReader::getFlowConfigInfo() const
+    {
+        return _local->getFlowConfigInfo();
+    }
+
+    mxlFlowRuntimeInfo PullDiscreteFlowReader::getFlowRuntimeInfo() const
+    {
+        return _local->getFlowRuntimeInfo();
+    }
+
+    mxlStatus PullDiscreteFlowReader::getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, std::uint64_t in_timeoutNs,
+        mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload)
+    {
+        // The source can't signal new grains, so they are polled for until the deadline.
+        auto const deadline = PullSession::Clock::now() + std::chrono::nanoseconds{in_timeoutNs};
+        auto status = tryPull(in_index, in_minValidSlices, false, deadline);
+        while ((status == MXL_ERR_OUT_OF_RANGE_TOO_EARLY) && (PullSession::Clock::now() + PullInterval < deadline))
+        {
+            std::this_thread::sleep_for(PullInterval);
+            status = tryPull(in_index, in_minValidSlices, false, deadline);
+        }
+
+        if (status != MXL_STATUS_OK)
+        {
+            return status;
+        }
+        return _local->getGrain(in_index, in_minValidSlices, out_grainInfo, out_payload);
+    }
+
+    mxlStatus PullDiscreteFlowReader::getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
+        std::uint8_t** out_payload)
+    {
+        if (auto const status = tryPull(in_index, in_minValidSlices, false, PullSession::Clock::now()); status != MXL_STATUS_OK)
+        {
+            return status;
+        }
+        return _local->getGrain(in_index, in_minValidSlices, out_grainInfo, out_payload);
+    }
+
+    mxlStatus PullDiscreteFlowReader::getNextSlices(mxlGrainSliceCursor& io_cursor, std::uint64_t in_timeoutNs, std::uint16_t* out_firstSlice,
+        std::uint16_t* out_lastSlice)
+    {
+        // At least the next slice, and every slice the source holds past it, so that the ranges handed out are as large as with a local flow.
+        auto const minValidSlices = static_cast<std::uint16_t>(std::min<std::uint32_t>(io_cursor.nextSlice + 1U, UINT16_MAX));
+        auto const deadline = PullSession::Clock::now() + std::chrono::nanoseconds{in_timeoutNs};
+        auto status = tryPull(io_cursor.index, minValidSlices, true, deadline);
+        while ((status == MXL_ERR_OUT_OF_RANGE_TOO_EARLY) && (PullSession::Clock::now() + PullInterval < deadline))
+        {
+            std::this_thread::sleep_for(PullInterval);
+            status = tryPull(io_cursor.index, minValidSlices, true, deadline);
+        }
+
+        if (status != MXL_STATUS_OK)
+        {
+            return status;
+        }
+        return _local->getNextSlices(io_cursor, 0, out_firstSlice, out_lastSlice);
+    }
+
+    mxlStatus PullDiscreteFlowReader::getLatestGrain(std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload)
+    {
+        auto head = std::uint64_t{};
+        try
+        {
+            head = _session.headIndex(_pullId, PullSession::Clock::now());
+        }
+        catch (Exception const& e)
+        {
+            return (e.status() == MXL_ERR_NOT_READY) ? MXL_ERR_OUT_OF_RANGE_TOO_EARLY : e.status();
+        }
+
+        if (head == MXL_UNDEFINED_INDEX)
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+        }
+
+        // Only the grains that are still in the ring of the source are considered, newest first.
+        auto const grainCount = _session.grainCount(_pullId);
+        for (auto i = std::size_t{0}; (i < grainCount) && (i <= head); ++i)
+        {
+            auto const status = tryPull(head - i, in_minValidSlices, false, PullSession::Clock::now());
+            if (status == MXL_STATUS_OK)
+            {
+                return _local->getGrain(head - i, in_minValidSlices, out_grainInfo, out_payload);
+            }
+            if (status != MXL_ERR_OUT_OF_RANGE_TOO_EARLY)
+            {
+                return status;
+            }
+        }
+        return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+    }
+
+    mxlStatus PullDiscreteFlowReader::verifyGrain(mxlGrainInfo const& in_grainInfo, std::uint8_t const* in_payload) const
+    {
+        return _local->verifyGrain(in_grainInfo, in_payload);
+    }
+
+    bool PullDiscreteFlowReader::isFlowValid() const
+    {
+        // The local reader checks the mirror. The source is only known to be gone once reads of it fail.
+        return true;
+    }
+
+    mxlStatus PullDiscreteFlowReader::pull(std::uint64_t index, std::uint16_t minValidSlices, bool allValid,
+        PullSession::Clock::time_point deadline)
+    {
+        auto const held = _mirror.getGrainInfo(index);
+        if (holds(held, index, minValidSlices, allValid))
+        {
+            return MXL_STATUS_OK;
+        }
+
+        auto const grainCount = _session.grainCount(_pullId);
+        auto const head = _session.headIndex(_pullId, deadline);
+        if ((head == MXL_UNDEFINED_INDEX) || (index > head))
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+        }
+        if ((head - index) >= grainCount)
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+        }
+
+        auto info = _session.grainInfo(_pullId, index, deadline);
+        if (info.index != index)
+        {
+            // Either the slot was recycled, or the writer of the source hasn't opened the grain yet.
+            return (info.index > index) ? MXL_ERR_OUT_OF_RANGE_TOO_LATE : MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+        }
+
+        auto const invalid = (info.flags & MXL_GRAIN_FLAG_INVALID) != 0;
+        auto const repeat = (info.flags & MXL_GRAIN_FLAG_REPEAT) != 0;
+        auto const wanted = allValid ? info.validSlices : std::min(minValidSlices, info.totalSlices);
+        if (!invalid && (info.validSlices < wanted))
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+        }
+
+        // The payload of a repeated grain is read from its source grain, the mirror holds it as a grain of its own.
+        auto const sourceIndex = repeat ? info.sourceIndex : index;
+        auto const first = (repeat || (held.index != index)) ? std::uint16_t{0} : std::min(held.validSlices, wanted);
+        auto const last = repeat ? info.totalSlices : wanted;
+
+        auto slot = mxlGrainInfo{};
+        auto payload = static_cast<std::uint8_t*>(nullptr);
+        if (auto const status = _mirror.openGrain(index, &slot, &payload); status != MXL_STATUS_OK)
+        {
+            return status;
+        }
+
+        if (!invalid && (first < last))
+        {
+            auto const [firstByte, lastByte] = payloadBytes(info, first, last);
+            _session.readPayload(_pullId, sourceIndex, index, firstByte, lastByte, deadline);
+
+            // The source may have recycled the slot while it was read, in which case the payload is torn. The writer of the source stamps
+            // the new index in the header of the slot when it opens the grain, before it writes the payload and long before the head moves,
+            // so the header is read again, like the sequence of a sequence lock.
+            if (_session.grainInfo(_pullId, sourceIndex, deadline).index != sourceIndex)
+            {
+                _mirror.cancel();
+                return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+            }
+        }
+
+        info.flags &= ~MXL_GRAIN_FLAG_REPEAT;
+        info.validSlices = repeat ? info.totalSlices : last;
+        return _mirror.commit(info);
+    }
+
+    mxlStatus PullDiscreteFlowReader::tryPull(std::uint64_t index, std::uint16_t minValidSlices, bool allValid,
+        PullSession::Clock::time_point deadline) noexcept
+    {
+        auto const lock = std::lock_guard{_mirrorMutex};
+        try
+        {
+            return pull(index, minValidSlices, allValid, deadline);
+        }
+        catch (Exception const& e)
+        {
+            _mirror.cancel();
+
+            // A link that is not up yet holds no grain yet.
+            if (e.status() == MXL_ERR_NOT_READY)
+            {
+                return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+            }
+            MXL_ERROR("Failed to pull grain {}: {}", index, e.what());
+            return e.status();
+        }
+        catch (std::exception const& e)
+        {
+            _mirror.cancel();
+            MXL_ERROR("Failed to pull grain {}: {}", index, e.what());
+            return MXL_ERR_UNKNOWN;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <uuid.h>
+#include <mxl/flow.h>
+#include <mxl-internal/DiscreteFlowReader.hpp>
+#include <mxl-internal/DiscreteFlowWriter.hpp>
+#include "PullSession.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief A reader of a discrete flow that pulls the grains it is asked for from a remote source.
+     *
+     * The grains live in a local mirror flow. Before a grain is handed out, the slices of it that the mirror lacks are read from the source
+     * with the pull session and committed to the mirror, then the grain is read from the mirror. Grains nobody asks for never cross the
+     * fabric. The accessors of the flow info describe the mirror.
+     */
+    class PullDiscreteFlowReader : public DiscreteFlowReader
+    {
+    public:
+        /** \brief Create a reader of the pulled flow `pullId` of a session, whose grains are read from `local` once pulled into `mirror`.
+         *
+         * The mirror is shared by every reader of the pulled flow, which all lock `mirrorMutex` around their accesses to it.
+         */
+        PullDiscreteFlowReader(uuids::uuid const& flowId, std::unique_ptr<DiscreteFlowReader>&& local, PullSession& session,
+            std::uint32_t pullId, DiscreteFlowWriter& mirror, std::mutex& mirrorMutex);
+
+        /** \see FlowReader::getFlowData() */
+        [[nodiscard]]
+        virtual FlowData const& getFlowData() const override;
+
+        /** \see FlowReader::getFlowInfo() */
+        [[nodiscard]]
+        virtual mxlFlowInfo getFlowInfo() const override;
+
+        /** \see FlowReader::getFlowConfigInfo() */
+        [[nodiscard]]
+        virtual mxlFlowConfigInfo getFlowConfigInfo() const override;
+
+        /** \see FlowReader::getFlowRuntimeInfo() */
+        [[nodiscard]]
+        virtual mxlFlowRuntimeInfo getFlowRuntimeInfo() const override;
+
+        /** \see DiscreteFlowReader::getGrain() */
+        virtual mxlStatus getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, std::uint64_t in_timeoutNs, mxlGrainInfo* out_grainInfo,
+            std::uint8_t** out_payload) override;
+
+        /** \see DiscreteFlowReader::getGrain() */
+        virtual mxlStatus getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
+            std::uint8_t** out_payload) override;
+
+        /** \see DiscreteFlowReader::getNextSlices() */
+        virtual mxlStatus getNextSlices(mxlGrainSliceCursor& io_cursor, std::uint64_t in_timeoutNs, std::uint16_t* out_firstSlice,
+            std::uint16_t* out_lastSlice) override;
+
+        /** \see DiscreteFlowReader::getLatestGrain() */
+        virtual mxlStatus getLatestGrain(std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload) override;
+
+        /** \see DiscreteFlowReader::verifyGrain() */
+        [[nodiscard]]
+        virtual mxlStatus verifyGrain(mxlGrainInfo const& in_grainInfo, std::uint8_t const* in_payload) const override;
+
+    protected:
+        /** \see FlowReader::isFlowValid() */
+        [[nodiscard]]
+        virtual bool isFlowValid() const override;
+
+    private:
+        /** \brief Pull the slices of grain `index` that the mirror lacks, so that it holds `minValidSlices` of them, or all the slices the
+         * source holds if `allValid` is set.
+         *
+         * \return MXL_STATUS_OK if the mirror holds enough slices, MXL_ERR_OUT_OF_RANGE_TOO_EARLY if the source doesn't hold them yet, or
+         *     MXL_ERR_OUT_OF_RANGE_TOO_LATE if the grain left the ring of the source.
+         */
+        mxlStatus pull(std::uint64_t index, std::uint16_t minValidSlices, bool allValid, PullSession::Clock::time_point deadline);
+
+        /** \brief Call pull(), turning the exceptions of the session into status codes.
+         */
+        mxlStatus tryPull(std::uint64_t index, std::uint16_t minValidSlices, bool allValid, PullSession::Clock::time_point deadline) noexcept;
+
+    private:
+        std::unique_ptr<DiscreteFlowReader> _local; /**< Reads the mirror. */
+        PullSession& _session;
+        std::uint32_t _pullId;
+        DiscreteFlowWriter& _mirror;
+        std::mutex& _mirrorMutex; /**< Serializes the pulls of every reader of the flow, the mirror has a single writer. */
+    };
+}
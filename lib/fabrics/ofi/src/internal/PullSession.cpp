@@ -0,0 +1,332 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PullSession.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <mxl-internal/Flow.hpp>
+#include <mxl-internal/Logging.hpp>
+#include "Exception.hpp"
+#include "MemoryRegion.hpp"
+#include "Region.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    namespace
+    {
+        /** Offset of the head index in the mxlFlowInfo of a flow. */
+        constexpr auto HeadIndexOffset = offsetof(mxlFlowInfo, runtime) + offsetof(mxlFlowRuntimeInfo, headIndex);
+
+        /** How long a read is given to complete at least, so that the non-blocking pulls of a healthy link succeed. */
+        constexpr auto MinReadTime = std::chrono::milliseconds{50};
+    }
+
+    PullSession::PullSession(SessionConfig const& config)
+        : _rails(SessionRails::open(config, FI_RMA | FI_READ))
+        , _scratch(std::make_unique<Scratch>())
+        , _pendingReads(0)
+    {
+        if (_rails.size() > 1U)
+        {
+            MXL_WARN("Pulled flows are read on the first rail only, the {} other rails are not used", _rails.size() - 1U);
+        }
+
+        auto const scratch = Region{reinterpret_cast<std::uintptr_t>(_scratch.get()), sizeof(Scratch)};
+        _scratchRegion.emplace(MemoryRegion::reg(*_rails[0].domain, scratch, FI_READ), scratch);
+
+        if (_rails.connectionless())
+        {
+            openEndpoint();
+        }
+    }
+
+    PullSession::~PullSession()
+    {
+        for (auto& [key, link] : _links)
+        {
+            if (link.endpoint && link.up)
+            {
+                try
+                {
+                    link.endpoint->shutdown();
+                }
+                catch (Exception const& e)
+                {
+                    MXL_WARN("Failed to shut the pull connection down: {}", e.what());
+                }
+            }
+        }
+    }
+
+    std::uint32_t PullSession::addFlow(TargetInfo const& info, std::uint32_t flowId, FlowData& mirror)
+    {
+        auto const& source = info.flow(flowId);
+        if (!source.header)
+        {
+            throw Exception::invalidArgument("Flow {} of the target session is not exposed for pulling", flowId);
+        }
+
+        auto const regions = mxlRegionsFromFlow(mirror);
+        auto const& grains = regions.regions();
+        auto const& remote = source.regions.front();
+        if (std::ranges::any_of(grains, [&](Region const& grain) { return grain.size < remote.front().len; }))
+        {
+            throw Exception::invalidArgument("The grains of the mirror of flow {} are smaller than the grains of the source", flowId);
+        }
+
+        auto const lock = std::lock_guard{_mutex};
+        auto key = info.addresses().front().toBase64();
+        if (auto const it = _links.find(key); it == _links.end())
+        {
+            auto link = Link{.address = info.addresses().front(), .endpoint = std::nullopt, .addr = FI_ADDR_UNSPEC, .up = false};
+            connect(_links.emplace(key, std::move(link)).first->second);
+        }
+
+        auto flow = Flow{.source = std::move(key), .header = *source.header, .grains = remote, .local = {}};
+        for (auto const& grain : grains)
+        {
+            flow.local.emplace_back(MemoryRegion::reg(*_rails[0].domain, grain, FI_READ), grain);
+        }
+        _flows.push_back(std::move(flow));
+
+        MXL_INFO("Pulling flow {} of a target session, {} grains", flowId, remote.size());
+        return static_cast<std::uint32_t>(_flows.size() - 1U);
+    }
+
+    std::size_t PullSession::grainCount(std::uint32_t id) const
+    {
+        auto const lock = std::lock_guard{_mutex};
+        return flow(id).grains.size();
+    }
+
+    std::uint64_t PullSession::headIndex(std::uint32_t id, Clock::time_point deadline)
+    {
+        auto const lock = std::lock_guard{_mutex};
+        auto const& pulled = flow(id);
+
+        auto local = _scratchRegion->toLocal();
+        local.len = sizeof(std::uint64_t);
+        auto remote = pulled.header;
+        remote.addr += HeadIndexOffset;
+        remote.len = sizeof(std::uint64_t);
+        read(pulled, local, remote, deadline);
+
+        return _scratch->headIndex;
+    }
+
+    mxlGrainInfo PullSession::grainInfo(std::uint32_t id, std::uint64_t index, Clock::time_point deadline)
+    {
+        auto const lock = std::lock_guard{_mutex};
+        auto const& pulled = flow(id);
+
+        // The padding that makes up most of the header is left out.
+        auto local = _scratchRegion->toLocal();
+        local.addr += offsetof(Scratch, grain);
+        local.len = offsetof(mxlGrainInfo, reserved);
+        auto remote = pulled.grains[index % pulled.grains.size()];
+        remote.len = offsetof(mxlGrainInfo, reserved);
+        read(pulled, local, remote, deadline);
+
+        return _scratch->grain;
+    }
+
+    void PullSession::readPayload(std::uint32_t id, std::uint64_t sourceIndex, std::uint64_t index, std::size_t first, std::size_t last,
+        Clock::time_point deadline)
+    {
+        auto const lock = std::lock_guard{_mutex};
+        auto const& pulled = flow(id);
+
+        auto local = pulled.local[index % pulled.local.size()].toLocal();
+        local.addr += MXL_GRAIN_PAYLOAD_OFFSET + first;
+        local.len = last - first;
+        auto remote = pulled.grains[sourceIndex % pulled.grains.size()];
+        remote.addr += MXL_GRAIN_PAYLOAD_OFFSET + first;
+        remote.len = last - first;
+        read(pulled, local, remote, deadline);
+    }
+
+    PullSession::Flow const& PullSession::flow(std::uint32_t id) const
+    {
+        if (id >= _flows.size())
+        {
+            throw Exception::notFound("Pulled flow {} doesn't exist", id);
+        }
+        return _flows[id];
+    }
+
+    PullSession::Link& PullSession::linkOf(Flow const& flow, Clock::time_point deadline)
+    {
+        auto& link = _links.at(flow.source);
+        if (!link.up && !link.endpoint)
+        {
+            connect(link);
+        }
+
+        while (!link.up)
+        {
+            poll(deadline);
+            if (!link.up && (Clock::now() >= deadline))
+            {
+                throw Exception::make(MXL_ERR_NOT_READY, "The link to the source of the flow is not up yet");
+            }
+        }
+        return link;
+    }
+
+    void PullSession::connect(Link& link)
+    {
+        auto& resources = _rails[0];
+        if (resources.connectionless())
+        {
+            link.addr = resources.av->insert(link.address);
+            link.up = true;
+            return;
+        }
+
+        auto endpoint = Endpoint::create(resources.domain);
+        endpoint.bind(resources.eq);
+        endpoint.bind(resources.cq, FI_TRANSMIT | FI_RECV);
+        endpoint.enable();
+        endpoint.connect(link.address);
+
+        _connections[endpoint.id()] = link.address.toBase64();
+        link.endpoint = std::move(endpoint);
+    }
+
+    void PullSession::openEndpoint()
+    {
+        auto& resources = _rails[0];
+        _endpoint.reset();
+        _endpoint = Endpoint::create(resources.domain, resources.info.view());
+        _endpoint->bind(resources.cq, FI_TRANSMIT | FI_RECV);
+        _endpoint->bind(resources.av);
+        _endpoint->enable();
+    }
+
+    void PullSession::failLink(Link& link)
+    {
+        // Closing the endpoint drops the reads in flight on it. Connectionless sessions share theirs between the links, a new one is opened.
+        if (_rails.connectionless())
+        {
+            openEndpoint();
+        }
+        else if (link.endpoint)
+        {
+            _connections.erase(link.endpoint->id());
+            link.endpoint.reset();
+            link.up = false;
+        }
+        _pendingReads = 0;
+    }
+
+    void PullSession::read(Flow const& flow, LocalRegion const& local, RemoteRegion const& remote, Clock::time_point deadline)
+    {
+        auto& link = linkOf(flow, deadline);
+        auto& endpoint = link.endpoint ? *link.endpoint : *_endpoint;
+
+        for (;;)
+        {
+            try
+            {
+                endpoint.read(local, remote, link.addr);
+                break;
+            }
+            catch (Exception const& e)
+            {
+                // The queue is full of reads that completed without being polled, or of reads of a failed link that will complete in error.
+                if ((e.status() != MXL_ERR_NOT_READY) || (Clock::now() >= deadline))
+                {
+                    throw;
+                }
+                poll(deadline);
+            }
+        }
+
+        // A read that doesn't complete in time fails the link, so that its destination is never written once the caller moved on.
+        ++_pendingReads;
+        _reading = flow.source;
+        _failure.reset();
+        auto const readDeadline = std::max(deadline, Clock::now() + MinReadTime);
+        while (_pendingReads > 0)
+        {
+            if (Clock::now() >= readDeadline)
+            {
+                failLink(link);
+                throw Exception::make(MXL_ERR_TIMEOUT, "A read of a pulled flow did not complete in time, the link to the source was reset");
+            }
+            poll(readDeadline);
+        }
+
+        if (_failure)
+        {
+            throw Exception::internal("A read of a pulled flow failed: {}", *_failure);
+        }
+    }
+
+    void PullSession::poll(Clock::time_point deadline)
+    {
+        auto const now = Clock::now();
+        auto event = (deadline > now) ? _rails.readQueuesBlocking(_completions, deadline - now) : _rails.readQueues(_completions);
+        if (event)
+        {
+            handleEvent(event->event);
+        }
+
+        for (auto const& completion : _completions)
+        {
+            // Completions of connections and endpoints that failed in the meantime were written off with them.
+            if (_rails.connectionless() ? (completion.fid() != _endpoint->raw()) : !_connections.contains(Endpoint::idFromFID(completion.fid())))
+            {
+                continue;
+            }
+
+            if (auto error = completion.tryErr(); error)
+            {
+                _failure = error->toString();
+            }
+            if (_pendingReads > 0)
+            {
+                --_pendingReads;
+            }
+        }
+        _completions.clear();
+    }
+
+    void PullSession::handleEvent(Event& event)
+    {
+        auto const it = _connections.find(Endpoint::idFromFID(event.fid()));
+        if (it == _connections.end())
+        {
+            return;
+        }
+        auto& link = _links.at(it->second);
+
+        if (event.isConnected())
+        {
+            MXL_INFO("Pull connection {} established", it->first);
+            link.up = true;
+            return;
+        }
+
+        if (event.isShutdown())
+        {
+            MXL_WARN("Pull connection {} was shut down by the source", it->first);
+        }
+        else if (event.isError())
+        {
+            MXL_ERROR("Error event on pull connection {}: {}", it->first, event.err().toString());
+        }
+
+        // The next read connects again. A read in flight on the connection fails with it.
+        if ((_pendingReads > 0) && (_reading == it->second))
+        {
+            _pendingReads = 0;
+            _failure = "the link to the source was lost";
+        }
+        link.up = false;
+        link.endpoint.reset();
+        _connections.erase(it);
+    }
+}
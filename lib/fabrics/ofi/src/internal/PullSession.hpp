@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <mxl/fabrics.h>
+#include <mxl/flow.h>
+#include <mxl-internal/FlowData.hpp>
+#include "Address.hpp"
+#include "Completion.hpp"
+#include "Endpoint.hpp"
+#include "RegisteredRegion.hpp"
+#include "RemoteRegion.hpp"
+#include "Session.hpp"
+#include "TargetInfo.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief The consuming side of pull mode.
+     *
+     * The session reads the flows that target sessions expose for pulling (\see TargetSession::addPullFlow()) with RDMA reads on its first
+     * rail: the head index from the header of a flow, then the header and the slices of the grains its readers want, which land in a local
+     * mirror flow. The sources never take part in the transfers. Reads are synchronous, and readers of different flows may pull from
+     * different threads. A link that fails, or whose read doesn't complete by the deadline of the read, is connected again by the next read.
+     */
+    class PullSession
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    public:
+        /** \brief Open the resources of the session. Only the first rail of the configuration is used.
+         */
+        explicit PullSession(SessionConfig const& config);
+
+        /** \brief Shut the connections down.
+         */
+        ~PullSession();
+
+        // No copying, no moving, readers reference the session.
+        PullSession(PullSession const&) = delete;
+        void operator=(PullSession const&) = delete;
+
+        /** \brief Start pulling a flow of a target session into a local mirror flow, and return the id of the pulled flow.
+         *
+         * Throws an MXL_ERR_INVALID_ARG exception if the flow is not exposed for pulling, or if the grains of the mirror are smaller than
+         * the grains of the source.
+         */
+        std::uint32_t addFlow(TargetInfo const& info, std::uint32_t flowId, FlowData& mirror);
+
+        /** \brief Number of grains of the ring of the source of a pulled flow.
+         */
+        [[nodiscard]]
+        std::size_t grainCount(std::uint32_t id) const;
+
+        /** \brief Read the head index of the source of a pulled flow.
+         *
+         * Throws an MXL_ERR_NOT_READY exception if the link to the source is not up by the deadline, or an MXL_ERR_TIMEOUT exception if the
+         * read doesn't complete by then. Reads are given a few milliseconds at least, even with a deadline in the past.
+         */
+        std::uint64_t headIndex(std::uint32_t id, Clock::time_point deadline);
+
+        /** \brief Read the header of the grain that the slot of `index` in the ring of the source holds, which may be another grain.
+         */
+        mxlGrainInfo grainInfo(std::uint32_t id, std::uint64_t index, Clock::time_point deadline);
+
+        /** \brief Read the payload bytes [first, last) of the grain `sourceIndex` of the source into the slot of `index` in the mirror.
+         */
+        void readPayload(std::uint32_t id, std::uint64_t sourceIndex, std::uint64_t index, std::size_t first, std::size_t last,
+            Clock::time_point deadline);
+
+    private:
+        /** \brief The link to a target session.
+         */
+        struct Link
+        {
+            FabricAddress address;            /**< The address of the first rail of the target session. */
+            std::optional<Endpoint> endpoint; /**< The connection, connected sessions only. Reset when it fails. */
+            ::fi_addr_t addr;                 /**< The address of the target session in the address vector, connectionless sessions only. */
+            bool up;
+        };
+
+        /** \brief A flow pulled from a target session.
+         */
+        struct Flow
+        {
+            std::string source;                  /**< The key of the link to the target session. */
+            RemoteRegion header;                 /**< The mxlFlowInfo of the source. */
+            std::vector<RemoteRegion> grains;    /**< The grains of the source on its first rail, in ring buffer order. */
+            std::vector<RegisteredRegion> local; /**< The grains of the mirror, in ring buffer order. */
+        };
+
+        /** \brief The words the headers are read into.
+         */
+        struct Scratch
+        {
+            std::uint64_t headIndex;
+            mxlGrainInfo grain;
+        };
+
+        Flow const& flow(std::uint32_t id) const;
+
+        /** \brief Return the link of a flow once it is up, connecting it again if it failed.
+         */
+        Link& linkOf(Flow const& flow, Clock::time_point deadline);
+
+        /** \brief Connect a link, or do nothing for connectionless sessions.
+         */
+        void connect(Link& link);
+
+        /** \brief Post a read and wait for its completion until the deadline, failing the link if it doesn't complete by then.
+         */
+        void read(Flow const& flow, LocalRegion const& local, RemoteRegion const& remote, Clock::time_point deadline);
+
+        /** \brief Read the queues once, blocking until the deadline at most.
+         */
+        void poll(Clock::time_point deadline);
+
+        void handleEvent(Event& event);
+
+        /** \brief Open the endpoint of a connectionless session, dropping the previous one and the reads in flight on it.
+         */
+        void openEndpoint();
+
+        /** \brief Drop the reads in flight on a link, which is connected again by the next read.
+         */
+        void failLink(Link& link);
+
+    private:
+        SessionRails _rails;
+        std::optional<Endpoint> _endpoint; /**< Connectionless sessions only. */
+
+        std::map<std::string, Link> _links;               /**< By the address of the target session. */
+        std::map<Endpoint::Id, std::string> _connections; /**< The key of the link of every connection. */
+        std::vector<Flow> _flows;                         /**< Indexed by the id of the pulled flow. */
+
+        std::unique_ptr<Scratch> _scratch;
+        std::optional<RegisteredRegion> _scratchRegion; /**< _scratch, registered for local reads. */
+
+        std::size_t _pendingReads;           /**< Reads posted and not completed yet. There is one at most. */
+        std::string _reading;                /**< The key of the link of the last read. */
+        std::optional<std::string> _failure; /**< The error of the last read, if it failed. */
+
+        std::vector<Completion> _completions; /**< Completions of the last read, kept to avoid allocations. */
+        std::mutex mutable _mutex;
+    };
+}
@@ -0,0 +1,303 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Session.hpp"
+#include <algorithm>
+#include <mxl-internal/Logging.hpp>
+#include <rdma/fabric.h>
+#include "Endpoint.hpp"
+#include "Exception.hpp"
+#include "Format.hpp" // IWYU pragma: keep; Includes template specializations of fmt::formatter for our types
+
+namespace mxl::lib::fabrics::ofi
+{
+    namespace
+    {
+        /** Number of completions read at once when the configuration doesn't specify it. */
+        constexpr auto DefaultCompletionBatchSize = std::size_t{64};
+
+        /** Time between two attempts to re-establish a supervised link, if the configuration doesn't set it. */
+        constexpr auto DefaultRetryInterval = std::chrono::milliseconds{100};
+
+        /** Number of peers the address vector of a connectionless session is sized for. It grows beyond if needed. */
+        constexpr auto ExpectedPeers = std::size_t{32};
+    }
+
+    SessionConfig SessionConfig::fromAPI(mxlSessionConfig const& config)
+    {
+        auto const provider = providerFromAPI(config.provider);
+        if (!provider)
+        {
+            throw Exception::invalidArgument("Invalid provider {}", config.provider);
+        }
+
+        if ((config.extraRailCount != 0) && (config.extraRails == nullptr))
+        {
+            throw Exception::invalidArgument("The addresses of the extra rails are missing");
+        }
+        if (config.extraRailCount >= MXL_FABRICS_SESSION_MAX_RAILS)
+        {
+            throw Exception::invalidArgument("A session can have at most {} rails", MXL_FABRICS_SESSION_MAX_RAILS);
+        }
+
+        auto const toOptional = [](char const* s) { return (s != nullptr) ? std::optional<std::string>{s} : std::nullopt; };
+        auto const toRail = [&](mxlEndpointAddress const& address) {
+            return Rail{.node = toOptional(address.node), .service = toOptional(address.service)};
+        };
+
+        auto rails = std::vector<Rail>{toRail(config.endpointAddress)};
+        for (auto i = std::uint32_t{0}; i < config.extraRailCount; ++i)
+        {
+            rails.push_back(toRail(config.extraRails[i]));
+        }
+
+        auto endpointType = ::fi_ep_type{};
+        switch (config.endpointType)
+        {
+            case MXL_FABRICS_ENDPOINT_TYPE_CONNECTED:         endpointType = FI_EP_MSG; break;
+            case MXL_FABRICS_ENDPOINT_TYPE_RELIABLE_DATAGRAM: endpointType = FI_EP_RDM; break;
+            default:
+                throw Exception::invalidArgument("Invalid endpoint type {}", static_cast<int>(config.endpointType));
+        }
+
+        auto supervision = LinkSupervision{
+            .enabled = config.supervision.enabled,
+            .retryInterval = DefaultRetryInterval,
+            .catchUpGrains = config.supervision.catchUpGrains,
+        };
+        if (config.supervision.retryIntervalMs != 0)
+        {
+            supervision.retryInterval = std::chrono::milliseconds{config.supervision.retryIntervalMs};
+        }
+
+        return SessionConfig{
+            .rails = std::move(rails),
+            .provider = *provider,
+            .deviceSupport = config.deviceSupport,
+            .cq = CompletionQueue::Attributes::fromAPI(config.completionQueue),
+            .completionBatchSize = (config.completionQueue.batchSize != 0) ? config.completionQueue.batchSize : DefaultCompletionBatchSize,
+            .endpointType = endpointType,
+            .creditWindow = config.creditWindow,
+            .supervision = supervision,
+        };
+    }
+
+    SessionConfig SessionConfig::singleFlow(mxlEndpointAddress const& address, mxlFabricsProvider provider, bool deviceSupport)
+    {
+        return fromAPI(mxlSessionConfig{
+            .endpointAddress = address,
+            .provider = provider,
+            .deviceSupport = deviceSupport,
+            .completionQueue = {},
+            .endpointType = MXL_FABRICS_ENDPOINT_TYPE_CONNECTED,
+            .extraRails = nullptr,
+            .extraRailCount = 0,
+            .creditWindow = 0,
+            .supervision = {},
+        });
+    }
+
+    SessionResources SessionResources::open(SessionConfig const& config, std::size_t rail, std::uint64_t caps)
+    {
+        if (config.deviceSupport)
+        {
+            caps |= FI_HMEM;
+        }
+
+        // The bursts of paced grains rely on the writes of a connection being placed in order, which providers don't always guarantee
+        // unless asked to. The providers that can't are still used, without pacing.
+        auto const& address = config.rails.at(rail);
+        auto const getInfo = [&](std::uint64_t msgOrder) {
+            return FabricInfoList::get(address.node.value_or(""), address.service.value_or(""), config.provider, caps, config.endpointType, msgOrder);
+        };
+        auto infoList = FabricInfoList::own(nullptr);
+        try
+        {
+            infoList = getInfo(FI_ORDER_WAW);
+        }
+        catch (Exception const& e)
+        {
+            MXL_DEBUG("No {} provider configuration places the writes of rail {} in order: {}", config.provider, rail, e.what());
+        }
+        if (infoList.begin() == infoList.end())
+        {
+            infoList = getInfo(0);
+        }
+        auto it = infoList.begin();
+        if (it == infoList.end())
+        {
+            throw Exception::notFound("No {} provider configuration supports rail {} of the session", config.provider, rail);
+        }
+
+        auto info = FabricInfo{*it};
+        MXL_INFO("Opening {} resources of session rail {} with provider {} on fabric {}",
+            (config.endpointType == FI_EP_RDM) ? "connectionless" : "connected",
+            rail,
+            config.provider,
+            info->fabric_attr->name);
+
+        auto fabric = Fabric::open(info.view());
+        auto domain = Domain::open(fabric);
+        auto eq = EventQueue::open(fabric);
+        auto cq = CompletionQueue::open(domain, config.cq);
+        auto av = (config.endpointType == FI_EP_RDM) ? AddressVector::open(domain, {.count = ExpectedPeers, .epPerNode = 0}) : nullptr;
+
+        return SessionResources{
+            .info = std::move(info),
+            .fabric = std::move(fabric),
+            .domain = std::move(domain),
+            .eq = std::move(eq),
+            .cq = std::move(cq),
+            .av = std::move(av),
+            .completionBatchSize = config.completionBatchSize,
+        };
+    }
+
+    bool SessionResources::connectionless() const noexcept
+    {
+        return av != nullptr;
+    }
+
+    bool SessionResources::orderedWrites() const noexcept
+    {
+        return (info->tx_attr->msg_order & FI_ORDER_WAW) != 0;
+    }
+
+    std::optional<Event> SessionResources::readQueues(std::vector<Completion>& completions)
+    {
+        cq->readBatch(completions, completionBatchSize);
+        return eq->read();
+    }
+
+    std::optional<Event> SessionResources::readQueuesBlocking(std::vector<Completion>& completions, std::chrono::steady_clock::duration timeout)
+    {
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+
+        for (;;)
+        {
+            if (auto event = eq->read(); event)
+            {
+                return event;
+            }
+
+            auto const timeUntilDeadline = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (timeUntilDeadline <= std::chrono::milliseconds(0))
+            {
+                cq->readBatch(completions, completionBatchSize);
+                return std::nullopt;
+            }
+
+            auto const interval = std::min<std::chrono::milliseconds>(Endpoint::EQReadInterval, timeUntilDeadline);
+            if (cq->readBatchBlocking(completions, completionBatchSize, interval) > 0)
+            {
+                return std::nullopt;
+            }
+        }
+    }
+
+    SessionRails::SessionRails(std::vector<SessionResources> rails)
+        : _rails(std::move(rails))
+        , _next(0)
+    {}
+
+    SessionRails SessionRails::open(SessionConfig const& config, std::uint64_t caps)
+    {
+        auto rails = std::vector<SessionResources>{};
+        for (auto rail = std::size_t{0}; rail < config.rails.size(); ++rail)
+        {
+            rails.push_back(SessionResources::open(config, rail, caps));
+        }
+
+        return SessionRails{std::move(rails)};
+    }
+
+    std::size_t SessionRails::size() const noexcept
+    {
+        return _rails.size();
+    }
+
+    SessionResources& SessionRails::operator[](std::size_t rail) noexcept
+    {
+        return _rails[rail];
+    }
+
+    SessionResources const& SessionRails::operator[](std::size_t rail) const noexcept
+    {
+        return _rails[rail];
+    }
+
+    bool SessionRails::connectionless() const noexcept
+    {
+        return _rails.front().connectionless();
+    }
+
+    bool SessionRails::orderedWrites() const noexcept
+    {
+        return std::ranges::all_of(_rails, [](auto const& rail) { return rail.orderedWrites(); });
+    }
+
+    std::size_t SessionRails::readCompletions(std::vector<Completion>& completions)
+    {
+        auto count = std::size_t{0};
+        for (auto& rail : _rails)
+        {
+            count += rail.cq->readBatch(completions, rail.completionBatchSize);
+        }
+        return count;
+    }
+
+    std::optional<RailEvent> SessionRails::readQueues(std::vector<Completion>& completions)
+    {
+        readCompletions(completions);
+
+        for (auto i = std::size_t{0}; i < _rails.size(); ++i)
+        {
+            auto const rail = _next;
+            _next = (_next + 1U) % _rails.size();
+
+            if (auto event = _rails[rail].eq->read(); event)
+            {
+                return RailEvent{.rail = rail, .event = std::move(*event)};
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<RailEvent> SessionRails::readQueuesBlocking(std::vector<Completion>& completions, std::chrono::steady_clock::duration timeout)
+    {
+        if (_rails.size() == 1U)
+        {
+            if (auto event = _rails.front().readQueuesBlocking(completions, timeout); event)
+            {
+                return RailEvent{.rail = 0, .event = std::move(*event)};
+            }
+            return std::nullopt;
+        }
+
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        auto const read = completions.size();
+
+        for (;;)
+        {
+            if (auto event = readQueues(completions); event || (completions.size() > read))
+            {
+                return event;
+            }
+
+            auto const timeUntilDeadline = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (timeUntilDeadline <= std::chrono::milliseconds(0))
+            {
+                return std::nullopt;
+            }
+
+            auto& rail = _rails[_next];
+            _next = (_next + 1U) % _rails.size();
+            if (rail.cq->readBatchBlocking(completions, rail.completionBatchSize, std::min(MultiRailBlockInterval, timeUntilDeadline)) > 0)
+            {
+                return std::nullopt;
+            }
+        }
+    }
+}
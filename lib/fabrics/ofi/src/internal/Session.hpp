@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <mxl/fabrics.h>
+#include <rdma/fabric.h>
+#include "AddressVector.hpp"
+#include "Completion.hpp"
+#include "CompletionQueue.hpp"
+#include "Domain.hpp"
+#include "Event.hpp"
+#include "EventQueue.hpp"
+#include "Fabric.hpp"
+#include "FabricInfo.hpp"
+#include "Provider.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief Internal version of mxlSessionConfig.
+     */
+    struct SessionConfig
+    {
+    public:
+        /** \brief Convert between external and internal versions of this type
+         */
+        static SessionConfig fromAPI(mxlSessionConfig const& config);
+
+        /** \brief The configuration of the sessions behind the single-flow targets and initiators: connected, on a single rail, with the
+         * defaults of the provider and neither flow control nor supervision.
+         */
+        static SessionConfig singleFlow(mxlEndpointAddress const& address, mxlFabricsProvider provider, bool deviceSupport);
+
+    public:
+        /** \brief The bind address of the local endpoints of a rail.
+         */
+        struct Rail
+        {
+            std::optional<std::string> node;    /**< Bind address of the local endpoint. */
+            std::optional<std::string> service; /**< Bind service of the local endpoint. */
+        };
+
+        /** \brief How an initiator session recovers from the failure of its links, \see mxlLinkSupervisionConfig.
+         */
+        struct LinkSupervision
+        {
+            bool enabled;                                      /**< Re-establish the links that fail. */
+            std::chrono::steady_clock::duration retryInterval; /**< Between two recovery attempts or liveness checks of a link. */
+            std::uint32_t catchUpGrains;                       /**< Newest grains of each flow written again once a link is restored. */
+        };
+
+    public:
+        std::vector<Rail> rails;         /**< One entry per rail, at least one. */
+        Provider provider;               /**< The provider that should be used. */
+        bool deviceSupport;              /**< Require support of transfers involving device memory. */
+        CompletionQueue::Attributes cq;  /**< Attributes of the completion queue of every rail. */
+        std::size_t completionBatchSize; /**< Maximum number of completions read from a queue at once. */
+        ::fi_ep_type endpointType;       /**< FI_EP_MSG for connected endpoints, FI_EP_RDM for a connectionless endpoint. */
+        std::uint32_t creditWindow;      /**< How many grains an initiator may run ahead of the released grains. 0 disables flow control. */
+        LinkSupervision supervision;     /**< Supervision of the links of an initiator session. */
+    };
+
+    /** \brief The libfabric resources of a rail of a multi-flow session.
+     *
+     * All the endpoints of a rail are created in the same domain and share the same event and completion queues, so that the cost of
+     * polling a session doesn't depend on the number of flows it carries. Connectionless sessions also get an address vector, which holds
+     * the addresses of their peers.
+     */
+    struct SessionResources
+    {
+    public:
+        /** \brief Select a provider configuration matching the configuration of a rail of the session and the requested capabilities, and
+         * open the fabric, domain and queues of the rail.
+         */
+        static SessionResources open(SessionConfig const& config, std::size_t rail, std::uint64_t caps);
+
+        /** \brief Do a non-blocking read of the event queue and of up to completionBatchSize entries of the completion queue.
+         *
+         * The completions are appended to `completions`.
+         */
+        std::optional<Event> readQueues(std::vector<Completion>& completions);
+
+        /** \brief Do a combined blocking read of both the event and completion queues.
+         *
+         * Like Endpoint::readQueuesBlocking(), the event queue is read in an interval of Endpoint::EQReadInterval, and the thread blocks on
+         * the completion queue the rest of the time. Returns as soon as an event or at least one completion is available.
+         */
+        std::optional<Event> readQueuesBlocking(std::vector<Completion>& completions, std::chrono::steady_clock::duration timeout);
+
+    public:
+        FabricInfo info;
+        std::shared_ptr<Fabric> fabric;
+        std::shared_ptr<Domain> domain;
+        std::shared_ptr<EventQueue> eq;
+        std::shared_ptr<CompletionQueue> cq;
+        std::shared_ptr<AddressVector> av; /**< Only opened for connectionless sessions. */
+        std::size_t completionBatchSize;
+
+        /** \brief Whether the session uses a single connectionless endpoint rather than one connected endpoint per peer.
+         */
+        [[nodiscard]]
+        bool connectionless() const noexcept;
+
+        /** \brief Whether the provider places the writes of an endpoint in the order in which they were posted (FI_ORDER_WAW).
+         */
+        [[nodiscard]]
+        bool orderedWrites() const noexcept;
+    };
+
+    /** \brief An event read from the event queue of a rail.
+     */
+    struct RailEvent
+    {
+        std::size_t rail;
+        Event event;
+    };
+
+    /** \brief The rails of a multi-flow session.
+     *
+     * The grains of a session are striped across all its rails, which have independent resources so that they can use different NICs or
+     * provider instances. The queues of all rails are polled together.
+     */
+    class SessionRails
+    {
+    public:
+        /** \brief Open the resources of every rail of the session.
+         */
+        static SessionRails open(SessionConfig const& config, std::uint64_t caps);
+
+        /** \brief The number of rails.
+         */
+        [[nodiscard]]
+        std::size_t size() const noexcept;
+
+        /** \brief Access the resources of a rail.
+         */
+        SessionResources& operator[](std::size_t rail) noexcept;
+        /** \copydoc operator[]() */
+        SessionResources const& operator[](std::size_t rail) const noexcept;
+
+        /** \brief Whether the rails use connectionless endpoints.
+         */
+        [[nodiscard]]
+        bool connectionless() const noexcept;
+
+        /** \brief Whether every rail places the writes of an endpoint in order. \see SessionResources::orderedWrites()
+         */
+        [[nodiscard]]
+        bool orderedWrites() const noexcept;
+
+        /** \brief Do a non-blocking read of up to completionBatchSize entries of the completion queue of every rail.
+         *
+         * The completions are appended to `completions`. \return The number of completions read.
+         */
+        std::size_t readCompletions(std::vector<Completion>& completions);
+
+        /** \brief Do a non-blocking read of the completion queues of all rails, and of their event queues until an event is found.
+         */
+        std::optional<RailEvent> readQueues(std::vector<Completion>& completions);
+
+        /** \brief Do a blocking read of the queues of all rails. Returns as soon as an event or at least one completion is available.
+         *
+         * A single rail is read like SessionResources::readQueuesBlocking(). The thread can't block on the completion queues of several
+         * rails at once, so with more rails it blocks on one rail at a time, for at most MultiRailBlockInterval, after polling all of them.
+         */
+        std::optional<RailEvent> readQueuesBlocking(std::vector<Completion>& completions, std::chrono::steady_clock::duration timeout);
+
+    public:
+        /** \brief The longest a blocking read of several rails blocks on the completion queue of one of them.
+         */
+        constexpr static auto const MultiRailBlockInterval = std::chrono::milliseconds{1};
+
+    private:
+        explicit SessionRails(std::vector<SessionResources> rails);
+
+    private:
+        std::vector<SessionResources> _rails;
+        std::size_t _next; /**< The rail read first by the next read, so that all rails are served fairly. */
+    };
+}
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Stripe.hpp"
+#include <mxl-internal/Flow.hpp>
+#include <mxl-internal/Logging.hpp>
+#include "ImmediateData.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    // Grains are at least a header long, which guarantees that no stripe is empty.
+    static_assert(sizeof(GrainHeader) / MXL_FABRICS_SESSION_MAX_RAILS >= 2U * StripeAlignment);
+
+    bool sliceable(mxlGrainInfo const& header, std::size_t length, std::size_t rails) noexcept
+    {
+        auto const slices = std::size_t{header.totalSlices};
+        return (slices >= rails) && ((header.grainSize % slices) == 0U) && (MXL_GRAIN_PAYLOAD_OFFSET + std::size_t{header.grainSize} <= length);
+    }
+
+    StripeBounds stripeBounds(mxlGrainInfo const& header, std::size_t length, std::size_t rails) noexcept
+    {
+        auto bounds = StripeBounds{};
+        bounds[rails] = length;
+
+        auto const slices = std::size_t{header.totalSlices};
+        auto const bySlice = sliceable(header, length, rails);
+        for (auto rail = std::size_t{1}; rail < rails; ++rail)
+        {
+            bounds[rail] = bySlice ? MXL_GRAIN_PAYLOAD_OFFSET + (rail * slices / rails) * (header.grainSize / slices)
+                                   : (rail * length / rails) & ~(StripeAlignment - 1U);
+        }
+
+        return bounds;
+    }
+
+    StripeBounds burstBounds(mxlGrainInfo const& header, std::size_t length, std::size_t first, std::size_t last, std::size_t rails) noexcept
+    {
+        auto const sliceSize = std::size_t{header.grainSize / header.totalSlices};
+        auto bounds = StripeBounds{};
+        for (auto rail = std::size_t{0}; rail <= rails; ++rail)
+        {
+            bounds[rail] = MXL_GRAIN_PAYLOAD_OFFSET + (first + rail * (last - first) / rails) * sliceSize;
+        }
+        if (first == 0)
+        {
+            bounds[0] = 0;
+        }
+        if (last == header.totalSlices)
+        {
+            bounds[rails] = length;
+        }
+
+        return bounds;
+    }
+
+    StripeCounter::StripeCounter(std::size_t slots, std::size_t rails)
+        : _slots(slots, Slot{.position = 0, .count = 0})
+        , _rails(static_cast<std::uint32_t>(rails))
+    {}
+
+    bool StripeCounter::count(std::uint32_t position)
+    {
+        auto const slots = static_cast<std::uint32_t>(_slots.size());
+        auto& slot = _slots[position % slots];
+        if ((slot.count != 0) && (slot.position != position))
+        {
+            // Positions tell a few turns of the ring buffer apart, the grains of the previous half of them are older.
+            auto const turns = ImmediateData::turns(slots);
+            auto const behind = (slot.position / slots + turns - position / slots) % turns;
+            if (2U * behind < turns)
+            {
+                MXL_DEBUG("Dropping a late stripe of the grain at position {}, the slot holds the grain at position {}", position, slot.position);
+                return false;
+            }
+            MXL_DEBUG("The grain at position {} is incomplete, {} of its stripes arrived", slot.position, slot.count);
+            slot.count = 0;
+        }
+
+        slot.position = position;
+        if (++slot.count < _rails)
+        {
+            return false;
+        }
+        slot.count = 0;
+        return true;
+    }
+}
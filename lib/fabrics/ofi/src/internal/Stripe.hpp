@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <mxl/fabrics.h>
+#include <mxl/flow.h>
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief Alignment of the stripe boundaries of grains that aren't striped on slice boundaries. */
+    constexpr auto StripeAlignment = std::size_t{64};
+
+    /** \brief Offsets of the boundaries of the stripes of a grain, one stripe per rail of a session.
+     *
+     * The first offset is the start of the first stripe and the offset at the index of the number of rails is the end of the last one.
+     */
+    using StripeBounds = std::array<std::size_t, MXL_FABRICS_SESSION_MAX_RAILS + 1U>;
+
+    /** \brief Whether the first `length` bytes of a grain hold its whole payload, which can be divided in at least one slice per rail.
+     */
+    [[nodiscard]]
+    bool sliceable(mxlGrainInfo const& header, std::size_t length, std::size_t rails) noexcept;
+
+    /** \brief Split the first `length` bytes of a grain into one stripe per rail.
+     *
+     * Whenever the payload is transferred and can be divided in slices, the boundaries are slice boundaries, so that every rail carries
+     * whole slices. The first stripe also carries the header. Otherwise, e.g. for grains of which only the header is transferred, the
+     * bytes are split evenly on StripeAlignment boundaries. The first bound is always 0 and the last is `length`.
+     */
+    [[nodiscard]]
+    StripeBounds stripeBounds(mxlGrainInfo const& header, std::size_t length, std::size_t rails) noexcept;
+
+    /** \brief Split the slices [first, last) of a sliceable grain into one stripe per rail, every rail carrying whole slices.
+     *
+     * The first burst of a grain also carries its header, and the last one the bytes that follow the payload up to `length`.
+     */
+    [[nodiscard]]
+    StripeBounds burstBounds(mxlGrainInfo const& header, std::size_t length, std::size_t first, std::size_t last, std::size_t rails) noexcept;
+
+    /** \brief Counts the stripes received for the grains in the slots of a flow, and tells when a grain has one from every rail.
+     *
+     * The stripes of different rails complete in any order. The stripes of a grain whose initiator failed, or that were lost on the way,
+     * never all arrive: the first stripe of the next grain written to the slot replaces them, and the late stripes of older grains are
+     * dropped. Grains are told apart by their position (\see ImmediateData::positionOf()).
+     */
+    class StripeCounter
+    {
+    public:
+        StripeCounter(std::size_t slots, std::size_t rails);
+
+        /** \brief Count a stripe of the grain at `position`. \return true once the grain has a stripe from every rail.
+         */
+        bool count(std::uint32_t position);
+
+    private:
+        /** \brief The stripes received for the grain in a slot.
+         */
+        struct Slot
+        {
+            std::uint32_t position; /**< The position of the grain. */
+            std::uint32_t count;    /**< The number of stripes of the grain received so far. */
+        };
+
+    private:
+        std::vector<Slot> _slots;
+        std::uint32_t _rails;
+    };
+}
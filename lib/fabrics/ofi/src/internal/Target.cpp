@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Target.hpp"
+#include "Exception.hpp"
+#include "Region.hpp"
+#include "Session.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    Target* Target::fromAPI(mxlFabricsTarget target) noexcept
+    {
+        return reinterpret_cast<Target*>(target);
+    }
+
+    mxlFabricsTarget Target::toAPI() noexcept
+    {
+        return reinterpret_cast<mxlFabricsTarget>(this);
+    }
+
+    TargetInfo Target::setup(mxlTargetConfig const& config)
+    {
+        if (_session)
+        {
+            throw Exception::invalidState("The target is already set up");
+        }
+        if (config.regions == nullptr)
+        {
+            throw Exception::invalidArgument("The target has no regions to receive the flow in");
+        }
+
+        auto session = std::make_unique<TargetSession>(SessionConfig::singleFlow(config.endpointAddress, config.provider, config.deviceSupport));
+        session->addFlow(*MxlRegions::fromAPI(config.regions));
+        _session = std::move(session);
+        return _session->info();
+    }
+
+    std::optional<std::uint64_t> Target::tryNewGrain()
+    {
+        if (auto const grain = session().tryNewGrain(); grain)
+        {
+            return grain->index;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::uint64_t> Target::waitForNewGrain(std::chrono::steady_clock::duration timeout)
+    {
+        if (auto const grain = session().waitForNewGrain(timeout); grain)
+        {
+            return grain->index;
+        }
+        return std::nullopt;
+    }
+
+    TargetSession& Target::session()
+    {
+        if (!_session)
+        {
+            throw Exception::invalidState("The target is not set up");
+        }
+        return *_session;
+    }
+}
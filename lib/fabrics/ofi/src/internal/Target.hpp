@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <mxl/fabrics.h>
+#include "TargetInfo.hpp"
+#include "TargetSession.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief The receiving side of a single flow.
+     *
+     * Once set up, the target is a target session on a single rail that carries only its flow. This is the internal structure representing
+     * the mxlFabricsTarget API type.
+     */
+    class Target
+    {
+    public:
+        Target() = default;
+
+        // No copying, no moving, the API handle is the address of the target.
+        Target(Target const&) = delete;
+        void operator=(Target const&) = delete;
+
+        /** \brief Convert between external and internal versions of this type
+         */
+        static Target* fromAPI(mxlFabricsTarget) noexcept;
+        /** \copydoc fromAPI() */
+        [[nodiscard]]
+        mxlFabricsTarget toAPI() noexcept;
+
+        /** \brief Open the session of the target and add the flow to it. Throws an MXL_ERR_INVALID_STATE exception if the target was
+         * already set up.
+         *
+         * \return The target info initiators write the grains of the flow with.
+         */
+        TargetInfo setup(mxlTargetConfig const& config);
+
+        /** \brief Accept pending connections and return the index of the next grain written by an initiator, if any.
+         */
+        std::optional<std::uint64_t> tryNewGrain();
+
+        /** \brief Accept pending connections and wait for the next grain written by an initiator.
+         */
+        std::optional<std::uint64_t> waitForNewGrain(std::chrono::steady_clock::duration timeout);
+
+    private:
+        /** \brief The session of the target. Throws an MXL_ERR_INVALID_STATE exception if the target was not set up yet.
+         */
+        TargetSession& session();
+
+    private:
+        std::unique_ptr<TargetSession> _session;
+    };
+}
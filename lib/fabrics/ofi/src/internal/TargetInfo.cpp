@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TargetInfo.hpp"
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <picojson/picojson.h>
+#include "Exception.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    namespace
+    {
+        // 64 bit addresses and keys don't survive the conversion to a JSON number, so they are carried as strings.
+        picojson::value toJson(std::uint64_t value)
+        {
+            return picojson::value{std::to_string(value)};
+        }
+
+        template<typename T>
+        T const& fetch(picojson::object const& object, std::string const& field)
+        {
+            auto const it = object.find(field);
+            if ((it == object.end()) || !it->second.is<T>())
+            {
+                throw Exception::invalidArgument("Malformed target info: missing or invalid field '{}'", field);
+            }
+            return it->second.get<T>();
+        }
+
+        std::uint64_t fetchU64(picojson::object const& object, std::string const& field)
+        {
+            auto const& value = fetch<std::string>(object, field);
+            try
+            {
+                return std::stoull(value);
+            }
+            catch (std::exception const&)
+            {
+                throw Exception::invalidArgument("Malformed target info: invalid value '{}' for field '{}'", value, field);
+            }
+        }
+
+        picojson::value toJson(RemoteRegion const& region)
+        {
+            auto object = picojson::object{};
+            object["addr"] = toJson(region.addr);
+            object["len"] = toJson(region.len);
+            object["rkey"] = toJson(region.rkey);
+            return picojson::value{object};
+        }
+
+        RemoteRegion fromJson(picojson::object const& object)
+        {
+            return RemoteRegion{
+                .addr = fetchU64(object, "addr"),
+                .len = static_cast<std::size_t>(fetchU64(object, "len")),
+                .rkey = fetchU64(object, "rkey"),
+            };
+        }
+    }
+
+    TargetInfo::TargetInfo(std::vector<FabricAddress> addresses, std::vector<Flow> flows, std::optional<RemoteRegion> credits,
+        std::uint64_t instance)
+        : _addresses(std::move(addresses))
+        , _flows(std::move(flows))
+        , _credits(credits)
+        , _instance(instance)
+    {}
+
+    TargetInfo* TargetInfo::fromAPI(mxlTargetInfo info) noexcept
+    {
+        return reinterpret_cast<TargetInfo*>(info);
+    }
+
+    mxlTargetInfo TargetInfo::toAPI() noexcept
+    {
+        return reinterpret_cast<mxlTargetInfo>(this);
+    }
+
+    std::string TargetInfo::toString() const
+    {
+        auto flows = picojson::array{};
+        for (auto const& flow : _flows)
+        {
+            auto rails = picojson::array{};
+            for (auto const& railRegions : flow.regions)
+            {
+                auto regions = picojson::array{};
+                for (auto const& region : railRegions)
+                {
+                    regions.emplace_back(toJson(region));
+                }
+                rails.emplace_back(regions);
+            }
+
+            auto entry = picojson::object{};
+            entry["id"] = picojson::value{static_cast<double>(flow.id)};
+            entry["regions"] = picojson::value{rails};
+            if (flow.header)
+            {
+                entry["header"] = toJson(*flow.header);
+            }
+            flows.emplace_back(entry);
+        }
+
+        auto addresses = picojson::array{};
+        for (auto const& address : _addresses)
+        {
+            addresses.emplace_back(address.toBase64());
+        }
+
+        auto root = picojson::object{};
+        root["addresses"] = picojson::value{addresses};
+        root["flows"] = picojson::value{flows};
+        if (_credits)
+        {
+            root["credits"] = toJson(*_credits);
+        }
+        if (_instance != 0)
+        {
+            root["instance"] = toJson(_instance);
+        }
+        return picojson::value{root}.serialize();
+    }
+
+    TargetInfo TargetInfo::fromString(std::string_view s)
+    {
+        auto json = picojson::value{};
+        if (auto const err = picojson::parse(json, std::string{s}); !err.empty())
+        {
+            throw Exception::invalidArgument("Malformed target info: {}", err);
+        }
+        if (!json.is<picojson::object>())
+        {
+            throw Exception::invalidArgument("Malformed target info: not a JSON object");
+        }
+
+        auto const& root = json.get<picojson::object>();
+        auto flows = std::vector<Flow>{};
+        for (auto const& flowValue : fetch<picojson::array>(root, "flows"))
+        {
+            if (!flowValue.is<picojson::object>())
+            {
+                throw Exception::invalidArgument("Malformed target info: invalid flow entry");
+            }
+
+            auto const& flowObject = flowValue.get<picojson::object>();
+            auto flow = Flow{.id = static_cast<std::uint32_t>(fetch<double>(flowObject, "id")), .regions = {}, .header = std::nullopt};
+            for (auto const& railValue : fetch<picojson::array>(flowObject, "regions"))
+            {
+                if (!railValue.is<picojson::array>())
+                {
+                    throw Exception::invalidArgument("Malformed target info: invalid rail entry");
+                }
+
+                auto& railRegions = flow.regions.emplace_back();
+                for (auto const& regionValue : railValue.get<picojson::array>())
+                {
+                    if (!regionValue.is<picojson::object>())
+                    {
+                        throw Exception::invalidArgument("Malformed target info: invalid region entry");
+                    }
+
+                    railRegions.push_back(fromJson(regionValue.get<picojson::object>()));
+                }
+            }
+            if (flowObject.contains("header"))
+            {
+                flow.header = fromJson(fetch<picojson::object>(flowObject, "header"));
+            }
+            flows.push_back(std::move(flow));
+        }
+
+        auto addresses = std::vector<FabricAddress>{};
+        for (auto const& addressValue : fetch<picojson::array>(root, "addresses"))
+        {
+            if (!addressValue.is<std::string>())
+            {
+                throw Exception::invalidArgument("Malformed target info: invalid address entry");
+            }
+            addresses.push_back(FabricAddress::fromBase64(addressValue.get<std::string>()));
+        }
+        if (addresses.empty())
+        {
+            throw Exception::invalidArgument("Malformed target info: no address");
+        }
+        if (std::ranges::any_of(flows, [&](Flow const& flow) { return flow.regions.size() != addresses.size(); }))
+        {
+            throw Exception::invalidArgument("Malformed target info: the flows don't have regions for every rail");
+        }
+
+        // Credits are optional, initiators without flow control don't need them.
+        auto credits = std::optional<RemoteRegion>{};
+        if (root.contains("credits"))
+        {
+            credits = fromJson(fetch<picojson::object>(root, "credits"));
+        }
+
+        // Without an instance id, initiators can't validate the regions after their link to the session was restored.
+        auto const instance = root.contains("instance") ? fetchU64(root, "instance") : std::uint64_t{0};
+
+        return {std::move(addresses), std::move(flows), credits, instance};
+    }
+
+    std::vector<FabricAddress> const& TargetInfo::addresses() const noexcept
+    {
+        return _addresses;
+    }
+
+    std::vector<TargetInfo::Flow> const& TargetInfo::flows() const noexcept
+    {
+        return _flows;
+    }
+
+    TargetInfo::Flow const& TargetInfo::flow(std::uint32_t id) const
+    {
+        auto const it = std::ranges::find(_flows, id, &Flow::id);
+        if (it == _flows.end())
+        {
+            throw Exception::notFound("Flow {} is not part of the target info", id);
+        }
+        return *it;
+    }
+
+    std::optional<RemoteRegion> const& TargetInfo::credits() const noexcept
+    {
+        return _credits;
+    }
+
+    std::uint64_t TargetInfo::instance() const noexcept
+    {
+        return _instance;
+    }
+}
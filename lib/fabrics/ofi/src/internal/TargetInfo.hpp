@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mxl/fabrics.h>
+#include "Address.hpp"
+#include "RemoteRegion.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief Everything an initiator needs to write to the flows of a target session.
+     *
+     * This is the internal structure representing the mxlTargetInfo API type. It holds the fabric address the initiator connects to on
+     * every rail of the session, the table of remote regions of every flow of the session, one region per rail and grain, and the remote
+     * region of the credits of the session along with the instance id that lets initiators check that the regions are still valid. The
+     * flows that consumers pull also carry the remote region of their flow header.
+     */
+    class TargetInfo
+    {
+    public:
+        /** \brief The remote regions of one flow of a session.
+         */
+        struct Flow
+        {
+        public:
+            std::uint32_t id;                               /**< Id of the flow in the session. */
+            std::vector<std::vector<RemoteRegion>> regions; /**< Per rail, remote region of every grain of the flow in ring buffer order. */
+            std::optional<RemoteRegion> header;             /**< On the first rail, the remote region of the mxlFlowInfo of a flow that
+                                                                 consumers pull, which holds its head index. */
+        };
+
+    public:
+        TargetInfo(std::vector<FabricAddress> addresses, std::vector<Flow> flows, std::optional<RemoteRegion> credits, std::uint64_t instance);
+
+        /** \brief Convert between external and internal versions of this type
+         */
+        static TargetInfo* fromAPI(mxlTargetInfo) noexcept;
+        /** \copydoc fromAPI() */
+        [[nodiscard]]
+        mxlTargetInfo toAPI() noexcept;
+
+        /** \brief Serialize to a JSON string that can be shared with initiators.
+         */
+        [[nodiscard]]
+        std::string toString() const;
+
+        /** \brief Parse the string representation produced by toString().
+         */
+        static TargetInfo fromString(std::string_view s);
+
+        /** \brief The address of the endpoint that initiators connect to, per rail.
+         */
+        [[nodiscard]]
+        std::vector<FabricAddress> const& addresses() const noexcept;
+
+        /** \brief The flows of the session at the time the info was obtained.
+         */
+        [[nodiscard]]
+        std::vector<Flow> const& flows() const noexcept;
+
+        /** \brief Find a flow by id. Throws an MXL_ERR_NOT_FOUND exception if the session had no such flow.
+         */
+        [[nodiscard]]
+        Flow const& flow(std::uint32_t id) const;
+
+        /** \brief The remote region of the credits of the session on its first rail, an array of one 64 bit word per flow id holding the
+         * index following the last grain released by the consumers of the flow, or 0 if they didn't release any. The word following the
+         * last flow id holds the instance id of the session.
+         */
+        [[nodiscard]]
+        std::optional<RemoteRegion> const& credits() const noexcept;
+
+        /** \brief The random id the session drew when it was created, or 0 if the info doesn't carry it. A session that was restarted has a
+         * new id, and new remote keys.
+         */
+        [[nodiscard]]
+        std::uint64_t instance() const noexcept;
+
+    private:
+        std::vector<FabricAddress> _addresses;
+        std::vector<Flow> _flows;
+        std::optional<RemoteRegion> _credits;
+        std::uint64_t _instance;
+    };
+}
@@ -0,0 +1,362 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TargetSession.hpp"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <utility>
+#include <mxl-internal/Flow.hpp>
+#include <mxl-internal/Logging.hpp>
+#include <rdma/fabric.h>
+#include "Exception.hpp"
+#include "ImmediateData.hpp"
+#include "MemoryRegion.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    static_assert(ImmediateData::MaxFlows == MXL_FABRICS_SESSION_MAX_FLOWS);
+
+    namespace
+    {
+        /** Draw the instance id of a session. It is never 0, which stands for an unknown instance. */
+        std::uint64_t drawInstance()
+        {
+            auto device = std::random_device{};
+            auto const instance = (std::uint64_t{device()} << 32U) | device();
+            return (instance != 0U) ? instance : 1U;
+        }
+    }
+
+    TargetSession::TargetSession(SessionConfig const& config)
+        : _rails(SessionRails::open(config, FI_RMA | FI_REMOTE_WRITE | FI_REMOTE_READ))
+        , _credits(ImmediateData::MaxFlows + 1U, 0)
+    {
+        // Initiators with flow control read the credits of the flows they write to, and supervising initiators read the instance id
+        // that follows them. The session doesn't take part in the reads.
+        _credits.back() = drawInstance();
+        auto const credits = Region{reinterpret_cast<std::uintptr_t>(_credits.data()), _credits.size() * sizeof(std::uint64_t)};
+        _creditRegion.emplace(MemoryRegion::reg(*_rails[0].domain, credits, FI_REMOTE_READ), credits);
+
+        for (auto rail = std::size_t{0}; rail < _rails.size(); ++rail)
+        {
+            auto& resources = _rails[rail];
+            if (resources.connectionless())
+            {
+                // Initiators write to the endpoint without connecting, the address vector is only bound because reliable datagram endpoints
+                // require one.
+                auto endpoint = Endpoint::create(resources.domain, resources.info.view());
+                endpoint.bind(resources.cq, FI_TRANSMIT | FI_RECV);
+                endpoint.bind(resources.av);
+                endpoint.enable();
+                _endpoints.push_back(std::move(endpoint));
+            }
+            else
+            {
+                auto listener = PassiveEndpoint::create(resources.fabric, resources.info.view());
+                listener.bind(resources.eq);
+                listener.listen();
+                _listeners.push_back(std::move(listener));
+            }
+        }
+    }
+
+    TargetSession* TargetSession::fromAPI(mxlFabricsTargetSession session) noexcept
+    {
+        return reinterpret_cast<TargetSession*>(session);
+    }
+
+    mxlFabricsTargetSession TargetSession::toAPI() noexcept
+    {
+        return reinterpret_cast<mxlFabricsTargetSession>(this);
+    }
+
+    std::uint32_t TargetSession::addFlow(MxlRegions const& regions)
+    {
+        return addFlow(regions, FI_REMOTE_WRITE, std::nullopt);
+    }
+
+    std::uint32_t TargetSession::addPullFlow(FlowData& flow)
+    {
+        auto const* info = flow.flowInfo();
+        if (!mxlIsDiscreteDataFormat(info->config.common.format))
+        {
+            throw Exception::invalidArgument("Only discrete flows can be pulled");
+        }
+
+        // Consumers read the head index from the header of the flow and the grains they want from its ring, nothing is written remotely.
+        return addFlow(mxlRegionsFromFlow(flow), FI_REMOTE_READ, Region{reinterpret_cast<std::uintptr_t>(info), sizeof(mxlFlowInfo)});
+    }
+
+    std::uint32_t TargetSession::addFlow(MxlRegions const& regions, std::uint64_t access, std::optional<Region> header)
+    {
+        auto const& grains = regions.regions();
+        if (grains.empty() || (grains.size() > ImmediateData::MaxSlots))
+        {
+            throw Exception::invalidArgument("A session flow must have between 1 and {} grains, got {}", ImmediateData::MaxSlots, grains.size());
+        }
+        if (std::ranges::any_of(grains, [](Region const& region) { return region.size < sizeof(GrainHeader); }))
+        {
+            throw Exception::invalidArgument("The regions of a session flow must start with a grain header");
+        }
+
+        auto slot = std::ranges::find_if(_flows, [](auto const& flow) { return !flow.has_value(); });
+        if (slot == _flows.end())
+        {
+            if (_flows.size() == ImmediateData::MaxFlows)
+            {
+                throw Exception::exists("The session already carries {} flows", ImmediateData::MaxFlows);
+            }
+            slot = _flows.emplace(_flows.end());
+        }
+
+        // Every rail has its own domain, in which the regions are registered separately.
+        auto flow = Flow{
+            .regions = std::vector<std::vector<RegisteredRegion>>(_rails.size()),
+            .stripes = StripeCounter{grains.size(), _rails.size()},
+            .header = std::nullopt,
+        };
+        for (auto rail = std::size_t{0}; rail < _rails.size(); ++rail)
+        {
+            for (auto const& grain : grains)
+            {
+                flow.regions[rail].emplace_back(MemoryRegion::reg(*_rails[rail].domain, grain, access), grain);
+            }
+        }
+        if (header)
+        {
+            flow.header.emplace(MemoryRegion::reg(*_rails[0].domain, *header, FI_REMOTE_READ), *header);
+        }
+        *slot = std::move(flow);
+
+        auto const flowId = static_cast<std::uint32_t>(slot - _flows.begin());
+        std::atomic_ref{_credits[flowId]}.store(0, std::memory_order_release);
+        MXL_INFO("Added flow {} with {} grains to the target session", flowId, grains.size());
+        return flowId;
+    }
+
+    void TargetSession::removeFlow(std::uint32_t flowId)
+    {
+        if ((flowId >= _flows.size()) || !_flows[flowId])
+        {
+            throw Exception::notFound("Flow {} is not part of the session", flowId);
+        }
+
+        _flows[flowId].reset();
+        std::atomic_ref{_credits[flowId]}.store(0, std::memory_order_release);
+        MXL_INFO("Removed flow {} from the target session", flowId);
+    }
+
+    void TargetSession::releaseGrains(std::uint32_t flowId, std::uint64_t index)
+    {
+        if ((flowId >= _flows.size()) || !_flows[flowId])
+        {
+            throw Exception::notFound("Flow {} is not part of the session", flowId);
+        }
+
+        // The word is read by the NICs of the initiators at any time, it must never be torn or go backwards.
+        auto credit = std::atomic_ref{_credits[flowId]};
+        if (index + 1U > credit.load(std::memory_order_relaxed))
+        {
+            credit.store(index + 1U, std::memory_order_release);
+        }
+    }
+
+    TargetInfo TargetSession::info() const
+    {
+        auto flows = std::vector<TargetInfo::Flow>{};
+        for (auto flowId = std::size_t{0}; flowId < _flows.size(); ++flowId)
+        {
+            if (_flows[flowId])
+            {
+                auto const& header = _flows[flowId]->header;
+                auto& flow = flows.emplace_back(TargetInfo::Flow{
+                    .id = static_cast<std::uint32_t>(flowId),
+                    .regions = {},
+                    .header = header ? std::optional{header->toRemote(_rails[0].domain->usingVirtualAddresses())} : std::nullopt,
+                });
+                for (auto rail = std::size_t{0}; rail < _rails.size(); ++rail)
+                {
+                    flow.regions.push_back(toRemote(_flows[flowId]->regions[rail], _rails[rail].domain->usingVirtualAddresses()));
+                }
+            }
+        }
+
+        auto addresses = std::vector<FabricAddress>{};
+        for (auto const& listener : _listeners)
+        {
+            addresses.push_back(listener.localAddress());
+        }
+        for (auto const& endpoint : _endpoints)
+        {
+            addresses.push_back(endpoint.localAddress());
+        }
+
+        return {std::move(addresses), std::move(flows), _creditRegion->toRemote(_rails[0].domain->usingVirtualAddresses()), _credits.back()};
+    }
+
+    mxlFabricsLinkStats TargetSession::stats() const noexcept
+    {
+        auto values = _stats.values();
+        values.inFlight = static_cast<std::uint32_t>(_grains.size());
+        return values;
+    }
+
+    std::optional<mxlSessionGrain> TargetSession::tryNewGrain()
+    {
+        if (auto grain = nextGrain(); grain)
+        {
+            return grain;
+        }
+
+        return handleQueues(_rails.readQueues(_completions));
+    }
+
+    std::optional<mxlSessionGrain> TargetSession::waitForNewGrain(std::chrono::steady_clock::duration timeout)
+    {
+        if (auto grain = nextGrain(); grain)
+        {
+            return grain;
+        }
+
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+
+        // Connection management events don't end the wait, only grains do.
+        for (auto now = std::chrono::steady_clock::now(); now < deadline; now = std::chrono::steady_clock::now())
+        {
+            if (auto grain = handleQueues(_rails.readQueuesBlocking(_completions, deadline - now)); grain)
+            {
+                return grain;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<mxlSessionGrain> TargetSession::handleQueues(std::optional<RailEvent> event)
+    {
+        if (event)
+        {
+            handleEvent(*event);
+        }
+
+        for (auto const& completion : _completions)
+        {
+            if (auto grain = handleCompletion(completion); grain)
+            {
+                _grains.push_back(*grain);
+            }
+        }
+        _completions.clear();
+        _stats.inFlight(_grains.size());
+
+        return nextGrain();
+    }
+
+    std::optional<mxlSessionGrain> TargetSession::nextGrain()
+    {
+        if (_grains.empty())
+        {
+            return std::nullopt;
+        }
+
+        auto const grain = _grains.front();
+        _grains.pop_front();
+        return grain;
+    }
+
+    void TargetSession::handleEvent(RailEvent& railEvent)
+    {
+        auto& event = railEvent.event;
+        if (event.isConnReq())
+        {
+            // The connection is accepted in the domain of the rail it was requested on.
+            auto& resources = _rails[railEvent.rail];
+            auto endpoint = Endpoint::create(resources.domain, event.connReq().info());
+            endpoint.bind(resources.eq);
+            endpoint.bind(resources.cq, FI_TRANSMIT | FI_RECV);
+            endpoint.enable();
+            endpoint.accept();
+
+            auto const id = endpoint.id();
+            _connections.emplace(id, std::move(endpoint));
+            MXL_INFO("Accepted connection {} of an initiator session on rail {}", id, railEvent.rail);
+        }
+        else if (event.isConnected())
+        {
+            MXL_INFO("Connection {} established", Endpoint::idFromFID(event.fid()));
+        }
+        else if (event.isShutdown())
+        {
+            auto const id = Endpoint::idFromFID(event.fid());
+            MXL_INFO("Connection {} was shut down by the initiator", id);
+            dropConnection(id);
+        }
+        else if (event.isError())
+        {
+            MXL_ERROR("Error event on the target session: {}", event.err().toString());
+
+            // The fid of an error event can be a listener, which is not one of the connections.
+            if (std::ranges::none_of(_listeners, [&](PassiveEndpoint const& listener) { return event.fid() == &listener.raw()->fid; }))
+            {
+                dropConnection(Endpoint::idFromFID(event.fid()));
+            }
+        }
+    }
+
+    void TargetSession::dropConnection(Endpoint::Id id)
+    {
+        if (_connections.erase(id) == 0)
+        {
+            return;
+        }
+        _stats.linkFailed();
+
+        // The stripes the initiator delivered before its link failed are left counted. The completions don't tell which initiator wrote
+        // them, but they tell which grain they belong to, and the next grain written to the same slot starts counting anew.
+    }
+
+    std::optional<mxlSessionGrain> TargetSession::handleCompletion(Completion const& completion)
+    {
+        if (auto error = completion.tryErr(); error)
+        {
+            MXL_ERROR("Error completion on the target session: {}", error->toString());
+            _stats.failed(error->code(), false);
+            return std::nullopt;
+        }
+
+        auto const data = completion.data().data();
+        if (!data)
+        {
+            return std::nullopt;
+        }
+        _stats.received(completion.data().length());
+
+        auto const id = ImmediateData::decode(*data);
+        auto const known = (id.flowId < _flows.size()) && _flows[id.flowId];
+        auto const slots = known ? static_cast<std::uint32_t>(_flows[id.flowId]->regions.front().size()) : 0U;
+        if (!known || (id.position >= slots * ImmediateData::turns(slots)))
+        {
+            // The flow was removed while the write was in flight.
+            MXL_DEBUG("Dropping a grain written to unknown flow {} position {}", id.flowId, id.position);
+            return std::nullopt;
+        }
+
+        // Every rail carries one stripe of the grain, the grain is only complete once all of them arrived.
+        auto& flow = *_flows[id.flowId];
+        if (!flow.stripes.count(id.position))
+        {
+            return std::nullopt;
+        }
+        _stats.grain();
+
+        // The header of the grain was written together with the first stripe of its payload.
+        auto const* header = reinterpret_cast<mxlGrainInfo const*>(flow.regions.front()[id.position % slots].toLocal().addr);
+        return mxlSessionGrain{
+            .flowId = static_cast<std::uint16_t>(id.flowId),
+            .validSlices = (id.slices == ImmediateData::SlicesFromHeader) ? header->validSlices : static_cast<std::uint16_t>(id.slices),
+            .index = header->index,
+        };
+    }
+}
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <vector>
+#include <mxl/fabrics.h>
+#include "Completion.hpp"
+#include "Endpoint.hpp"
+#include "Event.hpp"
+#include "LinkStats.hpp"
+#include "PassiveEndpoint.hpp"
+#include "Region.hpp"
+#include "RegisteredRegion.hpp"
+#include "Session.hpp"
+#include "Stripe.hpp"
+#include "TargetInfo.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief The receiving side of a multi-flow session.
+     *
+     * The session listens on a passive endpoint and accepts one connection per initiator session. All connections share the completion queue
+     * of the session, and every grain written by an initiator is identified by the remote completion data of its write (\see ImmediateData).
+     * A connectionless session has a single reliable datagram endpoint instead, which initiators write to without connecting. A session
+     * with several rails has endpoints on every rail, and reports a grain once one stripe of it was written on each rail. Initiators whose
+     * connection failed can connect again at any time. The session can also expose flows that consumers pull: their ring and flow header
+     * are registered for remote reads only, and consumers read the head index and the grains they want themselves. The transfers the session
+     * receives are counted. This is the internal structure representing the mxlFabricsTargetSession API type.
+     */
+    class TargetSession
+    {
+    public:
+        /** \brief Open the resources of the session and start listening for connections.
+         */
+        explicit TargetSession(SessionConfig const& config);
+
+        // No copying, no moving, the API handle is the address of the session.
+        TargetSession(TargetSession const&) = delete;
+        void operator=(TargetSession const&) = delete;
+
+        /** \brief Convert between external and internal versions of this type
+         */
+        static TargetSession* fromAPI(mxlFabricsTargetSession) noexcept;
+        /** \copydoc fromAPI() */
+        [[nodiscard]]
+        mxlFabricsTargetSession toAPI() noexcept;
+
+        /** \brief Register the regions of a flow and return the id of the flow in the session.
+         */
+        std::uint32_t addFlow(MxlRegions const& regions);
+
+        /** \brief Register the grains and the header of a discrete flow for remote reads, and return the id of the flow in the session.
+         */
+        std::uint32_t addPullFlow(FlowData& flow);
+
+        /** \brief Deregister the regions of a flow.
+         */
+        void removeFlow(std::uint32_t flowId);
+
+        /** \brief Advertise that the consumers of a flow are done with its grains up to and including `index`.
+         */
+        void releaseGrains(std::uint32_t flowId, std::uint64_t index);
+
+        /** \brief Get the address of the session and the remote regions of all its flows.
+         */
+        [[nodiscard]]
+        TargetInfo info() const;
+
+        /** \brief The counters of all the transfers the session received.
+         */
+        [[nodiscard]]
+        mxlFabricsLinkStats stats() const noexcept;
+
+        /** \brief Accept pending connections and return the next grain written by an initiator, if any.
+         */
+        std::optional<mxlSessionGrain> tryNewGrain();
+
+        /** \brief Accept pending connections and wait for the next grain written by an initiator.
+         */
+        std::optional<mxlSessionGrain> waitForNewGrain(std::chrono::steady_clock::duration timeout);
+
+    private:
+        /** \brief A flow of the session.
+         */
+        struct Flow
+        {
+            std::vector<std::vector<RegisteredRegion>> regions; /**< Per rail, one region per grain in ring buffer order. */
+            StripeCounter stripes;                              /**< The stripes received so far. */
+            std::optional<RegisteredRegion> header;             /**< The mxlFlowInfo of a pulled flow, registered on the first rail. */
+        };
+
+        /** \brief Register the regions of a flow with the given remote access, and its header if it has one.
+         */
+        std::uint32_t addFlow(MxlRegions const& regions, std::uint64_t access, std::optional<Region> header);
+
+        /** \brief Handle the entries read from the queues of the session, and return the next received grain, if any.
+         *
+         * A batch of completions can carry more than one grain, the grains that are not returned are kept for the next calls.
+         */
+        std::optional<mxlSessionGrain> handleQueues(std::optional<RailEvent> event);
+
+        /** \brief Return the oldest received grain that was not returned yet, if any.
+         */
+        std::optional<mxlSessionGrain> nextGrain();
+
+        void handleEvent(RailEvent& railEvent);
+
+        /** \brief Forget a connection that was shut down or failed. The initiator may reconnect, with a new connection.
+         */
+        void dropConnection(Endpoint::Id id);
+
+        std::optional<mxlSessionGrain> handleCompletion(Completion const& completion);
+
+    private:
+        SessionRails _rails;
+        std::vector<PassiveEndpoint> _listeners; /**< One per rail, connected sessions only. */
+        std::vector<Endpoint> _endpoints;        /**< One per rail, connectionless sessions only. */
+
+        std::map<Endpoint::Id, Endpoint> _connections; /**< One connection per initiator session and rail. */
+        std::vector<std::optional<Flow>> _flows;       /**< Indexed by flow id. Ids of removed flows are reused. */
+
+        std::vector<std::uint64_t> _credits;           /**< Per flow id, the index following the last released grain, then the instance id
+                                                            of the session. Never resized. */
+        std::optional<RegisteredRegion> _creditRegion; /**< _credits, registered for remote reads on the first rail. */
+
+        std::vector<Completion> _completions; /**< Completions of the last read, kept to avoid allocations. */
+        std::deque<mxlSessionGrain> _grains;  /**< Grains received but not returned yet. */
+        LinkStats _stats;                     /**< The counters of the transfers received from all the initiators. */
+    };
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TimerWheel.hpp"
+#include <algorithm>
+#include "Exception.hpp"
+
+namespace mxl::lib::fabrics::ofi
+{
+    namespace
+    {
+        /** The tick of a wheel, validated before the current tick is derived from it. */
+        std::uint64_t validTick(std::uint64_t tick, std::size_t slots)
+        {
+            if ((tick == 0) || (slots == 0))
+            {
+                throw Exception::invalidArgument("A timer wheel must have a non-zero tick and at least one slot");
+            }
+            return tick;
+        }
+    }
+
+    TimerWheel::TimerWheel(std::uint64_t tick, std::size_t slots, std::uint64_t now)
+        : _tick(validTick(tick, slots))
+        , _slots(slots)
+        , _current(now / tick)
+        , _size(0)
+    {}
+
+    void TimerWheel::schedule(std::uint64_t due, std::uint64_t id)
+    {
+        // The ticks up to the current one were already processed, a timer that is due expires on the next one.
+        auto const tick = std::max(due / _tick, _current + 1U);
+        _slots[tick % _slots.size()].push_back(Timer{.tick = tick, .id = id});
+        ++_size;
+    }
+
+    void TimerWheel::advance(std::uint64_t now, std::vector<std::uint64_t>& expired)
+    {
+        auto const target = now / _tick;
+        if ((target <= _current) || (_size == 0))
+        {
+            _current = std::max(_current, target);
+            return;
+        }
+
+        // Each slot is visited once at most, even if the wheel turned more than once since the last call. The partition is stable, so the
+        // timers of a slot expire in the order they were scheduled.
+        auto const ticks = std::min(target - _current, std::uint64_t{_slots.size()});
+        _due.clear();
+        for (auto tick = target - ticks + 1U; tick <= target; ++tick)
+        {
+            auto& slot = _slots[tick % _slots.size()];
+            auto const due = std::ranges::stable_partition(slot, [&](Timer const& timer) { return timer.tick > target; });
+            _due.insert(_due.end(), due.begin(), due.end());
+            _size -= due.size();
+            slot.erase(due.begin(), due.end());
+        }
+
+        // After a gap of more than one turn, a slot holds the timers of several ticks. Sorting them keeps the expiry in tick order.
+        std::ranges::stable_sort(_due, {}, &Timer::tick);
+        for (auto const& timer : _due)
+        {
+            expired.push_back(timer.id);
+        }
+
+        _current = target;
+    }
+
+    bool TimerWheel::empty() const noexcept
+    {
+        return _size == 0;
+    }
+}
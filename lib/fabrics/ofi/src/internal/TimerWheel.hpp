@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mxl::lib::fabrics::ofi
+{
+    /** \brief A hashed timer wheel, which schedules many timers at a constant cost per timer.
+     *
+     * Times are TAI nanoseconds, as returned by mxlGetTime(), so that timers line up with the grain indices of the flows. Time is split into
+     * ticks, and every tick maps to one slot of the wheel. A timer due further away than one turn of the wheel stays in its slot for as
+     * many turns as needed. Timers are identified by an id chosen by the caller.
+     */
+    class TimerWheel
+    {
+    public:
+        /** \brief Create an empty wheel of `slots` slots of `tick` nanoseconds, whose current tick is the tick of `now`.
+         */
+        TimerWheel(std::uint64_t tick, std::size_t slots, std::uint64_t now);
+
+        /** \brief Schedule a timer. A timer that is already due expires on the next tick.
+         */
+        void schedule(std::uint64_t due, std::uint64_t id);
+
+        /** \brief Move the current tick to the tick of `now`, and append the ids of the timers that expired to `expired`.
+         *
+         * Timers expire in the order of their ticks, and the timers of the same tick in the order they were scheduled.
+         */
+        void advance(std::uint64_t now, std::vector<std::uint64_t>& expired);
+
+        /** \brief Whether no timer is scheduled.
+         */
+        [[nodiscard]]
+        bool empty() const noexcept;
+
+    private:
+        struct Timer
+        {
+            std::uint64_t tick; /**< The tick the timer expires on. */
+            std::uint64_t id;
+        };
+
+    private:
+        std::uint64_t _tick;                    /**< Duration of a tick in nanoseconds. */
+        std::vector<std::vector<Timer>> _slots; /**< The timers of every slot, in the order they were scheduled. */
+        std::uint64_t _current;                 /**< The last tick whose timers expired. */
+        std::size_t _size;                      /**< Number of timers scheduled. */
+        std::vector<Timer> _due;                /**< The timers that expire in a call to advance(), kept to reuse its storage. */
+    };
+}
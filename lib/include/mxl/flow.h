@@ -28,6 +28,20 @@ extern "C"
  */
 #define MXL_GRAIN_FLAG_INVALID 0x00000001 // 1 << 0.
 
+/*
+ * Set by the flow writer on complete grains of flows created with MXL_FLOW_FLAG_GRAIN_CHECKSUM to indicate that
+ * mxlGrainInfo::checksum holds the CRC32C of the grain payload. Any value passed by the user when committing is ignored.
+ */
+#define MXL_GRAIN_FLAG_CHECKSUM 0x00000002 // 1 << 1.
+
+/*
+ * A grain can repeat the payload of an earlier grain, for example to freeze the picture while a source is stalled,
+ * without copying it. To do so, open the grain, set this flag together with mxlGrainInfo::sourceIndex and commit it
+ * without touching the payload. Readers are transparently handed the payload of the source grain for as long as it
+ * is available.
+ */
+#define MXL_GRAIN_FLAG_REPEAT 0x00000004 // 1 << 2.
+
     /**
      * A helper type used to describe consecutive sequences of bytes in memory.
      */
@@ -131,10 +145,77 @@ extern "C"
         /// How many slices of the grain are currently valid (committed). This is typically used when writing individual slices instead of a full
         /// grain. A grain is complete when validSlices == totalSlices
         uint16_t validSlices;
+        /// CRC32C of the complete grain payload (grainSize bytes). Only meaningful if MXL_GRAIN_FLAG_CHECKSUM is set in flags.
+        uint32_t checksum;
+        /// Index of the grain whose payload is repeated by this grain. Only meaningful if MXL_GRAIN_FLAG_REPEAT is set in flags.
+        /// The flow writer resolves repeats of repeated grains, so this always refers to a grain that carries a payload.
+        uint64_t sourceIndex;
         /// Padding. Do not use.
-        uint8_t reserved[4068];
+        uint8_t reserved[4056];
     } mxlGrainInfo;
 
+    /**
+     * Header preceding every record in the grains of a multi-producer data flow (\see MXL_FLOW_FLAG_MULTI_PRODUCER).
+     *
+     * The valid part of such a grain (mxlGrainInfo::validSlices bytes) is a sequence of records. Each record consists of
+     * this header, followed by `size` bytes of data, padded to a multiple of 4 bytes. Records appear in the order in which
+     * they were claimed by the producers, and the valid part of a grain only ever covers records that have been committed.
+     */
+    typedef struct mxlDataRecordHeader_t
+    {
+        /// Size of the record data in bytes, excluding this header and padding.
+        uint32_t size;
+    } mxlDataRecordHeader;
+
+    /**
+     * A record claimed in a grain of a multi-producer data flow.
+     */
+    typedef struct mxlDataRecord_t
+    {
+        /// The index of the grain the record was claimed in.
+        uint64_t index;
+        /// The offset of the record header in the grain payload.
+        uint32_t offset;
+        /// The size of the record data in bytes.
+        uint32_t size;
+        /// Pointer to the record data, which the producer must fill before committing the record.
+        uint8_t* data;
+    } mxlDataRecord;
+
+    /**
+     * A read-only view of the runtime state of a flow, as returned by mxlFlowReaderGetRuntimeView().
+     *
+     * The pointers reference the shared memory of the flow and are updated in place by the writer, which
+     * makes it possible to poll the state of a flow without copying it. Each field must be read using an
+     * atomic load (for instance __atomic_load_n() or std::atomic_ref), as the writer may update it at any
+     * time. The pointers remain valid until the reader is released.
+     */
+    typedef struct mxlFlowRuntimeView_t
+    {
+        /// The runtime info of the flow. The head index is published with release semantics.
+        mxlFlowRuntimeInfo const* runtime;
+        /// Counter incremented by the writer every time new data is committed to the flow.
+        uint32_t const* syncCounter;
+    } mxlFlowRuntimeView;
+
+    /**
+     * Cursor used to stream the slices of a single grain as they are committed by the writer.
+     * \see mxlFlowReaderOpenSliceCursor() and mxlFlowReaderGetNextSlices().
+     */
+    typedef struct mxlGrainSliceCursor_t
+    {
+        /// Index of the grain being streamed.
+        uint64_t index;
+        /// The first slice that has not been handed out yet.
+        uint16_t nextSlice;
+        /// Number of slices that make up the full grain. 0 until the first range of slices was obtained.
+        uint16_t totalSlices;
+        /// Grain flags, as of the last range of slices obtained.
+        uint32_t flags;
+        /// Pointer to the first byte of the grain payload. NULL until the first range of slices was obtained.
+        uint8_t* payload;
+    } mxlGrainSliceCursor;
+
     typedef struct mxlFlowReader_t* mxlFlowReader;
     typedef struct mxlFlowWriter_t* mxlFlowWriter;
 
@@ -149,6 +230,8 @@ extern "C"
      * \param[out] info A pointer to an mxlFlowConfigInfo structure.
      *     If not the nullptr, this structure will be updated with the flow
      *     information after the flow is created.
+     * \return MXL_STATUS_OK if the flow was created, MXL_ERR_INVALID_ARG if the flow definition or the options are malformed or
+     *     not supported for this flow.
      */
     MXL_EXPORT
     mxlStatus mxlCreateFlow(mxlInstance instance, char const* flowDef, char const* options, mxlFlowConfigInfo* info);
@@ -234,6 +317,30 @@ extern "C"
     MXL_EXPORT
     mxlStatus mxlFlowReaderGetRuntimeInfo(mxlFlowReader reader, mxlFlowRuntimeInfo* info);
 
+    /**
+     * Get a view of the runtime header of a Flow, which is updated in place by the writer.
+     * Unlike mxlFlowReaderGetInfo() this doesn't copy anything, so it only needs to be called once per reader.
+     *
+     * \param[in] reader A valid flow reader
+     * \param[out] view A valid pointer to an mxlFlowRuntimeView structure.
+     *      On return, the structure will point to the runtime state of the flow. \see mxlFlowRuntimeView
+     * \return The result code. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetRuntimeView(mxlFlowReader reader, mxlFlowRuntimeView* view);
+
+    /**
+     * Get the index of the last grain or sample committed to a Flow. This is a single atomic load,
+     * which makes it suitable to be called on the hot path, for instance after a read returned
+     * MXL_ERR_OUT_OF_RANGE_TOO_EARLY or MXL_ERR_OUT_OF_RANGE_TOO_LATE.
+     *
+     * \param[in] reader A valid flow reader
+     * \param[out] headIndex A valid pointer to receive the current head index of the flow.
+     * \return The result code. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetHeadIndex(mxlFlowReader reader, uint64_t* headIndex);
+
     /**
      * Accessors for a flow grain at a specific index
      * This method is expected to wait until the full grain is available (or the timeout expires). For partial grain access use
@@ -306,6 +413,110 @@ extern "C"
     mxlStatus mxlFlowReaderGetGrainSliceNonBlocking(mxlFlowReader reader, uint64_t index, uint16_t minValidSlices, mxlGrainInfo* grain,
         uint8_t** payload);
 
+    /**
+     * Prepare a cursor to stream the slices of a grain as they are committed by the writer.
+     * This doesn't wait for the grain, nor does it check whether it is available yet.
+     *
+     * \param[in] reader A valid discrete flow reader.
+     * \param[in] index The index of the grain to stream.
+     * \param[out] cursor The cursor to initialize.
+     * \return The result code. \see mxlStatus
+     * \note Please note that this function can only be called on readers that
+     *      operate on discrete flows. Any attempt to call this function on a
+     *      reader that operates on another type of flow will result in an
+     *      error.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderOpenSliceCursor(mxlFlowReader reader, uint64_t index, mxlGrainSliceCursor* cursor);
+
+    /**
+     * Wait for the next range of slices of the grain referenced by a cursor, and advance the cursor past it.
+     *
+     * Every committed slice is handed out exactly once. All slices committed since the previous call are returned as a
+     * single range, so there is only one wait per batch committed by the writer. The grain is complete once
+     * cursor->nextSlice reaches cursor->totalSlices. If the grain is marked as invalid, all of its remaining slices are
+     * returned at once and MXL_GRAIN_FLAG_INVALID is set in cursor->flags.
+     *
+     * \param[in] reader A valid discrete flow reader.
+     * \param[in,out] cursor A cursor initialized with mxlFlowReaderOpenSliceCursor().
+     * \param[in] timeoutNs How long to wait for new slices (in nanoseconds).
+     * \param[out] firstSlice The first slice of the range.
+     * \param[out] lastSlice One past the last slice of the range.
+     * \return The result code. MXL_ERR_OUT_OF_RANGE_TOO_EARLY if no new slice was committed before the timeout expired,
+     *      MXL_ERR_OUT_OF_RANGE_TOO_LATE if the grain was overwritten, in which case the slices previously handed out must
+     *      not be used anymore, MXL_ERR_INVALID_ARG if all slices of the grain were already handed out. \see mxlStatus
+     * \note Please note that this function can only be called on readers that
+     *      operate on discrete flows. Any attempt to call this function on a
+     *      reader that operates on another type of flow will result in an
+     *      error.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetNextSlices(mxlFlowReader reader, mxlGrainSliceCursor* cursor, uint64_t timeoutNs, uint16_t* firstSlice,
+        uint16_t* lastSlice);
+
+    /**
+     * Non-blocking accessor for the most recent grain of a flow that has at least a minimum number of valid slices.
+     * This is meant for consumers that are not interested in a particular index, such as monitoring applications,
+     * and is cheaper than querying the head index and stepping back until a suitable grain is found. Invalid grains
+     * are returned like with mxlFlowReaderGetGrain(), the caller must check MXL_GRAIN_FLAG_INVALID.
+     *
+     * \param[in] reader A valid discrete flow reader.
+     * \param[in] minValidSlices The minimum number of valid slices required in the returned grain. Use UINT16_MAX
+     *      to only accept complete grains.
+     * \param[out] grain The mxlGrainInfo structure of the grain found. The index of the grain is available in it.
+     * \param[out] payload The payload of the grain found.
+     * \return The result code. MXL_ERR_OUT_OF_RANGE_TOO_EARLY if none of the grains currently held by the flow
+     *      satisfies the requirement. \see mxlStatus
+     * \note Please note that this function can only be called on readers that
+     *      operate on discrete flows. Any attempt to call this function on a
+     *      reader that operates on another type of flow will result in an
+     *      error.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetLatestGrain(mxlFlowReader reader, uint16_t minValidSlices, mxlGrainInfo* grain, uint8_t** payload);
+
+    /**
+     * Accessor for the grain of a flow to present at a specific index of a foreign edit rate, for consumers that run on
+     * a different timeline than the flow (e.g. a 50 Hz flow presented on a 59.94 Hz multiviewer). The grain whose period
+     * contains the beginning of the requested index is returned, as computed by mxlConvertIndex(). Grains are repeated or
+     * dropped following the exact cadence between the two rates, and are returned in place without any copy.
+     *
+     * \param[in] reader A valid discrete flow reader.
+     * \param[in] editRate The edit rate of the timeline of the caller.
+     * \param[in] index The index on the timeline of the caller.
+     * \param[in] timeoutNs How long should we wait for the grain (in nanoseconds)
+     * \param[out] grain The mxlGrainInfo structure of the grain. Its index is expressed at the edit rate of the flow.
+     * \param[out] payload The grain payload.
+     * \return The result code. \see mxlStatus
+     * \note Please note that this function can only be called on readers that
+     *      operate on discrete flows. Any attempt to call this function on a
+     *      reader that operates on another type of flow will result in an
+     *      error.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetGrainAtRate(mxlFlowReader reader, mxlRational const* editRate, uint64_t index, uint64_t timeoutNs, mxlGrainInfo* grain,
+        uint8_t** payload);
+
+    /**
+     * Verify the integrity of a grain previously obtained from this reader against the CRC32C checksum computed by the
+     * writer of the flow when the grain was committed.
+     *
+     * \param[in] reader A valid discrete flow reader.
+     * \param[in] grain The mxlGrainInfo structure returned together with the payload.
+     * \param[in] payload The grain payload exactly as returned by mxlFlowReaderGetGrain() or one of its variants.
+     * \return MXL_STATUS_OK if the payload matches the checksum.
+     *      MXL_ERR_CHECKSUM_MISMATCH if the payload does not match the checksum although the grain was not overwritten,
+     *      which indicates that the grain was corrupted (for example in transit), or was not produced correctly.
+     *      MXL_ERR_OUT_OF_RANGE_TOO_LATE if the grain was overwritten by the writer while the caller was accessing it.
+     *      MXL_ERR_INVALID_ARG if the grain does not carry a checksum (\see MXL_GRAIN_FLAG_CHECKSUM).
+     * \note Please note that this function can only be called on readers that
+     *      operate on discrete flows. Any attempt to call this function on a
+     *      reader that operates on another type of flow will result in an
+     *      error.
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderVerifyGrain(mxlFlowReader reader, mxlGrainInfo const* grain, uint8_t const* payload);
+
     /**
      * Get grain info for a given index. This is used to inspect the grain info without opening the grain for mutation.
      *
@@ -353,11 +564,60 @@ extern "C"
      * that a new grain is available.  The mxlGrainInfo flags field in shared memory will be updated based on grain->flags This will increase the head
      * and potentially the tail IF this grain is the new head.
      *
-     * \return The result code. \see mxlStatus
+     * If grain->flags has MXL_GRAIN_FLAG_REPEAT set, the grain is committed as a complete grain that repeats the payload of the grain at
+     * grain->sourceIndex, which must be older than the committed grain, complete and still present in the ring buffer.
+     *
+     * \return The result code. MXL_ERR_OUT_OF_RANGE_TOO_LATE if the source of a repeated grain is not present in the ring buffer anymore,
+     *      MXL_ERR_OUT_OF_RANGE_TOO_EARLY if it is not complete yet.
+     *      \see mxlStatus
      */
     MXL_EXPORT
     mxlStatus mxlFlowWriterCommitGrain(mxlFlowWriter writer, mxlGrainInfo const* grain);
 
+    /**
+     * Atomically claim space for a record in a grain of a multi-producer data flow (\see MXL_FLOW_FLAG_MULTI_PRODUCER).
+     * Any number of writers, in the same or in different processes, can claim and commit records in the same grain
+     * concurrently. The first record claimed for a grain starts the grain, replacing the grain previously held by the
+     * ring buffer entry.
+     *
+     * \param[in] writer A valid flow writer on a multi-producer data flow.
+     * \param[in] index The index of the grain to add the record to.
+     * \param[in] size The size of the record data in bytes.
+     * \param[out] record The claimed record. Its data must be written before committing it with mxlFlowWriterCommitRecord().
+     * \return The result code. MXL_ERR_CONFLICT if the grain does not have enough space left for the record.
+     *      MXL_ERR_OUT_OF_RANGE_TOO_LATE if the ring buffer entry already holds a more recent grain. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowWriterClaimRecord(mxlFlowWriter writer, uint64_t index, uint32_t size, mxlDataRecord* record);
+
+    /**
+     * Commit a record previously claimed with mxlFlowWriterClaimRecord(). Records become visible to readers in the order
+     * in which they were claimed, as soon as all records claimed before them have been committed as well.
+     *
+     * \param[in] writer A valid flow writer on a multi-producer data flow.
+     * \param[in] record The record to commit.
+     * \return The result code. MXL_ERR_OUT_OF_RANGE_TOO_LATE if the grain was replaced before the record was committed.
+     *      \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowWriterCommitRecord(mxlFlowWriter writer, mxlDataRecord const* record);
+
+    /**
+     * Fill a gap in a discrete flow, for example after the writer missed a number of grains, by marking all grains from firstIndex to
+     * lastIndex (inclusive) as invalid (\see MXL_GRAIN_FLAG_INVALID) in one go. The head of the flow moves to lastIndex and waiting readers are
+     * signaled once for the whole range, rather than once per grain. If the range is longer than the ring buffer, only the most recent grains
+     * of the range are stamped, as the other ones would be overwritten anyway. Grains of the range that already left the ring buffer are
+     * skipped, and the head never moves backwards. If the grain currently opened by the writer is part of the range, it is implicitly
+     * cancelled.
+     *
+     * \param[in] writer A valid discrete flow writer.
+     * \param[in] firstIndex The index of the first invalid grain.
+     * \param[in] lastIndex The index of the last invalid grain. Must be greater or equal to firstIndex.
+     * \return The result code. MXL_ERR_OUT_OF_RANGE_TOO_LATE if the whole range already left the ring buffer. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowWriterCommitInvalidRange(mxlFlowWriter writer, uint64_t firstIndex, uint64_t lastIndex);
+
     /**
      * Accessor for a specific set of samples across all channels ending at a
      * specific index (`count` samples up to `index`).
@@ -401,6 +661,26 @@ extern "C"
     mxlStatus mxlFlowReaderGetSamplesNonBlocking(mxlFlowReader reader, uint64_t index, size_t count,
         mxlWrappedMultiBufferSlice* payloadBuffersSlices);
 
+    /**
+     * Accessor for the samples of a continuous flow that cover a specific index of a foreign edit rate, typically the
+     * audio that goes with a video grain. The window starts at the sample that contains the beginning of `index` and
+     * ends right before the one that contains the beginning of `index + 1`, as computed by mxlConvertIndex(). The size
+     * of consecutive windows follows the exact cadence between the two rates (e.g. 800 or 801 samples per frame for
+     * 48 kHz audio at 60000/1001).
+     *
+     * \param[in] reader A valid continuous flow reader.
+     * \param[in] editRate The edit rate of the timeline of the caller.
+     * \param[in] index The index on the timeline of the caller.
+     * \param[in] timeoutNs How long to wait in nanoseconds for the window of samples to become available.
+     * \param[out] payloadBuffersSlices A pointer to a wrapped multi buffer slice that represents the window across all
+     *      channel buffers.
+     * \param[out] count If not NULL, set to the number of samples in the window.
+     * \return The result code. \see mxlFlowReaderGetSamples()
+     */
+    MXL_EXPORT
+    mxlStatus mxlFlowReaderGetSamplesAtRate(mxlFlowReader reader, mxlRational const* editRate, uint64_t index, uint64_t timeoutNs,
+        mxlWrappedMultiBufferSlice* payloadBuffersSlices, size_t* count);
+
     /**
      * Open a specific set of mutable samples across all channels starting at a
      * specific index for mutation.
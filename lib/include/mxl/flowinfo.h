@@ -23,6 +23,19 @@
  */
 #define MXL_MAX_PLANES_PER_GRAIN 4
 
+/**
+ * The writer of the flow computes a CRC32C checksum over the payload of every complete grain when committing it.
+ * Enabled with the "checksum" flow option. Only supported for discrete flows.
+ * \see mxlGrainInfo::checksum
+ */
+#define MXL_FLOW_FLAG_GRAIN_CHECKSUM 0x00000001 // 1 << 0.
+
+/**
+ * Multiple writers can add records to the grains of the flow concurrently, using mxlFlowWriterClaimRecord() and
+ * mxlFlowWriterCommitRecord(). Enabled with the "multiProducer" flow option. Only supported for data flows.
+ */
+#define MXL_FLOW_FLAG_MULTI_PRODUCER 0x00000002 // 1 << 1.
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -51,7 +64,11 @@ extern "C"
          */
         uint32_t format;
 
-        /** No flags defined yet. */
+        /**
+         * Flow flags.
+         * \see MXL_FLOW_FLAG_GRAIN_CHECKSUM
+         * \see MXL_FLOW_FLAG_MULTI_PRODUCER
+         */
         uint32_t flags;
 
         /**
@@ -109,11 +126,18 @@ extern "C"
          */
         uint32_t grainCount;
 
+        /**
+         * How many grains are kept in the disk-backed history archive of this flow. Grains that have left the ring buffer, but are still
+         * present in the archive are served transparently to readers. 0 if the flow has no archive.
+         * \see {mxlDomain}/{flowId}/archive
+         */
+        uint32_t archiveGrainCount;
+
         /**
          * Reserved space for future extensions, padding the total size of this
          * structure to 64 bytes.
          */
-        uint8_t reserved[44];
+        uint8_t reserved[40];
     } mxlDiscreteFlowConfigInfo;
 
     /**
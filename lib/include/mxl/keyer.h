@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#ifdef __cplusplus
+#   include <cstdint>
+#else
+#   include <stdint.h>
+#endif
+
+#include <mxl/mxl.h>
+#include <mxl/platform.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef enum mxlKeyMode
+    {
+        /// The fill is not multiplied by the key. This is how video/v210a grains are defined.
+        MXL_KEY_MODE_STRAIGHT = 0,
+        /// The fill was already multiplied by the key, relative to black for luma and to the zero level for chroma.
+        MXL_KEY_MODE_PREMULTIPLIED = 1,
+    } mxlKeyMode;
+
+    /**
+     * Geometry and blending settings of a keying operation.
+     */
+    typedef struct mxlKeyerConfig_t
+    {
+        /// Width of the pictures in pixels.
+        uint32_t width;
+        /// Number of lines of the grains, i.e. mxlGrainInfo::totalSlices. The key of a video/v210a grain starts after this many fill lines.
+        uint32_t height;
+        /// How the fill relates to the key.
+        mxlKeyMode mode;
+        /// Non-zero if the fill and key use the full 10 bit range (0 to 1023), zero if they use video range (64 to 940 for luma and key).
+        uint32_t fullRange;
+    } mxlKeyerConfig;
+
+    /**
+     * Composite a range of lines of a video/v210a grain (fill and key) over a video/v210 grain. The lines are blended in
+     * their packed form, without unpacking them to an intermediate format, using the widest SIMD instructions available
+     * on the CPU. Working on a range of lines makes it possible to composite slices as soon as they are committed
+     * (\see mxlFlowReaderGetNextSlices()).
+     *
+     * \param[in] config The geometry of the grains and the blending settings.
+     * \param[in] foreground The payload of the video/v210a grain.
+     * \param[in] background The payload of the video/v210 grain.
+     * \param[out] output The payload to write the result to, typically a grain opened with mxlFlowWriterOpenGrain(). May be the same
+     *      as background to composite in place.
+     * \param[in] firstLine The first line to composite.
+     * \param[in] lastLine One past the last line to composite.
+     * \return The result code. MXL_ERR_INVALID_ARG if the configuration or the range of lines is invalid. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlKeyV210a(mxlKeyerConfig const* config, uint8_t const* foreground, uint8_t const* background, uint8_t* output, uint32_t firstLine,
+        uint32_t lastLine);
+
+#ifdef __cplusplus
+}
+#endif
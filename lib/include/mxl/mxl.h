@@ -35,6 +35,9 @@ extern "C"
         // (for example, if a writer restarted and recreated the flow)
         MXL_ERR_FLOW_INVALID,
 
+        // The payload of a grain does not match the checksum computed by the writer of the flow.
+        MXL_ERR_CHECKSUM_MISMATCH,
+
         /* fabrics.h errors */
         MXL_ERR_STRLEN = 1024,
         MXL_ERR_INTERRUPTED,
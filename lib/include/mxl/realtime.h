@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#ifdef __cplusplus
+#   include <cstdint>
+#else
+#   include <stdint.h>
+#endif
+
+#include <mxl/mxl.h>
+#include <mxl/platform.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * Scheduling settings for a thread running a latency sensitive MXL loop.
+     */
+    typedef struct mxlThreadSchedulingConfig_t
+    {
+        /// The CPU to pin the thread to, as numbered by the operating system. A negative value leaves the affinity of the thread untouched.
+        int32_t cpu;
+        /// The SCHED_FIFO priority of the thread (usually 1 to 99). 0 leaves the scheduling policy of the thread untouched.
+        int32_t rtPriority;
+    } mxlThreadSchedulingConfig;
+
+    /**
+     * Apply scheduling settings to the calling thread.
+     *
+     * \param[in] config The settings to apply.
+     * \return The result code. MXL_ERR_PERMISSION_DENIED if the process is not allowed to use real-time scheduling (it requires
+     *      CAP_SYS_NICE or an RLIMIT_RTPRIO allowance), MXL_ERR_INVALID_ARG if the CPU or priority is out of range.
+     *      MXL_ERR_UNKNOWN if CPU pinning is not supported on the current platform. \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlSetCurrentThreadScheduling(mxlThreadSchedulingConfig const* config);
+
+    /**
+     * Lock all current and future pages of the calling process in memory, so that latency sensitive threads never stall on
+     * page faults. This affects the whole process, including the shared memory of all flows it opens afterwards.
+     *
+     * \return The result code. MXL_ERR_PERMISSION_DENIED if the process is not allowed to lock that much memory
+     *      (see RLIMIT_MEMLOCK). \see mxlStatus
+     */
+    MXL_EXPORT
+    mxlStatus mxlLockProcessMemory(void);
+
+#ifdef __cplusplus
+}
+#endif
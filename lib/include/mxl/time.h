@@ -60,6 +60,20 @@ extern "C"
     MXL_EXPORT
     uint64_t mxlIndexToTimestamp(mxlRational const* editRate, uint64_t index);
 
+    /**
+     * Map an index at one edit rate onto another edit rate.
+     * The result is the index at `toRate` whose period contains the beginning of `index` at `fromRate`. The computation
+     * is exact, so converting consecutive indices yields the drop/repeat cadence between the two rates without drifting
+     * (e.g. 50 -> 60000/1001 repeats one grain out of every 5 or 6, 60000/1001 -> 48000 yields windows of 800 or 801 samples).
+     *
+     * \param[in] fromRate The edit rate of `index`
+     * \param[in] index The index to convert
+     * \param[in] toRate The edit rate to convert to
+     * \return The converted index or MXL_UNDEFINED_INDEX if one of the edit rates is null, invalid or not positive
+     */
+    MXL_EXPORT
+    uint64_t mxlConvertIndex(mxlRational const* fromRate, uint64_t index, mxlRational const* toRate);
+
     /**
      * Sleep for a specific amount of time.
      * \param[in] ns How long to sleep for, in nanoseconds.
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <mxl/flow.h>
+#include <mxl/platform.h>
+
+namespace mxl::lib
+{
+    /**
+     * Measure the levels and the loudness of the channels of a float32 audio flow.
+     *
+     * Per channel, the meter reports the sample peak, the true peak (the peak of the signal oversampled 4 times
+     * with the interpolation filter of ITU-R BS.1770-4, Annex 2) and the RMS level since the previous call to
+     * resetLevels(). For the flow as a whole, it reports the momentary (400 ms) and short-term (3 s) loudness of
+     * ITU-R BS.1770-4 and EBU R128, updated every 100 ms of samples.
+     *
+     * Samples are consumed as the wrapped multi-buffer slices returned by the continuous flow readers, without
+     * copies. Channels are processed side by side, 4 channels per vector with AVX2 on x86-64 CPUs that support it,
+     * 2 with NEON on ARMv8, and one at a time with a portable implementation otherwise. The filters run in double
+     * precision, so all implementations produce the same values to within rounding errors.
+     *
+     * A meter keeps the state of the filters of its flow and is meant to be fed every sample of the flow in order,
+     * by a single thread. A thread can run the meters of many flows.
+     */
+    class MXL_EXPORT AudioMeter
+    {
+    public:
+        /**
+         * \param[in] in_channelCount The number of channels of the flow.
+         * \param[in] in_sampleRate The sample rate of the flow in Hz.
+         * \throws std::invalid_argument if there are no channels or the sample rate is below 8 kHz.
+         */
+        AudioMeter(std::size_t in_channelCount, double in_sampleRate);
+
+        /**
+         * Set the weight of a channel in the loudness measurement, which is 1 by default. ITU-R BS.1770-4 uses
+         * 1.41 for the surround channels of 5.1 programmes and 0 for their LFE channel.
+         */
+        void setChannelWeight(std::size_t in_channel, double in_weight);
+
+        /**
+         * Process the next samples of the flow.
+         *
+         * \param[in] in_samples The samples of all the channels, as returned by mxlFlowReaderGetSamples(). Only the
+         *      first channelCount() buffers are read.
+         */
+        void process(mxlWrappedMultiBufferSlice const& in_samples) noexcept;
+
+        /** Process the next samples of the flow, stored as one buffer per channel separated by in_stride bytes. */
+        void process(float const* in_samples, std::size_t in_count, std::size_t in_stride) noexcept;
+
+        /** Restart the measurement of the peak, true peak and RMS levels. Loudness is not affected. */
+        void resetLevels() noexcept;
+
+        /** Largest absolute sample value of a channel since the previous call to resetLevels(). */
+        [[nodiscard]]
+        double peak(std::size_t in_channel) const noexcept;
+
+        /** Largest absolute value of the 4 times oversampled signal of a channel since the previous call to resetLevels(). */
+        [[nodiscard]]
+        double truePeak(std::size_t in_channel) const noexcept;
+
+        /** RMS value of the samples of a channel since the previous call to resetLevels(). */
+        [[nodiscard]]
+        double rms(std::size_t in_channel) const noexcept;
+
+        /** Loudness of the last 400 ms in LUFS, or minus infinity until 400 ms of samples were processed. */
+        [[nodiscard]]
+        double momentaryLoudness() const noexcept;
+
+        /** Loudness of the last 3 s in LUFS, or minus infinity until 3 s of samples were processed. */
+        [[nodiscard]]
+        double shortTermLoudness() const noexcept;
+
+        [[nodiscard]]
+        std::size_t channelCount() const noexcept
+        {
+            return _channelCount;
+        }
+
+    private:
+        double loudness(std::size_t in_blocks) const noexcept;
+
+        /** Push the K-weighted energy of the block that just completed into the loudness history. */
+        void completeBlock() noexcept;
+
+        std::size_t _channelCount;
+        /** Number of channels rounded up to a multiple of the widest vector, i.e. the stride between two fields of the state. */
+        std::size_t _paddedChannelCount;
+        /** Coefficients of the two biquads of the K-weighting filter, b0, b1, b2, a1 and a2 for each of them. */
+        std::array<double, 10> _coefficients;
+        /** State of all the channels, field by field. */
+        std::vector<double> _state;
+        std::vector<double> _weights;
+        /** Working memory for the first sample of every channel (padding included) of the samples being processed. */
+        std::vector<float const*> _channels;
+        /** Position of the next sample in the oversampling history, which is the same for all channels. */
+        std::size_t _historyPosition;
+        std::uint64_t _levelSamples;
+
+        /** Number of samples in a loudness block of 100 ms. */
+        std::size_t _blockSize;
+        std::size_t _blockSamples;
+        /** Weighted energy of the last 30 blocks, the most recent one at (_blockCount - 1) % 30. */
+        std::array<double, 30> _blockEnergies;
+        std::uint64_t _blockCount;
+    };
+
+    /**
+     * Get a human readable name of the audio metering implementation selected
+     * for the CPU the process is running on.
+     */
+    MXL_EXPORT
+    char const* audioMeterImplementation() noexcept;
+}
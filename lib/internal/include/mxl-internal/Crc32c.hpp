@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mxl/platform.h>
+
+namespace mxl::lib
+{
+    /**
+     * Compute the CRC32C (Castagnoli) checksum of a block of memory.
+     *
+     * The checksum is computed using the CRC32 instructions of the CPU if
+     * available (SSE4.2 on x86-64, the CRC extension on ARMv8), processing
+     * three independent streams in parallel to hide the latency of the
+     * instruction. A portable table based implementation is used otherwise.
+     *
+     * \param[in] in_data The data to compute the checksum of.
+     * \param[in] in_size The number of bytes to process.
+     * \param[in] in_crc The checksum of the data preceding in_data, which
+     *      allows computing the checksum of non-contiguous data in multiple
+     *      steps. Must be 0 for the first block.
+     * \return The checksum of all data processed so far.
+     */
+    MXL_EXPORT
+    std::uint32_t crc32c(void const* in_data, std::size_t in_size, std::uint32_t in_crc = 0U) noexcept;
+
+    /**
+     * Get a human readable name of the CRC32C implementation selected for
+     * the CPU the process is running on.
+     */
+    MXL_EXPORT
+    char const* crc32cImplementation() noexcept;
+}
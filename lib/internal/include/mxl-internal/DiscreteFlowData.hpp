@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 #include <fmt/format.h>
 #include "Flow.hpp"
+#include "FlowArchive.hpp"
 #include "FlowData.hpp"
 
 namespace mxl::lib
@@ -21,6 +25,21 @@ namespace mxl::lib
 
         std::size_t grainCount() const noexcept;
 
+        /**
+         * Create or open the grain arena, a single shared memory segment
+         * holding all grains of this flow back to back. Opening a flow this
+         * way takes a constant number of system calls, independently of
+         * the number of grains.
+         *
+         * \param[in] arenaFilePath The path to the arena file.
+         * \param[in] grainPayloadSize The payload size of a grain. Only used when creating the arena.
+         */
+        void openGrainArena(char const* arenaFilePath, std::size_t grainPayloadSize);
+
+        /**
+         * Open a grain stored in a file of its own, as done by flows that
+         * predate the grain arena.
+         */
         Grain* emplaceGrain(char const* grainFilePath, std::size_t grainPayloadSize);
 
         Grain* grainAt(std::size_t i) noexcept;
@@ -29,8 +48,35 @@ namespace mxl::lib
         mxlGrainInfo* grainInfoAt(std::size_t i) noexcept;
         mxlGrainInfo const* grainInfoAt(std::size_t i) const noexcept;
 
+        /**
+         * Create or open the disk-backed history archive of this flow.
+         *
+         * \param[in] archiveFilePath The path to the archive file.
+         * \param[in] grainPayloadSize The payload size of a grain. Only used when creating the archive.
+         */
+        void openArchive(char const* archiveFilePath, std::size_t grainPayloadSize);
+
+        /**
+         * Accessor for the history archive of this flow.
+         * \return The archive, or nullptr if the flow does not have an archive or it was not opened.
+         */
+        FlowArchive* archive() noexcept;
+
+        /** The distance in bytes between two grains in the arena, which is a multiple of the page size. */
+        static constexpr std::size_t grainStrideFor(std::size_t grainPayloadSize) noexcept;
+
     private:
+        /** Throw if grains whose header has the specified version can't be read. */
+        static void checkGrainHeaderVersion(std::uint32_t version);
+
+    private:
+        /** The grain arena. Not mapped for flows that store every grain in a file of its own. */
+        SharedMemorySegment _grainArena;
+        std::size_t _grainStride;
+        std::size_t _arenaGrainCount;
+        /** Grains stored in files of their own. */
         std::vector<SharedMemoryInstance<Grain>> _grains;
+        FlowArchive _archive;
     };
 
     /**************************************************************************/
@@ -39,21 +85,67 @@ namespace mxl::lib
 
     inline DiscreteFlowData::DiscreteFlowData(SharedMemoryInstance<Flow>&& flowSegement) noexcept
         : FlowData{std::move(flowSegement)}
+        , _grainArena{}
+        , _grainStride{0}
+        , _arenaGrainCount{0}
         , _grains{}
-    {
-        _grains.reserve(flowInfo()->config.discrete.grainCount);
-    }
+        , _archive{}
+    {}
 
     inline DiscreteFlowData::DiscreteFlowData(char const* flowFilePath, AccessMode mode)
         : FlowData{flowFilePath, mode}
+        , _grainArena{}
+        , _grainStride{0}
+        , _arenaGrainCount{0}
         , _grains{}
+        , _archive{}
+    {}
+
+    constexpr std::size_t DiscreteFlowData::grainStrideFor(std::size_t grainPayloadSize) noexcept
     {
-        _grains.reserve(flowInfo()->config.discrete.grainCount);
+        constexpr auto const pageSize = std::size_t{4096};
+        return ((sizeof(GrainHeader) + grainPayloadSize + pageSize - 1U) / pageSize) * pageSize;
     }
 
     inline std::size_t DiscreteFlowData::grainCount() const noexcept
     {
-        return _grains.size();
+        return _grainArena ? _arenaGrainCount : _grains.size();
+    }
+
+    inline void DiscreteFlowData::openGrainArena(char const* arenaFilePath, std::size_t grainPayloadSize)
+    {
+        auto const count = std::size_t{flowInfo()->config.discrete.grainCount};
+        if (count == 0U)
+        {
+            throw std::invalid_argument{"Attempt to open the grain arena of a flow without grains."};
+        }
+
+        if (this->created())
+        {
+            _grainArena = SharedMemorySegment{arenaFilePath, AccessMode::CREATE_READ_WRITE, count * grainStrideFor(grainPayloadSize)};
+        }
+        else
+        {
+            auto arena = SharedMemorySegment{arenaFilePath, this->accessMode(), 0U};
+
+            // All grains are created at once by the same writer, so validating the geometry of the arena and the
+            // header of the first grain is enough to cover all of them.
+            auto const stride = arena.mappedSize() / count;
+            if ((stride < sizeof(GrainHeader)) || ((stride % 4096U) != 0U))
+            {
+                throw std::invalid_argument{"The grain arena does not have the expected geometry."};
+            }
+            auto const first = static_cast<Grain const*>(arena.cdata());
+            checkGrainHeaderVersion(first->header.info.version);
+            if ((sizeof(GrainHeader) + first->header.info.grainSize) > stride)
+            {
+                throw std::invalid_argument{"The grains do not fit the slots of the grain arena."};
+            }
+            _grainArena = std::move(arena);
+        }
+
+        _grainStride = _grainArena.mappedSize() / count;
+        _arenaGrainCount = count;
     }
 
     inline Grain* DiscreteFlowData::emplaceGrain(char const* grainFilePath, std::size_t grainPayloadSize)
@@ -64,23 +156,37 @@ namespace mxl::lib
         if (!this->created())
         {
             // Check for the version of the grain data structure in the memory that was just mapped.
-            if (grain.get()->header.info.version != GRAIN_HEADER_VERSION)
-            {
-                throw std::invalid_argument{
-                    fmt::format("Unsupported grain version: {}, supported version is: {}", grain.get()->header.info.version, GRAIN_HEADER_VERSION)};
-            }
+            checkGrainHeaderVersion(grain.get()->header.info.version);
         }
 
         return _grains.emplace_back(std::move(grain)).get();
     }
 
+    inline void DiscreteFlowData::checkGrainHeaderVersion(std::uint32_t version)
+    {
+        if ((version < GRAIN_HEADER_MIN_VERSION) || (version > GRAIN_HEADER_VERSION))
+        {
+            throw std::invalid_argument{
+                fmt::format("Unsupported grain version: {}, supported are: {} to {}", version, GRAIN_HEADER_MIN_VERSION, GRAIN_HEADER_VERSION)};
+        }
+    }
+
     inline Grain* DiscreteFlowData::grainAt(std::size_t i) noexcept
     {
+        if (_grainArena)
+        {
+            return (i < _arenaGrainCount) ? reinterpret_cast<Grain*>(static_cast<std::uint8_t*>(_grainArena.data()) + i * _grainStride) : nullptr;
+        }
         return (i < _grains.size()) ? _grains[i].get() : nullptr;
     }
 
     inline Grain const* DiscreteFlowData::grainAt(std::size_t i) const noexcept
     {
+        if (_grainArena)
+        {
+            return (i < _arenaGrainCount) ? reinterpret_cast<Grain const*>(static_cast<std::uint8_t const*>(_grainArena.data()) + i * _grainStride)
+                                          : nullptr;
+        }
         return (i < _grains.size()) ? _grains[i].get() : nullptr;
     }
 
@@ -101,4 +207,15 @@ namespace mxl::lib
         }
         return nullptr;
     }
+
+    inline void DiscreteFlowData::openArchive(char const* archiveFilePath, std::size_t grainPayloadSize)
+    {
+        auto const mode = this->created() ? AccessMode::CREATE_READ_WRITE : this->accessMode();
+        _archive = FlowArchive{archiveFilePath, mode, flowInfo()->config.discrete.archiveGrainCount, grainPayloadSize};
+    }
+
+    inline FlowArchive* DiscreteFlowData::archive() noexcept
+    {
+        return _archive.isValid() ? &_archive : nullptr;
+    }
 }
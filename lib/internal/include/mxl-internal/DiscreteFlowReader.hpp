@@ -42,6 +42,44 @@ namespace mxl::lib
         virtual mxlStatus getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
             std::uint8_t** out_payload) = 0;
 
+        /**
+         * Wait for the slices of a grain committed since the last call and advance the cursor past them.
+         *
+         * \param io_cursor The cursor describing the grain and the first slice not handed out yet.
+         * \param in_timeoutNs How long to wait in nanoseconds for new slices to be committed.
+         * \param out_firstSlice Set to the first slice of the range handed out.
+         * \param out_lastSlice Set to one past the last slice of the range handed out.
+         *
+         * \return A status code describing the outcome of the call.
+         */
+        virtual mxlStatus getNextSlices(mxlGrainSliceCursor& io_cursor, std::uint64_t in_timeoutNs, std::uint16_t* out_firstSlice,
+            std::uint16_t* out_lastSlice) = 0;
+
+        /**
+         * Non-blocking accessor for the most recent grain of the flow that satisfies a slice requirement.
+         * Only the grains currently held in the ring buffer are considered, starting at the head of the flow.
+         *
+         * \param in_minValidSlices The expected number of valid slices in the returned mxlGrainInfo.
+         * \param out_grainInfo A valid pointer to mxlGrainInfo that will be copied to
+         * \param out_payload A valid void pointer to pointer that will be set to the first byte of the grain payload.
+         *     Payload size is available in the mxlGrainInfo structure.
+         *
+         * \return A status code describing the outcome of the call.
+         */
+        virtual mxlStatus getLatestGrain(std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload) = 0;
+
+        /**
+         * Verify the payload of a grain previously obtained from this reader
+         * against the checksum computed by the writer of the flow.
+         *
+         * \param in_grainInfo The grain info returned together with the payload.
+         * \param in_payload The payload exactly as returned by getGrain().
+         *
+         * \return A status code describing the outcome of the call.
+         */
+        [[nodiscard]]
+        virtual mxlStatus verifyGrain(mxlGrainInfo const& in_grainInfo, std::uint8_t const* in_payload) const = 0;
+
     protected:
         using FlowReader::FlowReader;
     };
@@ -20,8 +20,31 @@ namespace mxl::lib
 
         virtual mxlStatus commit(mxlGrainInfo const& mxlGrainInfo) = 0;
 
+        /**
+         * Mark a range of grains as invalid and commit them all at once, moving the head of the flow to the last grain of the range and
+         * signaling waiting readers only once.
+         *
+         * \param in_firstIndex The index of the first grain of the range.
+         * \param in_lastIndex The index of the last grain of the range (inclusive).
+         */
+        virtual mxlStatus commitInvalidRange(std::uint64_t in_firstIndex, std::uint64_t in_lastIndex) = 0;
+
         virtual mxlStatus cancel() = 0;
 
+        /**
+         * Claim space for a record in a grain of a multi-producer data flow.
+         *
+         * \param in_index The index of the grain to add the record to.
+         * \param in_size The size of the record data in bytes.
+         * \param out_record The claimed record.
+         */
+        virtual mxlStatus claimRecord(std::uint64_t in_index, std::uint32_t in_size, mxlDataRecord* out_record) = 0;
+
+        /**
+         * Commit a record previously claimed with claimRecord().
+         */
+        virtual mxlStatus commitRecord(mxlDataRecord const& in_record) = 0;
+
     protected:
         using FlowWriter::FlowWriter;
     };
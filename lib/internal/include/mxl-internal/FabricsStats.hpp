@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mxl/platform.h>
+
+namespace mxl::lib
+{
+    /** Version of the FabricsValues structure. */
+    constexpr auto const FABRICS_STATS_VERSION = std::uint32_t{1};
+
+    /** Number of buckets of the completion latency histogram, as MXL_FABRICS_LATENCY_BUCKETS. */
+    constexpr auto const FABRICS_LATENCY_BUCKETS = std::size_t{16};
+
+    /** Number of error codes counted separately, as MXL_FABRICS_MAX_ERROR_CODES. */
+    constexpr auto const FABRICS_MAX_ERROR_CODES = std::size_t{8};
+
+    /** Maximum length of the address of the peer of a link, including the null terminator. */
+    constexpr auto const FABRICS_MAX_PEER_SIZE = std::size_t{64};
+
+    /** The flow is the source of a link, its grains are sent to the peer. */
+    constexpr auto const FABRICS_ROLE_SENDER = std::uint32_t{0};
+
+    /** The flow is written by a link, its grains are received from the peer. */
+    constexpr auto const FABRICS_ROLE_RECEIVER = std::uint32_t{1};
+
+    /**
+     * The latest counters of the fabrics link a flow is transferred over, as returned by
+     * mxlFabricsInitiatorSessionGetStats() or mxlFabricsTargetSessionGetStats(). The counters
+     * cover the whole link, which may carry other flows as well.
+     */
+    struct FabricsValues
+    {
+        /** Version of the structure, FABRICS_STATS_VERSION. */
+        std::uint32_t version;
+        /** FABRICS_ROLE_SENDER or FABRICS_ROLE_RECEIVER. */
+        std::uint32_t role;
+        /** TAI time of the update in nanoseconds. */
+        std::uint64_t updateTime;
+        /** Address of the peer, null terminated. Empty if it is unknown. */
+        char peer[FABRICS_MAX_PEER_SIZE];
+
+        /** The mxlFabricsLinkState of the link of a sender. */
+        std::uint32_t linkState;
+        /** Times the link failed. */
+        std::uint32_t linkFailures;
+        /** Times the link was restored after a failure. */
+        std::uint32_t reconnects;
+        /** Writes posted that didn't complete yet, or grains received that were not committed yet. */
+        std::uint32_t inFlight;
+        /** The largest inFlight value seen. */
+        std::uint32_t maxInFlight;
+
+        /** Bytes sent or received. */
+        std::uint64_t bytes;
+        /** Grains sent or received. */
+        std::uint64_t grains;
+        /** Writes posted or received. */
+        std::uint64_t writes;
+
+        /** Writes of a sender by latency, bucket 0 counts those under 1 us, bucket i those under 2^i us. */
+        std::uint64_t latencyHistogram[FABRICS_LATENCY_BUCKETS];
+        /** Sum of the latencies of the writes counted in latencyHistogram. */
+        std::uint64_t totalLatencyNs;
+        /** The longest of these latencies. */
+        std::uint64_t maxLatencyNs;
+
+        /** Operations that completed with an error. */
+        std::uint64_t errors;
+        /** The fi_errno of the first error codes seen, those with a count of 0 are unused. */
+        std::int32_t errorCodes[FABRICS_MAX_ERROR_CODES];
+        /** Number of errors of each of errorCodes. */
+        std::uint32_t errorCounts[FABRICS_MAX_ERROR_CODES];
+    };
+
+    /**
+     * The fabrics statistics of a flow, as published in shared memory next to the flow data by the
+     * application that transfers the flow.
+     *
+     * The values are protected by a sequence lock so that a single writer never blocks any of its readers.
+     */
+    struct FabricsStats
+    {
+        /** Incremented before and after every update of the values, which makes it odd while an update is in progress. */
+        std::uint64_t sequence;
+        FabricsValues values;
+    };
+
+    /** Update the fabrics statistics of a flow. There must be a single writer per flow. */
+    MXL_EXPORT
+    void publishFabricsStats(FabricsStats& io_stats, FabricsValues const& in_values) noexcept;
+
+    /**
+     * Read a consistent snapshot of the fabrics statistics of a flow.
+     *
+     * \return true on success, false if the values kept being updated while being read.
+     */
+    MXL_EXPORT
+    bool readFabricsStats(FabricsStats const& in_stats, FabricsValues& out_values) noexcept;
+}
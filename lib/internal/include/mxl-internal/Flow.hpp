@@ -16,8 +16,16 @@ namespace mxl::lib
     /// The version of the flow data structs in shared memory that we expect and support.
     constexpr auto FLOW_DATA_VERSION = 1U;
 
+    /// The version of the flow data structs of discrete flows. Version 2 stores the grains in a single arena, the flows of
+    /// version 1 store every grain in a shared memory segment of its own and can still be opened.
+    constexpr auto DISCRETE_FLOW_DATA_VERSION = 2U;
+
     /// The version of the grain header structs in shared memory that we expect an support.
-    constexpr auto GRAIN_HEADER_VERSION = 1U;
+    /// Version 2 adds the checksum, the source index of repeated grains and the state of the producers of records.
+    constexpr auto GRAIN_HEADER_VERSION = 2U;
+
+    /// The oldest version of the grain header structs that can still be read. The fields added since are zero in older headers.
+    constexpr auto GRAIN_HEADER_MIN_VERSION = 1U;
 
     ///
     /// Internal Flow structure stored in shared memory
@@ -33,11 +41,25 @@ namespace mxl::lib
     /// between the header and the payload.  Payload is page aligned AND AVX512 (64 bytes) aligned.
     constexpr auto const MXL_GRAIN_PAYLOAD_OFFSET = std::size_t{8192};
 
+    ///
+    /// State shared by the producers of a multi-producer flow (\see MXL_FLOW_FLAG_MULTI_PRODUCER) for a single grain.
+    /// Each word holds the index of the grain it refers to, truncated to 32 bits, in its upper half and a number of bytes
+    /// in its lower half, so that both can be updated atomically together.
+    ///
+    struct GrainProducerState
+    {
+        /// Number of payload bytes claimed by producers.
+        std::uint64_t claimed;
+        /// Number of payload bytes committed by producers.
+        std::uint64_t committed;
+    };
+
     struct GrainHeader
     {
         mxlGrainInfo info;
+        GrainProducerState producers;
 
-        std::uint8_t pad[MXL_GRAIN_PAYLOAD_OFFSET - sizeof info];
+        std::uint8_t pad[MXL_GRAIN_PAYLOAD_OFFSET - sizeof info - sizeof producers];
     };
 
     ///
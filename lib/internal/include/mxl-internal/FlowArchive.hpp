@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mxl/platform.h>
+#include "Flow.hpp"
+#include "SharedMemory.hpp"
+
+namespace mxl::lib
+{
+    /// Number of grains following the most recently requested archived grain that
+    /// readers ask the kernel to page in ahead of time.
+    constexpr auto const FLOW_ARCHIVE_READ_AHEAD_GRAINS = std::size_t{8};
+
+    ///
+    /// Disk-backed long history of a discrete flow.
+    ///
+    /// The archive is a single memory mapped file, usually located on a fast block device rather than on tmpfs, that
+    /// is organized as a second, much deeper ring of grains. Every slot has the same layout as a regular grain (a
+    /// GrainHeader followed by the payload) and is page aligned, so that archived grains can be handed out to readers
+    /// exactly like grains that still live in the regular ring buffer.
+    ///
+    /// Slots are filled asynchronously by the writer of the flow once grains have been committed. A slot is only
+    /// considered valid for a given index while its header carries that index, which is what readers use to detect
+    /// grains that were never archived or that have since been overwritten.
+    ///
+    class MXL_EXPORT FlowArchive
+    {
+    public:
+        /// Compute the size of a single archive slot for grains of the specified payload size.
+        static constexpr std::size_t slotSizeFor(std::size_t grainPayloadSize) noexcept;
+
+        constexpr FlowArchive() noexcept;
+
+        ///
+        /// Create or open an archive file.
+        ///
+        /// \param[in] path The path to the archive file.
+        /// \param[in] mode The access mode.
+        /// \param[in] slotCount The number of grains held by the archive.
+        /// \param[in] grainPayloadSize The payload size of a grain. Only used when creating the archive.
+        /// \throw std::system_error If the file could not be created, opened or mapped.
+        ///
+        FlowArchive(char const* path, AccessMode mode, std::size_t slotCount, std::size_t grainPayloadSize);
+
+        constexpr bool isValid() const noexcept;
+
+        constexpr std::size_t slotCount() const noexcept;
+        constexpr std::size_t slotSize() const noexcept;
+
+        ///
+        /// Look up an archived grain.
+        ///
+        /// \param[in] index The absolute index of the grain.
+        /// \return The archived grain, or nullptr if the grain is not (or no longer) present in the archive.
+        ///
+        Grain* find(std::uint64_t index) noexcept;
+
+        ///
+        /// Copy a committed grain into the archive slot associated with its index.
+        ///
+        /// \param[in] grain The grain to archive. Its payload must not exceed the slot size of the archive.
+        ///
+        void store(Grain const& grain) noexcept;
+
+        ///
+        /// Mark the archive slot associated with the specified index as not holding that grain anymore.
+        ///
+        void invalidate(std::uint64_t index) noexcept;
+
+        ///
+        /// Hint the kernel that the grains starting at the specified index will be read in the near future.
+        ///
+        void prefetch(std::uint64_t index, std::size_t count) const noexcept;
+
+    private:
+        Grain* slotAt(std::uint64_t index) noexcept;
+
+    private:
+        SharedMemorySegment _segment;
+        std::size_t _slotCount;
+        std::size_t _slotSize;
+    };
+
+    ///
+    /// Remove the archive file referenced by a flow directory, if any.
+    /// Removing the flow directory itself only removes the link to the archive.
+    ///
+    /// \param[in] flowDirectory The flow directory.
+    ///
+    MXL_EXPORT
+    void removeFlowArchive(std::filesystem::path const& flowDirectory) noexcept;
+
+    /**************************************************************************/
+    /* Inline implementation.                                                 */
+    /**************************************************************************/
+
+    constexpr std::size_t FlowArchive::slotSizeFor(std::size_t grainPayloadSize) noexcept
+    {
+        constexpr auto const pageSize = std::size_t{4096};
+        return ((MXL_GRAIN_PAYLOAD_OFFSET + grainPayloadSize + pageSize - 1U) / pageSize) * pageSize;
+    }
+
+    constexpr FlowArchive::FlowArchive() noexcept
+        : _segment{}
+        , _slotCount{0U}
+        , _slotSize{0U}
+    {}
+
+    constexpr bool FlowArchive::isValid() const noexcept
+    {
+        return _segment.isValid() && (_slotCount > 0U);
+    }
+
+    constexpr std::size_t FlowArchive::slotCount() const noexcept
+    {
+        return _slotCount;
+    }
+
+    constexpr std::size_t FlowArchive::slotSize() const noexcept
+    {
+        return _slotSize;
+    }
+}
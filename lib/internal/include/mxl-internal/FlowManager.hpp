@@ -25,7 +25,10 @@ namespace mxl::lib
     ///  - <mxl_domain>/<flow_id>.mxl-flow/flow_def.json : A file containing the flow definition (NMOS Flow resource json)
     ///  - <mxl_domain>/<flow_id>.mxl-flow/access        : A file used for access notifications by consumers of the flow
     ///  - <mxl_domain>/<flow_id>.mxl-flow/data          : The shared memory segment containing the `Flow`
-    ///  - <mxl_domain>/<flow_id>.mxl-flow/grains/       : A directory containing the per grain shared memory segments.
+    ///  - <mxl_domain>/<flow_id>.mxl-flow/grains/       : A directory containing the grain arena of a discrete flow, a single shared memory
+    ///                                                    segment holding all the grains of the ring buffer. Flows of data version 1 store
+    ///                                                    every grain in a shared memory segment of its own instead.
+    ///  - <mxl_domain>/<flow_id>.mxl-flow/archive       : An optional link to the disk-backed history archive of a discrete flow.
     ///
     /// After creation, the FlowData associated with the new flow is stored in an internal cache.
     ///
@@ -62,11 +65,15 @@ namespace mxl::lib
         /// \param[in] grainSliceLengths Length of each slice in bytes.
         /// \param[in] maxSyncBatchSizeHintOpt Optional max sync batch size hint.
         /// \param[in] maxCommitBatchSizeHintOpt Optional max commit batch size hint
+        /// \param[in] archiveGrainCount How many grains to keep in the disk-backed history archive of the flow. 0 to disable the archive.
+        /// \param[in] archiveDirectory The directory in which the archive file is created. Ignored if archiveGrainCount is 0.
+        /// \param[in] flags The flow flags (\see mxlCommonFlowConfigInfo::flags).
         ///
         std::unique_ptr<DiscreteFlowData> createDiscreteFlow(uuids::uuid const& flowId, std::string const& flowDef, mxlDataFormat flowFormat,
             std::size_t grainCount, mxlRational const& grainRate, std::size_t grainPayloadSize, std::size_t grainNumOfSlices,
             std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN> grainSliceLengths, std::uint32_t maxSyncBatchSizeHintOpt = 1,
-            std::uint32_t maxCommitBatchSizeHintOpt = 1);
+            std::uint32_t maxCommitBatchSizeHintOpt = 1, std::size_t archiveGrainCount = 0, std::filesystem::path const& archiveDirectory = {},
+            std::uint32_t flags = 0);
 
         ///
         /// Create a new continuous flow together with its associated channel store and open it in read-write mode.
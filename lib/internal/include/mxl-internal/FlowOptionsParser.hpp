@@ -41,6 +41,28 @@ namespace mxl::lib
         [[nodiscard]]
         std::optional<std::uint32_t> getMaxSyncBatchSizeHint() const;
 
+        /**
+         * Accessor for the 'archiveDuration' field, which expresses, in nanoseconds, how much history of a discrete flow should be kept in its
+         * disk-backed archive. This must be longer than the history duration of the domain, and requires the archive directory of the domain to
+         * be configured.
+         */
+        [[nodiscard]]
+        std::optional<std::uint64_t> getArchiveDuration() const;
+
+        /**
+         * Accessor for the 'checksum' field, which selects the algorithm used by the writer of a discrete flow to compute a checksum over the
+         * payload of every complete grain. The only supported value is "crc32c". Grain checksums are disabled if the field is absent.
+         */
+        [[nodiscard]]
+        bool getGrainChecksum() const;
+
+        /**
+         * Accessor for the 'multiProducer' field, which allows several writers to append records to the same grain of a data flow
+         * concurrently. Defaults to false.
+         */
+        [[nodiscard]]
+        bool getMultiProducer() const;
+
         /**
          * Generic accessor for json fields.
          *
@@ -57,6 +79,12 @@ namespace mxl::lib
         std::optional<std::uint32_t> _maxSyncBatchSizeHint;
         /// \see mxlCommonFlowInfo::maxCommitBatchSizeHint
         std::optional<std::uint32_t> _maxCommitBatchSizeHint;
+        /// \see getArchiveDuration
+        std::optional<std::uint64_t> _archiveDuration;
+        /// \see getGrainChecksum
+        bool _grainChecksum = false;
+        /// \see getMultiProducer
+        bool _multiProducer = false;
         /** The parsed flow object. */
         picojson::object _root;
     };
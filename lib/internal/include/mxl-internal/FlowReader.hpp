@@ -61,6 +61,25 @@ namespace mxl::lib
         [[nodiscard]]
         virtual mxlFlowRuntimeInfo getFlowRuntimeInfo() const = 0;
 
+        /**
+         * Accessor for the runtime state of the currently opened flow, without copying it.
+         * The returned pointers reference the shared memory of the flow and remain valid for
+         * as long as the reader exists. The reader must be properly attached to the flow before
+         * invoking this method.
+         * \return A view of the runtime state of the currently opened flow.
+         */
+        [[nodiscard]]
+        mxlFlowRuntimeView getFlowRuntimeView() const;
+
+        /**
+         * Accessor for the index of the last grain or sample committed to the currently opened flow.
+         * This is a single atomic load. The reader must be properly attached to the flow before
+         * invoking this method.
+         * \return The current head index of the flow.
+         */
+        [[nodiscard]]
+        std::uint64_t getHeadIndex() const;
+
         /** Destructor. */
         virtual ~FlowReader();
 
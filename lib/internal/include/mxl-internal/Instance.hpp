@@ -115,6 +115,10 @@ namespace mxl::lib
         /// \return The path to the MXL domain of this instance
         std::string getDomain() const;
 
+        /// Accessor for the factory the readers and writers of this instance are created with
+        /// \return The flow I/O factory of this instance
+        FlowIoFactory& getFlowIoFactory() noexcept;
+
     private:
         template<typename T>
         class RefCounted
@@ -174,6 +178,9 @@ namespace mxl::lib
         /// Ring buffer history duration in nanoseconds
         std::uint64_t _historyDuration;
 
+        /// Directory in which the history archives of flows are created. Empty if archives are not available in this domain.
+        std::filesystem::path _archiveDirectory;
+
         DomainWatcher::ptr _watcher;
 
         std::atomic_bool _stopping;
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mxl/platform.h>
+
+namespace mxl::lib
+{
+    /** How the fill of a v210a grain relates to its key. */
+    enum class KeyMode
+    {
+        /** The fill is not multiplied by the key, which is what the v210a format defines. */
+        STRAIGHT,
+        /** The fill was already multiplied by the key (relative to black and to the chroma zero level). */
+        PREMULTIPLIED
+    };
+
+    /**
+     * Composite one line of v210a fill and key over one line of v210 background, without unpacking the lines.
+     *
+     * The key of each pixel applies to its luma sample and to the chroma samples co-sited with it, i.e. the key
+     * of even pixels is used for the chroma of every pair of pixels.
+     *
+     * The blending is performed with AVX2 on x86-64 CPUs that support it, with NEON on ARMv8, and with a portable
+     * implementation otherwise. All implementations produce the exact same output.
+     *
+     * \param[in] in_fill The fill line, in v210 format.
+     * \param[in] in_key The key line, in the 10 bit alpha format of v210a (3 samples per 32 bit word).
+     * \param[in] in_background The background line, in v210 format.
+     * \param[out] out_line The composited line, in v210 format. May be the same as in_background.
+     * \param[in] in_width The width of the lines in pixels.
+     * \param[in] in_mode Whether the fill is straight or premultiplied.
+     * \param[in] in_fullRangeKey true if the key uses the full 10 bit range (0 to 1023), false if it uses the
+     *      video range (64 to 940).
+     */
+    MXL_EXPORT
+    void keyV210aLine(std::uint8_t const* in_fill, std::uint8_t const* in_key, std::uint8_t const* in_background, std::uint8_t* out_line,
+        std::size_t in_width, KeyMode in_mode, bool in_fullRangeKey) noexcept;
+
+    /**
+     * Get a human readable name of the keying implementation selected for
+     * the CPU the process is running on.
+     */
+    MXL_EXPORT
+    char const* keyerImplementation() noexcept;
+}
@@ -13,8 +13,13 @@ namespace mxl::lib
     constexpr auto const FLOW_ACCESS_FILE_NAME = "access";
     constexpr auto const GRAIN_DIRECTORY_NAME = "grains";
     constexpr auto const GRAIN_DATA_FILE_NAME_STEM = "data";
+    constexpr auto const GRAIN_ARENA_FILE_NAME = "arena";
     constexpr auto const CHANNEL_DATA_FILE_NAME = "channels";
     constexpr auto const DOMAIN_OPTIONS_FILE_NAME = "options.json";
+    constexpr auto const FLOW_ARCHIVE_LINK_NAME = "archive";
+    constexpr auto const FLOW_ARCHIVE_FILE_NAME_SUFFIX = ".mxl-archive";
+    constexpr auto const FLOW_PROBE_FILE_NAME = "probe";
+    constexpr auto const FLOW_FABRICS_FILE_NAME = "fabrics";
 
     std::filesystem::path makeFlowDirectoryName(std::filesystem::path const& domain, std::string const& uuid);
 
@@ -33,11 +38,20 @@ namespace mxl::lib
     std::filesystem::path makeGrainDataFilePath(std::filesystem::path const& grainDirectory, unsigned int index);
     std::filesystem::path makeGrainDataFilePath(std::filesystem::path const& domain, std::string const& uuid, unsigned int index);
 
+    std::filesystem::path makeGrainArenaFilePath(std::filesystem::path const& grainDirectory);
+
     std::filesystem::path makeChannelDataFilePath(std::filesystem::path const& flowDirectory);
     std::filesystem::path makeChannelDataFilePath(std::filesystem::path const& domain, std::string const& uuid);
 
     std::filesystem::path makeDomainOptionsFilePath(std::filesystem::path const& domain);
 
+    std::filesystem::path makeFlowArchiveLinkPath(std::filesystem::path const& flowDirectory);
+    std::filesystem::path makeFlowArchiveFilePath(std::filesystem::path const& archiveDirectory, std::string const& uuid);
+
+    std::filesystem::path makeFlowProbeFilePath(std::filesystem::path const& flowDirectory);
+
+    std::filesystem::path makeFlowFabricsFilePath(std::filesystem::path const& flowDirectory);
+
     /**************************************************************************/
     /* Inline implementation.                                                 */
     /**************************************************************************/
@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <mxl/platform.h>
+
+namespace mxl::lib
+{
+    /** Number of columns of the regions the luma signature of a picture is made of. */
+    constexpr auto const PROBE_SIGNATURE_COLUMNS = std::size_t{8};
+
+    /** Number of rows of the regions the luma signature of a picture is made of. */
+    constexpr auto const PROBE_SIGNATURE_ROWS = std::size_t{8};
+
+    /** Fractional bits of the average luma levels stored in a signature. */
+    constexpr auto const PROBE_SIGNATURE_FRACTION_BITS = 4U;
+
+    /** Statistics of the luma samples of a subset of the lines of a v210 picture. */
+    struct LumaStats
+    {
+        /** Sum of the luma samples that were analysed. */
+        std::uint64_t sum;
+        /** Number of luma samples that were analysed. */
+        std::uint64_t samples;
+        /** Number of luma samples at or below the black threshold. */
+        std::uint64_t blackSamples;
+        /**
+         * Average luma level of each region of the picture, in row major order and with
+         * PROBE_SIGNATURE_FRACTION_BITS fractional bits. Two pictures with the same content
+         * have the same signature, which makes it usable as a difference hash.
+         */
+        std::array<std::uint16_t, PROBE_SIGNATURE_COLUMNS * PROBE_SIGNATURE_ROWS> signature;
+    };
+
+    /** Statistics of a sequence of float32 audio samples. */
+    struct SampleStats
+    {
+        /** Sum of the squares of the samples. */
+        double sumOfSquares;
+        /** Largest absolute value of the samples. */
+        float peak;
+        /** Number of samples. */
+        std::uint64_t samples;
+    };
+
+    /**
+     * Analyse the luma samples of one line out of every in_lineStep lines of a v210 picture.
+     *
+     * Only the complete 6 pixel blocks of each line are analysed, pixels of a trailing partial block are ignored.
+     * The samples are summed with AVX2 on x86-64 CPUs that support it, with NEON on ARMv8, and with a portable
+     * implementation otherwise. All implementations produce the exact same statistics.
+     *
+     * \param[in] in_picture The first line of the picture.
+     * \param[in] in_stride The distance in bytes between two lines of the picture.
+     * \param[in] in_width The width of the picture in pixels.
+     * \param[in] in_height The height of the picture in lines.
+     * \param[in] in_lineStep Analyse one line out of this many. 0 is treated as 1.
+     * \param[in] in_blackThreshold Luma samples at or below this 10 bit level are counted as black.
+     */
+    MXL_EXPORT
+    LumaStats analyzeV210Luma(std::uint8_t const* in_picture, std::size_t in_stride, std::size_t in_width, std::size_t in_height,
+        std::size_t in_lineStep, std::uint32_t in_blackThreshold) noexcept;
+
+    /**
+     * Compute how much two pictures differ from their luma signatures.
+     *
+     * \return The mean absolute difference of the average luma levels of the regions of both pictures, in 10 bit
+     *      levels. 0 if the pictures are identical.
+     */
+    MXL_EXPORT
+    double signatureDifference(LumaStats const& in_lhs, LumaStats const& in_rhs) noexcept;
+
+    /**
+     * Accumulate the statistics of a sequence of float32 samples into io_stats, which allows analysing the
+     * fragments of a wrapped buffer one after the other.
+     */
+    MXL_EXPORT
+    void accumulateSampleStats(float const* in_samples, std::size_t in_count, SampleStats& io_stats) noexcept;
+
+    /**
+     * Get a human readable name of the probe implementation selected for
+     * the CPU the process is running on.
+     */
+    MXL_EXPORT
+    char const* probeImplementation() noexcept;
+
+    /** Version of the ProbeValues structure. */
+    constexpr auto const PROBE_STATS_VERSION = std::uint32_t{2};
+
+    /** Maximum number of audio channels reported in probe statistics. */
+    constexpr auto const PROBE_MAX_CHANNELS = std::size_t{64};
+
+    /** The picture of the flow is black. */
+    constexpr auto const PROBE_FLAG_BLACK = std::uint32_t{1} << 0;
+
+    /** The picture of the flow did not change since the previous grain that was analysed. */
+    constexpr auto const PROBE_FLAG_FROZEN = std::uint32_t{1} << 1;
+
+    /** All channels of the flow are below the silence threshold. */
+    constexpr auto const PROBE_FLAG_SILENT = std::uint32_t{1} << 2;
+
+    /** The latest results of the probe of a flow. */
+    struct ProbeValues
+    {
+        /** Version of the structure, PROBE_STATS_VERSION. */
+        std::uint32_t version;
+        /** Combination of the PROBE_FLAG_ values. */
+        std::uint32_t flags;
+        /** Index of the last grain, or head index of the last samples, that were analysed. */
+        std::uint64_t index;
+        /** TAI time of the analysis in nanoseconds. */
+        std::uint64_t updateTime;
+
+        /** Average 10 bit luma level of the picture. */
+        float averageLuma;
+        /** Ratio of the luma samples that are at or below the black threshold. */
+        float blackRatio;
+        /** Signature difference with the previous grain that was analysed. */
+        float difference;
+        /** Number of consecutive grains that were found black. */
+        std::uint32_t blackGrains;
+        /** Number of consecutive grains that were found frozen. */
+        std::uint32_t frozenGrains;
+
+        /** Number of channels reported in rms and peak. */
+        std::uint32_t channelCount;
+        /** Number of consecutive samples that were found silent. */
+        std::uint64_t silentSamples;
+        /** RMS level of each channel over the last samples analysed, in dBFS. */
+        float rms[PROBE_MAX_CHANNELS];
+        /** Peak level of each channel over the last samples analysed, in dBFS. */
+        float peak[PROBE_MAX_CHANNELS];
+        /** True peak level of each channel over the last samples analysed, in dBTP. */
+        float truePeak[PROBE_MAX_CHANNELS];
+        /** Momentary loudness of all the channels in LUFS, or a large negative value for silence. */
+        float momentaryLoudness;
+        /** Short-term loudness of all the channels in LUFS, or a large negative value for silence. */
+        float shortTermLoudness;
+    };
+
+    /**
+     * The probe statistics of a flow, as published in shared memory next to the flow data.
+     *
+     * The values are protected by a sequence lock so that a single writer never blocks any of its readers.
+     */
+    struct ProbeStats
+    {
+        /** Incremented before and after every update of the values, which makes it odd while an update is in progress. */
+        std::uint64_t sequence;
+        ProbeValues values;
+    };
+
+    /** Update the probe statistics of a flow. There must be a single writer per flow. */
+    MXL_EXPORT
+    void publishProbeStats(ProbeStats& io_stats, ProbeValues const& in_values) noexcept;
+
+    /**
+     * Read a consistent snapshot of the probe statistics of a flow.
+     *
+     * \return true on success, false if the values kept being updated while being read.
+     */
+    MXL_EXPORT
+    bool readProbeStats(ProbeStats const& in_stats, ProbeValues& out_values) noexcept;
+}
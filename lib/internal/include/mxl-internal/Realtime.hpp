@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace mxl::lib
+{
+    namespace this_thread
+    {
+        /**
+         * Restrict the calling thread to run on a single CPU.
+         *
+         * \param[in] cpu the index of the CPU, as numbered by the operating system.
+         * \return 0 on success, or an error number otherwise. ENOTSUP on
+         *      platforms that do not support thread affinity.
+         */
+        int pinToCpu(unsigned int cpu) noexcept;
+
+        /**
+         * Switch the calling thread to the SCHED_FIFO real-time scheduling
+         * policy with the specified priority.
+         *
+         * \param[in] priority the static priority of the thread. Must be in
+         *      the range supported by SCHED_FIFO (usually 1 to 99).
+         * \return 0 on success, or an error number otherwise. Usually EPERM if
+         *      the process lacks CAP_SYS_NICE or an RLIMIT_RTPRIO allowance.
+         */
+        int setRealtimePriority(int priority) noexcept;
+    }
+
+    /**
+     * Lock all current and future pages of the calling process in memory,
+     * so that real-time threads never stall on page faults.
+     *
+     * \return 0 on success, or an error number otherwise.
+     */
+    int lockProcessMemory() noexcept;
+
+    /**
+     * Inspect the system configuration for anything that is likely to
+     * disturb a latency sensitive thread pinned to the specified CPU, such
+     * as the CPU not being isolated from the scheduler or interrupts being
+     * routed to it.
+     *
+     * This is purely advisory, nothing is changed.
+     *
+     * \param[in] cpu the index of the CPU to inspect.
+     * \return A human readable hint for every issue found.
+     */
+    std::vector<std::string> cpuIsolationHints(unsigned int cpu);
+}
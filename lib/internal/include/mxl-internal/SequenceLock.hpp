@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <type_traits>
+
+namespace mxl::lib
+{
+    /** Number of attempts made at reading a consistent snapshot of values protected by a sequence lock. */
+    constexpr auto const SEQUENCE_LOCK_READ_ATTEMPTS = 64;
+
+    /**
+     * Update values protected by a sequence lock, typically statistics published in shared memory next to
+     * the data of a flow. The sequence is incremented before and after the update, which makes it odd while
+     * the update is in progress. There must be a single writer, which never blocks any of its readers.
+     */
+    template<typename T>
+    void writeSequenced(std::uint64_t& io_sequence, T& out_values, T const& in_values) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        auto const sequence = std::atomic_ref{io_sequence};
+        auto const current = sequence.load(std::memory_order_relaxed);
+
+        sequence.store(current + 1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&out_values, &in_values, sizeof in_values);
+        sequence.store(current + 2U, std::memory_order_release);
+    }
+
+    /**
+     * Read a consistent snapshot of values protected by a sequence lock.
+     *
+     * \return true on success, false if the values kept being updated while being read.
+     */
+    template<typename T>
+    bool readSequenced(std::uint64_t const& in_sequence, T const& in_values, T& out_values) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        auto const sequence = std::atomic_ref{const_cast<std::uint64_t&>(in_sequence)};
+        for (auto attempt = 0; attempt < SEQUENCE_LOCK_READ_ATTEMPTS; ++attempt)
+        {
+            auto const before = sequence.load(std::memory_order_acquire);
+            if ((before & 1U) == 0U)
+            {
+                std::memcpy(&out_values, &in_values, sizeof out_values);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+}
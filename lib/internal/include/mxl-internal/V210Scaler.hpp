@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <mxl/platform.h>
+
+namespace mxl::lib
+{
+    /**
+     * Downscale v210 pictures with a box filter, i.e. every target sample is the
+     * average of the source samples it covers.
+     *
+     * The source lines are accumulated in their packed form, which is where most
+     * of the work happens, with AVX2 on x86-64 CPUs that support it, with NEON on
+     * ARMv8, and with a portable implementation otherwise. All implementations
+     * produce the exact same output.
+     *
+     * A scaler only holds the precomputed geometry of the operation and can be
+     * used by several threads at once, as long as every thread uses its own
+     * scratch buffer.
+     */
+    class MXL_EXPORT V210Scaler
+    {
+    public:
+        /**
+         * \param[in] in_sourceWidth The width of the source pictures in pixels.
+         * \param[in] in_sourceHeight The height of the source pictures in lines.
+         * \param[in] in_targetWidth The width of the target pictures in pixels. Must be a multiple of 6,
+         *      so that the target does not share a v210 block with its neighbours.
+         * \param[in] in_targetHeight The height of the target pictures in lines.
+         * \throws std::invalid_argument if the target is empty or larger than the source.
+         */
+        V210Scaler(std::size_t in_sourceWidth, std::size_t in_sourceHeight, std::size_t in_targetWidth, std::size_t in_targetHeight);
+
+        /**
+         * Scale a range of lines of the target picture.
+         *
+         * \param[in] in_source The first line of the source picture.
+         * \param[in] in_sourceStride The distance in bytes between two source lines.
+         * \param[out] out_target The first line of the target picture, which may be located anywhere
+         *      in a larger picture as long as it starts on a v210 block.
+         * \param[in] in_targetStride The distance in bytes between two target lines.
+         * \param[in] in_firstLine The first target line to produce.
+         * \param[in] in_lastLine One past the last target line to produce.
+         * \param[in,out] io_scratch Working memory of the calling thread, resized as needed.
+         */
+        void scaleLines(std::uint8_t const* in_source, std::size_t in_sourceStride, std::uint8_t* out_target, std::size_t in_targetStride,
+            std::size_t in_firstLine, std::size_t in_lastLine, std::vector<std::uint32_t>& io_scratch) const;
+
+        [[nodiscard]]
+        std::size_t sourceWidth() const noexcept
+        {
+            return _sourceWidth;
+        }
+
+        [[nodiscard]]
+        std::size_t sourceHeight() const noexcept
+        {
+            return _sourceHeight;
+        }
+
+        [[nodiscard]]
+        std::size_t targetWidth() const noexcept
+        {
+            return _targetWidth;
+        }
+
+        [[nodiscard]]
+        std::size_t targetHeight() const noexcept
+        {
+            return _targetHeight;
+        }
+
+    private:
+        /** A range of source elements (lines, pixels or pixel pairs) covered by a target element. */
+        struct Footprint
+        {
+            std::uint32_t first;
+            std::uint32_t count;
+        };
+
+        void scaleLine(std::uint32_t const* in_sums, std::uint32_t* io_prefix, std::uint32_t in_lineCount, std::uint8_t* out_line) const noexcept;
+
+        std::size_t _sourceWidth;
+        std::size_t _sourceHeight;
+        std::size_t _targetWidth;
+        std::size_t _targetHeight;
+        /** Number of v210 blocks of the source lines. */
+        std::size_t _sourceBlocks;
+        /** Distance between the sums of the three sample positions of the words in the scratch buffer. */
+        std::size_t _sumStride;
+        /** The largest number of source pixels or pixel pairs covered by a target pixel or pixel pair. */
+        std::uint32_t _maxTaps;
+        /** The largest number of source lines covered by a target line. */
+        std::uint32_t _maxLines;
+
+        /** Source lines covered by every target line. */
+        std::vector<Footprint> _lines;
+        /** Source pixels covered by the luma of every target pixel. */
+        std::vector<Footprint> _luma;
+        /** Source pixel pairs covered by the chroma of every target pixel pair. */
+        std::vector<Footprint> _chroma;
+        /** Fixed point reciprocals of the number of samples averaged into a target sample, by number of lines and of taps. */
+        std::vector<std::uint64_t> _reciprocals;
+    };
+
+    /**
+     * Get a human readable name of the scaling implementation selected for
+     * the CPU the process is running on.
+     */
+    MXL_EXPORT
+    char const* v210ScalerImplementation() noexcept;
+}
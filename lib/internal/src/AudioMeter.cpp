@@ -0,0 +1,561 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/AudioMeter.hpp"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <mxl/platform.h>
+
+#if defined(__x86_64__)
+#   include <immintrin.h>
+#elif defined(__aarch64__)
+#   include <arm_neon.h>
+#endif
+
+namespace mxl::lib
+{
+    namespace
+    {
+        /** Number of taps of every phase of the true peak interpolation filter. */
+        constexpr auto const TAPS = std::size_t{12};
+
+        /** Oversampling factor of the true peak measurement. */
+        constexpr auto const PHASES = std::size_t{4};
+
+        /** Channels are padded to a multiple of this, which is the number of channels in the widest vector. */
+        constexpr auto const CHANNEL_ALIGNMENT = std::size_t{4};
+
+        /** Number of loudness blocks of 100 ms in the momentary and short-term windows. */
+        constexpr auto const MOMENTARY_BLOCKS = std::size_t{4};
+        constexpr auto const SHORT_TERM_BLOCKS = std::size_t{30};
+
+        /** Interpolation filter of ITU-R BS.1770-4, Annex 2, one row per phase. */
+        constexpr double const TRUE_PEAK_FILTER[PHASES][TAPS] = {
+            {0.0017089843750,
+             0.0109863281250,
+             -0.0196533203125,
+             0.0332031250000,
+             -0.0594482421875,
+             0.1373291015625,
+             0.9721679687500,
+             -0.1022949218750,
+             0.0476074218750,
+             -0.0266113281250,
+             0.0148925781250,
+             -0.0083007812500},
+            {-0.0291748046875,
+             0.0292968750000,
+             -0.0517578125000,
+             0.0891113281250,
+             -0.1665039062500,
+             0.4650878906250,
+             0.7797851562500,
+             -0.2003173828125,
+             0.1015625000000,
+             -0.0582275390625,
+             0.0330810546875,
+             -0.0189208984375},
+            {-0.0189208984375,
+             0.0330810546875,
+             -0.0582275390625,
+             0.1015625000000,
+             -0.2003173828125,
+             0.7797851562500,
+             0.4650878906250,
+             -0.1665039062500,
+             0.0891113281250,
+             -0.0517578125000,
+             0.0292968750000,
+             -0.0291748046875},
+            {-0.0083007812500,
+             0.0148925781250,
+             -0.0266113281250,
+             0.0476074218750,
+             -0.1022949218750,
+             0.9721679687500,
+             0.1373291015625,
+             -0.0594482421875,
+             0.0332031250000,
+             -0.0196533203125,
+             0.0109863281250,
+             0.0017089843750},
+        };
+
+        /**
+         * Fields of the state of a channel. The oversampling history holds every sample twice, at
+         * position p and p + TAPS, so that the last TAPS samples are always contiguous.
+         */
+        enum Field : std::size_t
+        {
+            SHELF_Z1,
+            SHELF_Z2,
+            HIGHPASS_Z1,
+            HIGHPASS_Z2,
+            PEAK,
+            TRUE_PEAK,
+            SUM_OF_SQUARES,
+            WEIGHTED_SUM_OF_SQUARES,
+            HISTORY,
+            FIELD_COUNT = HISTORY + 2U * TAPS
+        };
+
+        /**
+         * Run the filters of all the channels over the next samples.
+         *
+         * \param[in] in_channels The next sample of every channel, padding included.
+         * \param[in] in_channelCount The number of channels, padding included.
+         * \param[in] in_count The number of samples to process.
+         * \param[in,out] io_state The state of the channels, field by field.
+         * \param[in] in_coefficients The coefficients of the K-weighting filter.
+         * \param[in] in_historyPosition The position of the next sample in the oversampling history.
+         */
+        using MeterFunction = void (*)(float const* const* in_channels, std::size_t in_channelCount, std::size_t in_count, double* io_state,
+            double const* in_coefficients, std::size_t in_historyPosition) noexcept;
+
+        struct MeterImplementation
+        {
+            MeterFunction function;
+            char const* name;
+        };
+
+        void meterScalar(float const* const* in_channels, std::size_t in_channelCount, std::size_t in_count, double* io_state,
+            double const* in_coefficients, std::size_t in_historyPosition) noexcept
+        {
+            auto const* c = in_coefficients;
+            for (auto channel = std::size_t{0}; channel < in_channelCount; ++channel)
+            {
+                auto const field = [&](std::size_t index) -> double&
+                {
+                    return io_state[index * in_channelCount + channel];
+                };
+
+                auto shelfZ1 = field(SHELF_Z1);
+                auto shelfZ2 = field(SHELF_Z2);
+                auto highpassZ1 = field(HIGHPASS_Z1);
+                auto highpassZ2 = field(HIGHPASS_Z2);
+                auto peak = field(PEAK);
+                auto truePeak = field(TRUE_PEAK);
+                auto squares = field(SUM_OF_SQUARES);
+                auto weighted = field(WEIGHTED_SUM_OF_SQUARES);
+                auto position = in_historyPosition;
+
+                for (auto i = std::size_t{0}; i < in_count; ++i)
+                {
+                    auto const x = static_cast<double>(in_channels[channel][i]);
+
+                    // K-weighting, as two biquads in transposed direct form II.
+                    auto const shelf = c[0] * x + shelfZ1;
+                    shelfZ1 = c[1] * x - c[3] * shelf + shelfZ2;
+                    shelfZ2 = c[2] * x - c[4] * shelf;
+                    auto const weightedSample = c[5] * shelf + highpassZ1;
+                    highpassZ1 = c[6] * shelf - c[8] * weightedSample + highpassZ2;
+                    highpassZ2 = c[7] * shelf - c[9] * weightedSample;
+
+                    weighted += weightedSample * weightedSample;
+                    squares += x * x;
+                    peak = std::max(peak, std::fabs(x));
+
+                    field(HISTORY + position) = x;
+                    field(HISTORY + position + TAPS) = x;
+                    for (auto phase = std::size_t{0}; phase < PHASES; ++phase)
+                    {
+                        auto sum = TRUE_PEAK_FILTER[phase][0] * field(HISTORY + position + TAPS);
+                        for (auto tap = std::size_t{1}; tap < TAPS; ++tap)
+                        {
+                            sum = sum + TRUE_PEAK_FILTER[phase][tap] * field(HISTORY + position + TAPS - tap);
+                        }
+                        truePeak = std::max(truePeak, std::fabs(sum));
+                    }
+                    position = (position + 1U == TAPS) ? 0U : position + 1U;
+                }
+
+                field(SHELF_Z1) = shelfZ1;
+                field(SHELF_Z2) = shelfZ2;
+                field(HIGHPASS_Z1) = highpassZ1;
+                field(HIGHPASS_Z2) = highpassZ2;
+                field(PEAK) = peak;
+                field(TRUE_PEAK) = truePeak;
+                field(SUM_OF_SQUARES) = squares;
+                field(WEIGHTED_SUM_OF_SQUARES) = weighted;
+            }
+        }
+
+#if defined(__x86_64__)
+        __attribute__((target("avx2,fma")))
+        void meterAvx2(float const* const* in_channels, std::size_t in_channelCount, std::size_t in_count, double* io_state,
+            double const* in_coefficients, std::size_t in_historyPosition) noexcept
+        {
+            auto const signMask = _mm256_set1_pd(-0.0);
+            auto const b0 = _mm256_set1_pd(in_coefficients[0]);
+            auto const b1 = _mm256_set1_pd(in_coefficients[1]);
+            auto const b2 = _mm256_set1_pd(in_coefficients[2]);
+            auto const a1 = _mm256_set1_pd(in_coefficients[3]);
+            auto const a2 = _mm256_set1_pd(in_coefficients[4]);
+            auto const d0 = _mm256_set1_pd(in_coefficients[5]);
+            auto const d1 = _mm256_set1_pd(in_coefficients[6]);
+            auto const d2 = _mm256_set1_pd(in_coefficients[7]);
+            auto const e1 = _mm256_set1_pd(in_coefficients[8]);
+            auto const e2 = _mm256_set1_pd(in_coefficients[9]);
+
+            // Four channels per vector, the filter state of which is kept in registers for the whole run.
+            for (auto first = std::size_t{0}; first < in_channelCount; first += 4U)
+            {
+                auto* const state = io_state + first;
+                auto const field = [&](std::size_t index)
+                {
+                    return state + index * in_channelCount;
+                };
+
+                auto shelfZ1 = _mm256_loadu_pd(field(SHELF_Z1));
+                auto shelfZ2 = _mm256_loadu_pd(field(SHELF_Z2));
+                auto highpassZ1 = _mm256_loadu_pd(field(HIGHPASS_Z1));
+                auto highpassZ2 = _mm256_loadu_pd(field(HIGHPASS_Z2));
+                auto peak = _mm256_loadu_pd(field(PEAK));
+                auto truePeak = _mm256_loadu_pd(field(TRUE_PEAK));
+                auto squares = _mm256_loadu_pd(field(SUM_OF_SQUARES));
+                auto weighted = _mm256_loadu_pd(field(WEIGHTED_SUM_OF_SQUARES));
+                auto position = in_historyPosition;
+
+                auto const* channel0 = in_channels[first];
+                auto const* channel1 = in_channels[first + 1U];
+                auto const* channel2 = in_channels[first + 2U];
+                auto const* channel3 = in_channels[first + 3U];
+
+                for (auto i = std::size_t{0}; i < in_count; ++i)
+                {
+                    auto const x = _mm256_cvtps_pd(_mm_setr_ps(channel0[i], channel1[i], channel2[i], channel3[i]));
+
+                    auto const shelf = _mm256_add_pd(_mm256_mul_pd(b0, x), shelfZ1);
+                    shelfZ1 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(b1, x), _mm256_mul_pd(a1, shelf)), shelfZ2);
+                    shelfZ2 = _mm256_sub_pd(_mm256_mul_pd(b2, x), _mm256_mul_pd(a2, shelf));
+                    auto const weightedSample = _mm256_add_pd(_mm256_mul_pd(d0, shelf), highpassZ1);
+                    highpassZ1 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(d1, shelf), _mm256_mul_pd(e1, weightedSample)), highpassZ2);
+                    highpassZ2 = _mm256_sub_pd(_mm256_mul_pd(d2, shelf), _mm256_mul_pd(e2, weightedSample));
+
+                    weighted = _mm256_add_pd(weighted, _mm256_mul_pd(weightedSample, weightedSample));
+                    squares = _mm256_add_pd(squares, _mm256_mul_pd(x, x));
+                    peak = _mm256_max_pd(peak, _mm256_andnot_pd(signMask, x));
+
+                    _mm256_storeu_pd(field(HISTORY + position), x);
+                    _mm256_storeu_pd(field(HISTORY + position + TAPS), x);
+                    auto const* newest = field(HISTORY + position + TAPS);
+                    for (auto phase = std::size_t{0}; phase < PHASES; ++phase)
+                    {
+                        auto sum = _mm256_mul_pd(_mm256_set1_pd(TRUE_PEAK_FILTER[phase][0]), x);
+                        for (auto tap = std::size_t{1}; tap < TAPS; ++tap)
+                        {
+                            auto const sample = _mm256_loadu_pd(newest - tap * in_channelCount);
+                            sum = _mm256_fmadd_pd(_mm256_set1_pd(TRUE_PEAK_FILTER[phase][tap]), sample, sum);
+                        }
+                        truePeak = _mm256_max_pd(truePeak, _mm256_andnot_pd(signMask, sum));
+                    }
+                    position = (position + 1U == TAPS) ? 0U : position + 1U;
+                }
+
+                _mm256_storeu_pd(field(SHELF_Z1), shelfZ1);
+                _mm256_storeu_pd(field(SHELF_Z2), shelfZ2);
+                _mm256_storeu_pd(field(HIGHPASS_Z1), highpassZ1);
+                _mm256_storeu_pd(field(HIGHPASS_Z2), highpassZ2);
+                _mm256_storeu_pd(field(PEAK), peak);
+                _mm256_storeu_pd(field(TRUE_PEAK), truePeak);
+                _mm256_storeu_pd(field(SUM_OF_SQUARES), squares);
+                _mm256_storeu_pd(field(WEIGHTED_SUM_OF_SQUARES), weighted);
+            }
+        }
+#elif defined(__aarch64__)
+        void meterNeon(float const* const* in_channels, std::size_t in_channelCount, std::size_t in_count, double* io_state,
+            double const* in_coefficients, std::size_t in_historyPosition) noexcept
+        {
+            auto const b0 = vdupq_n_f64(in_coefficients[0]);
+            auto const b1 = vdupq_n_f64(in_coefficients[1]);
+            auto const b2 = vdupq_n_f64(in_coefficients[2]);
+            auto const a1 = vdupq_n_f64(in_coefficients[3]);
+            auto const a2 = vdupq_n_f64(in_coefficients[4]);
+            auto const d0 = vdupq_n_f64(in_coefficients[5]);
+            auto const d1 = vdupq_n_f64(in_coefficients[6]);
+            auto const d2 = vdupq_n_f64(in_coefficients[7]);
+            auto const e1 = vdupq_n_f64(in_coefficients[8]);
+            auto const e2 = vdupq_n_f64(in_coefficients[9]);
+
+            // Two channels per vector, the filter state of which is kept in registers for the whole run.
+            for (auto first = std::size_t{0}; first < in_channelCount; first += 2U)
+            {
+                auto* const state = io_state + first;
+                auto const field = [&](std::size_t index)
+                {
+                    return state + index * in_channelCount;
+                };
+
+                auto shelfZ1 = vld1q_f64(field(SHELF_Z1));
+                auto shelfZ2 = vld1q_f64(field(SHELF_Z2));
+                auto highpassZ1 = vld1q_f64(field(HIGHPASS_Z1));
+                auto highpassZ2 = vld1q_f64(field(HIGHPASS_Z2));
+                auto peak = vld1q_f64(field(PEAK));
+                auto truePeak = vld1q_f64(field(TRUE_PEAK));
+                auto squares = vld1q_f64(field(SUM_OF_SQUARES));
+                auto weighted = vld1q_f64(field(WEIGHTED_SUM_OF_SQUARES));
+                auto position = in_historyPosition;
+
+                auto const* channel0 = in_channels[first];
+                auto const* channel1 = in_channels[first + 1U];
+
+                for (auto i = std::size_t{0}; i < in_count; ++i)
+                {
+                    auto const x = vcombine_f64(vdup_n_f64(channel0[i]), vdup_n_f64(channel1[i]));
+
+                    auto const shelf = vaddq_f64(vmulq_f64(b0, x), shelfZ1);
+                    shelfZ1 = vaddq_f64(vsubq_f64(vmulq_f64(b1, x), vmulq_f64(a1, shelf)), shelfZ2);
+                    shelfZ2 = vsubq_f64(vmulq_f64(b2, x), vmulq_f64(a2, shelf));
+                    auto const weightedSample = vaddq_f64(vmulq_f64(d0, shelf), highpassZ1);
+                    highpassZ1 = vaddq_f64(vsubq_f64(vmulq_f64(d1, shelf), vmulq_f64(e1, weightedSample)), highpassZ2);
+                    highpassZ2 = vsubq_f64(vmulq_f64(d2, shelf), vmulq_f64(e2, weightedSample));
+
+                    weighted = vaddq_f64(weighted, vmulq_f64(weightedSample, weightedSample));
+                    squares = vaddq_f64(squares, vmulq_f64(x, x));
+                    peak = vmaxq_f64(peak, vabsq_f64(x));
+
+                    vst1q_f64(field(HISTORY + position), x);
+                    vst1q_f64(field(HISTORY + position + TAPS), x);
+                    auto const* newest = field(HISTORY + position + TAPS);
+                    for (auto phase = std::size_t{0}; phase < PHASES; ++phase)
+                    {
+                        auto sum = vmulq_f64(vdupq_n_f64(TRUE_PEAK_FILTER[phase][0]), x);
+                        for (auto tap = std::size_t{1}; tap < TAPS; ++tap)
+                        {
+                            sum = vfmaq_f64(sum, vdupq_n_f64(TRUE_PEAK_FILTER[phase][tap]), vld1q_f64(newest - tap * in_channelCount));
+                        }
+                        truePeak = vmaxq_f64(truePeak, vabsq_f64(sum));
+                    }
+                    position = (position + 1U == TAPS) ? 0U : position + 1U;
+                }
+
+                vst1q_f64(field(SHELF_Z1), shelfZ1);
+                vst1q_f64(field(SHELF_Z2), shelfZ2);
+                vst1q_f64(field(HIGHPASS_Z1), highpassZ1);
+                vst1q_f64(field(HIGHPASS_Z2), highpassZ2);
+                vst1q_f64(field(PEAK), peak);
+                vst1q_f64(field(TRUE_PEAK), truePeak);
+                vst1q_f64(field(SUM_OF_SQUARES), squares);
+                vst1q_f64(field(WEIGHTED_SUM_OF_SQUARES), weighted);
+            }
+        }
+#endif
+
+        MeterImplementation selectImplementation() noexcept
+        {
+#if defined(__x86_64__)
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            {
+                return {&meterAvx2, "avx2"};
+            }
+#elif defined(__aarch64__)
+            // Advanced SIMD is mandatory on ARMv8-A.
+            return {&meterNeon, "neon"};
+#endif
+            return {&meterScalar, "scalar"};
+        }
+
+        MeterImplementation const& implementation() noexcept
+        {
+            static auto const result = selectImplementation();
+            return result;
+        }
+
+        /**
+         * Compute the coefficients of the K-weighting filter of ITU-R BS.1770-4 for a sample rate. The standard only
+         * lists them for 48 kHz, they are derived from the analog prototypes of both stages for other rates.
+         */
+        std::array<double, 10> kWeightingCoefficients(double in_sampleRate) noexcept
+        {
+            auto result = std::array<double, 10>{};
+
+            // High shelf modelling the acoustic effect of the head.
+            {
+                auto const f0 = 1681.974450955533;
+                auto const gain = 3.999843853973347;
+                auto const q = 0.7071752369554196;
+                auto const k = std::tan(std::numbers::pi * f0 / in_sampleRate);
+                auto const vh = std::pow(10.0, gain / 20.0);
+                auto const vb = std::pow(vh, 0.4996667741545416);
+                auto const a0 = 1.0 + k / q + k * k;
+                result[0] = (vh + vb * k / q + k * k) / a0;
+                result[1] = 2.0 * (k * k - vh) / a0;
+                result[2] = (vh - vb * k / q + k * k) / a0;
+                result[3] = 2.0 * (k * k - 1.0) / a0;
+                result[4] = (1.0 - k / q + k * k) / a0;
+            }
+
+            // Revised low-frequency B-curve high pass.
+            {
+                auto const f0 = 38.13547087602444;
+                auto const q = 0.5003270373238773;
+                auto const k = std::tan(std::numbers::pi * f0 / in_sampleRate);
+                auto const a0 = 1.0 + k / q + k * k;
+                result[5] = 1.0;
+                result[6] = -2.0;
+                result[7] = 1.0;
+                result[8] = 2.0 * (k * k - 1.0) / a0;
+                result[9] = (1.0 - k / q + k * k) / a0;
+            }
+            return result;
+        }
+    }
+
+    MXL_EXPORT
+    AudioMeter::AudioMeter(std::size_t in_channelCount, double in_sampleRate)
+        : _channelCount{in_channelCount}
+        , _paddedChannelCount{(in_channelCount + CHANNEL_ALIGNMENT - 1U) / CHANNEL_ALIGNMENT * CHANNEL_ALIGNMENT}
+        , _coefficients{kWeightingCoefficients(in_sampleRate)}
+        , _state(FIELD_COUNT * _paddedChannelCount)
+        , _weights(in_channelCount, 1.0)
+        , _channels(_paddedChannelCount)
+        , _historyPosition{0}
+        , _levelSamples{0}
+        , _blockSize{static_cast<std::size_t>(std::lround(in_sampleRate / 10.0))}
+        , _blockSamples{0}
+        , _blockEnergies{}
+        , _blockCount{0}
+    {
+        if (in_channelCount == 0U)
+        {
+            throw std::invalid_argument{"Audio meters require at least one channel."};
+        }
+        if (!(in_sampleRate >= 8000.0))
+        {
+            throw std::invalid_argument{"Audio meters require a sample rate of at least 8 kHz."};
+        }
+    }
+
+    MXL_EXPORT
+    void AudioMeter::setChannelWeight(std::size_t in_channel, double in_weight)
+    {
+        if (in_channel >= _channelCount)
+        {
+            throw std::invalid_argument{"Invalid audio meter channel."};
+        }
+        _weights[in_channel] = in_weight;
+    }
+
+    MXL_EXPORT
+    void AudioMeter::process(mxlWrappedMultiBufferSlice const& in_samples) noexcept
+    {
+        for (auto const& fragment : in_samples.base.fragments)
+        {
+            if (fragment.size != 0U)
+            {
+                process(static_cast<float const*>(fragment.pointer), fragment.size / sizeof(float), in_samples.stride);
+            }
+        }
+    }
+
+    MXL_EXPORT
+    void AudioMeter::process(float const* in_samples, std::size_t in_count, std::size_t in_stride) noexcept
+    {
+        auto const& meter = implementation();
+        for (auto offset = std::size_t{0}; offset < in_count;)
+        {
+            // Runs stop at the end of loudness blocks. Padding channels repeat the last channel.
+            auto const run = std::min(in_count - offset, _blockSize - _blockSamples);
+            for (auto channel = std::size_t{0}; channel < _paddedChannelCount; ++channel)
+            {
+                auto const source = std::min(channel, _channelCount - 1U);
+                _channels[channel] = reinterpret_cast<float const*>(reinterpret_cast<std::uint8_t const*>(in_samples) + source * in_stride) + offset;
+            }
+
+            meter.function(_channels.data(), _paddedChannelCount, run, _state.data(), _coefficients.data(), _historyPosition);
+
+            _historyPosition = (_historyPosition + run) % TAPS;
+            _levelSamples += run;
+            _blockSamples += run;
+            offset += run;
+            if (_blockSamples == _blockSize)
+            {
+                completeBlock();
+            }
+        }
+    }
+
+    MXL_EXPORT
+    void AudioMeter::resetLevels() noexcept
+    {
+        for (auto const field : {PEAK, TRUE_PEAK, SUM_OF_SQUARES})
+        {
+            std::fill_n(_state.begin() + field * _paddedChannelCount, _paddedChannelCount, 0.0);
+        }
+        _levelSamples = 0U;
+    }
+
+    MXL_EXPORT
+    double AudioMeter::peak(std::size_t in_channel) const noexcept
+    {
+        return (in_channel < _channelCount) ? _state[PEAK * _paddedChannelCount + in_channel] : 0.0;
+    }
+
+    MXL_EXPORT
+    double AudioMeter::truePeak(std::size_t in_channel) const noexcept
+    {
+        return (in_channel < _channelCount) ? _state[TRUE_PEAK * _paddedChannelCount + in_channel] : 0.0;
+    }
+
+    MXL_EXPORT
+    double AudioMeter::rms(std::size_t in_channel) const noexcept
+    {
+        if ((in_channel < _channelCount) && (_levelSamples != 0U))
+        {
+            return std::sqrt(_state[SUM_OF_SQUARES * _paddedChannelCount + in_channel] / static_cast<double>(_levelSamples));
+        }
+        return 0.0;
+    }
+
+    MXL_EXPORT
+    double AudioMeter::momentaryLoudness() const noexcept
+    {
+        return loudness(MOMENTARY_BLOCKS);
+    }
+
+    MXL_EXPORT
+    double AudioMeter::shortTermLoudness() const noexcept
+    {
+        return loudness(SHORT_TERM_BLOCKS);
+    }
+
+    double AudioMeter::loudness(std::size_t in_blocks) const noexcept
+    {
+        if (_blockCount < in_blocks)
+        {
+            return -std::numeric_limits<double>::infinity();
+        }
+
+        auto energy = 0.0;
+        for (auto block = _blockCount - in_blocks; block < _blockCount; ++block)
+        {
+            energy += _blockEnergies[block % _blockEnergies.size()];
+        }
+        energy /= static_cast<double>(in_blocks);
+        return (energy > 0.0) ? -0.691 + 10.0 * std::log10(energy) : -std::numeric_limits<double>::infinity();
+    }
+
+    void AudioMeter::completeBlock() noexcept
+    {
+        auto* const sums = _state.data() + WEIGHTED_SUM_OF_SQUARES * _paddedChannelCount;
+        auto energy = 0.0;
+        for (auto channel = std::size_t{0}; channel < _channelCount; ++channel)
+        {
+            energy += _weights[channel] * sums[channel];
+        }
+        std::fill_n(sums, _paddedChannelCount, 0.0);
+
+        _blockEnergies[_blockCount % _blockEnergies.size()] = energy / static_cast<double>(_blockSize);
+        ++_blockCount;
+        _blockSamples = 0U;
+    }
+
+    MXL_EXPORT
+    char const* audioMeterImplementation() noexcept
+    {
+        return implementation().name;
+    }
+}
@@ -0,0 +1,242 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/Crc32c.hpp"
+#include <cstring>
+#include <array>
+#include <mxl/platform.h>
+
+#if defined(__x86_64__)
+#   include <nmmintrin.h>
+#elif defined(__aarch64__)
+#   include <arm_acle.h>
+#   if defined(__linux__)
+#       include <asm/hwcap.h>
+#       include <sys/auxv.h>
+#   endif
+#endif
+
+namespace mxl::lib
+{
+    namespace
+    {
+        /** The bit reflected CRC32C (Castagnoli) polynomial. */
+        constexpr auto const CRC32C_POLYNOMIAL = std::uint32_t{0x82F6'3B78};
+
+        /**
+         * The number of bytes processed by each of the three interleaved
+         * streams of the hardware accelerated implementations per iteration.
+         */
+        constexpr auto const STRIPE_SIZE = std::size_t{8192};
+
+        using Crc32cFunction = std::uint32_t (*)(std::uint32_t, std::uint8_t const*, std::size_t) noexcept;
+
+        struct Crc32cImplementation
+        {
+            Crc32cFunction function;
+            char const* name;
+        };
+
+        using ByteTable = std::array<std::uint32_t, 256>;
+
+        constexpr ByteTable makeByteTable() noexcept
+        {
+            auto result = ByteTable{};
+            for (auto i = std::uint32_t{0}; i < result.size(); ++i)
+            {
+                auto crc = i;
+                for (auto bit = 0; bit < 8; ++bit)
+                {
+                    crc = ((crc & 1U) != 0U) ? ((crc >> 1) ^ CRC32C_POLYNOMIAL) : (crc >> 1);
+                }
+                result[i] = crc;
+            }
+            return result;
+        }
+
+        constexpr auto const BYTE_TABLE = makeByteTable();
+
+        /**
+         * Multiply two bit reflected polynomials modulo the CRC32C polynomial.
+         * \note in_a must not be 0.
+         */
+        constexpr std::uint32_t multiplyModP(std::uint32_t in_a, std::uint32_t in_b) noexcept
+        {
+            auto result = std::uint32_t{0};
+            for (auto mask = std::uint32_t{1} << 31; mask != 0U; mask >>= 1)
+            {
+                if ((in_a & mask) != 0U)
+                {
+                    result ^= in_b;
+                }
+                in_b = ((in_b & 1U) != 0U) ? ((in_b >> 1) ^ CRC32C_POLYNOMIAL) : (in_b >> 1);
+            }
+            return result;
+        }
+
+        /** Compute x^(8 * in_bytes) modulo the CRC32C polynomial. */
+        constexpr std::uint32_t byteShiftOperator(std::size_t in_bytes) noexcept
+        {
+            auto result = std::uint32_t{0x8000'0000}; // x^0
+            auto square = std::uint32_t{0x0080'0000}; // x^8
+            for (; in_bytes != 0U; in_bytes >>= 1)
+            {
+                if ((in_bytes & 1U) != 0U)
+                {
+                    result = multiplyModP(square, result);
+                }
+                square = multiplyModP(square, square);
+            }
+            return result;
+        }
+
+        /**
+         * Lookup tables that advance a CRC register over a fixed number of
+         * zero bytes, which is what is needed to concatenate the checksums
+         * of independently processed streams.
+         */
+        class ShiftTable
+        {
+        public:
+            constexpr explicit ShiftTable(std::size_t in_bytes) noexcept
+                : _tables{}
+            {
+                auto const shiftOperator = byteShiftOperator(in_bytes);
+                for (auto i = std::size_t{0}; i < _tables.size(); ++i)
+                {
+                    for (auto b = std::uint32_t{0}; b < 256U; ++b)
+                    {
+                        _tables[i][b] = multiplyModP(shiftOperator, b << (8U * i));
+                    }
+                }
+            }
+
+            constexpr std::uint32_t operator()(std::uint32_t in_crc) const noexcept
+            {
+                return _tables[0][in_crc & 0xFFU] ^ _tables[1][(in_crc >> 8) & 0xFFU] ^ _tables[2][(in_crc >> 16) & 0xFFU] ^
+                       _tables[3][in_crc >> 24];
+            }
+
+        private:
+            std::array<ByteTable, 4> _tables;
+        };
+
+        constexpr auto const SHIFT_ONE_STRIPE = ShiftTable{STRIPE_SIZE};
+        constexpr auto const SHIFT_TWO_STRIPES = ShiftTable{2U * STRIPE_SIZE};
+
+        std::uint64_t load64(std::uint8_t const* in_data) noexcept
+        {
+            auto result = std::uint64_t{};
+            std::memcpy(&result, in_data, sizeof result);
+            return result;
+        }
+
+        std::uint32_t crc32cTable(std::uint32_t in_crc, std::uint8_t const* in_data, std::size_t in_size) noexcept
+        {
+            for (auto const end = in_data + in_size; in_data != end; ++in_data)
+            {
+                in_crc = BYTE_TABLE[(in_crc ^ *in_data) & 0xFFU] ^ (in_crc >> 8);
+            }
+            return in_crc;
+        }
+
+#if defined(__x86_64__) || defined(__aarch64__)
+#   if defined(__x86_64__)
+#       define MXL_CRC32C_TARGET __attribute__((target("sse4.2")))
+#       define MXL_CRC32C_U64(crc, value) static_cast<std::uint32_t>(::_mm_crc32_u64((crc), (value)))
+#       define MXL_CRC32C_U8(crc, value) ::_mm_crc32_u8((crc), (value))
+#   elif defined(__clang__)
+#       define MXL_CRC32C_TARGET __attribute__((target("crc")))
+#       define MXL_CRC32C_U64(crc, value) ::__crc32cd((crc), (value))
+#       define MXL_CRC32C_U8(crc, value) ::__crc32cb((crc), (value))
+#   else
+#       define MXL_CRC32C_TARGET __attribute__((target("+crc")))
+#       define MXL_CRC32C_U64(crc, value) ::__crc32cd((crc), (value))
+#       define MXL_CRC32C_U8(crc, value) ::__crc32cb((crc), (value))
+#   endif
+
+        MXL_CRC32C_TARGET
+        std::uint32_t crc32cHardware(std::uint32_t in_crc, std::uint8_t const* in_data, std::size_t in_size) noexcept
+        {
+            // The CRC instructions have a latency of 3 cycles, but a throughput of 1 per cycle. Processing
+            // three independent streams at once keeps the execution unit busy, the partial checksums are
+            // then concatenated using precomputed shift tables.
+            for (; in_size >= 3U * STRIPE_SIZE; in_size -= 3U * STRIPE_SIZE, in_data += 3U * STRIPE_SIZE)
+            {
+                auto crc0 = in_crc;
+                auto crc1 = std::uint32_t{0};
+                auto crc2 = std::uint32_t{0};
+                for (auto i = std::size_t{0}; i < STRIPE_SIZE; i += sizeof(std::uint64_t))
+                {
+                    crc0 = MXL_CRC32C_U64(crc0, load64(in_data + i));
+                    crc1 = MXL_CRC32C_U64(crc1, load64(in_data + STRIPE_SIZE + i));
+                    crc2 = MXL_CRC32C_U64(crc2, load64(in_data + 2U * STRIPE_SIZE + i));
+                }
+                in_crc = SHIFT_TWO_STRIPES(crc0) ^ SHIFT_ONE_STRIPE(crc1) ^ crc2;
+            }
+
+            for (; in_size >= sizeof(std::uint64_t); in_size -= sizeof(std::uint64_t), in_data += sizeof(std::uint64_t))
+            {
+                in_crc = MXL_CRC32C_U64(in_crc, load64(in_data));
+            }
+
+            for (; in_size > 0U; --in_size, ++in_data)
+            {
+                in_crc = MXL_CRC32C_U8(in_crc, *in_data);
+            }
+            return in_crc;
+        }
+
+#   undef MXL_CRC32C_U8
+#   undef MXL_CRC32C_U64
+#   undef MXL_CRC32C_TARGET
+
+        bool hasHardwareSupport() noexcept
+        {
+#   if defined(__x86_64__)
+            return __builtin_cpu_supports("sse4.2");
+#   elif defined(__aarch64__) && defined(__APPLE__)
+            // All 64 bit Apple silicon implements the CRC extension.
+            return true;
+#   elif defined(__aarch64__) && defined(__linux__)
+            return (::getauxval(AT_HWCAP) & HWCAP_CRC32) != 0U;
+#   else
+            return false;
+#   endif
+        }
+#endif
+
+        Crc32cImplementation selectImplementation() noexcept
+        {
+#if defined(__x86_64__) || defined(__aarch64__)
+            if (hasHardwareSupport())
+            {
+#   if defined(__x86_64__)
+                return {&crc32cHardware, "sse4.2"};
+#   else
+                return {&crc32cHardware, "armv8-crc"};
+#   endif
+            }
+#endif
+            return {&crc32cTable, "table"};
+        }
+
+        Crc32cImplementation const& implementation() noexcept
+        {
+            static auto const result = selectImplementation();
+            return result;
+        }
+    }
+
+    MXL_EXPORT
+    std::uint32_t crc32c(void const* in_data, std::size_t in_size, std::uint32_t in_crc) noexcept
+    {
+        return ~implementation().function(~in_crc, static_cast<std::uint8_t const*>(in_data), in_size);
+    }
+
+    MXL_EXPORT
+    char const* crc32cImplementation() noexcept
+    {
+        return implementation().name;
+    }
+}
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/FabricsStats.hpp"
+#include <mxl/platform.h>
+#include "mxl-internal/SequenceLock.hpp"
+
+namespace mxl::lib
+{
+    MXL_EXPORT
+    void publishFabricsStats(FabricsStats& io_stats, FabricsValues const& in_values) noexcept
+    {
+        writeSequenced(io_stats.sequence, io_stats.values, in_values);
+    }
+
+    MXL_EXPORT
+    bool readFabricsStats(FabricsStats const& in_stats, FabricsValues& out_values) noexcept
+    {
+        return readSequenced(in_stats.sequence, in_stats.values, out_values);
+    }
+}
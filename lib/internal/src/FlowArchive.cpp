@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/FlowArchive.hpp"
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <system_error>
+#include <sys/mman.h>
+#include <mxl/platform.h>
+#include <mxl/time.h>
+#include "mxl-internal/Logging.hpp"
+#include "mxl-internal/PathUtils.hpp"
+
+namespace mxl::lib
+{
+    MXL_EXPORT
+    FlowArchive::FlowArchive(char const* path, AccessMode mode, std::size_t slotCount, std::size_t grainPayloadSize)
+        : FlowArchive{}
+    {
+        if (slotCount == 0U)
+        {
+            throw std::invalid_argument{"Attempt to open flow archive without any slots."};
+        }
+
+        auto const requiredSize = (mode == AccessMode::CREATE_READ_WRITE) ? slotCount * slotSizeFor(grainPayloadSize) : std::size_t{0};
+        _segment = SharedMemorySegment{path, mode, requiredSize};
+        _slotCount = slotCount;
+        _slotSize = _segment.mappedSize() / slotCount;
+
+        if ((_slotSize < MXL_GRAIN_PAYLOAD_OFFSET) || ((_slotSize % 4096U) != 0U))
+        {
+            throw std::system_error(EINVAL, std::generic_category(), "Flow archive does not have the expected geometry.");
+        }
+
+        // Archived grains are mostly read in sequence, but the archive as a whole is way too large to
+        // be read ahead speculatively by the kernel. Read-ahead is performed explicitly by readers.
+        (void)::madvise(_segment.data(), _segment.mappedSize(), MADV_RANDOM);
+    }
+
+    MXL_EXPORT
+    Grain* FlowArchive::find(std::uint64_t index) noexcept
+    {
+        if (auto const slot = slotAt(index); slot != nullptr)
+        {
+            auto const slotIndex = std::atomic_ref{slot->header.info.index};
+            auto const version = slot->header.info.version;
+            if ((version >= GRAIN_HEADER_MIN_VERSION) && (version <= GRAIN_HEADER_VERSION) && (slotIndex.load(std::memory_order_acquire) == index))
+            {
+                return slot;
+            }
+        }
+        return nullptr;
+    }
+
+    MXL_EXPORT
+    void FlowArchive::store(Grain const& grain) noexcept
+    {
+        auto const index = grain.header.info.index;
+        if (auto const slot = slotAt(index); slot != nullptr)
+        {
+            auto const payloadSize = std::min<std::size_t>(grain.header.info.grainSize, _slotSize - sizeof(GrainHeader));
+            if (payloadSize < grain.header.info.grainSize)
+            {
+                MXL_WARN("Grain {} is larger than the archive slot size. Payload will be truncated.", index);
+            }
+
+            // Take the slot out of circulation while we are updating it, so that readers
+            // never observe a header that doesn't match the payload.
+            auto const slotIndex = std::atomic_ref{slot->header.info.index};
+            slotIndex.store(MXL_UNDEFINED_INDEX, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            // Repeated grains only reference the payload of their source grain, which is archived on its own.
+            if ((grain.header.info.flags & MXL_GRAIN_FLAG_REPEAT) == 0)
+            {
+                std::memcpy(&slot->header + 1, &grain.header + 1, payloadSize);
+            }
+
+            auto info = grain.header.info;
+            info.index = MXL_UNDEFINED_INDEX;
+            slot->header.info = info;
+
+            slotIndex.store(index, std::memory_order_release);
+        }
+    }
+
+    MXL_EXPORT
+    void FlowArchive::invalidate(std::uint64_t index) noexcept
+    {
+        if (auto const slot = slotAt(index); slot != nullptr)
+        {
+            auto const slotIndex = std::atomic_ref{slot->header.info.index};
+            auto expected = index;
+            slotIndex.compare_exchange_strong(expected, MXL_UNDEFINED_INDEX, std::memory_order_release, std::memory_order_relaxed);
+        }
+    }
+
+    MXL_EXPORT
+    void FlowArchive::prefetch(std::uint64_t index, std::size_t count) const noexcept
+    {
+        if (isValid())
+        {
+            auto const base = static_cast<std::uint8_t const*>(_segment.data());
+            count = std::min(count, _slotCount);
+
+            // The range may wrap around the end of the archive, in which case it is split in two.
+            auto const first = index % _slotCount;
+            auto const head = std::min(count, _slotCount - first);
+            (void)::madvise(const_cast<std::uint8_t*>(base + first * _slotSize), head * _slotSize, MADV_WILLNEED);
+            if (head < count)
+            {
+                (void)::madvise(const_cast<std::uint8_t*>(base), (count - head) * _slotSize, MADV_WILLNEED);
+            }
+        }
+    }
+
+    Grain* FlowArchive::slotAt(std::uint64_t index) noexcept
+    {
+        if (isValid() && (index != MXL_UNDEFINED_INDEX))
+        {
+            auto const base = static_cast<std::uint8_t*>(_segment.data());
+            return reinterpret_cast<Grain*>(base + (index % _slotCount) * _slotSize);
+        }
+        return nullptr;
+    }
+
+    MXL_EXPORT
+    void removeFlowArchive(std::filesystem::path const& flowDirectory) noexcept
+    {
+        auto ec = std::error_code{};
+        auto const link = makeFlowArchiveLinkPath(flowDirectory);
+        if (is_symlink(link, ec))
+        {
+            if (auto const target = read_symlink(link, ec); !ec)
+            {
+                if (std::filesystem::remove(target, ec); ec)
+                {
+                    MXL_DEBUG("Failed to remove flow archive '{}': {}", target.string(), ec.message());
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "FlowArchiver.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <mxl/time.h>
+#include "mxl-internal/Logging.hpp"
+
+namespace mxl::lib
+{
+    namespace
+    {
+        FlowArchive& checkedArchive(DiscreteFlowData& flowData)
+        {
+            if (auto const archive = flowData.archive(); archive != nullptr)
+            {
+                return *archive;
+            }
+            throw std::invalid_argument{"Attempt to archive a flow without an archive."};
+        }
+    }
+
+    FlowArchiver::FlowArchiver(DiscreteFlowData& flowData)
+        : _flowData{flowData}
+        , _archive{checkedArchive(flowData)}
+        , _mutex{}
+        , _cv{}
+        , _committedIndex{MXL_UNDEFINED_INDEX}
+        , _stopping{false}
+        , _archivedIndex{MXL_UNDEFINED_INDEX}
+        , _thread{}
+    {
+        _thread = std::thread{[this]() { run(); }};
+    }
+
+    FlowArchiver::~FlowArchiver()
+    {
+        {
+            auto const lock = std::lock_guard{_mutex};
+            _stopping = true;
+        }
+        _cv.notify_one();
+        _thread.join();
+    }
+
+    void FlowArchiver::grainCommitted(std::uint64_t in_index) noexcept
+    {
+        {
+            auto const lock = std::lock_guard{_mutex};
+            _committedIndex = in_index;
+        }
+        _cv.notify_one();
+    }
+
+    void FlowArchiver::run()
+    {
+        auto const grainCount = std::uint64_t{_flowData.flowInfo()->config.discrete.grainCount};
+
+        auto lock = std::unique_lock{_mutex};
+        while (true)
+        {
+            _cv.wait(lock, [this]() { return _stopping || (_committedIndex != _archivedIndex); });
+            if (_stopping)
+            {
+                break;
+            }
+            auto const committedIndex = _committedIndex;
+            lock.unlock();
+
+            // Only grains that are still present in the ring buffer can be archived.
+            auto const oldestIndex = (committedIndex >= grainCount) ? (committedIndex - grainCount + 1U) : std::uint64_t{0};
+            auto firstIndex = (_archivedIndex == MXL_UNDEFINED_INDEX) ? committedIndex : (_archivedIndex + 1U);
+            if ((firstIndex < oldestIndex) || (firstIndex > committedIndex))
+            {
+                if (_archivedIndex != MXL_UNDEFINED_INDEX)
+                {
+                    MXL_WARN("Flow archiver fell behind or the writer jumped. Grains {} to {} are not archived.", firstIndex, oldestIndex - 1U);
+                }
+                firstIndex = oldestIndex;
+            }
+
+            for (auto index = firstIndex; index <= committedIndex; ++index)
+            {
+                archiveGrain(index);
+            }
+            _archivedIndex = committedIndex;
+
+            lock.lock();
+        }
+    }
+
+    void FlowArchiver::archiveGrain(std::uint64_t in_index) noexcept
+    {
+        auto const grainCount = _flowData.flowInfo()->config.discrete.grainCount;
+        auto const grain = _flowData.grainAt(in_index % grainCount);
+        auto const ringIndex = std::atomic_ref{grain->header.info.index};
+
+        // Skip grains that were never written, or were overwritten already.
+        if (ringIndex.load(std::memory_order_acquire) == in_index)
+        {
+            _archive.store(*grain);
+
+            // The writer might have lapped us while we were copying, in which case the archived grain
+            // may be torn. Make sure readers never get to see it.
+            if (ringIndex.load(std::memory_order_acquire) != in_index)
+            {
+                _archive.invalidate(in_index);
+            }
+        }
+    }
+}
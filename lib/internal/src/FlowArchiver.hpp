@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "mxl-internal/DiscreteFlowData.hpp"
+
+namespace mxl::lib
+{
+    /**
+     * Asynchronously copies committed grains from the ring buffer of a discrete
+     * flow into its disk-backed history archive.
+     *
+     * Copying is performed on a dedicated thread, so that committing grains is
+     * never delayed by the (potentially much slower) archive storage. If the
+     * archiver falls behind by more than the depth of the ring buffer, the
+     * grains that were overwritten in the meantime are skipped.
+     */
+    class FlowArchiver final
+    {
+    public:
+        /**
+         * \param[in] flowData The flow to archive. Must have an open archive and
+         *      must outlive the archiver.
+         */
+        explicit FlowArchiver(DiscreteFlowData& flowData);
+
+        /** Stops the archiving thread. Grains that were not archived yet are dropped. */
+        ~FlowArchiver();
+
+        FlowArchiver(FlowArchiver const&) = delete;
+        FlowArchiver& operator=(FlowArchiver const&) = delete;
+
+        /**
+         * Notify the archiver that all grains up to and including the specified
+         * index have been committed.
+         */
+        void grainCommitted(std::uint64_t in_index) noexcept;
+
+    private:
+        void run();
+
+        /**
+         * Copy the grain with the specified index from the ring buffer into
+         * the archive.
+         */
+        void archiveGrain(std::uint64_t in_index) noexcept;
+
+    private:
+        DiscreteFlowData& _flowData;
+        FlowArchive& _archive;
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        /** Most recent committed index. Protected by _mutex. */
+        std::uint64_t _committedIndex;
+        /** Set to true to stop the archiving thread. Protected by _mutex. */
+        bool _stopping;
+
+        /** Most recent archived index. Only accessed by the archiving thread. */
+        std::uint64_t _archivedIndex;
+
+        std::thread _thread;
+    };
+}
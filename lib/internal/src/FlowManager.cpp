@@ -11,6 +11,7 @@
 #include <sys/stat.h>
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
+#include "mxl-internal/FlowArchive.hpp"
 #include "mxl-internal/Logging.hpp"
 #include "mxl-internal/PathUtils.hpp"
 #include "mxl-internal/SharedMemory.hpp"
@@ -143,7 +144,7 @@ namespace mxl::lib
     std::unique_ptr<DiscreteFlowData> FlowManager::createDiscreteFlow(uuids::uuid const& flowId, std::string const& flowDef, mxlDataFormat flowFormat,
         std::size_t grainCount, mxlRational const& grainRate, std::size_t grainPayloadSize, std::size_t grainNumOfSlices,
         std::array<uint32_t, MXL_MAX_PLANES_PER_GRAIN> grainSliceLengths, std::uint32_t maxSyncBatchSizeHintOpt,
-        std::uint32_t maxCommitBatchSizeHintOpt)
+        std::uint32_t maxCommitBatchSizeHintOpt, std::size_t archiveGrainCount, std::filesystem::path const& archiveDirectory, std::uint32_t flags)
     {
         auto const uuidString = uuids::to_string(flowId);
         MXL_DEBUG("Create discrete flow. id: {}, grainCount: {}, grain payload size: {}", uuidString, grainCount, grainPayloadSize);
@@ -154,7 +155,14 @@ namespace mxl::lib
             throw std::runtime_error{"Attempt to create discrete flow with unsupported or non matching format."};
         }
 
+        if ((archiveGrainCount > 0U) && (archiveGrainCount <= grainCount))
+        {
+            throw std::invalid_argument{"The flow archive must hold more grains than the ring buffer."};
+        }
+
         auto const tempDirectory = createTemporaryFlowDirectory(_mxlDomain);
+        auto const archiveFile = (archiveGrainCount > 0U) ? makeFlowArchiveFilePath(archiveDirectory, uuidString) : std::filesystem::path{};
+        auto ownsArchiveFile = false;
         try
         {
             // Write the json file to disk.
@@ -172,11 +180,13 @@ namespace mxl::lib
             auto flowData = std::make_unique<DiscreteFlowData>(flowDataPath.string().c_str(), AccessMode::CREATE_READ_WRITE);
 
             auto& info = *flowData->flowInfo();
-            info.version = FLOW_DATA_VERSION;
+            info.version = DISCRETE_FLOW_DATA_VERSION;
             info.size = sizeof info;
             info.config.common = initCommonFlowConfigInfo(flowId, flowFormat, grainRate, maxSyncBatchSizeHintOpt, maxCommitBatchSizeHintOpt);
+            info.config.common.flags = flags;
             info.config.discrete = {};
             info.config.discrete.grainCount = grainCount;
+            info.config.discrete.archiveGrainCount = archiveGrainCount;
             std::copy(grainSliceLengths.begin(), grainSliceLengths.end(), info.config.discrete.sliceSizes);
 
             info.runtime = initFlowRuntimeInfo();
@@ -190,14 +200,17 @@ namespace mxl::lib
                 throw std::filesystem::filesystem_error{"Could not create grain directory.", grainDir, std::make_error_code(std::errc::io_error)};
             }
 
-            for (auto i = std::size_t{0}; i < grainCount; ++i)
+            if (grainCount > 0U)
             {
-                auto const grainPath = makeGrainDataFilePath(grainDir, i);
-                MXL_TRACE("Creating grain: {}", grainPath.string());
-
                 // \todo Handle payload stored device memory
-                auto const grain = flowData->emplaceGrain(grainPath.string().c_str(), grainPayloadSize);
-                auto& gInfo = grain->header.info;
+                auto const arenaPath = makeGrainArenaFilePath(grainDir);
+                MXL_TRACE("Creating grain arena: {}", arenaPath.string());
+                flowData->openGrainArena(arenaPath.string().c_str(), grainPayloadSize);
+            }
+
+            for (auto i = std::size_t{0}; i < grainCount; ++i)
+            {
+                auto& gInfo = flowData->grainAt(i)->header.info;
                 gInfo.grainSize = grainPayloadSize;
                 gInfo.totalSlices = grainNumOfSlices;
                 gInfo.validSlices = 0;
@@ -206,6 +219,23 @@ namespace mxl::lib
             }
 
             auto const finalDir = makeFlowDirectoryName(_mxlDomain, uuidString);
+
+            // If the flow already exists, publishing the flow directory below fails and the archive of the
+            // existing flow must be left alone.
+            if ((archiveGrainCount > 0U) && !exists(finalDir))
+            {
+                MXL_DEBUG("Create flow archive. id: {}, path: {}, grainCount: {}", uuidString, archiveFile.string(), archiveGrainCount);
+
+                // An archive without a matching flow directory is a leftover of a flow that was not properly
+                // cleaned up. Get rid of it, so that we don't inherit its geometry or contents.
+                auto ec = std::error_code{};
+                std::filesystem::remove(archiveFile, ec);
+
+                ownsArchiveFile = true;
+                flowData->openArchive(archiveFile.string().c_str(), grainPayloadSize);
+                create_symlink(archiveFile, makeFlowArchiveLinkPath(tempDirectory));
+            }
+
             publishFlowDirectory(tempDirectory, finalDir);
 
             return flowData;
@@ -214,6 +244,10 @@ namespace mxl::lib
         {
             auto ec = std::error_code{};
             remove_all(tempDirectory, ec);
+            if (ownsArchiveFile)
+            {
+                std::filesystem::remove(archiveFile, ec);
+            }
             throw;
         }
     }
@@ -286,13 +320,16 @@ namespace mxl::lib
         if (auto const flowFile = makeFlowDataFilePath(base); exists(flowFile))
         {
             auto flowSegment = SharedMemoryInstance<Flow>{flowFile.string().c_str(), in_mode, 0U};
-            if (flowSegment.get()->info.version != FLOW_DATA_VERSION)
+            // Only the layout of discrete flows changed since the first version, continuous flows are still at version 1.
+            auto const flowFormat = flowSegment.get()->info.config.common.format;
+            auto const maxVersion = mxlIsDiscreteDataFormat(flowFormat) ? DISCRETE_FLOW_DATA_VERSION : FLOW_DATA_VERSION;
+            if (auto const version = flowSegment.get()->info.version; (version < FLOW_DATA_VERSION) || (version > maxVersion))
             {
                 throw std::invalid_argument{
-                    fmt::format("Unsupported flow data version: {}, supported is: {}", flowSegment.get()->info.version, FLOW_DATA_VERSION)};
+                    fmt::format("Unsupported flow data version: {}, supported are: {} to {}", version, FLOW_DATA_VERSION, maxVersion)};
             }
 
-            if (auto const flowFormat = flowSegment.get()->info.config.common.format; mxlIsDiscreteDataFormat(flowFormat))
+            if (mxlIsDiscreteDataFormat(flowFormat))
             {
                 return openDiscreteFlow(base, std::move(flowSegment));
             }
@@ -321,9 +358,15 @@ namespace mxl::lib
         if (grainCount > 0U)
         {
             auto const grainDir = makeGrainDirectoryName(flowDir);
-            if (exists(grainDir) && is_directory(grainDir))
+            auto const arenaPath = makeGrainArenaFilePath(grainDir);
+            if (auto ec = std::error_code{}; is_regular_file(arenaPath, ec))
             {
-                // Open each grain with per-item error handling
+                MXL_TRACE("Opening grain arena: {}", arenaPath.string());
+                flowData->openGrainArena(arenaPath.string().c_str(), /*grainPayloadSize=*/0U);
+            }
+            else if (exists(grainDir) && is_directory(grainDir))
+            {
+                // Flows created before the grain arena was introduced store each grain in a file of its own.
                 for (auto i = 0U; i < grainCount; ++i)
                 {
                     auto const grainPath = makeGrainDataFilePath(grainDir, i).string();
@@ -339,6 +382,20 @@ namespace mxl::lib
             }
         }
 
+        if (flowData->flowInfo()->config.discrete.archiveGrainCount > 0U)
+        {
+            // The archive lives outside of the domain and may not be reachable from every container
+            // that has access to the domain. Such readers simply don't get the extended history.
+            if (auto const archiveLink = makeFlowArchiveLinkPath(flowDir); exists(archiveLink))
+            {
+                flowData->openArchive(archiveLink.string().c_str(), /*grainPayloadSize=*/0U);
+            }
+            else
+            {
+                MXL_WARN("Flow archive not reachable: {}. Serving the ring buffer history only.", archiveLink.string());
+            }
+        }
+
         return flowData;
     }
 
@@ -379,6 +436,7 @@ namespace mxl::lib
         {
             // Compute the flow directory path
             auto const flowPath = makeFlowDirectoryName(_mxlDomain, uuid);
+            removeFlowArchive(flowPath);
             auto const removed = remove_all(flowPath);
             if (removed == 0)
             {
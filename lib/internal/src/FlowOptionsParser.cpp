@@ -67,6 +67,42 @@ namespace mxl::lib
                 throw std::invalid_argument{"maxSyncBatchSizeHint must be a multiple of maxCommitBatchSizeHint."};
             }
         }
+
+        auto archiveDurationIt = _root.find("archiveDuration");
+        if (archiveDurationIt != _root.end())
+        {
+            if (!archiveDurationIt->second.is<double>())
+            {
+                throw std::invalid_argument{"archiveDuration must be a number."};
+            }
+
+            auto const v = archiveDurationIt->second.get<double>();
+            if (v < 1)
+            {
+                throw std::invalid_argument{"archiveDuration must be greater or equal to 1."};
+            }
+            _archiveDuration = static_cast<std::uint64_t>(v);
+        }
+
+        auto checksumIt = _root.find("checksum");
+        if (checksumIt != _root.end())
+        {
+            if (!checksumIt->second.is<std::string>() || (checksumIt->second.get<std::string>() != "crc32c"))
+            {
+                throw std::invalid_argument{"checksum must be \"crc32c\"."};
+            }
+            _grainChecksum = true;
+        }
+
+        auto multiProducerIt = _root.find("multiProducer");
+        if (multiProducerIt != _root.end())
+        {
+            if (!multiProducerIt->second.is<bool>())
+            {
+                throw std::invalid_argument{"multiProducer must be a boolean."};
+            }
+            _multiProducer = multiProducerIt->second.get<bool>();
+        }
     }
 
     std::optional<std::uint32_t> FlowOptionsParser::getMaxCommitBatchSizeHint() const
@@ -78,4 +114,19 @@ namespace mxl::lib
     {
         return _maxSyncBatchSizeHint;
     }
+
+    std::optional<std::uint64_t> FlowOptionsParser::getArchiveDuration() const
+    {
+        return _archiveDuration;
+    }
+
+    bool FlowOptionsParser::getGrainChecksum() const
+    {
+        return _grainChecksum;
+    }
+
+    bool FlowOptionsParser::getMultiProducer() const
+    {
+        return _multiProducer;
+    }
 } // namespace mxl::lib
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "mxl-internal/FlowReader.hpp"
+#include <atomic>
 #include <utility>
 
 namespace mxl::lib
@@ -27,4 +28,17 @@ namespace mxl::lib
     {
         return _domain;
     }
+
+    mxlFlowRuntimeView FlowReader::getFlowRuntimeView() const
+    {
+        auto const flow = getFlowData().flow();
+        return {&flow->info.runtime, &flow->state.syncCounter};
+    }
+
+    std::uint64_t FlowReader::getHeadIndex() const
+    {
+        // The flow data is mapped read-only, but atomic loads never write to the referenced object.
+        auto& headIndex = const_cast<std::uint64_t&>(getFlowData().flowInfo()->runtime.headIndex);
+        return std::atomic_ref{headIndex}.load(std::memory_order_acquire);
+    }
 }
@@ -25,6 +25,7 @@
 #include <mxl/mxl.h>
 #include <mxl/time.h>
 #include "mxl-internal/DomainWatcher.hpp"
+#include "mxl-internal/FlowArchive.hpp"
 #include "mxl-internal/FlowManager.hpp"
 #include "mxl-internal/FlowOptionsParser.hpp"
 #include "mxl-internal/FlowParser.hpp"
@@ -36,6 +37,7 @@ namespace mxl::lib
     namespace
     {
         constexpr auto MXL_HISTORY_DURATION_OPTION = "urn:x-mxl:option:history_duration/v1.0";
+        constexpr auto MXL_ARCHIVE_DIRECTORY_OPTION = "urn:x-mxl:option:archive_directory/v1.0";
 
         std::once_flag loggingFlag;
 
@@ -82,6 +84,7 @@ namespace mxl::lib
         , _mutex{}
         , _options{options}
         , _historyDuration{100'000'000ULL}
+        , _archiveDirectory{}
         , _watcher{}
         , _stopping{false}
     {
@@ -241,6 +244,33 @@ namespace mxl::lib
 
             auto const batchSizeDefault = parser.getTotalPayloadSlices();
 
+            // Compute the number of archived grains if the flow should have a long history.
+            auto archiveGrainCount = std::size_t{0};
+            if (auto const archiveDuration = optionsParser.getArchiveDuration(); archiveDuration)
+            {
+                if (_archiveDirectory.empty())
+                {
+                    throw std::invalid_argument{"The archiveDuration flow option requires an archive directory to be configured for the domain."};
+                }
+                archiveGrainCount = *archiveDuration * grainRate.numerator / (1'000'000'000ULL * grainRate.denominator);
+            }
+
+            auto flags = optionsParser.getGrainChecksum() ? MXL_FLOW_FLAG_GRAIN_CHECKSUM : 0U;
+            if (optionsParser.getMultiProducer())
+            {
+                // Records are appended to a grain by several producers at once, so there is no single point in time at which the
+                // grain is complete. This rules out anything that processes complete grains on behalf of the writer.
+                if (format != MXL_DATA_FORMAT_DATA)
+                {
+                    throw std::invalid_argument{"The multiProducer flow option is only supported for data flows."};
+                }
+                if (optionsParser.getGrainChecksum() || (archiveGrainCount != 0U))
+                {
+                    throw std::invalid_argument{"The multiProducer flow option cannot be combined with checksum or archiveDuration."};
+                }
+                flags |= MXL_FLOW_FLAG_MULTI_PRODUCER;
+            }
+
             return _flowManager.createDiscreteFlow(parser.getId(),
                 flowDef,
                 parser.getFormat(),
@@ -250,10 +280,26 @@ namespace mxl::lib
                 parser.getTotalPayloadSlices(),
                 parser.getPayloadSliceLengths(),
                 optionsParser.getMaxSyncBatchSizeHint().value_or(batchSizeDefault),
-                optionsParser.getMaxCommitBatchSizeHint().value_or(batchSizeDefault));
+                optionsParser.getMaxCommitBatchSizeHint().value_or(batchSizeDefault),
+                archiveGrainCount,
+                _archiveDirectory,
+                flags);
         }
         else if (mxlIsContinuousDataFormat(format))
         {
+            if (optionsParser.getArchiveDuration())
+            {
+                throw std::invalid_argument{"The archiveDuration flow option is only supported for discrete flows."};
+            }
+            if (optionsParser.getGrainChecksum())
+            {
+                throw std::invalid_argument{"The checksum flow option is only supported for discrete flows."};
+            }
+            if (optionsParser.getMultiProducer())
+            {
+                throw std::invalid_argument{"The multiProducer flow option is only supported for data flows."};
+            }
+
             // Read the mandatory grain_rate field
             auto const sampleRate = parser.getGrainRate();
             // Compute the grain count based on our configured history duration
@@ -291,6 +337,11 @@ namespace mxl::lib
         return _flowManager.getDomain();
     }
 
+    FlowIoFactory& Instance::getFlowIoFactory() noexcept
+    {
+        return *_flowIoFactory;
+    }
+
     std::string Instance::getFlowDef(uuids::uuid const& flowId) const
     {
         return _flowManager.getFlowDef(flowId);
@@ -337,6 +388,7 @@ namespace mxl::lib
                         if (!active)
                         {
                             std::error_code ec;
+                            removeFlowArchive(entry.path());
                             std::filesystem::remove_all(entry.path(), ec);
                             if (ec)
                             {
@@ -399,6 +451,12 @@ namespace mxl::lib
                         MXL_TRACE("Found history duration option in domain specific options: {}ns", it->second.get<double>());
                         historyDuration = static_cast<std::uint64_t>(it->second.get<double>());
                     }
+
+                    if (auto it = config.find(MXL_ARCHIVE_DIRECTORY_OPTION); it != config.end() && it->second.is<std::string>())
+                    {
+                        MXL_TRACE("Found archive directory option in domain specific options: {}", it->second.get<std::string>());
+                        _archiveDirectory = it->second.get<std::string>();
+                    }
                 }
                 else
                 {
@@ -0,0 +1,328 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/Keyer.hpp"
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <mxl/platform.h>
+
+#if defined(__x86_64__)
+#   include <immintrin.h>
+#elif defined(__aarch64__)
+#   include <arm_neon.h>
+#endif
+
+namespace mxl::lib
+{
+    namespace
+    {
+        /** Size in bytes of a v210 block, which packs 6 pixels as 12 samples in 4 words of 3 samples each. */
+        constexpr auto const V210_BLOCK_SIZE = std::size_t{16};
+
+        /** Number of pixels in a v210 block. */
+        constexpr auto const V210_BLOCK_PIXELS = std::size_t{6};
+
+        /** Number of key words covering the pixels of a v210 block. */
+        constexpr auto const KEY_WORDS_PER_BLOCK = std::size_t{2};
+
+        /** The pixel (within its block) whose key applies to each of the 12 samples of a v210 block (Cb Y Cr Y Cb Y Cr Y Cb Y Cr Y). */
+        constexpr auto const SAMPLE_KEY_PIXEL = std::array<std::uint8_t, 12>{0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5};
+
+        /** Chroma samples are centered on this level, regardless of the range of the signal. */
+        constexpr auto const CHROMA_ZERO = std::int32_t{512};
+
+        struct LineArgs
+        {
+            std::uint8_t const* fill;
+            std::uint8_t const* key;
+            std::uint8_t const* background;
+            std::uint8_t* output;
+            std::size_t blocks;
+            std::size_t keyWords;
+            KeyMode mode;
+            bool fullRangeKey;
+        };
+
+        /**
+         * Process as many whole v210 blocks of a line as the implementation
+         * can, starting at the beginning of the line.
+         * \return The number of blocks processed.
+         */
+        using KeyBlocksFunction = std::size_t (*)(LineArgs const&) noexcept;
+
+        struct KeyerImplementation
+        {
+            KeyBlocksFunction function;
+            char const* name;
+        };
+
+        std::uint32_t load32(std::uint8_t const* in_data) noexcept
+        {
+            auto result = std::uint32_t{};
+            std::memcpy(&result, in_data, sizeof result);
+            return result;
+        }
+
+        void store32(std::uint8_t* out_data, std::uint32_t in_value) noexcept
+        {
+            std::memcpy(out_data, &in_value, sizeof in_value);
+        }
+
+        /** Convert a 10 bit key sample to a blending weight in the range 0 to 1024. */
+        constexpr std::int32_t keyWeight(std::int32_t in_key, bool in_fullRangeKey) noexcept
+        {
+            // 1197 / 1024 ~= 1024 / 876 and 1025 / 1024 ~= 1024 / 1023, rounded so that the largest key maps to exactly 1024.
+            return in_fullRangeKey ? ((in_key * 1025 + 512) >> 10) : ((std::clamp(in_key - 64, 0, 876) * 1197 + 512) >> 10);
+        }
+
+        constexpr std::int32_t blendSample(std::int32_t in_fill, std::int32_t in_background, std::int32_t in_weight, std::int32_t in_zero,
+            KeyMode in_mode) noexcept
+        {
+            auto const result = (in_mode == KeyMode::STRAIGHT) ? (in_background + (((in_fill - in_background) * in_weight + 512) >> 10))
+                                                               : (in_fill + (((in_background - in_zero) * (1024 - in_weight) + 512) >> 10));
+            return std::clamp(result, 0, 1023);
+        }
+
+        std::size_t keyBlocksNone(LineArgs const&) noexcept
+        {
+            return 0U;
+        }
+
+        void keyBlocksScalar(LineArgs const& in_args, std::size_t in_firstBlock) noexcept
+        {
+            auto const lumaZero = in_args.fullRangeKey ? std::int32_t{0} : std::int32_t{64};
+            for (auto block = in_firstBlock; block < in_args.blocks; ++block)
+            {
+                auto const offset = block * V210_BLOCK_SIZE;
+                auto keys = std::array<std::int32_t, V210_BLOCK_PIXELS>{};
+                for (auto pixel = std::size_t{0}; pixel < keys.size(); ++pixel)
+                {
+                    // The key line may be shorter than the padded fill line, pixels past its end are fully transparent.
+                    if (auto const word = block * KEY_WORDS_PER_BLOCK + pixel / 3U; word < in_args.keyWords)
+                    {
+                        auto const key = static_cast<std::int32_t>((load32(in_args.key + 4U * word) >> (10U * (pixel % 3U))) & 0x3FFU);
+                        keys[pixel] = keyWeight(key, in_args.fullRangeKey);
+                    }
+                }
+
+                for (auto word = std::size_t{0}; word < 4U; ++word)
+                {
+                    auto const fill = load32(in_args.fill + offset + 4U * word);
+                    auto const background = load32(in_args.background + offset + 4U * word);
+                    auto result = std::uint32_t{0};
+                    for (auto component = std::size_t{0}; component < 3U; ++component)
+                    {
+                        auto const sample = 3U * word + component;
+                        auto const zero = ((sample % 2U) != 0U) ? lumaZero : CHROMA_ZERO;
+                        auto const f = static_cast<std::int32_t>((fill >> (10U * component)) & 0x3FFU);
+                        auto const b = static_cast<std::int32_t>((background >> (10U * component)) & 0x3FFU);
+                        result |= static_cast<std::uint32_t>(blendSample(f, b, keys[SAMPLE_KEY_PIXEL[sample]], zero, in_args.mode)) << (10U * component);
+                    }
+                    store32(in_args.output + offset + 4U * word, result);
+                }
+            }
+        }
+
+#if defined(__x86_64__)
+#   define MXL_KEYER_AVX2 __attribute__((target("avx2")))
+
+        /** \see keyWeight */
+        MXL_KEYER_AVX2
+        __m256i keyWeightAvx2(__m256i in_key, bool in_fullRangeKey) noexcept
+        {
+            auto const half = _mm256_set1_epi32(512);
+            if (in_fullRangeKey)
+            {
+                return _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(in_key, _mm256_set1_epi32(1025)), half), 10);
+            }
+
+            auto const key = _mm256_min_epi32(_mm256_max_epi32(_mm256_sub_epi32(in_key, _mm256_set1_epi32(64)), _mm256_setzero_si256()),
+                _mm256_set1_epi32(876));
+            return _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(key, _mm256_set1_epi32(1197)), half), 10);
+        }
+
+        /** \see blendSample */
+        MXL_KEYER_AVX2
+        __m256i blendSamplesAvx2(__m256i in_fill, __m256i in_background, __m256i in_weight, __m256i in_zero, KeyMode in_mode) noexcept
+        {
+            auto const half = _mm256_set1_epi32(512);
+            auto const result = (in_mode == KeyMode::STRAIGHT)
+                                  ? _mm256_add_epi32(in_background,
+                                        _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(in_fill, in_background), in_weight), half), 10))
+                                  : _mm256_add_epi32(in_fill,
+                                        _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(in_background, in_zero),
+                                                                               _mm256_sub_epi32(_mm256_set1_epi32(1024), in_weight)),
+                                                              half),
+                                            10));
+            return _mm256_min_epi32(_mm256_max_epi32(result, _mm256_setzero_si256()), _mm256_set1_epi32(1023));
+        }
+
+        MXL_KEYER_AVX2
+        std::size_t keyBlocksAvx2(LineArgs const& in_args) noexcept
+        {
+            // Each 32 bit lane holds one word of a v210 block, two blocks are processed per iteration. The three samples of
+            // every word are blended one after the other, which keeps the samples in place and avoids any shuffling of the
+            // fill and background. Only the key words need to be distributed to the lanes that use them.
+            auto const mask = _mm256_set1_epi32(0x3FF);
+            auto const c = CHROMA_ZERO;
+            auto const y = in_args.fullRangeKey ? 0 : 64;
+
+            // For each of the 3 samples of a word: the key word and bit offset of the key that applies to it in every lane,
+            // and the zero level of the sample (samples alternate between chroma and luma).
+            auto const keyWord = std::array{_mm256_setr_epi32(0, 0, 0, 1, 2, 2, 2, 3),
+                _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3),
+                _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3)};
+            auto const keyShift = std::array{_mm256_setr_epi32(0, 10, 20, 10, 0, 10, 20, 10),
+                _mm256_setr_epi32(0, 20, 0, 10, 0, 20, 0, 10),
+                _mm256_setr_epi32(0, 20, 10, 20, 0, 20, 10, 20)};
+            auto const sampleZero = std::array{_mm256_setr_epi32(c, y, c, y, c, y, c, y),
+                _mm256_setr_epi32(y, c, y, c, y, c, y, c),
+                _mm256_setr_epi32(c, y, c, y, c, y, c, y)};
+
+            auto block = std::size_t{0};
+            for (; ((block + 2U) <= in_args.blocks) && (((block + 2U) * KEY_WORDS_PER_BLOCK) <= in_args.keyWords); block += 2U)
+            {
+                auto const offset = block * V210_BLOCK_SIZE;
+                auto const fill = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in_args.fill + offset));
+                auto const background = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in_args.background + offset));
+                auto const keys = _mm256_castsi128_si256(
+                    _mm_loadu_si128(reinterpret_cast<__m128i const*>(in_args.key + 4U * KEY_WORDS_PER_BLOCK * block)));
+
+                auto result = _mm256_setzero_si256();
+                for (auto component = std::size_t{0}; component < 3U; ++component)
+                {
+                    auto const count = _mm_cvtsi32_si128(10 * static_cast<int>(component));
+                    auto const f = _mm256_and_si256(_mm256_srl_epi32(fill, count), mask);
+                    auto const b = _mm256_and_si256(_mm256_srl_epi32(background, count), mask);
+                    auto const key = _mm256_and_si256(_mm256_srlv_epi32(_mm256_permutevar8x32_epi32(keys, keyWord[component]), keyShift[component]),
+                        mask);
+                    auto const sample = blendSamplesAvx2(f, b, keyWeightAvx2(key, in_args.fullRangeKey), sampleZero[component], in_args.mode);
+                    result = _mm256_or_si256(result, _mm256_sll_epi32(sample, count));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(in_args.output + offset), result);
+            }
+            return block;
+        }
+
+#   undef MXL_KEYER_AVX2
+#elif defined(__aarch64__)
+        /** \see keyWeight */
+        int32x4_t keyWeightNeon(int32x4_t in_key, bool in_fullRangeKey) noexcept
+        {
+            auto const half = vdupq_n_s32(512);
+            if (in_fullRangeKey)
+            {
+                return vshrq_n_s32(vaddq_s32(vmulq_n_s32(in_key, 1025), half), 10);
+            }
+
+            auto const key = vminq_s32(vmaxq_s32(vsubq_s32(in_key, vdupq_n_s32(64)), vdupq_n_s32(0)), vdupq_n_s32(876));
+            return vshrq_n_s32(vaddq_s32(vmulq_n_s32(key, 1197), half), 10);
+        }
+
+        /** \see blendSample */
+        int32x4_t blendSamplesNeon(int32x4_t in_fill, int32x4_t in_background, int32x4_t in_weight, int32x4_t in_zero, KeyMode in_mode) noexcept
+        {
+            auto const half = vdupq_n_s32(512);
+            auto const result = (in_mode == KeyMode::STRAIGHT)
+                                  ? vaddq_s32(in_background, vshrq_n_s32(vaddq_s32(vmulq_s32(vsubq_s32(in_fill, in_background), in_weight), half), 10))
+                                  : vaddq_s32(in_fill,
+                                        vshrq_n_s32(vaddq_s32(vmulq_s32(vsubq_s32(in_background, in_zero), vsubq_s32(vdupq_n_s32(1024), in_weight)), half),
+                                            10));
+            return vminq_s32(vmaxq_s32(result, vdupq_n_s32(0)), vdupq_n_s32(1023));
+        }
+
+        std::size_t keyBlocksNeon(LineArgs const& in_args) noexcept
+        {
+            // Same approach as the AVX2 implementation, one block per iteration. The key words are distributed to the lanes
+            // that use them with a byte table lookup.
+            auto const mask = vdupq_n_s32(0x3FF);
+            auto const c = CHROMA_ZERO;
+            auto const y = in_args.fullRangeKey ? 0 : 64;
+
+            static constexpr std::uint8_t keyBytes[3][16] = {
+                {0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 6, 7},
+                {0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 6, 7, 4, 5, 6, 7},
+                {0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 6, 7, 4, 5, 6, 7},
+            };
+            static constexpr std::int32_t keyShift[3][4] = {
+                {0, -10, -20, -10},
+                {0, -20, 0, -10},
+                {0, -20, -10, -20},
+            };
+            std::int32_t const sampleZero[3][4] = {
+                {c, y, c, y},
+                {y, c, y, c},
+                {c, y, c, y},
+            };
+
+            auto block = std::size_t{0};
+            for (; (block < in_args.blocks) && (((block + 1U) * KEY_WORDS_PER_BLOCK) <= in_args.keyWords); ++block)
+            {
+                auto const offset = block * V210_BLOCK_SIZE;
+                auto const fill = vreinterpretq_u32_u8(vld1q_u8(in_args.fill + offset));
+                auto const background = vreinterpretq_u32_u8(vld1q_u8(in_args.background + offset));
+                auto const keyHalf = vld1_u8(in_args.key + 4U * KEY_WORDS_PER_BLOCK * block);
+                auto const keys = vcombine_u8(keyHalf, keyHalf);
+
+                auto result = vdupq_n_u32(0);
+                for (auto component = std::size_t{0}; component < 3U; ++component)
+                {
+                    auto const shift = 10 * static_cast<std::int32_t>(component);
+                    auto const f = vandq_s32(vreinterpretq_s32_u32(vshlq_u32(fill, vdupq_n_s32(-shift))), mask);
+                    auto const b = vandq_s32(vreinterpretq_s32_u32(vshlq_u32(background, vdupq_n_s32(-shift))), mask);
+                    auto const keyWords = vreinterpretq_u32_u8(vqtbl1q_u8(keys, vld1q_u8(keyBytes[component])));
+                    auto const key = vandq_s32(vreinterpretq_s32_u32(vshlq_u32(keyWords, vld1q_s32(keyShift[component]))), mask);
+                    auto const sample = blendSamplesNeon(f, b, keyWeightNeon(key, in_args.fullRangeKey), vld1q_s32(sampleZero[component]), in_args.mode);
+                    result = vorrq_u32(result, vshlq_u32(vreinterpretq_u32_s32(sample), vdupq_n_s32(shift)));
+                }
+                vst1q_u8(in_args.output + offset, vreinterpretq_u8_u32(result));
+            }
+            return block;
+        }
+#endif
+
+        KeyerImplementation selectImplementation() noexcept
+        {
+#if defined(__x86_64__)
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return {&keyBlocksAvx2, "avx2"};
+            }
+#elif defined(__aarch64__)
+            // Advanced SIMD is mandatory on ARMv8-A.
+            return {&keyBlocksNeon, "neon"};
+#endif
+            return {&keyBlocksNone, "scalar"};
+        }
+
+        KeyerImplementation const& implementation() noexcept
+        {
+            static auto const result = selectImplementation();
+            return result;
+        }
+    }
+
+    MXL_EXPORT
+    void keyV210aLine(std::uint8_t const* in_fill, std::uint8_t const* in_key, std::uint8_t const* in_background, std::uint8_t* out_line,
+        std::size_t in_width, KeyMode in_mode, bool in_fullRangeKey) noexcept
+    {
+        auto const args = LineArgs{
+            .fill = in_fill,
+            .key = in_key,
+            .background = in_background,
+            .output = out_line,
+            .blocks = (in_width + V210_BLOCK_PIXELS - 1U) / V210_BLOCK_PIXELS,
+            .keyWords = (in_width + 2U) / 3U,
+            .mode = in_mode,
+            .fullRangeKey = in_fullRangeKey,
+        };
+        keyBlocksScalar(args, implementation().function(args));
+    }
+
+    MXL_EXPORT
+    char const* keyerImplementation() noexcept
+    {
+        return implementation().name;
+    }
+}
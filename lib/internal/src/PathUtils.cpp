@@ -43,6 +43,12 @@ namespace mxl::lib
         return grainDirectory / fmt::format("{}.{}", GRAIN_DATA_FILE_NAME_STEM, index);
     }
 
+    MXL_EXPORT
+    std::filesystem::path makeGrainArenaFilePath(std::filesystem::path const& grainDirectory)
+    {
+        return grainDirectory / GRAIN_ARENA_FILE_NAME;
+    }
+
     MXL_EXPORT
     std::filesystem::path makeChannelDataFilePath(std::filesystem::path const& flowDirectory)
     {
@@ -54,4 +60,28 @@ namespace mxl::lib
     {
         return domain / (DOMAIN_OPTIONS_FILE_NAME);
     }
+
+    MXL_EXPORT
+    std::filesystem::path makeFlowArchiveLinkPath(std::filesystem::path const& flowDirectory)
+    {
+        return flowDirectory / FLOW_ARCHIVE_LINK_NAME;
+    }
+
+    MXL_EXPORT
+    std::filesystem::path makeFlowArchiveFilePath(std::filesystem::path const& archiveDirectory, std::string const& uuid)
+    {
+        return archiveDirectory / (uuid + FLOW_ARCHIVE_FILE_NAME_SUFFIX);
+    }
+
+    MXL_EXPORT
+    std::filesystem::path makeFlowProbeFilePath(std::filesystem::path const& flowDirectory)
+    {
+        return flowDirectory / FLOW_PROBE_FILE_NAME;
+    }
+
+    MXL_EXPORT
+    std::filesystem::path makeFlowFabricsFilePath(std::filesystem::path const& flowDirectory)
+    {
+        return flowDirectory / FLOW_FABRICS_FILE_NAME;
+    }
 }
@@ -110,7 +110,7 @@ namespace mxl::lib
     mxlStatus PosixContinuousFlowReader::getSamplesImpl(std::uint64_t index, std::size_t count,
         mxlWrappedMultiBufferSlice& payloadBuffersSlices) const
     {
-        if (auto const headIndex = _flowData->flowInfo()->runtime.headIndex; index <= headIndex)
+        if (auto const headIndex = getHeadIndex(); index <= headIndex)
         {
             auto const minIndex = (headIndex >= (_bufferLength / 2U)) ? (headIndex - (_bufferLength / 2U)) : std::uint64_t{0};
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "PosixContinuousFlowWriter.hpp"
+#include <atomic>
 #include <stdexcept>
 #include <mxl/time.h>
 #include "mxl-internal/Sync.hpp"
@@ -91,13 +92,13 @@ namespace mxl::lib
         if (_flowData)
         {
             auto const flow = _flowData->flow();
-            flow->info.runtime.headIndex = _currentIndex;
+            std::atomic_ref{flow->info.runtime.headIndex}.store(_currentIndex, std::memory_order_release);
             _currentIndex = MXL_UNDEFINED_INDEX;
 
             if (signalCompletedBatch())
             {
                 // Let readers know that the head has moved
-                flow->state.syncCounter++;
+                std::atomic_ref{flow->state.syncCounter}.fetch_add(1U, std::memory_order_release);
                 wakeAll(&flow->state.syncCounter);
             }
 
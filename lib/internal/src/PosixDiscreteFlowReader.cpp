@@ -7,6 +7,7 @@
 #include <ctime>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <filesystem>
 #include <mutex>
 #include <stdexcept>
@@ -17,6 +18,7 @@
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
 #include <mxl/time.h>
+#include "mxl-internal/Crc32c.hpp"
 #include "mxl-internal/Flow.hpp"
 #include "mxl-internal/FlowManager.hpp"
 #include "mxl-internal/Logging.hpp"
@@ -146,12 +148,91 @@ namespace mxl::lib
         return result;
     }
 
+    mxlStatus PosixDiscreteFlowReader::getNextSlices(mxlGrainSliceCursor& io_cursor, std::uint64_t in_timeoutNs, std::uint16_t* out_firstSlice,
+        std::uint16_t* out_lastSlice)
+    {
+        if ((io_cursor.totalSlices != 0U) && (io_cursor.nextSlice >= io_cursor.totalSlices))
+        {
+            return MXL_ERR_INVALID_ARG;
+        }
+
+        auto result = MXL_ERR_TIMEOUT;
+        if (_flowData)
+        {
+            auto const deadline = currentTime(Clock::Realtime) + Duration{static_cast<std::int64_t>(in_timeoutNs)};
+            auto const flow = _flowData->flow();
+            auto const syncObject = std::atomic_ref{flow->state.syncCounter};
+            while (true)
+            {
+                // \see getGrain() for why the sync counter must be loaded before looking at the grain.
+                auto const previousSyncCounter = syncObject.load(std::memory_order_acquire);
+                result = getNextSlicesImpl(io_cursor, out_firstSlice, out_lastSlice);
+                if ((result != MXL_ERR_OUT_OF_RANGE_TOO_EARLY) || !waitUntilChanged(&flow->state.syncCounter, previousSyncCounter, deadline))
+                {
+                    break;
+                }
+            }
+
+            if (result == MXL_STATUS_OK)
+            {
+                // We ignore the return value of updateFileAccessTime. It may fail if the domain is in a read-only volume.
+                (void)updateFileAccessTime(_accessFileFd);
+            }
+            else if ((result == MXL_ERR_OUT_OF_RANGE_TOO_EARLY) && !isFlowValidImpl())
+            {
+                result = MXL_ERR_FLOW_INVALID;
+            }
+        }
+        return result;
+    }
+
+    mxlStatus PosixDiscreteFlowReader::getLatestGrain(std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload)
+    {
+        auto result = MXL_ERR_UNKNOWN;
+        if (_flowData)
+        {
+            result = getLatestGrainImpl(in_minValidSlices, out_grainInfo, out_payload);
+            if (result == MXL_STATUS_OK)
+            {
+                // We ignore the return value of updateFileAccessTime. It may fail if the domain is in a read-only volume.
+                (void)updateFileAccessTime(_accessFileFd);
+            }
+            else if ((result == MXL_ERR_OUT_OF_RANGE_TOO_EARLY) && !isFlowValidImpl())
+            {
+                result = MXL_ERR_FLOW_INVALID;
+            }
+        }
+        return result;
+    }
+
+    mxlStatus PosixDiscreteFlowReader::verifyGrain(mxlGrainInfo const& in_grainInfo, std::uint8_t const* in_payload) const
+    {
+        if ((in_grainInfo.flags & MXL_GRAIN_FLAG_CHECKSUM) == 0)
+        {
+            return MXL_ERR_INVALID_ARG;
+        }
+
+        if (crc32c(in_payload, in_grainInfo.grainSize) == in_grainInfo.checksum)
+        {
+            return MXL_STATUS_OK;
+        }
+
+        // Grains are handed out in place, both from the ring buffer and from the archive, so the header
+        // of the grain immediately precedes its payload. If it does not carry the index of the grain we
+        // verified anymore, the grain was overwritten while we were reading it, which is not corruption.
+        // Repeated grains are handed out with the payload of their source grain.
+        auto const header = reinterpret_cast<GrainHeader const*>(in_payload) - 1;
+        auto const index = std::atomic_ref{const_cast<GrainHeader*>(header)->info.index};
+        auto const expectedIndex = ((in_grainInfo.flags & MXL_GRAIN_FLAG_REPEAT) != 0) ? in_grainInfo.sourceIndex : in_grainInfo.index;
+        return (index.load(std::memory_order_acquire) == expectedIndex) ? MXL_ERR_CHECKSUM_MISMATCH : MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+    }
+
     mxlStatus PosixDiscreteFlowReader::getGrainImpl(std::uint64_t in_index, std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
         std::uint8_t** out_payload) const
     {
         auto result = MXL_ERR_UNKNOWN;
         auto const flow = _flowData->flow();
-        if (auto const headIndex = flow->info.runtime.headIndex; in_index <= headIndex)
+        if (auto const headIndex = getHeadIndex(); in_index <= headIndex)
         {
             auto const grainCount = flow->info.config.discrete.grainCount;
             auto const minIndex = (headIndex >= grainCount) ? (headIndex - grainCount + 1U) : std::uint64_t{0};
@@ -164,9 +245,15 @@ namespace mxl::lib
                     ((grain->header.info.flags & MXL_GRAIN_FLAG_INVALID) != 0))
                 {
                     *out_grainInfo = grain->header.info;
-                    *out_payload = reinterpret_cast<std::uint8_t*>(&grain->header + 1);
-
-                    result = MXL_STATUS_OK;
+                    if ((out_grainInfo->flags & MXL_GRAIN_FLAG_REPEAT) != 0)
+                    {
+                        result = getRepeatedPayloadImpl(out_grainInfo->sourceIndex, out_payload);
+                    }
+                    else
+                    {
+                        *out_payload = reinterpret_cast<std::uint8_t*>(&grain->header + 1);
+                        result = MXL_STATUS_OK;
+                    }
                 }
                 else
                 {
@@ -175,7 +262,7 @@ namespace mxl::lib
             }
             else
             {
-                result = MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+                result = getArchivedGrainImpl(in_index, out_grainInfo, out_payload);
             }
         }
         else
@@ -186,6 +273,187 @@ namespace mxl::lib
         return result;
     }
 
+    mxlStatus PosixDiscreteFlowReader::getNextSlicesImpl(mxlGrainSliceCursor& io_cursor, std::uint16_t* out_firstSlice,
+        std::uint16_t* out_lastSlice) const
+    {
+        auto const headIndex = getHeadIndex();
+        if ((headIndex == MXL_UNDEFINED_INDEX) || (io_cursor.index > headIndex))
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+        }
+
+        auto const grainCount = std::uint64_t{_flowData->flowInfo()->config.discrete.grainCount};
+        auto flags = std::uint32_t{};
+        auto totalSlices = std::uint16_t{};
+        auto validSlices = std::uint16_t{};
+        auto payload = static_cast<std::uint8_t*>(nullptr);
+        if ((headIndex - io_cursor.index) < grainCount)
+        {
+            // Only the fields needed to hand out the next range are read, rather than copying the whole grain header.
+            auto const grain = _flowData->grainAt(io_cursor.index % grainCount);
+            auto const grainIndex = std::atomic_ref{grain->header.info.index};
+            flags = std::atomic_ref{grain->header.info.flags}.load(std::memory_order_relaxed);
+            totalSlices = grain->header.info.totalSlices;
+            validSlices = std::atomic_ref{grain->header.info.validSlices}.load(std::memory_order_relaxed);
+            auto const sourceIndex = grain->header.info.sourceIndex;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (auto const currentIndex = grainIndex.load(std::memory_order_relaxed); currentIndex != io_cursor.index)
+            {
+                // Either the grain was recycled while we were looking at it, or the writer hasn't opened it yet.
+                return (currentIndex > io_cursor.index) ? MXL_ERR_OUT_OF_RANGE_TOO_LATE : MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+            }
+
+            payload = reinterpret_cast<std::uint8_t*>(&grain->header + 1);
+            if ((flags & MXL_GRAIN_FLAG_REPEAT) != 0)
+            {
+                if (auto const status = getRepeatedPayloadImpl(sourceIndex, &payload); status != MXL_STATUS_OK)
+                {
+                    return status;
+                }
+            }
+        }
+        else
+        {
+            // The grain left the ring buffer while it was being streamed, which is only recoverable from the archive.
+            auto info = mxlGrainInfo{};
+            if (auto const status = getArchivedGrainImpl(io_cursor.index, &info, &payload); status != MXL_STATUS_OK)
+            {
+                return status;
+            }
+            flags = info.flags;
+            totalSlices = info.totalSlices;
+            validSlices = info.validSlices;
+        }
+
+        auto const lastSlice = ((flags & MXL_GRAIN_FLAG_INVALID) != 0) ? totalSlices : std::min(validSlices, totalSlices);
+        if (lastSlice <= io_cursor.nextSlice)
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+        }
+
+        *out_firstSlice = io_cursor.nextSlice;
+        *out_lastSlice = lastSlice;
+        io_cursor.nextSlice = lastSlice;
+        io_cursor.totalSlices = totalSlices;
+        io_cursor.flags = flags;
+        io_cursor.payload = payload;
+        return MXL_STATUS_OK;
+    }
+
+    mxlStatus PosixDiscreteFlowReader::getLatestGrainImpl(std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
+        std::uint8_t** out_payload) const
+    {
+        auto const headIndex = getHeadIndex();
+        if (headIndex == MXL_UNDEFINED_INDEX)
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+        }
+
+        // Walk the ring buffer backwards from the head. Only the headers are touched, and in the common case
+        // the grain at the head or the one right before it satisfies the requirement.
+        auto const grainCount = std::uint64_t{_flowData->flowInfo()->config.discrete.grainCount};
+        auto const depth = std::min(grainCount, headIndex + 1U);
+        for (auto index = headIndex; index + depth > headIndex; --index)
+        {
+            auto const grain = _flowData->grainAt(index % grainCount);
+            auto const grainIndex = std::atomic_ref{grain->header.info.index};
+            if (grainIndex.load(std::memory_order_acquire) != index)
+            {
+                // The grain is either not written yet, or already being replaced by a newer one.
+                continue;
+            }
+
+            // Only the fields needed to pick a grain are read, the whole header is copied once a grain qualifies.
+            auto const flags = std::atomic_ref{grain->header.info.flags}.load(std::memory_order_relaxed);
+            auto const totalSlices = grain->header.info.totalSlices;
+            auto const validSlices = std::atomic_ref{grain->header.info.validSlices}.load(std::memory_order_relaxed);
+            if ((validSlices < std::min(in_minValidSlices, totalSlices)) && ((flags & MXL_GRAIN_FLAG_INVALID) == 0))
+            {
+                continue;
+            }
+
+            auto const info = grain->header.info;
+
+            // The writer may have recycled the grain while we were copying its header.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (grainIndex.load(std::memory_order_relaxed) != index)
+            {
+                continue;
+            }
+
+            *out_grainInfo = info;
+            if ((info.flags & MXL_GRAIN_FLAG_REPEAT) != 0)
+            {
+                return getRepeatedPayloadImpl(info.sourceIndex, out_payload);
+            }
+            *out_payload = reinterpret_cast<std::uint8_t*>(&grain->header + 1);
+            return MXL_STATUS_OK;
+        }
+
+        return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+    }
+
+    mxlStatus PosixDiscreteFlowReader::getArchivedGrainImpl(std::uint64_t in_index, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload) const
+    {
+        if (auto const archive = _flowData->archive(); archive != nullptr)
+        {
+            if (auto const grain = archive->find(in_index); grain != nullptr)
+            {
+                auto const grainIndex = std::atomic_ref{grain->header.info.index};
+                if (grainIndex.load(std::memory_order_acquire) == in_index)
+                {
+                    auto const info = grain->header.info;
+
+                    // The archived grain may have been replaced while we were copying its header.
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (grainIndex.load(std::memory_order_relaxed) == in_index)
+                    {
+                        *out_grainInfo = info;
+                        if ((info.flags & MXL_GRAIN_FLAG_REPEAT) != 0)
+                        {
+                            return getRepeatedPayloadImpl(info.sourceIndex, out_payload);
+                        }
+
+                        *out_payload = reinterpret_cast<std::uint8_t*>(&grain->header + 1);
+
+                        // Replay is expected to move forward, so get the following grains off the disk while the caller is busy with this one.
+                        archive->prefetch(in_index + 1U, FLOW_ARCHIVE_READ_AHEAD_GRAINS);
+                        return MXL_STATUS_OK;
+                    }
+                }
+            }
+        }
+        return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+    }
+
+    mxlStatus PosixDiscreteFlowReader::getRepeatedPayloadImpl(std::uint64_t in_sourceIndex, std::uint8_t** out_payload) const
+    {
+        auto const grainCount = _flowData->flowInfo()->config.discrete.grainCount;
+        auto source = _flowData->grainAt(in_sourceIndex % grainCount);
+        if (std::atomic_ref{source->header.info.index}.load(std::memory_order_acquire) != in_sourceIndex)
+        {
+            source = nullptr;
+            if (auto const archive = _flowData->archive(); archive != nullptr)
+            {
+                source = archive->find(in_sourceIndex);
+            }
+        }
+
+        if (source == nullptr)
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+        }
+
+        // The writer only repeats complete grains, anything else is a source that is being rewritten.
+        if (std::atomic_ref{source->header.info.validSlices}.load(std::memory_order_relaxed) < source->header.info.totalSlices)
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+        }
+
+        *out_payload = reinterpret_cast<std::uint8_t*>(&source->header + 1);
+        return MXL_STATUS_OK;
+    }
+
     bool PosixDiscreteFlowReader::isFlowValid() const
     {
         return _flowData && isFlowValidImpl();
@@ -52,6 +52,17 @@ namespace mxl::lib
         virtual mxlStatus getGrain(std::uint64_t in_index, std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
             std::uint8_t** out_payload) override;
 
+        /** \see DiscreteFlowReader::getNextSlices */
+        virtual mxlStatus getNextSlices(mxlGrainSliceCursor& io_cursor, std::uint64_t in_timeoutNs, std::uint16_t* out_firstSlice,
+            std::uint16_t* out_lastSlice) override;
+
+        /** \see DiscreteFlowReader::getLatestGrain */
+        virtual mxlStatus getLatestGrain(std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload) override;
+
+        /** \see DiscreteFlowReader::verifyGrain */
+        [[nodiscard]]
+        virtual mxlStatus verifyGrain(mxlGrainInfo const& in_grainInfo, std::uint8_t const* in_payload) const override;
+
     protected:
         /** \see FlowReader::isFlowValid */
         [[nodiscard]]
@@ -74,6 +85,38 @@ namespace mxl::lib
         mxlStatus getGrainImpl(std::uint64_t in_index, std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo,
             std::uint8_t** out_payload) const;
 
+        /**
+         * Implementation of getNextSlices() that can be used by other methods
+         * that have previously asserted that we're operating on a valid flow
+         * (i.e. that _flowData is a valid pointer). This never waits.
+         */
+        mxlStatus getNextSlicesImpl(mxlGrainSliceCursor& io_cursor, std::uint16_t* out_firstSlice, std::uint16_t* out_lastSlice) const;
+
+        /**
+         * Implementation of getLatestGrain() that can be used by other methods
+         * that have previously asserted that we're operating on a valid flow
+         * (i.e. that _flowData is a valid pointer).
+         */
+        mxlStatus getLatestGrainImpl(std::uint16_t in_minValidSlices, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload) const;
+
+        /**
+         * Look up a grain that has already left the ring buffer in the
+         * history archive of the flow.
+         *
+         * \return MXL_STATUS_OK if the grain was found in the archive,
+         *      MXL_ERR_OUT_OF_RANGE_TOO_LATE otherwise.
+         */
+        mxlStatus getArchivedGrainImpl(std::uint64_t in_index, mxlGrainInfo* out_grainInfo, std::uint8_t** out_payload) const;
+
+        /**
+         * Look up the payload of the source grain of a repeated grain, either
+         * in the ring buffer or in the history archive of the flow.
+         *
+         * \return MXL_STATUS_OK if the source grain was found,
+         *      MXL_ERR_OUT_OF_RANGE_TOO_LATE otherwise.
+         */
+        mxlStatus getRepeatedPayloadImpl(std::uint64_t in_sourceIndex, std::uint8_t** out_payload) const;
+
     private:
         std::unique_ptr<DiscreteFlowData> _flowData;
         int _accessFileFd;
@@ -2,7 +2,10 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "PosixDiscreteFlowWriter.hpp"
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <atomic>
 #include <stdexcept>
 #include <fcntl.h>
 #include <uuid.h>
@@ -10,18 +13,59 @@
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
 #include <mxl/time.h>
+#include "mxl-internal/Crc32c.hpp"
 #include "mxl-internal/Flow.hpp"
 #include "mxl-internal/FlowManager.hpp"
 #include "mxl-internal/Sync.hpp"
+#include "mxl-internal/Thread.hpp"
 #include "mxl-internal/Timing.hpp"
 
 namespace mxl::lib
 {
+    namespace
+    {
+        /** Byte count marking a multi-producer grain that is being started by its first producer. */
+        constexpr auto const PRODUCER_OPENING = std::uint32_t{0xFFFF'FFFF};
+
+        constexpr std::uint64_t makeProducerWord(std::uint64_t in_index, std::uint32_t in_bytes) noexcept
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(in_index)) << 32) | in_bytes;
+        }
+
+        constexpr std::uint32_t producerWordGeneration(std::uint64_t in_word) noexcept
+        {
+            return static_cast<std::uint32_t>(in_word >> 32);
+        }
+
+        constexpr std::uint32_t producerWordBytes(std::uint64_t in_word) noexcept
+        {
+            return static_cast<std::uint32_t>(in_word);
+        }
+
+        /** Whether the generation in_lhs refers to an older grain than in_rhs, taking wrap around into account. */
+        constexpr bool isOlderGeneration(std::uint32_t in_lhs, std::uint32_t in_rhs) noexcept
+        {
+            return static_cast<std::int32_t>(in_lhs - in_rhs) < 0;
+        }
+
+        /** The number of payload bytes occupied by a record, including its header and padding. */
+        constexpr std::uint32_t recordFootprint(std::uint32_t in_size) noexcept
+        {
+            return sizeof(mxlDataRecordHeader) + ((in_size + 3U) & ~std::uint32_t{3});
+        }
+    }
+
     PosixDiscreteFlowWriter::PosixDiscreteFlowWriter(FlowManager const&, uuids::uuid const& flowId, std::unique_ptr<DiscreteFlowData>&& data)
         : DiscreteFlowWriter{flowId}
         , _flowData{std::move(data)}
         , _currentIndex{MXL_UNDEFINED_INDEX}
-    {}
+        , _archiver{}
+    {
+        if (_flowData && (_flowData->archive() != nullptr))
+        {
+            _archiver = std::make_unique<FlowArchiver>(*_flowData);
+        }
+    }
 
     FlowData const& PosixDiscreteFlowWriter::getFlowData() const
     {
@@ -61,6 +105,7 @@ namespace mxl::lib
             auto offset = in_index % _flowData->flowInfo()->config.discrete.grainCount;
             auto const grain = _flowData->grainAt(offset);
             grain->header.info.index = in_index; // Set the absolute grain index associated to that ring buffer entry
+            grain->header.info.flags &= ~MXL_GRAIN_FLAG_REPEAT; // The payload of the entry is about to be written, it is not a repeat anymore
             *out_grainInfo = grain->header.info;
             *out_payload = reinterpret_cast<std::uint8_t*>(&grain->header + 1);
             _currentIndex = in_index;
@@ -69,6 +114,44 @@ namespace mxl::lib
         return MXL_ERR_UNKNOWN;
     }
 
+    mxlStatus PosixDiscreteFlowWriter::resolveRepeatSource(mxlGrainInfo& io_grainInfo) const
+    {
+        if (io_grainInfo.sourceIndex >= io_grainInfo.index)
+        {
+            return MXL_ERR_INVALID_ARG;
+        }
+
+        auto const grainCount = _flowData->flowInfo()->config.discrete.grainCount;
+        auto source = _flowData->grainAt(io_grainInfo.sourceIndex % grainCount);
+        if (std::atomic_ref{source->header.info.index}.load(std::memory_order_acquire) != io_grainInfo.sourceIndex)
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+        }
+
+        // Always reference the grain that carries the payload, so that readers never have to follow a chain of repeats.
+        if ((source->header.info.flags & MXL_GRAIN_FLAG_REPEAT) != 0)
+        {
+            io_grainInfo.sourceIndex = source->header.info.sourceIndex;
+            source = _flowData->grainAt(io_grainInfo.sourceIndex % grainCount);
+            if (std::atomic_ref{source->header.info.index}.load(std::memory_order_acquire) != io_grainInfo.sourceIndex)
+            {
+                return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+            }
+        }
+
+        // A repeated grain is published as complete, so readers would otherwise consume a payload that is still being written.
+        if (source->header.info.validSlices < source->header.info.totalSlices)
+        {
+            return MXL_ERR_OUT_OF_RANGE_TOO_EARLY;
+        }
+
+        // The payload is only referenced, so a repeated grain is always complete and shares the checksum of its source.
+        io_grainInfo.validSlices = io_grainInfo.totalSlices;
+        io_grainInfo.checksum = source->header.info.checksum;
+        io_grainInfo.flags |= (source->header.info.flags & (MXL_GRAIN_FLAG_CHECKSUM | MXL_GRAIN_FLAG_INVALID));
+        return MXL_STATUS_OK;
+    }
+
     mxlStatus PosixDiscreteFlowWriter::cancel()
     {
         _currentIndex = MXL_UNDEFINED_INDEX;
@@ -93,24 +176,268 @@ namespace mxl::lib
             }
 
             auto const flow = _flowData->flow();
-            flow->info.runtime.headIndex = _currentIndex;
-
             auto const offset = _currentIndex % flow->info.config.discrete.grainCount;
-            *_flowData->grainInfoAt(offset) = mxlGrainInfo;
-            flow->info.runtime.lastWriteTime = currentTime(mxl::lib::Clock::TAI).value;
+            auto const grain = _flowData->grainAt(offset);
+
+            auto info = mxlGrainInfo;
+            info.flags &= ~MXL_GRAIN_FLAG_CHECKSUM;
+            if ((info.flags & MXL_GRAIN_FLAG_REPEAT) != 0)
+            {
+                if (auto const status = resolveRepeatSource(info); status != MXL_STATUS_OK)
+                {
+                    return status;
+                }
+            }
+            else if (((flow->info.config.common.flags & MXL_FLOW_FLAG_GRAIN_CHECKSUM) != 0) && (info.validSlices == info.totalSlices) &&
+                ((info.flags & MXL_GRAIN_FLAG_INVALID) == 0))
+            {
+                // The payload of a complete grain won't change anymore, so this is the only point at which it needs to be checksummed.
+                info.checksum = crc32c(&grain->header + 1, grain->header.info.grainSize);
+                info.flags |= MXL_GRAIN_FLAG_CHECKSUM;
+            }
+
+            grain->header.info = info;
+
+            // The head never moves backwards, an older grain may be completed after newer ones were committed.
+            auto const headIndex = std::atomic_ref{flow->info.runtime.headIndex};
+            auto currentHeadIndex = headIndex.load(std::memory_order_acquire);
+            while (((currentHeadIndex < _currentIndex) || (currentHeadIndex == MXL_UNDEFINED_INDEX)) &&
+                   !headIndex.compare_exchange_weak(currentHeadIndex, _currentIndex, std::memory_order_release, std::memory_order_acquire))
+            {}
+            std::atomic_ref{flow->info.runtime.lastWriteTime}.store(currentTime(mxl::lib::Clock::TAI).value, std::memory_order_relaxed);
+
+            // Complete and invalid grains won't change anymore, so they can be archived.
+            if (_archiver && ((info.validSlices == info.totalSlices) || ((info.flags & MXL_GRAIN_FLAG_INVALID) != 0)))
+            {
+                _archiver->grainCommitted(_currentIndex);
+            }
 
             // If the grain is complete, reset the current index of the flow writer.
-            if (mxlGrainInfo.validSlices == mxlGrainInfo.totalSlices)
+            if (info.validSlices == info.totalSlices)
             {
                 _currentIndex = MXL_UNDEFINED_INDEX;
             }
 
             // Let readers know that the head has moved or that new data is available in a partial grain
-            flow->state.syncCounter++;
+            std::atomic_ref{flow->state.syncCounter}.fetch_add(1U, std::memory_order_release);
             wakeAll(&flow->state.syncCounter);
 
             return MXL_STATUS_OK;
         }
         return MXL_ERR_UNKNOWN;
     }
+
+    mxlStatus PosixDiscreteFlowWriter::commitInvalidRange(std::uint64_t in_firstIndex, std::uint64_t in_lastIndex)
+    {
+        if (_flowData)
+        {
+            if ((in_firstIndex > in_lastIndex) || (in_lastIndex == MXL_UNDEFINED_INDEX))
+            {
+                return MXL_ERR_INVALID_ARG;
+            }
+
+            auto const flow = _flowData->flow();
+            auto const grainCount = std::uint64_t{flow->info.config.discrete.grainCount};
+            auto const headIndex = std::atomic_ref{flow->info.runtime.headIndex};
+            auto currentHeadIndex = headIndex.load(std::memory_order_acquire);
+
+            // Grains that already left the ring buffer can't be invalidated, their slots hold newer grains.
+            auto const oldestIndex = ((currentHeadIndex != MXL_UNDEFINED_INDEX) && (currentHeadIndex >= grainCount))
+                                       ? (currentHeadIndex - grainCount + 1U)
+                                       : std::uint64_t{0};
+            if (in_lastIndex < oldestIndex)
+            {
+                return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+            }
+
+            // Grains older than the ring buffer depth would be overwritten by the following ones anyway.
+            auto firstIndex = ((in_lastIndex - in_firstIndex) >= grainCount) ? (in_lastIndex - grainCount + 1U) : in_firstIndex;
+            firstIndex = std::max(firstIndex, oldestIndex);
+            for (auto index = firstIndex; index <= in_lastIndex; ++index)
+            {
+                auto& info = _flowData->grainAt(index % grainCount)->header.info;
+                if ((info.index > index) && (info.index != MXL_UNDEFINED_INDEX))
+                {
+                    // The slot was reused by a newer grain in the meantime.
+                    continue;
+                }
+                info.index = index;
+                info.flags = MXL_GRAIN_FLAG_INVALID;
+                info.validSlices = 0;
+                info.checksum = 0;
+                info.sourceIndex = 0;
+            }
+
+            // The range may include a grain that was previously opened, which is now gone.
+            if ((_currentIndex >= in_firstIndex) && (_currentIndex <= in_lastIndex))
+            {
+                _currentIndex = MXL_UNDEFINED_INDEX;
+            }
+
+            // The head never moves backwards, the range may be a gap behind grains that were committed already.
+            while (((currentHeadIndex < in_lastIndex) || (currentHeadIndex == MXL_UNDEFINED_INDEX)) &&
+                   !headIndex.compare_exchange_weak(currentHeadIndex, in_lastIndex, std::memory_order_release, std::memory_order_acquire))
+            {}
+            auto const newHeadIndex = ((currentHeadIndex < in_lastIndex) || (currentHeadIndex == MXL_UNDEFINED_INDEX)) ? in_lastIndex
+                                                                                                                      : currentHeadIndex;
+            std::atomic_ref{flow->info.runtime.lastWriteTime}.store(currentTime(mxl::lib::Clock::TAI).value, std::memory_order_relaxed);
+
+            if (_archiver)
+            {
+                _archiver->grainCommitted(newHeadIndex);
+            }
+
+            // Signal the whole range at once, rather than waking up readers for every single grain.
+            std::atomic_ref{flow->state.syncCounter}.fetch_add(1U, std::memory_order_release);
+            wakeAll(&flow->state.syncCounter);
+
+            return MXL_STATUS_OK;
+        }
+        return MXL_ERR_UNKNOWN;
+    }
+
+    mxlStatus PosixDiscreteFlowWriter::claimRecord(std::uint64_t in_index, std::uint32_t in_size, mxlDataRecord* out_record)
+    {
+        if (_flowData)
+        {
+            auto const& config = _flowData->flowInfo()->config;
+            if (((config.common.flags & MXL_FLOW_FLAG_MULTI_PRODUCER) == 0) || (in_index == MXL_UNDEFINED_INDEX))
+            {
+                return MXL_ERR_INVALID_ARG;
+            }
+
+            auto const grain = _flowData->grainAt(in_index % config.discrete.grainCount);
+            auto const grainSize = grain->header.info.grainSize;
+            auto const footprint = recordFootprint(in_size);
+            if ((in_size > grainSize) || (footprint > grainSize))
+            {
+                return MXL_ERR_INVALID_ARG;
+            }
+
+            auto const generation = static_cast<std::uint32_t>(in_index);
+            auto const claimed = std::atomic_ref{grain->header.producers.claimed};
+            auto expected = claimed.load(std::memory_order_acquire);
+            auto offset = std::uint32_t{0};
+            while (true)
+            {
+                auto const bytes = producerWordBytes(expected);
+                if ((producerWordGeneration(expected) == generation) && ((bytes != 0U) || (grain->header.info.index == in_index)))
+                {
+                    if (bytes == PRODUCER_OPENING)
+                    {
+                        // Another producer is starting this grain, which only takes a couple of stores.
+                        this_thread::yieldProcessor();
+                        expected = claimed.load(std::memory_order_acquire);
+                    }
+                    else if ((bytes + footprint) > grainSize)
+                    {
+                        return MXL_ERR_CONFLICT;
+                    }
+                    else if (claimed.compare_exchange_weak(expected, expected + footprint, std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        offset = bytes;
+                        break;
+                    }
+                }
+                else if (isOlderGeneration(generation, producerWordGeneration(expected)))
+                {
+                    return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+                }
+                else if (claimed.compare_exchange_weak(
+                             expected, makeProducerWord(in_index, PRODUCER_OPENING), std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    // We are the first producer of this grain. Nobody else can claim or commit records in it until we are done
+                    // resetting its header.
+                    auto& info = grain->header.info;
+                    info.index = in_index;
+                    info.flags = 0;
+                    info.validSlices = 0;
+                    info.checksum = 0;
+                    info.sourceIndex = 0;
+                    std::atomic_ref{grain->header.producers.committed}.store(makeProducerWord(in_index, 0U), std::memory_order_relaxed);
+                    claimed.store(makeProducerWord(in_index, footprint), std::memory_order_release);
+                    offset = 0U;
+                    break;
+                }
+            }
+
+            auto const payload = reinterpret_cast<std::uint8_t*>(&grain->header + 1);
+            auto const header = mxlDataRecordHeader{in_size};
+            std::memcpy(payload + offset, &header, sizeof header);
+
+            *out_record = mxlDataRecord{in_index, offset, in_size, payload + offset + sizeof header};
+            return MXL_STATUS_OK;
+        }
+        return MXL_ERR_UNKNOWN;
+    }
+
+    mxlStatus PosixDiscreteFlowWriter::commitRecord(mxlDataRecord const& in_record)
+    {
+        if (_flowData)
+        {
+            auto const& config = _flowData->flowInfo()->config;
+            if (((config.common.flags & MXL_FLOW_FLAG_MULTI_PRODUCER) == 0) || (in_record.index == MXL_UNDEFINED_INDEX))
+            {
+                return MXL_ERR_INVALID_ARG;
+            }
+
+            auto const grain = _flowData->grainAt(in_record.index % config.discrete.grainCount);
+            auto const generation = static_cast<std::uint32_t>(in_record.index);
+            auto const committed = std::atomic_ref{grain->header.producers.committed};
+            auto expected = committed.load(std::memory_order_acquire);
+            auto desired = std::uint64_t{};
+            do
+            {
+                if (producerWordGeneration(expected) != generation)
+                {
+                    return MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+                }
+                desired = expected + recordFootprint(in_record.size);
+            }
+            while (!committed.compare_exchange_weak(expected, desired, std::memory_order_acq_rel, std::memory_order_acquire));
+
+            // Records are published in the order in which they were claimed, so the grain only grows once everything
+            // that was claimed so far has been committed. Whoever commits last publishes on behalf of everyone.
+            if (std::atomic_ref{grain->header.producers.claimed}.load(std::memory_order_acquire) == desired)
+            {
+                publishRecords(in_record.index, producerWordBytes(desired));
+            }
+            return MXL_STATUS_OK;
+        }
+        return MXL_ERR_UNKNOWN;
+    }
+
+    void PosixDiscreteFlowWriter::publishRecords(std::uint64_t in_index, std::uint32_t in_committedBytes)
+    {
+        auto const flow = _flowData->flow();
+        auto const grain = _flowData->grainAt(in_index % flow->info.config.discrete.grainCount);
+        auto& info = grain->header.info;
+
+        // The grain may have been recycled by a producer of a newer grain since the records were committed, in which case
+        // the slice count belongs to the new grain and must not be touched.
+        auto const committed = std::atomic_ref{grain->header.producers.committed}.load(std::memory_order_acquire);
+        if ((producerWordGeneration(committed) != static_cast<std::uint32_t>(in_index)) ||
+            (std::atomic_ref{info.index}.load(std::memory_order_acquire) != in_index))
+        {
+            return;
+        }
+
+        auto const validSlices = std::atomic_ref{info.validSlices};
+        auto const newValidSlices = static_cast<std::uint16_t>(in_committedBytes / flow->info.config.discrete.sliceSizes[0]);
+        auto currentValidSlices = validSlices.load(std::memory_order_relaxed);
+        while ((currentValidSlices < newValidSlices) &&
+               !validSlices.compare_exchange_weak(currentValidSlices, newValidSlices, std::memory_order_release, std::memory_order_relaxed))
+        {}
+
+        auto const headIndex = std::atomic_ref{flow->info.runtime.headIndex};
+        auto currentHeadIndex = headIndex.load(std::memory_order_relaxed);
+        while (((currentHeadIndex < in_index) || (currentHeadIndex == MXL_UNDEFINED_INDEX)) &&
+               !headIndex.compare_exchange_weak(currentHeadIndex, in_index, std::memory_order_release, std::memory_order_relaxed))
+        {}
+
+        std::atomic_ref{flow->info.runtime.lastWriteTime}.store(currentTime(mxl::lib::Clock::TAI).value, std::memory_order_relaxed);
+
+        std::atomic_ref{flow->state.syncCounter}.fetch_add(1U, std::memory_order_release);
+        wakeAll(&flow->state.syncCounter);
+    }
 }
@@ -4,11 +4,13 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <uuid.h>
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
 #include "mxl-internal/DiscreteFlowData.hpp"
 #include "mxl-internal/DiscreteFlowWriter.hpp"
+#include "FlowArchiver.hpp"
 
 namespace mxl::lib
 {
@@ -58,16 +60,48 @@ namespace mxl::lib
         /** \see DiscreteFlowWriter::commit */
         virtual mxlStatus commit(mxlGrainInfo const& mxlGrainInfo) override;
 
+        /** \see DiscreteFlowWriter::commitInvalidRange */
+        virtual mxlStatus commitInvalidRange(std::uint64_t in_firstIndex, std::uint64_t in_lastIndex) override;
+
         /** \see DiscreteFlowWriter::cancel */
         virtual mxlStatus cancel() override;
 
+        /** \see DiscreteFlowWriter::claimRecord */
+        virtual mxlStatus claimRecord(std::uint64_t in_index, std::uint32_t in_size, mxlDataRecord* out_record) override;
+
+        /** \see DiscreteFlowWriter::commitRecord */
+        virtual mxlStatus commitRecord(mxlDataRecord const& in_record) override;
+
         /** \see FlowWriter::flowRead */
         virtual void flowRead() override;
 
+    private:
+        /**
+         * Validate the source of a repeated grain and complete its grain info.
+         * Repeats of repeated grains are resolved to the grain that actually
+         * carries the payload.
+         *
+         * \param[in,out] io_grainInfo The grain info that is about to be committed.
+         * \return MXL_STATUS_OK if the source grain is present in the ring buffer.
+         */
+        mxlStatus resolveRepeatSource(mxlGrainInfo& io_grainInfo) const;
+
+        /**
+         * Make the records of a multi-producer grain that have been committed
+         * so far visible to readers. Nothing is published if the grain was
+         * recycled for a newer index in the meantime.
+         *
+         * \param[in] in_index The index of the grain.
+         * \param[in] in_committedBytes The number of bytes at the beginning of the grain that have been committed.
+         */
+        void publishRecords(std::uint64_t in_index, std::uint32_t in_committedBytes);
+
     private:
         /** The FlowData for the currently opened flow. null if no flow is opened. */
         std::unique_ptr<DiscreteFlowData> _flowData;
         /** The currently opened grain index. MXL_UNDEFINED_INDEX if no grain is currently opened. */
         std::uint64_t _currentIndex;
+        /** Copies committed grains into the history archive of the flow. null if the flow has no archive. */
+        std::unique_ptr<FlowArchiver> _archiver;
     };
 }
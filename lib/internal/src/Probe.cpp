@@ -0,0 +1,352 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/Probe.hpp"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <mxl/platform.h>
+#include "mxl-internal/SequenceLock.hpp"
+
+#if defined(__x86_64__)
+#   include <immintrin.h>
+#elif defined(__aarch64__)
+#   include <arm_neon.h>
+#endif
+
+namespace mxl::lib
+{
+    namespace
+    {
+        /** Size in bytes of a v210 block, which packs 6 pixels as 12 samples in 4 words of 3 samples each. */
+        constexpr auto const V210_BLOCK_SIZE = std::size_t{16};
+
+        /** Number of pixels in a v210 block. */
+        constexpr auto const V210_BLOCK_PIXELS = std::size_t{6};
+
+        /** Number of blocks summed by the vector implementations before their 32 bit lanes are flushed. */
+        constexpr auto const MAX_BLOCKS_PER_FLUSH = std::size_t{65536};
+
+        struct LumaSums
+        {
+            std::uint64_t sum;
+            std::uint64_t black;
+        };
+
+        /**
+         * Add the luma samples of the first blocks of a v210 line to io_sums.
+         * \return The number of blocks processed.
+         */
+        using LumaFunction = std::size_t (*)(std::uint8_t const* in_line, std::size_t in_blocks, std::uint32_t in_blackThreshold,
+            LumaSums& io_sums) noexcept;
+
+        /**
+         * Add the first samples of a float32 sequence to io_stats.
+         * \return The number of samples processed.
+         */
+        using SampleFunction = std::size_t (*)(float const* in_samples, std::size_t in_count, SampleStats& io_stats) noexcept;
+
+        struct ProbeImplementation
+        {
+            LumaFunction luma;
+            SampleFunction samples;
+            char const* name;
+        };
+
+        std::uint32_t load32(std::uint8_t const* in_data) noexcept
+        {
+            auto result = std::uint32_t{};
+            std::memcpy(&result, in_data, sizeof result);
+            return result;
+        }
+
+        std::size_t lumaNone(std::uint8_t const*, std::size_t, std::uint32_t, LumaSums&) noexcept
+        {
+            return 0U;
+        }
+
+        std::size_t samplesNone(float const*, std::size_t, SampleStats&) noexcept
+        {
+            return 0U;
+        }
+
+        void lumaScalar(std::uint8_t const* in_line, std::size_t in_firstBlock, std::size_t in_blocks, std::uint32_t in_blackThreshold,
+            LumaSums& io_sums) noexcept
+        {
+            auto const add = [&](std::uint32_t luma)
+            {
+                io_sums.sum += luma;
+                io_sums.black += (luma <= in_blackThreshold) ? 1U : 0U;
+            };
+
+            for (auto block = in_firstBlock; block < in_blocks; ++block)
+            {
+                // Luma samples are the middle sample of even words, and the outer samples of odd words.
+                auto const* data = in_line + block * V210_BLOCK_SIZE;
+                for (auto word = std::size_t{0}; word < 4U; word += 2U)
+                {
+                    auto const even = load32(data + 4U * word);
+                    auto const odd = load32(data + 4U * word + 4U);
+                    add((even >> 10) & 0x3FFU);
+                    add(odd & 0x3FFU);
+                    add((odd >> 20) & 0x3FFU);
+                }
+            }
+        }
+
+        void samplesScalar(float const* in_samples, std::size_t in_first, std::size_t in_count, SampleStats& io_stats) noexcept
+        {
+            for (auto i = in_first; i < in_count; ++i)
+            {
+                auto const sample = in_samples[i];
+                io_stats.sumOfSquares += static_cast<double>(sample) * sample;
+                io_stats.peak = std::max(io_stats.peak, std::fabs(sample));
+            }
+            io_stats.samples += in_count - in_first;
+        }
+
+#if defined(__x86_64__)
+        __attribute__((target("avx2")))
+        std::uint64_t sumLanesAvx2(__m256i in_lanes) noexcept
+        {
+            alignas(32) std::uint32_t lanes[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), in_lanes);
+            auto result = std::uint64_t{0};
+            for (auto const lane : lanes)
+            {
+                result += lane;
+            }
+            return result;
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t lumaAvx2(std::uint8_t const* in_line, std::size_t in_blocks, std::uint32_t in_blackThreshold, LumaSums& io_sums) noexcept
+        {
+            // Two blocks per vector. Even lanes hold their luma sample in the middle field, odd lanes in the outer fields.
+            auto const mask = _mm256_set1_epi32(0x3FF);
+            auto const oddLanes = _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+            auto const limit = _mm256_set1_epi32(static_cast<int>(in_blackThreshold) + 1);
+
+            auto const pairs = in_blocks / 2U;
+            for (auto first = std::size_t{0}; first < pairs; first += MAX_BLOCKS_PER_FLUSH / 2U)
+            {
+                auto sum = _mm256_setzero_si256();
+                auto black = _mm256_setzero_si256();
+                auto const last = std::min(pairs, first + MAX_BLOCKS_PER_FLUSH / 2U);
+                for (auto pair = first; pair < last; ++pair)
+                {
+                    auto const words = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in_line + 2U * V210_BLOCK_SIZE * pair));
+                    auto const field0 = _mm256_and_si256(words, mask);
+                    auto const field1 = _mm256_and_si256(_mm256_srli_epi32(words, 10), mask);
+                    auto const field2 = _mm256_and_si256(_mm256_srli_epi32(words, 20), mask);
+
+                    auto const inner = _mm256_blend_epi32(field1, field0, 0xAA);
+                    auto const outer = _mm256_and_si256(field2, oddLanes);
+                    sum = _mm256_add_epi32(sum, _mm256_add_epi32(inner, outer));
+
+                    // Comparisons yield -1 for samples at or below the threshold.
+                    black = _mm256_sub_epi32(black, _mm256_cmpgt_epi32(limit, inner));
+                    black = _mm256_sub_epi32(black, _mm256_and_si256(_mm256_cmpgt_epi32(limit, field2), oddLanes));
+                }
+                io_sums.sum += sumLanesAvx2(sum);
+                io_sums.black += sumLanesAvx2(black);
+            }
+            return 2U * pairs;
+        }
+
+        __attribute__((target("avx2")))
+        std::size_t samplesAvx2(float const* in_samples, std::size_t in_count, SampleStats& io_stats) noexcept
+        {
+            auto const signMask = _mm256_set1_ps(-0.0f);
+            auto peak = _mm256_setzero_ps();
+            auto low = _mm256_setzero_pd();
+            auto high = _mm256_setzero_pd();
+
+            auto const count = in_count & ~std::size_t{7};
+            for (auto i = std::size_t{0}; i < count; i += 8U)
+            {
+                auto const samples = _mm256_loadu_ps(in_samples + i);
+                peak = _mm256_max_ps(peak, _mm256_andnot_ps(signMask, samples));
+
+                // Squares are summed in double precision, as seconds of samples may be summed between two reports.
+                auto const lowSamples = _mm256_cvtps_pd(_mm256_castps256_ps128(samples));
+                auto const highSamples = _mm256_cvtps_pd(_mm256_extractf128_ps(samples, 1));
+                low = _mm256_add_pd(low, _mm256_mul_pd(lowSamples, lowSamples));
+                high = _mm256_add_pd(high, _mm256_mul_pd(highSamples, highSamples));
+            }
+
+            alignas(32) double sums[4];
+            _mm256_store_pd(sums, _mm256_add_pd(low, high));
+            alignas(32) float peaks[8];
+            _mm256_store_ps(peaks, peak);
+
+            io_stats.sumOfSquares += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+            io_stats.peak = std::max(io_stats.peak, *std::max_element(std::begin(peaks), std::end(peaks)));
+            io_stats.samples += count;
+            return count;
+        }
+#elif defined(__aarch64__)
+        std::size_t lumaNeon(std::uint8_t const* in_line, std::size_t in_blocks, std::uint32_t in_blackThreshold, LumaSums& io_sums) noexcept
+        {
+            // One block per vector. Even lanes hold their luma sample in the middle field, odd lanes in the outer fields.
+            auto const mask = vdupq_n_u32(0x3FF);
+            auto const oddLanes = uint32x4_t{0U, ~0U, 0U, ~0U};
+            auto const limit = vdupq_n_u32(in_blackThreshold);
+
+            for (auto first = std::size_t{0}; first < in_blocks; first += MAX_BLOCKS_PER_FLUSH)
+            {
+                auto sum = vdupq_n_u32(0U);
+                auto black = vdupq_n_u32(0U);
+                auto const last = std::min(in_blocks, first + MAX_BLOCKS_PER_FLUSH);
+                for (auto block = first; block < last; ++block)
+                {
+                    auto const words = vreinterpretq_u32_u8(vld1q_u8(in_line + V210_BLOCK_SIZE * block));
+                    auto const field0 = vandq_u32(words, mask);
+                    auto const field1 = vandq_u32(vshrq_n_u32(words, 10), mask);
+                    auto const field2 = vandq_u32(vshrq_n_u32(words, 20), mask);
+
+                    auto const inner = vbslq_u32(oddLanes, field0, field1);
+                    auto const outer = vandq_u32(field2, oddLanes);
+                    sum = vaddq_u32(sum, vaddq_u32(inner, outer));
+
+                    // Comparisons yield all ones for samples at or below the threshold.
+                    black = vsubq_u32(black, vcleq_u32(inner, limit));
+                    black = vsubq_u32(black, vandq_u32(vcleq_u32(field2, limit), oddLanes));
+                }
+                io_sums.sum += vaddlvq_u32(sum);
+                io_sums.black += vaddlvq_u32(black);
+            }
+            return in_blocks;
+        }
+
+        std::size_t samplesNeon(float const* in_samples, std::size_t in_count, SampleStats& io_stats) noexcept
+        {
+            auto peak = vdupq_n_f32(0.0f);
+            auto low = vdupq_n_f64(0.0);
+            auto high = vdupq_n_f64(0.0);
+
+            auto const count = in_count & ~std::size_t{3};
+            for (auto i = std::size_t{0}; i < count; i += 4U)
+            {
+                auto const samples = vld1q_f32(in_samples + i);
+                peak = vmaxq_f32(peak, vabsq_f32(samples));
+
+                auto const lowSamples = vcvt_f64_f32(vget_low_f32(samples));
+                auto const highSamples = vcvt_high_f64_f32(samples);
+                low = vfmaq_f64(low, lowSamples, lowSamples);
+                high = vfmaq_f64(high, highSamples, highSamples);
+            }
+
+            io_stats.sumOfSquares += vaddvq_f64(vaddq_f64(low, high));
+            io_stats.peak = std::max(io_stats.peak, vmaxvq_f32(peak));
+            io_stats.samples += count;
+            return count;
+        }
+#endif
+
+        ProbeImplementation selectImplementation() noexcept
+        {
+#if defined(__x86_64__)
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return {&lumaAvx2, &samplesAvx2, "avx2"};
+            }
+#elif defined(__aarch64__)
+            // Advanced SIMD is mandatory on ARMv8-A.
+            return {&lumaNeon, &samplesNeon, "neon"};
+#endif
+            return {&lumaNone, &samplesNone, "scalar"};
+        }
+
+        ProbeImplementation const& implementation() noexcept
+        {
+            static auto const result = selectImplementation();
+            return result;
+        }
+    }
+
+    MXL_EXPORT
+    LumaStats analyzeV210Luma(std::uint8_t const* in_picture, std::size_t in_stride, std::size_t in_width, std::size_t in_height,
+        std::size_t in_lineStep, std::uint32_t in_blackThreshold) noexcept
+    {
+        constexpr auto const regionCount = PROBE_SIGNATURE_COLUMNS * PROBE_SIGNATURE_ROWS;
+
+        auto const& probe = implementation();
+        auto const threshold = std::min(in_blackThreshold, 0x3FFU);
+        auto const lineStep = std::max(in_lineStep, std::size_t{1});
+        auto const blocks = in_width / V210_BLOCK_PIXELS;
+
+        auto regionSums = std::array<std::uint64_t, regionCount>{};
+        auto regionSamples = std::array<std::uint64_t, regionCount>{};
+        auto result = LumaStats{};
+
+        for (auto line = std::size_t{0}; line < in_height; line += lineStep)
+        {
+            auto const row = line * PROBE_SIGNATURE_ROWS / in_height;
+            auto const* data = in_picture + line * in_stride;
+            for (auto column = std::size_t{0}; column < PROBE_SIGNATURE_COLUMNS; ++column)
+            {
+                auto const firstBlock = column * blocks / PROBE_SIGNATURE_COLUMNS;
+                auto const lastBlock = (column + 1U) * blocks / PROBE_SIGNATURE_COLUMNS;
+                auto const regionData = data + firstBlock * V210_BLOCK_SIZE;
+                auto const regionBlocks = lastBlock - firstBlock;
+
+                auto sums = LumaSums{};
+                lumaScalar(regionData, probe.luma(regionData, regionBlocks, threshold, sums), regionBlocks, threshold, sums);
+
+                auto const region = row * PROBE_SIGNATURE_COLUMNS + column;
+                regionSums[region] += sums.sum;
+                regionSamples[region] += regionBlocks * V210_BLOCK_PIXELS;
+                result.blackSamples += sums.black;
+            }
+        }
+
+        for (auto region = std::size_t{0}; region < regionCount; ++region)
+        {
+            result.sum += regionSums[region];
+            result.samples += regionSamples[region];
+            if (regionSamples[region] != 0U)
+            {
+                auto const scaled = (regionSums[region] << PROBE_SIGNATURE_FRACTION_BITS) + regionSamples[region] / 2U;
+                result.signature[region] = static_cast<std::uint16_t>(scaled / regionSamples[region]);
+            }
+        }
+        return result;
+    }
+
+    MXL_EXPORT
+    double signatureDifference(LumaStats const& in_lhs, LumaStats const& in_rhs) noexcept
+    {
+        auto total = std::uint64_t{0};
+        for (auto region = std::size_t{0}; region < in_lhs.signature.size(); ++region)
+        {
+            total += static_cast<std::uint64_t>(std::abs(static_cast<int>(in_lhs.signature[region]) - static_cast<int>(in_rhs.signature[region])));
+        }
+        return static_cast<double>(total) / static_cast<double>(in_lhs.signature.size() << PROBE_SIGNATURE_FRACTION_BITS);
+    }
+
+    MXL_EXPORT
+    void accumulateSampleStats(float const* in_samples, std::size_t in_count, SampleStats& io_stats) noexcept
+    {
+        samplesScalar(in_samples, implementation().samples(in_samples, in_count, io_stats), in_count, io_stats);
+    }
+
+    MXL_EXPORT
+    char const* probeImplementation() noexcept
+    {
+        return implementation().name;
+    }
+
+    MXL_EXPORT
+    void publishProbeStats(ProbeStats& io_stats, ProbeValues const& in_values) noexcept
+    {
+        writeSequenced(io_stats.sequence, io_stats.values, in_values);
+    }
+
+    MXL_EXPORT
+    bool readProbeStats(ProbeStats const& in_stats, ProbeValues& out_values) noexcept
+    {
+        return readSequenced(in_stats.sequence, in_stats.values, out_values);
+    }
+}
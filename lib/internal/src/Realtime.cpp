@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/Realtime.hpp"
+#include <cerrno>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <pthread.h>
+#include <sched.h>
+#include <fmt/format.h>
+#include <sys/mman.h>
+#include <mxl/platform.h>
+
+namespace mxl::lib
+{
+    namespace
+    {
+        /** Read the first line of a sysfs or procfs file. Returns an empty string if the file can't be read. */
+        std::string readFirstLine(std::filesystem::path const& path)
+        {
+            auto result = std::string{};
+            if (auto file = std::ifstream{path}; file)
+            {
+                std::getline(file, result);
+            }
+            return result;
+        }
+
+        /** Check whether a CPU is part of a kernel CPU list, such as "0-3,8,10-11". */
+        bool cpuListContains(std::string_view list, unsigned int cpu) noexcept
+        {
+            while (!list.empty())
+            {
+                auto const comma = list.find(',');
+                auto const range = list.substr(0, comma);
+                list = (comma == std::string_view::npos) ? std::string_view{} : list.substr(comma + 1U);
+
+                auto first = 0U;
+                auto last = 0U;
+                auto const dash = range.find('-');
+                auto const firstPart = range.substr(0, dash);
+                if (std::from_chars(firstPart.data(), firstPart.data() + firstPart.size(), first).ec != std::errc{})
+                {
+                    continue;
+                }
+                last = first;
+                if (dash != std::string_view::npos)
+                {
+                    auto const lastPart = range.substr(dash + 1U);
+                    if (std::from_chars(lastPart.data(), lastPart.data() + lastPart.size(), last).ec != std::errc{})
+                    {
+                        continue;
+                    }
+                }
+
+                if ((cpu >= first) && (cpu <= last))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    namespace this_thread
+    {
+        MXL_EXPORT
+        int pinToCpu([[maybe_unused]] unsigned int cpu) noexcept
+        {
+#if defined(__linux__)
+            if (cpu >= CPU_SETSIZE)
+            {
+                return EINVAL;
+            }
+
+            auto cpuSet = ::cpu_set_t{};
+            CPU_ZERO(&cpuSet);
+            CPU_SET(cpu, &cpuSet);
+            return ::pthread_setaffinity_np(::pthread_self(), sizeof cpuSet, &cpuSet);
+#else
+            // Thread affinity can only be expressed as a hint on macOS, which is
+            // not what callers of this function are asking for.
+            return ENOTSUP;
+#endif
+        }
+
+        MXL_EXPORT
+        int setRealtimePriority(int priority) noexcept
+        {
+            if ((priority < ::sched_get_priority_min(SCHED_FIFO)) || (priority > ::sched_get_priority_max(SCHED_FIFO)))
+            {
+                return EINVAL;
+            }
+
+            auto param = ::sched_param{};
+            param.sched_priority = priority;
+            return ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param);
+        }
+    }
+
+    MXL_EXPORT
+    int lockProcessMemory() noexcept
+    {
+        return (::mlockall(MCL_CURRENT | MCL_FUTURE) == 0) ? 0 : errno;
+    }
+
+    MXL_EXPORT
+    std::vector<std::string> cpuIsolationHints([[maybe_unused]] unsigned int cpu)
+    {
+        auto result = std::vector<std::string>{};
+
+#if defined(__linux__)
+        auto const cpuRoot = std::filesystem::path{"/sys/devices/system/cpu"};
+        if (!cpuListContains(readFirstLine(cpuRoot / "isolated"), cpu))
+        {
+            result.emplace_back(fmt::format("CPU {} is not isolated from the scheduler. Consider adding it to the isolcpus= kernel parameter.", cpu));
+        }
+        if (!cpuListContains(readFirstLine(cpuRoot / "nohz_full"), cpu))
+        {
+            result.emplace_back(fmt::format("CPU {} receives scheduler ticks. Consider adding it to the nohz_full= kernel parameter.", cpu));
+        }
+
+        if (auto const governor = readFirstLine(cpuRoot / fmt::format("cpu{}", cpu) / "cpufreq" / "scaling_governor");
+            !governor.empty() && (governor != "performance"))
+        {
+            result.emplace_back(fmt::format("CPU {} uses the '{}' frequency governor. Consider switching it to 'performance'.", cpu, governor));
+        }
+
+        // Collect the interrupts that are allowed to be serviced on the CPU.
+        auto irqs = std::string{};
+        auto ec = std::error_code{};
+        for (auto const& entry : std::filesystem::directory_iterator{"/proc/irq", ec})
+        {
+            if (entry.is_directory(ec) && cpuListContains(readFirstLine(entry.path() / "smp_affinity_list"), cpu))
+            {
+                irqs += irqs.empty() ? "" : ", ";
+                irqs += entry.path().filename().string();
+            }
+        }
+        if (!irqs.empty())
+        {
+            result.emplace_back(fmt::format(
+                "IRQs {} may be serviced on CPU {}. Consider moving them away through /proc/irq/<irq>/smp_affinity_list or irqbalance --banirq.",
+                irqs,
+                cpu));
+        }
+#endif
+
+        return result;
+    }
+}
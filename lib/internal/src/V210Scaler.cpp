@@ -0,0 +1,302 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl-internal/V210Scaler.hpp"
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <mxl/platform.h>
+
+#if defined(__x86_64__)
+#   include <immintrin.h>
+#elif defined(__aarch64__)
+#   include <arm_neon.h>
+#endif
+
+namespace mxl::lib
+{
+    namespace
+    {
+        /** Size in bytes of a v210 block, which packs 6 pixels as 12 samples in 4 words of 3 samples each. */
+        constexpr auto const V210_BLOCK_SIZE = std::size_t{16};
+
+        /** Number of pixels in a v210 block. */
+        constexpr auto const V210_BLOCK_PIXELS = std::size_t{6};
+
+        /** Number of words in a v210 block. */
+        constexpr auto const V210_BLOCK_WORDS = std::size_t{4};
+
+        /** Limits the number of source samples averaged into a target sample, which keeps the fixed point division exact. */
+        constexpr auto const MAX_SAMPLES_PER_TARGET_SAMPLE = std::size_t{4096};
+
+        /**
+         * Add the three samples of the first words of a packed line to the sums of their positions
+         * in the words (sums for the first sample of each word, then for the second, then for the third).
+         * \return The number of words processed.
+         */
+        using AccumulateFunction = std::size_t (*)(std::uint8_t const* in_line, std::uint32_t* io_sums, std::size_t in_words,
+            std::size_t in_sumStride) noexcept;
+
+        struct ScalerImplementation
+        {
+            AccumulateFunction function;
+            char const* name;
+        };
+
+        std::uint32_t load32(std::uint8_t const* in_data) noexcept
+        {
+            auto result = std::uint32_t{};
+            std::memcpy(&result, in_data, sizeof result);
+            return result;
+        }
+
+        void store32(std::uint8_t* out_data, std::uint32_t in_value) noexcept
+        {
+            std::memcpy(out_data, &in_value, sizeof in_value);
+        }
+
+        std::size_t accumulateNone(std::uint8_t const*, std::uint32_t*, std::size_t, std::size_t) noexcept
+        {
+            return 0U;
+        }
+
+        void accumulateScalar(std::uint8_t const* in_line, std::uint32_t* io_sums, std::size_t in_firstWord, std::size_t in_words,
+            std::size_t in_sumStride) noexcept
+        {
+            for (auto word = in_firstWord; word < in_words; ++word)
+            {
+                auto const value = load32(in_line + 4U * word);
+                io_sums[word] += value & 0x3FFU;
+                io_sums[in_sumStride + word] += (value >> 10) & 0x3FFU;
+                io_sums[2U * in_sumStride + word] += (value >> 20) & 0x3FFU;
+            }
+        }
+
+#if defined(__x86_64__)
+        __attribute__((target("avx2")))
+        std::size_t accumulateAvx2(std::uint8_t const* in_line, std::uint32_t* io_sums, std::size_t in_words, std::size_t in_sumStride) noexcept
+        {
+            auto const mask = _mm256_set1_epi32(0x3FF);
+            auto const sums0 = io_sums;
+            auto const sums1 = io_sums + in_sumStride;
+            auto const sums2 = io_sums + 2U * in_sumStride;
+
+            auto word = std::size_t{0};
+            for (; (word + 8U) <= in_words; word += 8U)
+            {
+                auto const value = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in_line + 4U * word));
+                auto const sum0 = reinterpret_cast<__m256i*>(sums0 + word);
+                auto const sum1 = reinterpret_cast<__m256i*>(sums1 + word);
+                auto const sum2 = reinterpret_cast<__m256i*>(sums2 + word);
+                _mm256_storeu_si256(sum0, _mm256_add_epi32(_mm256_loadu_si256(sum0), _mm256_and_si256(value, mask)));
+                _mm256_storeu_si256(sum1, _mm256_add_epi32(_mm256_loadu_si256(sum1), _mm256_and_si256(_mm256_srli_epi32(value, 10), mask)));
+                _mm256_storeu_si256(sum2, _mm256_add_epi32(_mm256_loadu_si256(sum2), _mm256_and_si256(_mm256_srli_epi32(value, 20), mask)));
+            }
+            return word;
+        }
+#elif defined(__aarch64__)
+        std::size_t accumulateNeon(std::uint8_t const* in_line, std::uint32_t* io_sums, std::size_t in_words, std::size_t in_sumStride) noexcept
+        {
+            auto const mask = vdupq_n_u32(0x3FFU);
+            auto const sums0 = io_sums;
+            auto const sums1 = io_sums + in_sumStride;
+            auto const sums2 = io_sums + 2U * in_sumStride;
+
+            auto word = std::size_t{0};
+            for (; (word + 4U) <= in_words; word += 4U)
+            {
+                auto const value = vreinterpretq_u32_u8(vld1q_u8(in_line + 4U * word));
+                vst1q_u32(sums0 + word, vaddq_u32(vld1q_u32(sums0 + word), vandq_u32(value, mask)));
+                vst1q_u32(sums1 + word, vaddq_u32(vld1q_u32(sums1 + word), vandq_u32(vshrq_n_u32(value, 10), mask)));
+                vst1q_u32(sums2 + word, vaddq_u32(vld1q_u32(sums2 + word), vandq_u32(vshrq_n_u32(value, 20), mask)));
+            }
+            return word;
+        }
+#endif
+
+        ScalerImplementation selectImplementation() noexcept
+        {
+#if defined(__x86_64__)
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return {&accumulateAvx2, "avx2"};
+            }
+#elif defined(__aarch64__)
+            // Advanced SIMD is mandatory on ARMv8-A.
+            return {&accumulateNeon, "neon"};
+#endif
+            return {&accumulateNone, "scalar"};
+        }
+
+        ScalerImplementation const& implementation() noexcept
+        {
+            static auto const result = selectImplementation();
+            return result;
+        }
+
+    }
+
+    MXL_EXPORT
+    V210Scaler::V210Scaler(std::size_t in_sourceWidth, std::size_t in_sourceHeight, std::size_t in_targetWidth, std::size_t in_targetHeight)
+        : _sourceWidth{in_sourceWidth}
+        , _sourceHeight{in_sourceHeight}
+        , _targetWidth{in_targetWidth}
+        , _targetHeight{in_targetHeight}
+        , _sourceBlocks{(in_sourceWidth + V210_BLOCK_PIXELS - 1U) / V210_BLOCK_PIXELS}
+        , _sumStride{(_sourceBlocks * V210_BLOCK_WORDS + 7U) & ~std::size_t{7}}
+        , _maxTaps{0}
+        , _maxLines{0}
+    {
+        if ((in_targetWidth == 0U) || (in_targetHeight == 0U) || ((in_targetWidth % V210_BLOCK_PIXELS) != 0U))
+        {
+            throw std::invalid_argument{"The target of a v210 scaler must be a non-empty multiple of 6 pixels wide."};
+        }
+        if ((in_targetWidth > in_sourceWidth) || (in_targetHeight > in_sourceHeight))
+        {
+            throw std::invalid_argument{"A v210 scaler can only downscale pictures."};
+        }
+
+        auto const footprint = [](std::size_t in_index, std::size_t in_source, std::size_t in_target)
+        {
+            auto const first = in_index * in_source / in_target;
+            auto const last = (in_index + 1U) * in_source / in_target;
+            return Footprint{static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(last - first)};
+        };
+
+        for (auto line = std::size_t{0}; line < in_targetHeight; ++line)
+        {
+            _lines.push_back(footprint(line, in_sourceHeight, in_targetHeight));
+            _maxLines = std::max(_maxLines, _lines.back().count);
+        }
+        for (auto pixel = std::size_t{0}; pixel < in_targetWidth; ++pixel)
+        {
+            _luma.push_back(footprint(pixel, in_sourceWidth, in_targetWidth));
+            _maxTaps = std::max(_maxTaps, _luma.back().count);
+        }
+
+        // Chroma is shared by pairs of pixels, the chroma of a target pair covers every source pair that has
+        // a pixel covered by the luma of the target pair.
+        for (auto pair = std::size_t{0}; pair < in_targetWidth / 2U; ++pair)
+        {
+            auto const first = _luma[2U * pair].first / 2U;
+            auto const last = (_luma[2U * pair + 1U].first + _luma[2U * pair + 1U].count - 1U) / 2U;
+            _chroma.push_back(Footprint{first, last - first + 1U});
+            _maxTaps = std::max(_maxTaps, _chroma.back().count);
+        }
+
+        // Sums are divided by multiplying them with a fixed point reciprocal of the number of samples. Sums are less than
+        // 1024 times the number of samples n and the reciprocal is off by less than n / 2^48, which keeps the error below
+        // 1 / n, i.e. the result is exact, as long as n is less than ~6500.
+        if ((std::size_t{_maxTaps} * _maxLines) > MAX_SAMPLES_PER_TARGET_SAMPLE)
+        {
+            throw std::invalid_argument{"The downscaling ratio of a v210 scaler is too large."};
+        }
+
+        _reciprocals.resize(std::size_t{_maxLines + 1U} * (_maxTaps + 1U));
+        for (auto lines = std::uint64_t{1}; lines <= _maxLines; ++lines)
+        {
+            for (auto taps = std::uint64_t{1}; taps <= _maxTaps; ++taps)
+            {
+                _reciprocals[lines * (_maxTaps + 1U) + taps] = ((std::uint64_t{1} << 48) + lines * taps - 1U) / (lines * taps);
+            }
+        }
+    }
+
+    MXL_EXPORT
+    void V210Scaler::scaleLines(std::uint8_t const* in_source, std::size_t in_sourceStride, std::uint8_t* out_target, std::size_t in_targetStride,
+        std::size_t in_firstLine, std::size_t in_lastLine, std::vector<std::uint32_t>& io_scratch) const
+    {
+        // The sums of the three sample positions of the source words, followed by the prefix sums of the luma, Cb and Cr planes.
+        auto const pixels = V210_BLOCK_PIXELS * _sourceBlocks;
+        io_scratch.resize(3U * _sumStride + (pixels + 1U) + 2U * (pixels / 2U + 1U));
+        auto const sums = io_scratch.data();
+        auto const accumulate = implementation().function;
+        auto const words = _sourceBlocks * V210_BLOCK_WORDS;
+
+        for (auto line = in_firstLine; line < std::min(in_lastLine, _targetHeight); ++line)
+        {
+            std::fill_n(sums, 3U * _sumStride, 0U);
+
+            auto const [first, count] = _lines[line];
+            for (auto sourceLine = std::size_t{first}; sourceLine < first + count; ++sourceLine)
+            {
+                auto const source = in_source + sourceLine * in_sourceStride;
+                accumulateScalar(source, sums, accumulate(source, sums, words, _sumStride), words, _sumStride);
+            }
+
+            scaleLine(sums, sums + 3U * _sumStride, count, out_target + line * in_targetStride);
+        }
+    }
+
+    void V210Scaler::scaleLine(std::uint32_t const* in_sums, std::uint32_t* io_prefix, std::uint32_t in_lineCount, std::uint8_t* out_line) const noexcept
+    {
+        // Turn the sums into prefix sums of the luma, Cb and Cr planes, so that averaging any number of source pixels takes
+        // a single subtraction. The prefix sums wrap around, which is harmless because the sum of the samples averaged into
+        // a target sample always fits.
+        auto const luma = io_prefix;
+        auto const cb = luma + V210_BLOCK_PIXELS * _sourceBlocks + 1U;
+        auto const cr = cb + V210_BLOCK_PIXELS * _sourceBlocks / 2U + 1U;
+        auto const s0 = in_sums;
+        auto const s1 = in_sums + _sumStride;
+        auto const s2 = in_sums + 2U * _sumStride;
+
+        luma[0] = cb[0] = cr[0] = 0U;
+        for (auto block = std::size_t{0}; block < _sourceBlocks; ++block)
+        {
+            // Cb0 Y0 Cr0 | Y1 Cb2 Y2 | Cr2 Y3 Cb4 | Y4 Cr4 Y5
+            auto const w = V210_BLOCK_WORDS * block;
+            auto const y = luma + V210_BLOCK_PIXELS * block;
+            y[1] = y[0] + s1[w];
+            y[2] = y[1] + s0[w + 1U];
+            y[3] = y[2] + s2[w + 1U];
+            y[4] = y[3] + s1[w + 2U];
+            y[5] = y[4] + s0[w + 3U];
+            y[6] = y[5] + s2[w + 3U];
+
+            auto const b = cb + 3U * block;
+            b[1] = b[0] + s0[w];
+            b[2] = b[1] + s1[w + 1U];
+            b[3] = b[2] + s2[w + 2U];
+
+            auto const r = cr + 3U * block;
+            r[1] = r[0] + s2[w];
+            r[2] = r[1] + s0[w + 2U];
+            r[3] = r[2] + s1[w + 3U];
+        }
+
+        auto const reciprocals = _reciprocals.data() + std::size_t{in_lineCount} * (_maxTaps + 1U);
+        auto const average = [&](std::uint32_t const* in_prefix, Footprint const& in_footprint)
+        {
+            auto const sum = std::uint64_t{in_prefix[in_footprint.first + in_footprint.count] - in_prefix[in_footprint.first]};
+            auto const rounding = (std::uint64_t{in_footprint.count} * in_lineCount) / 2U;
+            return static_cast<std::uint32_t>(((sum + rounding) * reciprocals[in_footprint.count]) >> 48);
+        };
+
+        for (auto block = std::size_t{0}; block < _targetWidth / V210_BLOCK_PIXELS; ++block)
+        {
+            // Samples of a block, in v210 order: Cb Y Cr Y Cb Y Cr Y Cb Y Cr Y
+            auto samples = std::array<std::uint32_t, 12>{};
+            for (auto pair = std::size_t{0}; pair < 3U; ++pair)
+            {
+                auto const index = 3U * block + pair;
+                samples[4U * pair] = average(cb, _chroma[index]);
+                samples[4U * pair + 1U] = average(luma, _luma[2U * index]);
+                samples[4U * pair + 2U] = average(cr, _chroma[index]);
+                samples[4U * pair + 3U] = average(luma, _luma[2U * index + 1U]);
+            }
+
+            for (auto word = std::size_t{0}; word < V210_BLOCK_WORDS; ++word)
+            {
+                store32(out_line + block * V210_BLOCK_SIZE + 4U * word,
+                    samples[3U * word] | (samples[3U * word + 1U] << 10) | (samples[3U * word + 2U] << 20));
+            }
+        }
+    }
+
+    MXL_EXPORT
+    char const* v210ScalerImplementation() noexcept
+    {
+        return implementation().name;
+    }
+}
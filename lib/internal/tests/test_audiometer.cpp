@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include "mxl-internal/AudioMeter.hpp"
+
+using namespace mxl::lib;
+
+namespace
+{
+    /** Samples of a sine wave, one buffer per channel like in the channel buffers of a continuous flow. */
+    std::vector<float> sine(std::size_t channels, std::size_t count, double frequency, double amplitude, double phase, double sampleRate)
+    {
+        auto result = std::vector<float>(channels * count);
+        for (auto channel = std::size_t{0}; channel < channels; ++channel)
+        {
+            for (auto i = std::size_t{0}; i < count; ++i)
+            {
+                result[channel * count + i] = static_cast<float>(amplitude * std::sin(2.0 * std::numbers::pi * frequency * i / sampleRate + phase));
+            }
+        }
+        return result;
+    }
+}
+
+TEST_CASE("AudioMeter : Loudness of a stereo sine wave", "[audiometer]")
+{
+    // EBU Tech 3341, test 1: a 1 kHz sine wave at -23 dBFS on both channels of a stereo programme measures -23 LUFS.
+    for (auto const sampleRate : {48000.0, 44100.0, 96000.0})
+    {
+        INFO(fmt::format("{} Hz", sampleRate));
+
+        auto const count = static_cast<std::size_t>(4.0 * sampleRate);
+        auto const samples = sine(2U, count, 1000.0, std::pow(10.0, -23.0 / 20.0), 0.0, sampleRate);
+
+        auto meter = AudioMeter{2U, sampleRate};
+        REQUIRE(std::isinf(meter.momentaryLoudness()));
+
+        // Feed the samples in uneven chunks, which must not matter.
+        for (auto offset = std::size_t{0}; offset < count; offset += 1237U)
+        {
+            meter.process(samples.data() + offset, std::min<std::size_t>(1237U, count - offset), count * sizeof(float));
+        }
+
+        REQUIRE(std::fabs(meter.momentaryLoudness() + 23.0) < 0.1);
+        REQUIRE(std::fabs(meter.shortTermLoudness() + 23.0) < 0.1);
+        REQUIRE(std::fabs(meter.rms(0) - std::pow(10.0, -23.0 / 20.0) / std::numbers::sqrt2) < 1e-4);
+
+        // Channels with a weight of 0, like LFE channels, don't contribute.
+        meter.setChannelWeight(1U, 0.0);
+        meter.process(samples.data(), count, count * sizeof(float));
+        REQUIRE(std::fabs(meter.shortTermLoudness() + 26.01) < 0.1);
+    }
+}
+
+TEST_CASE("AudioMeter : True peak", "[audiometer]")
+{
+    // EBU Tech 3341, test 15: a sine wave at a quarter of the sample rate, sampled 45 degrees off its peaks,
+    // has sample peaks 3 dB below its true peak.
+    auto const count = std::size_t{48000};
+    auto const samples = sine(1U, count, 12000.0, 0.5, std::numbers::pi / 4.0, 48000.0);
+
+    auto meter = AudioMeter{1U, 48000.0};
+    meter.process(samples.data(), count, count * sizeof(float));
+
+    REQUIRE(std::fabs(meter.peak(0) - 0.5 / std::numbers::sqrt2) < 1e-6);
+    auto const truePeakDb = 20.0 * std::log10(meter.truePeak(0) / 0.5);
+    REQUIRE(truePeakDb > -0.4);
+    REQUIRE(truePeakDb < 0.2);
+
+    meter.resetLevels();
+    REQUIRE(meter.peak(0) == 0.0);
+    REQUIRE(meter.truePeak(0) == 0.0);
+    REQUIRE(meter.rms(0) == 0.0);
+}
+
+TEST_CASE("AudioMeter : Channels are independent and wrapped slices are consumed in order", "[audiometer]")
+{
+    auto generator = std::mt19937{42};
+    auto distribution = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+
+    // An odd number of channels exercises the padding of the vector implementations.
+    constexpr auto channels = std::size_t{7};
+    constexpr auto count = std::size_t{20000};
+    auto samples = std::vector<float>(channels * count);
+    for (auto channel = std::size_t{0}; channel < channels; ++channel)
+    {
+        auto const gain = 1.0f / static_cast<float>(channel + 1U);
+        for (auto i = std::size_t{0}; i < count; ++i)
+        {
+            samples[channel * count + i] = gain * distribution(generator);
+        }
+    }
+
+    auto meter = AudioMeter{channels, 48000.0};
+    auto const split = std::size_t{7777};
+    auto slice = mxlWrappedMultiBufferSlice{};
+    slice.base.fragments[0] = {samples.data(), split * sizeof(float)};
+    slice.base.fragments[1] = {samples.data() + split, (count - split) * sizeof(float)};
+    slice.stride = count * sizeof(float);
+    slice.count = channels;
+    meter.process(slice);
+
+    for (auto channel = std::size_t{0}; channel < channels; ++channel)
+    {
+        INFO(fmt::format("channel {}", channel));
+
+        auto single = AudioMeter{1U, 48000.0};
+        single.process(samples.data() + channel * count, count, 0U);
+
+        REQUIRE(std::fabs(meter.peak(channel) - single.peak(0)) <= 1e-12);
+        REQUIRE(std::fabs(meter.truePeak(channel) - single.truePeak(0)) <= 1e-12);
+        REQUIRE(std::fabs(meter.rms(channel) - single.rms(0)) <= 1e-12);
+        REQUIRE(meter.truePeak(channel) >= meter.peak(channel) * 0.99);
+    }
+}
+
+TEST_CASE("AudioMeter : Throughput", "[.][audiometer][benchmark]")
+{
+    // One second of a 64 channel flow.
+    constexpr auto channels = std::size_t{64};
+    constexpr auto count = std::size_t{48000};
+    constexpr auto iterations = 8;
+
+    auto const samples = sine(channels, count, 997.0, 0.5, 0.0, 48000.0);
+    auto meter = AudioMeter{channels, 48000.0};
+
+    auto const start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        meter.process(samples.data(), count, count * sizeof(float));
+    }
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    REQUIRE(meter.truePeak(0) > 0.0);
+
+    WARN(fmt::format("audio meter ({}): {:.1f}% of a core per 64 channel 48 kHz flow", audioMeterImplementation(), 100.0 * elapsed / iterations));
+}
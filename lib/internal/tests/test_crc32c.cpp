@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include "mxl-internal/Crc32c.hpp"
+
+using namespace mxl::lib;
+
+namespace
+{
+    std::uint32_t referenceCrc32c(std::uint8_t const* data, std::size_t size)
+    {
+        auto crc = ~std::uint32_t{0};
+        for (auto i = std::size_t{0}; i < size; ++i)
+        {
+            crc ^= data[i];
+            for (auto bit = 0; bit < 8; ++bit)
+            {
+                crc = ((crc & 1U) != 0U) ? ((crc >> 1) ^ 0x82F6'3B78U) : (crc >> 1);
+            }
+        }
+        return ~crc;
+    }
+
+    std::vector<std::uint8_t> randomBytes(std::size_t size)
+    {
+        auto generator = std::mt19937{42};
+        auto result = std::vector<std::uint8_t>(size);
+        for (auto& b : result)
+        {
+            b = static_cast<std::uint8_t>(generator());
+        }
+        return result;
+    }
+}
+
+TEST_CASE("CRC32C : Check value", "[crc32c]")
+{
+    // See https://reveng.sourceforge.io/crc-catalogue/17plus.htm#crc.cat.crc-32-iscsi
+    auto const check = "123456789";
+    REQUIRE(crc32c(check, std::strlen(check)) == 0xE306'9283U);
+    REQUIRE(crc32c(check, 0U) == 0U);
+}
+
+TEST_CASE("CRC32C : Matches the reference implementation", "[crc32c]")
+{
+    auto const data = randomBytes(256U * 1024U);
+
+    // Cover the tail handling as well as the interleaved streams of the accelerated implementations.
+    for (auto const size : {1U, 7U, 8U, 9U, 4095U, 24575U, 24576U, 24577U, 49152U, 100'003U, 256U * 1024U})
+    {
+        INFO("size: " << size << ", implementation: " << crc32cImplementation());
+        REQUIRE(crc32c(data.data(), size) == referenceCrc32c(data.data(), size));
+    }
+}
+
+TEST_CASE("CRC32C : Incremental computation", "[crc32c]")
+{
+    auto const data = randomBytes(100'000U);
+    auto const expected = crc32c(data.data(), data.size());
+
+    for (auto const split : {0U, 1U, 13U, 24576U, 50'000U, 99'999U})
+    {
+        auto const first = crc32c(data.data(), split);
+        REQUIRE(crc32c(data.data() + split, data.size() - split, first) == expected);
+    }
+}
+
+TEST_CASE("CRC32C : Throughput", "[.][crc32c][benchmark]")
+{
+    // A full 1080p v210 frame is ~5.5MB, use a buffer large enough not to be served from the caches.
+    constexpr auto bufferSize = std::size_t{256U * 1024U * 1024U};
+    constexpr auto iterations = 8;
+
+    auto const data = randomBytes(bufferSize);
+    auto result = std::uint32_t{0};
+
+    auto const start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        result ^= crc32c(data.data(), data.size());
+    }
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto const gigabytes = static_cast<double>(bufferSize) * iterations / 1e9;
+    WARN(fmt::format("crc32c ({}): {:.2f} GB/s, {:.1f} ms per GB (result {:08x})",
+        crc32cImplementation(),
+        gigabytes / elapsed,
+        1e3 * elapsed / gigabytes,
+        result));
+}
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include "mxl-internal/FabricsStats.hpp"
+
+using namespace mxl::lib;
+
+TEST_CASE("Fabrics stats : Statistics round trip", "[fabrics]")
+{
+    auto shared = FabricsStats{};
+    auto values = FabricsValues{};
+    values.version = FABRICS_STATS_VERSION;
+    values.role = FABRICS_ROLE_SENDER;
+    std::strncpy(values.peer, "192.0.2.1:5000", sizeof values.peer - 1U);
+    values.grains = 1234U;
+    values.latencyHistogram[3] = 42U;
+    values.errorCodes[0] = 5;
+    values.errorCounts[0] = 2U;
+
+    publishFabricsStats(shared, values);
+    REQUIRE(shared.sequence == 2U);
+
+    auto read = FabricsValues{};
+    REQUIRE(readFabricsStats(shared, read));
+    REQUIRE(std::memcmp(&read, &values, sizeof read) == 0);
+
+    // A snapshot can't be read while an update is in progress.
+    shared.sequence = 3U;
+    REQUIRE(!readFabricsStats(shared, read));
+}
+
+TEST_CASE("Fabrics stats : Snapshots are consistent while being updated", "[fabrics]")
+{
+    auto shared = FabricsStats{};
+    auto stop = std::atomic<bool>{false};
+
+    // Every update sets all the counters to the same value, a torn snapshot would mix two updates.
+    auto writer = std::thread{[&]()
+        {
+            auto values = FabricsValues{};
+            values.version = FABRICS_STATS_VERSION;
+            for (auto update = std::uint64_t{1}; !stop.load(std::memory_order_relaxed); ++update)
+            {
+                values.bytes = update;
+                values.grains = update;
+                values.writes = update;
+                for (auto& bucket : values.latencyHistogram)
+                {
+                    bucket = update;
+                }
+                values.maxLatencyNs = update;
+                publishFabricsStats(shared, values);
+            }
+        }};
+
+    auto snapshots = 0;
+    for (auto attempt = 0; attempt < 10'000; ++attempt)
+    {
+        auto read = FabricsValues{};
+        if (readFabricsStats(shared, read))
+        {
+            ++snapshots;
+            REQUIRE(read.grains == read.bytes);
+            REQUIRE(read.writes == read.bytes);
+            for (auto const bucket : read.latencyHistogram)
+            {
+                REQUIRE(bucket == read.bytes);
+            }
+            REQUIRE(read.maxLatencyNs == read.bytes);
+        }
+    }
+
+    stop = true;
+    writer.join();
+    REQUIRE(snapshots > 0);
+}
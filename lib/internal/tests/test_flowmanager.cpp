@@ -6,17 +6,46 @@
 #include <cstdlib>
 #include <atomic>
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <thread>
+#include <vector>
 #include <uuid.h>
 #include <catch2/catch_test_macros.hpp>
 #include <fmt/format.h>
+#include "mxl-internal/DiscreteFlowData.hpp"
 #include "mxl-internal/FlowManager.hpp"
 #include "mxl-internal/PathUtils.hpp"
 #include "../../tests/Utils.hpp"
 
 using namespace mxl::lib;
 
+namespace
+{
+    /**
+     * Split the grain arena of a flow into one file per grain, which is how flows were stored
+     * before the grain arena was introduced.
+     */
+    void splitGrainArena(std::filesystem::path const& flowDirectory, std::size_t grainCount, std::size_t payloadSize)
+    {
+        auto const grainDir = makeGrainDirectoryName(flowDirectory);
+        auto const arenaFile = makeGrainArenaFilePath(grainDir);
+        auto const stride = DiscreteFlowData::grainStrideFor(payloadSize);
+
+        auto arena = std::ifstream{arenaFile, std::ios::binary};
+        auto grain = std::vector<char>(sizeof(GrainHeader) + payloadSize);
+        for (auto i = std::size_t{0}; i < grainCount; ++i)
+        {
+            arena.seekg(static_cast<std::streamoff>(i * stride));
+            arena.read(grain.data(), static_cast<std::streamsize>(grain.size()));
+            auto out = std::ofstream{makeGrainDataFilePath(grainDir, i), std::ios::binary | std::ios::trunc};
+            out.write(grain.data(), static_cast<std::streamsize>(grain.size()));
+        }
+        arena.close();
+        remove(arenaFile);
+    }
+}
+
 TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : Create Manager", "[flow manager]")
 {
     remove_all(domain);
@@ -77,20 +106,14 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow Manager : Creat
     auto const channelDataFile = makeChannelDataFilePath(flowDirectory);
     REQUIRE(!exists(channelDataFile));
 
-    // Count the grains.
+    // All grains are stored in a single arena.
     auto const grainDir = makeGrainDirectoryName(flowDirectory);
     REQUIRE(exists(grainDir));
     REQUIRE(is_directory(grainDir));
 
-    auto grainCount = std::size_t{0};
-    for (auto const& entry : std::filesystem::directory_iterator{grainDir})
-    {
-        if (is_regular_file(entry))
-        {
-            grainCount += 1U;
-        }
-    }
-    REQUIRE(grainCount == 5U);
+    auto const arenaFile = makeGrainArenaFilePath(grainDir);
+    REQUIRE(is_regular_file(arenaFile));
+    REQUIRE(file_size(arenaFile) == 5U * DiscreteFlowData::grainStrideFor(payloadSize));
 
     // This should throw since the flow metadata will already exist.
     REQUIRE_THROWS(
@@ -536,3 +559,70 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "FlowManager: createF
     // restore perms so we can clean up
     permissions(domain, std::filesystem::perms::owner_all, std::filesystem::perm_options::add);
 }
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "FlowManager: open flow with one file per grain", "[flow manager]")
+{
+    auto mgr = std::make_shared<FlowManager>(domain);
+    auto const id = *uuids::uuid::from_string("dddddddd-0000-0000-0000-000000000000");
+    auto const def = mxl::tests::readFile("data/v210_flow.json");
+    auto const rate = mxlRational{50, 1};
+
+    auto const payloadSize = 512;
+    auto const sliceSizes = std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN>{payloadSize, 0, 0, 0};
+    mgr->createDiscreteFlow(id, def, MXL_DATA_FORMAT_VIDEO, 4, rate, payloadSize, 1, sliceSizes).reset();
+
+    splitGrainArena(makeFlowDirectoryName(domain, uuids::to_string(id)), 4, payloadSize);
+
+    auto flow = mgr->openFlow(id, AccessMode::READ_ONLY);
+    auto* d = dynamic_cast<DiscreteFlowData*>(flow.get());
+    REQUIRE(d);
+    REQUIRE(d->grainCount() == 4U);
+    for (auto i = std::size_t{0}; i < 4U; ++i)
+    {
+        REQUIRE(d->grainInfoAt(i)->grainSize == payloadSize);
+    }
+    REQUIRE(d->grainAt(4) == nullptr);
+
+    flow.reset();
+    REQUIRE(mgr->deleteFlow(id));
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "FlowManager: open latency", "[.][flow manager][benchmark]")
+{
+    auto mgr = std::make_shared<FlowManager>(domain);
+    auto const id = *uuids::uuid::from_string("eeeeeeee-0000-0000-0000-000000000000");
+    auto const def = mxl::tests::readFile("data/v210_flow.json");
+    auto const rate = mxlRational{120, 1};
+
+    // The cost of opening a flow doesn't depend on the payload size. Keep it small, so that splitting the arena stays cheap.
+    auto const payloadSize = 65'536;
+    auto const sliceSizes = std::array<std::uint32_t, MXL_MAX_PLANES_PER_GRAIN>{payloadSize, 0, 0, 0};
+    constexpr auto iterations = 100;
+
+    auto const measure = [&]()
+    {
+        auto const start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < iterations; ++i)
+        {
+            auto flow = mgr->openFlow(id, AccessMode::READ_ONLY);
+            REQUIRE(flow);
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+    };
+
+    for (auto const grainCount : {4U, 16U, 120U, 1200U})
+    {
+        mgr->createDiscreteFlow(id, def, MXL_DATA_FORMAT_VIDEO, grainCount, rate, payloadSize, 1, sliceSizes).reset();
+        auto const arenaLatency = measure();
+
+        splitGrainArena(makeFlowDirectoryName(domain, uuids::to_string(id)), grainCount, payloadSize);
+        auto const fileLatency = measure();
+
+        WARN(fmt::format("{:5} grains: {:9.1f} us per open with a grain arena, {:9.1f} us per open with one file per grain",
+            grainCount,
+            arenaLatency,
+            fileLatency));
+
+        REQUIRE(mgr->deleteFlow(id));
+    }
+}
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include "mxl-internal/Keyer.hpp"
+#include "mxl-internal/MediaUtils.hpp"
+
+using namespace mxl::lib;
+
+namespace
+{
+    std::vector<std::uint8_t> randomBytes(std::size_t size, std::mt19937& generator)
+    {
+        auto result = std::vector<std::uint8_t>(size);
+        for (auto& b : result)
+        {
+            b = static_cast<std::uint8_t>(generator());
+        }
+        return result;
+    }
+
+    /** Extract the 10 bit sample at the specified position of a line that packs 3 samples per 32 bit word. */
+    int sampleAt(std::vector<std::uint8_t> const& line, std::size_t sample)
+    {
+        auto word = std::uint32_t{};
+        std::memcpy(&word, line.data() + 4U * (sample / 3U), sizeof word);
+        return static_cast<int>((word >> (10U * (sample % 3U))) & 0x3FFU);
+    }
+
+    /** Check whether the first samples of two lines are equal, ignoring the unused top bits of their words. */
+    bool sameSamples(std::vector<std::uint8_t> const& lhs, std::vector<std::uint8_t> const& rhs, std::size_t count)
+    {
+        for (auto sample = std::size_t{0}; sample < count; ++sample)
+        {
+            if (sampleAt(lhs, sample) != sampleAt(rhs, sample))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Set every sample of a line that packs 3 samples per 32 bit word to the same value. */
+    void fillSamples(std::vector<std::uint8_t>& line, std::uint32_t value)
+    {
+        auto const word = value | (value << 10) | (value << 20);
+        for (auto offset = std::size_t{0}; offset + 4U <= line.size(); offset += 4U)
+        {
+            std::memcpy(line.data() + offset, &word, sizeof word);
+        }
+    }
+
+    /** Straightforward floating point model of the keyer, working on unpacked samples. */
+    double referenceSample(std::vector<std::uint8_t> const& fill, std::vector<std::uint8_t> const& key, std::vector<std::uint8_t> const& background,
+        std::size_t sample, KeyMode mode, bool fullRange)
+    {
+        auto const block = sample / 12U;
+        auto const position = sample % 12U;
+        auto const luma = (position % 2U) != 0U;
+        auto const pixel = block * 6U + (luma ? (position - 1U) / 2U : (position / 4U) * 2U);
+
+        auto const k = (pixel / 3U < key.size() / 4U) ? sampleAt(key, pixel) : 0;
+        auto const alpha = fullRange ? k / 1023.0 : std::clamp((k - 64) / 876.0, 0.0, 1.0);
+        auto const f = static_cast<double>(sampleAt(fill, sample));
+        auto const b = static_cast<double>(sampleAt(background, sample));
+        auto const zero = luma ? (fullRange ? 0.0 : 64.0) : 512.0;
+
+        auto const result = (mode == KeyMode::STRAIGHT) ? (b + (f - b) * alpha) : (f + (b - zero) * (1.0 - alpha));
+        return std::clamp(result, 0.0, 1023.0);
+    }
+}
+
+TEST_CASE("Keyer : Matches the reference implementation", "[keyer]")
+{
+    auto generator = std::mt19937{42};
+
+    // Cover the tail handling as well as the multi-block iterations of the accelerated implementations.
+    for (auto const width : {1U, 6U, 7U, 13U, 720U, 1280U, 1920U, 3840U})
+    {
+        for (auto const mode : {KeyMode::STRAIGHT, KeyMode::PREMULTIPLIED})
+        {
+            for (auto const fullRange : {false, true})
+            {
+                auto const fill = randomBytes(getV210LineLength(width), generator);
+                auto const key = randomBytes(get10BitAlphaLineLength(width), generator);
+                auto const background = randomBytes(getV210LineLength(width), generator);
+                auto output = std::vector<std::uint8_t>(fill.size());
+
+                keyV210aLine(fill.data(), key.data(), background.data(), output.data(), width, mode, fullRange);
+
+                INFO("width: " << width << ", premultiplied: " << (mode == KeyMode::PREMULTIPLIED) << ", full range: " << fullRange
+                               << ", implementation: " << keyerImplementation());
+                auto mismatches = 0;
+                for (auto sample = std::size_t{0}; sample < (width + 5U) / 6U * 12U; ++sample)
+                {
+                    auto const expected = referenceSample(fill, key, background, sample, mode, fullRange);
+                    mismatches += (std::abs(sampleAt(output, sample) - expected) > 1.0) ? 1 : 0;
+                }
+                REQUIRE(mismatches == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("Keyer : Opaque and transparent keys", "[keyer]")
+{
+    auto generator = std::mt19937{42};
+    constexpr auto width = 1920U;
+
+    auto const fill = randomBytes(getV210LineLength(width), generator);
+    auto background = randomBytes(getV210LineLength(width), generator);
+    auto key = std::vector<std::uint8_t>(get10BitAlphaLineLength(width));
+    auto output = std::vector<std::uint8_t>(fill.size());
+
+    for (auto const fullRange : {false, true})
+    {
+        INFO("full range: " << fullRange << ", implementation: " << keyerImplementation());
+
+        // A fully opaque straight key replaces the background with the fill.
+        fillSamples(key, fullRange ? 1023U : 940U);
+        keyV210aLine(fill.data(), key.data(), background.data(), output.data(), width, KeyMode::STRAIGHT, fullRange);
+        REQUIRE(sameSamples(output, fill, width * 2U));
+
+        // A fully transparent key leaves the background untouched.
+        fillSamples(key, fullRange ? 0U : 64U);
+        keyV210aLine(fill.data(), key.data(), background.data(), output.data(), width, KeyMode::STRAIGHT, fullRange);
+        REQUIRE(sameSamples(output, background, width * 2U));
+    }
+
+    // Compositing in place produces the same result as compositing to a separate line.
+    fillSamples(key, 512U);
+    keyV210aLine(fill.data(), key.data(), background.data(), output.data(), width, KeyMode::PREMULTIPLIED, false);
+    keyV210aLine(fill.data(), key.data(), background.data(), background.data(), width, KeyMode::PREMULTIPLIED, false);
+    REQUIRE(sameSamples(output, background, width * 2U));
+}
+
+TEST_CASE("Keyer : Throughput", "[.][keyer][benchmark]")
+{
+    // Composite full 1080p frames, which are large enough not to be served from the caches.
+    constexpr auto width = 1920U;
+    constexpr auto height = 1080U;
+    constexpr auto iterations = 100;
+
+    auto generator = std::mt19937{42};
+    auto const fillLineLength = std::size_t{getV210LineLength(width)};
+    auto const keyLineLength = std::size_t{get10BitAlphaLineLength(width)};
+    auto const fill = randomBytes(fillLineLength * height, generator);
+    auto const key = randomBytes(keyLineLength * height, generator);
+    auto background = randomBytes(fillLineLength * height, generator);
+
+    auto const start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        for (auto line = std::size_t{0}; line < height; ++line)
+        {
+            keyV210aLine(fill.data() + line * fillLineLength,
+                key.data() + line * keyLineLength,
+                background.data() + line * fillLineLength,
+                background.data() + line * fillLineLength,
+                width,
+                KeyMode::STRAIGHT,
+                false);
+        }
+    }
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    WARN(fmt::format("keyer ({}): {:.1f} frames/s, {:.3f} ms per 1080p frame", keyerImplementation(), iterations / elapsed, 1e3 * elapsed / iterations));
+}
@@ -0,0 +1,243 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include "mxl-internal/Probe.hpp"
+
+using namespace mxl::lib;
+
+namespace
+{
+    std::vector<std::uint8_t> randomBytes(std::size_t size, std::mt19937& generator)
+    {
+        auto result = std::vector<std::uint8_t>(size);
+        for (auto& b : result)
+        {
+            b = static_cast<std::uint8_t>(generator());
+        }
+        return result;
+    }
+
+    /** Extract the luma sample of a pixel of a v210 line. */
+    std::uint32_t lumaAt(std::uint8_t const* line, std::size_t pixel)
+    {
+        // Position of the luma samples of a block in its 12 samples: Cb Y Cr Y Cb Y Cr Y Cb Y Cr Y
+        auto const sample = (pixel / 6U) * 12U + (pixel % 6U) * 2U + 1U;
+        auto word = std::uint32_t{};
+        std::memcpy(&word, line + 4U * (sample / 3U), sizeof word);
+        return (word >> (10U * (sample % 3U))) & 0x3FFU;
+    }
+
+    /** Straightforward model of the luma analysis, working on unpacked samples. */
+    LumaStats referenceLumaStats(std::vector<std::uint8_t> const& picture, std::size_t stride, std::size_t width, std::size_t height,
+        std::size_t lineStep, std::uint32_t threshold)
+    {
+        auto const blocks = width / 6U;
+        auto sums = std::vector<std::uint64_t>(PROBE_SIGNATURE_COLUMNS * PROBE_SIGNATURE_ROWS);
+        auto samples = std::vector<std::uint64_t>(sums.size());
+        auto result = LumaStats{};
+
+        for (auto line = std::size_t{0}; line < height; line += lineStep)
+        {
+            for (auto pixel = std::size_t{0}; pixel < blocks * 6U; ++pixel)
+            {
+                auto column = std::size_t{0};
+                while ((column + 1U) * blocks / PROBE_SIGNATURE_COLUMNS <= pixel / 6U)
+                {
+                    ++column;
+                }
+                auto const region = (line * PROBE_SIGNATURE_ROWS / height) * PROBE_SIGNATURE_COLUMNS + column;
+                auto const luma = lumaAt(picture.data() + line * stride, pixel);
+
+                sums[region] += luma;
+                samples[region] += 1U;
+                result.sum += luma;
+                result.samples += 1U;
+                result.blackSamples += (luma <= threshold) ? 1U : 0U;
+            }
+        }
+
+        for (auto region = std::size_t{0}; region < sums.size(); ++region)
+        {
+            if (samples[region] != 0U)
+            {
+                result.signature[region] = static_cast<std::uint16_t>(std::lround(16.0 * sums[region] / samples[region]));
+            }
+        }
+        return result;
+    }
+}
+
+TEST_CASE("Probe : Luma statistics match the reference implementation", "[probe]")
+{
+    auto generator = std::mt19937{42};
+
+    struct Geometry
+    {
+        std::size_t width;
+        std::size_t height;
+    };
+
+    for (auto const geometry : {Geometry{1920, 1080}, Geometry{1280, 720}, Geometry{720, 486}, Geometry{102, 17}, Geometry{6, 4}})
+    {
+        // Lines are padded to 48 pixels, like in v210 grains. Padding must be ignored.
+        auto const stride = (geometry.width + 47U) / 48U * 128U;
+        auto const picture = randomBytes(stride * geometry.height, generator);
+
+        for (auto const lineStep : {1U, 3U, 8U})
+        {
+            for (auto const threshold : {0U, 64U, 512U, 1023U, 5000U})
+            {
+                INFO(fmt::format("{}x{}, line step {}, threshold {}", geometry.width, geometry.height, lineStep, threshold));
+
+                auto const expected = referenceLumaStats(picture, stride, geometry.width, geometry.height, lineStep, threshold);
+                auto const actual = analyzeV210Luma(picture.data(), stride, geometry.width, geometry.height, lineStep, threshold);
+
+                REQUIRE(actual.sum == expected.sum);
+                REQUIRE(actual.samples == expected.samples);
+                REQUIRE(actual.blackSamples == expected.blackSamples);
+                REQUIRE(actual.signature == expected.signature);
+            }
+        }
+    }
+}
+
+TEST_CASE("Probe : Signature difference", "[probe]")
+{
+    auto generator = std::mt19937{42};
+    constexpr auto width = 1920U;
+    constexpr auto height = 1080U;
+    constexpr auto stride = width / 6U * 16U;
+
+    auto picture = randomBytes(stride * height, generator);
+    auto const before = analyzeV210Luma(picture.data(), stride, width, height, 2U, 64U);
+
+    // The same picture has the same signature.
+    REQUIRE(signatureDifference(before, analyzeV210Luma(picture.data(), stride, width, height, 2U, 64U)) == 0.0);
+
+    // Painting the top left corner white changes the signature of at least one region.
+    auto const white = std::uint32_t{940U | (940U << 10) | (940U << 20)};
+    for (auto line = std::size_t{0}; line < height / 4U; ++line)
+    {
+        for (auto word = std::size_t{0}; word < stride / 16U; ++word)
+        {
+            std::memcpy(picture.data() + line * stride + 4U * word, &white, sizeof white);
+        }
+    }
+    auto const after = analyzeV210Luma(picture.data(), stride, width, height, 2U, 64U);
+    REQUIRE(signatureDifference(before, after) > 1.0);
+    REQUIRE(signatureDifference(before, after) == signatureDifference(after, before));
+}
+
+TEST_CASE("Probe : Sample statistics", "[probe]")
+{
+    auto generator = std::mt19937{42};
+    auto distribution = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+
+    for (auto const count : {0U, 1U, 7U, 8U, 9U, 63U, 1001U, 48000U})
+    {
+        INFO(fmt::format("{} samples", count));
+
+        auto samples = std::vector<float>(count);
+        for (auto& sample : samples)
+        {
+            sample = distribution(generator);
+        }
+
+        auto expectedSquares = 0.0;
+        auto expectedPeak = 0.0f;
+        for (auto const sample : samples)
+        {
+            expectedSquares += static_cast<double>(sample) * sample;
+            expectedPeak = std::max(expectedPeak, std::fabs(sample));
+        }
+
+        // Accumulate in two fragments, like the two parts of a wrapped buffer.
+        auto stats = SampleStats{};
+        accumulateSampleStats(samples.data(), count / 3U, stats);
+        accumulateSampleStats(samples.data() + count / 3U, count - count / 3U, stats);
+
+        REQUIRE(stats.samples == count);
+        REQUIRE(stats.peak == expectedPeak);
+        REQUIRE(std::fabs(stats.sumOfSquares - expectedSquares) <= 1e-9 * std::max(expectedSquares, 1.0));
+    }
+}
+
+TEST_CASE("Probe : Statistics round trip", "[probe]")
+{
+    auto shared = ProbeStats{};
+    auto values = ProbeValues{};
+    values.version = PROBE_STATS_VERSION;
+    values.flags = PROBE_FLAG_FROZEN | PROBE_FLAG_SILENT;
+    values.index = 1234U;
+    values.channelCount = 2U;
+    values.rms[1] = -20.0f;
+
+    publishProbeStats(shared, values);
+    REQUIRE(shared.sequence == 2U);
+
+    auto read = ProbeValues{};
+    REQUIRE(readProbeStats(shared, read));
+    REQUIRE(std::memcmp(&read, &values, sizeof read) == 0);
+
+    // A snapshot can't be read while an update is in progress.
+    shared.sequence = 3U;
+    REQUIRE(!readProbeStats(shared, read));
+}
+
+TEST_CASE("Probe : Throughput", "[.][probe][benchmark]")
+{
+    // Analyse full 1080p frames, which are large enough not to be served from the caches.
+    constexpr auto width = 1920U;
+    constexpr auto height = 1080U;
+    constexpr auto stride = width / 6U * 16U;
+    constexpr auto frames = 16U;
+    constexpr auto iterations = 512;
+
+    auto generator = std::mt19937{42};
+    auto const pictures = randomBytes(stride * height * frames, generator);
+
+    for (auto const lineStep : {1U, 4U})
+    {
+        auto total = std::uint64_t{0};
+        auto const start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < iterations; ++i)
+        {
+            auto const stats = analyzeV210Luma(pictures.data() + (i % frames) * stride * height, stride, width, height, lineStep, 64U);
+            total += stats.blackSamples;
+        }
+        auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        REQUIRE(total > 0U);
+
+        WARN(fmt::format("probe ({}): {:.1f} frames/s at line step {}, {:.3f} ms per 1080p frame",
+            probeImplementation(),
+            iterations / elapsed,
+            lineStep,
+            1e3 * elapsed / iterations));
+    }
+
+    auto samples = std::vector<float>(48000U * 16U);
+    for (auto& sample : samples)
+    {
+        sample = static_cast<float>(generator()) / 4294967296.0f;
+    }
+    auto stats = SampleStats{};
+    auto const start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        accumulateSampleStats(samples.data(), samples.size(), stats);
+    }
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    REQUIRE(stats.samples == iterations * samples.size());
+
+    WARN(fmt::format("probe ({}): {:.1f} channel seconds of 48 kHz audio per ms", probeImplementation(), iterations * 16.0 / (1e3 * elapsed)));
+}
@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include "mxl-internal/MediaUtils.hpp"
+#include "mxl-internal/V210Scaler.hpp"
+
+using namespace mxl::lib;
+
+namespace
+{
+    /** A v210 picture together with accessors for its unpacked samples. */
+    struct Picture
+    {
+        Picture(std::size_t width, std::size_t height)
+            : width{width}
+            , height{height}
+            , stride{getV210LineLength(width)}
+            , data(stride * height)
+        {}
+
+        /** Sample at a position of a line, in v210 order (Cb Y Cr Y ...). */
+        std::uint32_t sample(std::size_t line, std::size_t position) const
+        {
+            auto word = std::uint32_t{};
+            std::memcpy(&word, data.data() + line * stride + 4U * (position / 3U), sizeof word);
+            return (word >> (10U * (position % 3U))) & 0x3FFU;
+        }
+
+        void setSample(std::size_t line, std::size_t position, std::uint32_t value)
+        {
+            auto word = std::uint32_t{};
+            auto const offset = line * stride + 4U * (position / 3U);
+            std::memcpy(&word, data.data() + offset, sizeof word);
+            word = (word & ~(0x3FFU << (10U * (position % 3U)))) | (value << (10U * (position % 3U)));
+            std::memcpy(data.data() + offset, &word, sizeof word);
+        }
+
+        std::size_t width;
+        std::size_t height;
+        std::size_t stride;
+        std::vector<std::uint8_t> data;
+    };
+
+    Picture randomPicture(std::size_t width, std::size_t height, std::mt19937& generator)
+    {
+        auto result = Picture{width, height};
+        for (auto line = std::size_t{0}; line < height; ++line)
+        {
+            for (auto position = std::size_t{0}; position < 2U * width; ++position)
+            {
+                result.setSample(line, position, generator() & 0x3FFU);
+            }
+        }
+        return result;
+    }
+
+    /** Average of the samples of a source rectangle, with the same rounding as the scaler. */
+    std::uint32_t boxAverage(Picture const& source, std::size_t firstLine, std::size_t lastLine, std::size_t first, std::size_t last,
+        std::size_t step, std::size_t offset)
+    {
+        auto sum = std::uint32_t{0};
+        auto count = std::uint32_t{0};
+        for (auto line = firstLine; line < lastLine; ++line)
+        {
+            for (auto index = first; index < last; ++index)
+            {
+                sum += source.sample(line, step * index + offset);
+                ++count;
+            }
+        }
+        return (sum + count / 2U) / count;
+    }
+
+    /** Straightforward box filter, working on unpacked samples. */
+    std::uint32_t referenceSample(Picture const& source, std::size_t targetWidth, std::size_t targetHeight, std::size_t line, std::size_t position)
+    {
+        auto const firstLine = line * source.height / targetHeight;
+        auto const lastLine = (line + 1U) * source.height / targetHeight;
+
+        if ((position % 2U) != 0U)
+        {
+            auto const pixel = position / 2U;
+            return boxAverage(source,
+                firstLine,
+                lastLine,
+                pixel * source.width / targetWidth,
+                (pixel + 1U) * source.width / targetWidth,
+                2U,
+                1U);
+        }
+
+        auto const pair = position / 4U;
+        auto const firstPair = (2U * pair * source.width / targetWidth) / 2U;
+        auto const lastPair = ((2U * pair + 2U) * source.width / targetWidth - 1U) / 2U + 1U;
+        return boxAverage(source, firstLine, lastLine, firstPair, lastPair, 4U, position % 4U);
+    }
+}
+
+TEST_CASE("V210 scaler : Matches the reference implementation", "[v210scaler]")
+{
+    auto generator = std::mt19937{42};
+
+    struct Geometry
+    {
+        std::size_t sourceWidth;
+        std::size_t sourceHeight;
+        std::size_t targetWidth;
+        std::size_t targetHeight;
+    };
+
+    // Integer and fractional ratios, odd source widths and a source that is not scaled at all.
+    for (auto const& geometry : {Geometry{1920, 1080, 480, 270},
+             Geometry{1920, 1080, 636, 358},
+             Geometry{1280, 720, 474, 266},
+             Geometry{721, 13, 96, 5},
+             Geometry{13, 4, 6, 4},
+             Geometry{96, 8, 96, 8}})
+    {
+        INFO("source: " << geometry.sourceWidth << "x" << geometry.sourceHeight << ", target: " << geometry.targetWidth << "x"
+                        << geometry.targetHeight << ", implementation: " << v210ScalerImplementation());
+
+        auto const source = randomPicture(geometry.sourceWidth, geometry.sourceHeight, generator);
+        auto target = Picture{geometry.targetWidth, geometry.targetHeight};
+        auto scratch = std::vector<std::uint32_t>{};
+
+        auto const scaler = V210Scaler{geometry.sourceWidth, geometry.sourceHeight, geometry.targetWidth, geometry.targetHeight};
+        scaler.scaleLines(source.data.data(), source.stride, target.data.data(), target.stride, 0U, geometry.targetHeight, scratch);
+
+        auto mismatches = 0;
+        for (auto line = std::size_t{0}; line < geometry.targetHeight; ++line)
+        {
+            for (auto position = std::size_t{0}; position < 2U * geometry.targetWidth; ++position)
+            {
+                auto const expected = referenceSample(source, geometry.targetWidth, geometry.targetHeight, line, position);
+                mismatches += (target.sample(line, position) != expected) ? 1 : 0;
+            }
+        }
+        REQUIRE(mismatches == 0);
+    }
+}
+
+TEST_CASE("V210 scaler : Ranges of lines", "[v210scaler]")
+{
+    auto generator = std::mt19937{42};
+    auto const source = randomPicture(1920, 1080, generator);
+    auto const scaler = V210Scaler{1920, 1080, 480, 270};
+    auto scratch = std::vector<std::uint32_t>{};
+
+    auto whole = Picture{480, 270};
+    scaler.scaleLines(source.data.data(), source.stride, whole.data.data(), whole.stride, 0U, 270U, scratch);
+
+    // Scaling in bands, as done by concurrent workers, produces the same picture.
+    auto bands = Picture{480, 270};
+    for (auto line = std::size_t{0}; line < 270U; line += 32U)
+    {
+        scaler.scaleLines(source.data.data(), source.stride, bands.data.data(), bands.stride, line, line + 32U, scratch);
+    }
+    REQUIRE(whole.data == bands.data);
+}
+
+TEST_CASE("V210 scaler : Invalid geometry", "[v210scaler]")
+{
+    REQUIRE_THROWS_AS((V210Scaler{1920, 1080, 0, 270}), std::invalid_argument);
+    REQUIRE_THROWS_AS((V210Scaler{1920, 1080, 481, 270}), std::invalid_argument);
+    REQUIRE_THROWS_AS((V210Scaler{1920, 1080, 3840, 270}), std::invalid_argument);
+    REQUIRE_THROWS_AS((V210Scaler{1920, 1080, 480, 2160}), std::invalid_argument);
+}
+
+TEST_CASE("V210 scaler : Throughput", "[.][v210scaler][benchmark]")
+{
+    // Scale 16 different 1080p sources to the tiles of a 4x4 1080p multiviewer, which is large enough
+    // not to be served from the caches. Everything runs on the calling thread.
+    constexpr auto tiles = std::size_t{16};
+    constexpr auto iterations = 20;
+
+    auto generator = std::mt19937{42};
+    auto sources = std::vector<Picture>{};
+    for (auto i = std::size_t{0}; i < tiles; ++i)
+    {
+        sources.push_back(randomPicture(1920, 1080, generator));
+    }
+    auto target = Picture{1920, 1080};
+    auto scratch = std::vector<std::uint32_t>{};
+    auto const scaler = V210Scaler{1920, 1080, 480, 270};
+
+    auto const start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        for (auto tile = std::size_t{0}; tile < tiles; ++tile)
+        {
+            auto const offset = (tile / 4U) * 270U * target.stride + (tile % 4U) * 480U / 6U * 16U;
+            scaler.scaleLines(sources[tile].data.data(), sources[tile].stride, target.data.data() + offset, target.stride, 0U, 270U, scratch);
+        }
+    }
+    auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto const tilesPerSecond = static_cast<double>(tiles) * iterations / elapsed;
+    WARN(fmt::format("v210 scaler ({}): {:.0f} 1080p to 480x270 tiles/s per core, {:.3f} ms per tile",
+        v210ScalerImplementation(),
+        tilesPerSecond,
+        1e3 / tilesPerSecond));
+}
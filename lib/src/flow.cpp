@@ -5,10 +5,12 @@
 #include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <stdexcept>
 #include <string>
 #include <uuid.h>
 #include <sys/file.h>
 #include <mxl/mxl.h>
+#include <mxl/time.h>
 #include "mxl-internal/Instance.hpp"
 #include "mxl-internal/Logging.hpp"
 #include "mxl-internal/PathUtils.hpp"
@@ -47,6 +49,12 @@ mxlStatus mxlCreateFlow(mxlInstance instance, char const* flowDef, char const* o
             return MXL_ERR_UNKNOWN;
         }
     }
+    catch (std::invalid_argument const& e)
+    {
+        // Thrown for flow definitions and flow options that are malformed or not supported for the flow.
+        MXL_ERROR("Failed to create flow : {}", e.what());
+        return MXL_ERR_INVALID_ARG;
+    }
     catch (std::exception const& e)
     {
         MXL_ERROR("Failed to create flow : {}", e.what());
@@ -314,7 +322,7 @@ mxlStatus mxlFlowReaderGetConfigInfo(mxlFlowReader reader, mxlFlowConfigInfo* in
         {
             if (auto const cppReader = to_FlowReader(reader); cppReader != nullptr)
             {
-                *info = cppReader->getFlowInfo().config;
+                *info = cppReader->getFlowConfigInfo();
                 return MXL_STATUS_OK;
             }
             return MXL_ERR_INVALID_FLOW_READER;
@@ -337,7 +345,53 @@ mxlStatus mxlFlowReaderGetRuntimeInfo(mxlFlowReader reader, mxlFlowRuntimeInfo*
         {
             if (auto const cppReader = to_FlowReader(reader); cppReader != nullptr)
             {
-                *info = cppReader->getFlowInfo().runtime;
+                *info = cppReader->getFlowRuntimeInfo();
+                return MXL_STATUS_OK;
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetRuntimeView(mxlFlowReader reader, mxlFlowRuntimeView* view)
+{
+    try
+    {
+        if (view != nullptr)
+        {
+            if (auto const cppReader = to_FlowReader(reader); cppReader != nullptr)
+            {
+                *view = cppReader->getFlowRuntimeView();
+                return MXL_STATUS_OK;
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetHeadIndex(mxlFlowReader reader, uint64_t* headIndex)
+{
+    try
+    {
+        if (headIndex != nullptr)
+        {
+            if (auto const cppReader = to_FlowReader(reader); cppReader != nullptr)
+            {
+                *headIndex = cppReader->getHeadIndex();
                 return MXL_STATUS_OK;
             }
             return MXL_ERR_INVALID_FLOW_READER;
@@ -410,6 +464,125 @@ mxlStatus mxlFlowReaderGetGrainSliceNonBlocking(mxlFlowReader reader, uint64_t i
     }
 }
 
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderOpenSliceCursor(mxlFlowReader reader, uint64_t index, mxlGrainSliceCursor* cursor)
+{
+    try
+    {
+        if (cursor != nullptr)
+        {
+            if (auto const cppReader = dynamic_cast<DiscreteFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            {
+                *cursor = mxlGrainSliceCursor{};
+                cursor->index = index;
+                return MXL_STATUS_OK;
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetNextSlices(mxlFlowReader reader, mxlGrainSliceCursor* cursor, uint64_t timeoutNs, uint16_t* firstSlice,
+    uint16_t* lastSlice)
+{
+    try
+    {
+        if ((cursor != nullptr) && (firstSlice != nullptr) && (lastSlice != nullptr))
+        {
+            if (auto const cppReader = dynamic_cast<DiscreteFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            {
+                return cppReader->getNextSlices(*cursor, timeoutNs, firstSlice, lastSlice);
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetLatestGrain(mxlFlowReader reader, uint16_t minValidSlices, mxlGrainInfo* grainInfo, uint8_t** payload)
+{
+    try
+    {
+        if ((grainInfo != nullptr) && (payload != nullptr))
+        {
+            if (auto const cppReader = dynamic_cast<DiscreteFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            {
+                return cppReader->getLatestGrain(minValidSlices, grainInfo, payload);
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetGrainAtRate(mxlFlowReader reader, mxlRational const* editRate, uint64_t index, uint64_t timeoutNs, mxlGrainInfo* grainInfo,
+    uint8_t** payload)
+{
+    try
+    {
+        if ((grainInfo != nullptr) && (payload != nullptr))
+        {
+            if (auto const cppReader = dynamic_cast<DiscreteFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            {
+                auto const& grainRate = cppReader->getFlowData().flowInfo()->config.common.grainRate;
+                if (auto const grainIndex = mxlConvertIndex(editRate, index, &grainRate); grainIndex != MXL_UNDEFINED_INDEX)
+                {
+                    return cppReader->getGrain(grainIndex, UINT16_MAX, timeoutNs, grainInfo, payload);
+                }
+                return MXL_ERR_INVALID_ARG;
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderVerifyGrain(mxlFlowReader reader, mxlGrainInfo const* grainInfo, uint8_t const* payload)
+{
+    try
+    {
+        if ((grainInfo != nullptr) && (payload != nullptr))
+        {
+            if (auto const cppReader = dynamic_cast<DiscreteFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            {
+                return cppReader->verifyGrain(*grainInfo, payload);
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
 extern "C"
 MXL_EXPORT
 mxlStatus mxlFlowWriterGetGrainInfo(mxlFlowWriter writer, uint64_t index, mxlGrainInfo* grainInfo)
@@ -498,6 +671,68 @@ mxlStatus mxlFlowWriterCommitGrain(mxlFlowWriter writer, mxlGrainInfo const* gra
     }
 }
 
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowWriterCommitInvalidRange(mxlFlowWriter writer, uint64_t firstIndex, uint64_t lastIndex)
+{
+    try
+    {
+        if (auto const cppWriter = dynamic_cast<DiscreteFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+        {
+            return cppWriter->commitInvalidRange(firstIndex, lastIndex);
+        }
+        return MXL_ERR_INVALID_FLOW_WRITER;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowWriterClaimRecord(mxlFlowWriter writer, uint64_t index, uint32_t size, mxlDataRecord* record)
+{
+    try
+    {
+        if (record != nullptr)
+        {
+            if (auto const cppWriter = dynamic_cast<DiscreteFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+            {
+                return cppWriter->claimRecord(index, size, record);
+            }
+            return MXL_ERR_INVALID_FLOW_WRITER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowWriterCommitRecord(mxlFlowWriter writer, mxlDataRecord const* record)
+{
+    try
+    {
+        if (record != nullptr)
+        {
+            if (auto const cppWriter = dynamic_cast<DiscreteFlowWriter*>(to_FlowWriter(writer)); cppWriter != nullptr)
+            {
+                return cppWriter->commitRecord(*record);
+            }
+            return MXL_ERR_INVALID_FLOW_WRITER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
 extern "C"
 MXL_EXPORT
 mxlStatus mxlFlowReaderGetSamples(mxlFlowReader reader, uint64_t index, size_t count, uint64_t timeoutNs,
@@ -522,6 +757,47 @@ mxlStatus mxlFlowReaderGetSamples(mxlFlowReader reader, uint64_t index, size_t c
     }
 }
 
+extern "C"
+MXL_EXPORT
+mxlStatus mxlFlowReaderGetSamplesAtRate(mxlFlowReader reader, mxlRational const* editRate, uint64_t index, uint64_t timeoutNs,
+    mxlWrappedMultiBufferSlice* payloadBuffersSlices, size_t* count)
+{
+    try
+    {
+        if ((payloadBuffersSlices != nullptr) && (index != MXL_UNDEFINED_INDEX))
+        {
+            if (auto const cppReader = dynamic_cast<ContinuousFlowReader*>(to_FlowReader(reader)); cppReader != nullptr)
+            {
+                // Sample ranges are addressed by the index of their last sample.
+                auto const& sampleRate = cppReader->getFlowData().flowInfo()->config.common.grainRate;
+                auto const firstSample = mxlConvertIndex(editRate, index, &sampleRate);
+                auto const endSample = mxlConvertIndex(editRate, index + 1U, &sampleRate);
+                if ((firstSample == MXL_UNDEFINED_INDEX) || (endSample == MXL_UNDEFINED_INDEX) || (endSample == firstSample))
+                {
+                    return MXL_ERR_INVALID_ARG;
+                }
+
+                auto const sampleCount = static_cast<std::size_t>(endSample - firstSample);
+                if (auto const status = cppReader->getSamples(endSample - 1U, sampleCount, timeoutNs, *payloadBuffersSlices); status != MXL_STATUS_OK)
+                {
+                    return status;
+                }
+                if (count != nullptr)
+                {
+                    *count = sampleCount;
+                }
+                return MXL_STATUS_OK;
+            }
+            return MXL_ERR_INVALID_FLOW_READER;
+        }
+        return MXL_ERR_INVALID_ARG;
+    }
+    catch (...)
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+}
+
 extern "C"
 MXL_EXPORT
 mxlStatus mxlFlowReaderGetSamplesNonBlocking(mxlFlowReader reader, uint64_t index, size_t count, mxlWrappedMultiBufferSlice* payloadBuffersSlices)
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl/keyer.h"
+#include <cstddef>
+#include "mxl-internal/Keyer.hpp"
+#include "mxl-internal/MediaUtils.hpp"
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlKeyV210a(mxlKeyerConfig const* config, uint8_t const* foreground, uint8_t const* background, uint8_t* output, uint32_t firstLine,
+    uint32_t lastLine)
+{
+    if ((config == nullptr) || (foreground == nullptr) || (background == nullptr) || (output == nullptr) || (config->width == 0U) ||
+        (firstLine > lastLine) || (lastLine > config->height) ||
+        ((config->mode != MXL_KEY_MODE_STRAIGHT) && (config->mode != MXL_KEY_MODE_PREMULTIPLIED)))
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    auto const fillLineLength = std::size_t{mxl::lib::getV210LineLength(config->width)};
+    auto const keyLineLength = std::size_t{mxl::lib::get10BitAlphaLineLength(config->width)};
+    auto const key = foreground + fillLineLength * config->height;
+    auto const mode = (config->mode == MXL_KEY_MODE_STRAIGHT) ? mxl::lib::KeyMode::STRAIGHT : mxl::lib::KeyMode::PREMULTIPLIED;
+
+    for (auto line = std::size_t{firstLine}; line < lastLine; ++line)
+    {
+        mxl::lib::keyV210aLine(foreground + line * fillLineLength,
+            key + line * keyLineLength,
+            background + line * fillLineLength,
+            output + line * fillLineLength,
+            config->width,
+            mode,
+            config->fullRange != 0U);
+    }
+    return MXL_STATUS_OK;
+}
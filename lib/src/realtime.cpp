@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "mxl/realtime.h"
+#include <cerrno>
+#include "mxl-internal/Realtime.hpp"
+
+namespace
+{
+    mxlStatus statusFromErrno(int error) noexcept
+    {
+        switch (error)
+        {
+            case 0:      return MXL_STATUS_OK;
+            case EPERM:
+            case EACCES: return MXL_ERR_PERMISSION_DENIED;
+            case EINVAL: return MXL_ERR_INVALID_ARG;
+            default:     return MXL_ERR_UNKNOWN;
+        }
+    }
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlSetCurrentThreadScheduling(mxlThreadSchedulingConfig const* config)
+{
+    if (config == nullptr)
+    {
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    if (config->cpu >= 0)
+    {
+        if (auto const status = statusFromErrno(mxl::lib::this_thread::pinToCpu(static_cast<unsigned int>(config->cpu)));
+            status != MXL_STATUS_OK)
+        {
+            return status;
+        }
+    }
+
+    if (config->rtPriority != 0)
+    {
+        return statusFromErrno(mxl::lib::this_thread::setRealtimePriority(config->rtPriority));
+    }
+    return MXL_STATUS_OK;
+}
+
+extern "C"
+MXL_EXPORT
+mxlStatus mxlLockProcessMemory()
+{
+    return statusFromErrno(mxl::lib::lockProcessMemory());
+}
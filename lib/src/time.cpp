@@ -52,6 +52,21 @@ uint64_t mxlIndexToTimestamp(mxlRational const* editRate, uint64_t index)
         (index * __int128_t{editRate->denominator} * 1'000'000'000 + __int128_t{editRate->numerator} / 2) / __int128_t{editRate->numerator});
 }
 
+extern "C"
+MXL_EXPORT
+uint64_t mxlConvertIndex(mxlRational const* fromRate, uint64_t index, mxlRational const* toRate)
+{
+    // Validate the edit rates, only positive rates map indices onto each other
+    if ((fromRate == nullptr) || (fromRate->denominator <= 0) || (fromRate->numerator <= 0) || (toRate == nullptr) || (toRate->denominator <= 0) ||
+        (toRate->numerator <= 0) || (index == MXL_UNDEFINED_INDEX))
+    {
+        return MXL_UNDEFINED_INDEX;
+    }
+
+    return static_cast<uint64_t>((index * __int128_t{fromRate->denominator} * __int128_t{toRate->numerator}) /
+                                 (__int128_t{fromRate->numerator} * __int128_t{toRate->denominator}));
+}
+
 extern "C"
 MXL_EXPORT
 uint64_t mxlGetNsUntilIndex(uint64_t index, mxlRational const* editRate)
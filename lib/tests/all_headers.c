@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <mxl/flow.h>
+#include <mxl/keyer.h>
 #include <mxl/mxl.h>
+#include <mxl/realtime.h>
 #include <mxl/time.h>
 
 // Simple test to ensure all headers are valid according to the C17 standard
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <rdma/fi_eq.h>
+#include "mxl/fabrics.h"
+#include "Completion.hpp"
+#include "CompletionQueue.hpp"
+#include "Exception.hpp"
+#include "Util.hpp"
+
+using namespace mxl::lib::fabrics::ofi;
+using namespace std::chrono_literals;
+
+TEST_CASE("ofi: CompletionQueue attributes from the API", "[ofi][CompletionQueue]")
+{
+    // A zero-initialized configuration selects the defaults.
+    auto attr = CompletionQueue::Attributes::fromAPI(mxlCompletionQueueConfig{});
+    REQUIRE(attr.size == 0);
+    REQUIRE(attr.waitObject == FI_WAIT_UNSPEC);
+    REQUIRE_FALSE(attr.signalingVector.has_value());
+
+    auto raw = attr.raw();
+    REQUIRE(raw.format == FI_CQ_FORMAT_DATA);
+    REQUIRE(raw.wait_cond == FI_CQ_COND_NONE);
+    REQUIRE((raw.flags & FI_AFFINITY) == 0);
+
+    attr = CompletionQueue::Attributes::fromAPI(mxlCompletionQueueConfig{
+        .depth = 512, .batchSize = 16, .waitObject = MXL_FABRICS_WAIT_OBJECT_NONE, .pinInterrupts = true, .signalingVector = 3});
+    REQUIRE(attr.size == 512);
+    REQUIRE(attr.waitObject == FI_WAIT_NONE);
+    REQUIRE(attr.signalingVector == 3);
+
+    raw = attr.raw();
+    REQUIRE(raw.size == 512);
+    REQUIRE(raw.wait_obj == FI_WAIT_NONE);
+    REQUIRE((raw.flags & FI_AFFINITY) != 0);
+    REQUIRE(raw.signaling_vector == 3);
+
+    REQUIRE(CompletionQueue::Attributes::fromAPI({.waitObject = MXL_FABRICS_WAIT_OBJECT_FD}).waitObject == FI_WAIT_FD);
+    REQUIRE(CompletionQueue::Attributes::fromAPI({.waitObject = MXL_FABRICS_WAIT_OBJECT_YIELD}).waitObject == FI_WAIT_YIELD);
+    REQUIRE_THROWS_AS(CompletionQueue::Attributes::fromAPI({.waitObject = static_cast<mxlFabricsWaitObject>(42)}), Exception);
+}
+
+TEST_CASE("ofi: CompletionQueue batch reads of an empty queue", "[ofi][CompletionQueue]")
+{
+    for (auto const waitObject : {MXL_FABRICS_WAIT_OBJECT_DEFAULT, MXL_FABRICS_WAIT_OBJECT_NONE})
+    {
+        INFO("wait object: " << static_cast<int>(waitObject));
+
+        auto cq = CompletionQueue::open(getDomain(), CompletionQueue::Attributes::fromAPI({.waitObject = waitObject}));
+        auto completions = std::vector<Completion>{};
+
+        REQUIRE(cq->readBatch(completions, 16) == 0);
+        REQUIRE(cq->readBatch(completions, 0) == 0);
+        REQUIRE(completions.empty());
+
+        // Blocking reads return once the timeout elapsed, whether the provider waits or the queue is polled.
+        auto const start = std::chrono::steady_clock::now();
+        REQUIRE(cq->readBatchBlocking(completions, 16, 50ms) == 0);
+        REQUIRE(std::chrono::steady_clock::now() - start >= 40ms);
+        REQUIRE(completions.empty());
+
+        REQUIRE_FALSE(cq->readBlocking(0ms).has_value());
+    }
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <catch2/catch_test_macros.hpp>
+#include <rdma/fi_errno.h>
+#include "mxl/fabrics.h"
+#include "LinkStats.hpp"
+
+using namespace mxl::lib::fabrics::ofi;
+using namespace std::chrono_literals;
+
+TEST_CASE("ofi: LinkStats latency buckets", "[ofi][LinkStats]")
+{
+    // Bucket 0 counts the latencies under 1 us, bucket i those under 2^i us.
+    REQUIRE(LinkStats::latencyBucket(-5us) == 0);
+    REQUIRE(LinkStats::latencyBucket(0ns) == 0);
+    REQUIRE(LinkStats::latencyBucket(999ns) == 0);
+    REQUIRE(LinkStats::latencyBucket(1us) == 1);
+    REQUIRE(LinkStats::latencyBucket(2us) == 2);
+    REQUIRE(LinkStats::latencyBucket(3us) == 2);
+    REQUIRE(LinkStats::latencyBucket(4us) == 3);
+    REQUIRE(LinkStats::latencyBucket(1023us) == 10);
+    REQUIRE(LinkStats::latencyBucket(1024us) == 11);
+
+    // The last bucket counts all the slower ones.
+    REQUIRE(LinkStats::latencyBucket(16'383us) == MXL_FABRICS_LATENCY_BUCKETS - 2);
+    REQUIRE(LinkStats::latencyBucket(16'384us) == MXL_FABRICS_LATENCY_BUCKETS - 1);
+    REQUIRE(LinkStats::latencyBucket(1h) == MXL_FABRICS_LATENCY_BUCKETS - 1);
+}
+
+TEST_CASE("ofi: LinkStats write counters", "[ofi][LinkStats]")
+{
+    auto stats = LinkStats{};
+    stats.posted(100);
+    stats.posted(200);
+    stats.posted(300);
+    REQUIRE(stats.values().bytes == 600);
+    REQUIRE(stats.values().writes == 3);
+    REQUIRE(stats.values().inFlight == 3);
+    REQUIRE(stats.values().maxInFlight == 3);
+
+    stats.completed(3us);
+    stats.completed(10us);
+    stats.grain();
+    auto values = stats.values();
+    REQUIRE(values.inFlight == 1);
+    REQUIRE(values.maxInFlight == 3);
+    REQUIRE(values.grains == 1);
+    REQUIRE(values.latencyHistogram[2] == 1);
+    REQUIRE(values.latencyHistogram[4] == 1);
+    REQUIRE(values.totalLatencyNs == 13'000);
+    REQUIRE(values.maxLatencyNs == 10'000);
+
+    // A failed write is no longer in flight, and the depth never goes below zero.
+    stats.failed(-FI_EIO, true);
+    stats.abandoned();
+    values = stats.values();
+    REQUIRE(values.inFlight == 0);
+    REQUIRE(values.errors == 1);
+
+    stats.linkFailed();
+    stats.linkRestored();
+    REQUIRE(stats.values().linkFailures == 1);
+    REQUIRE(stats.values().reconnects == 1);
+}
+
+TEST_CASE("ofi: LinkStats error codes", "[ofi][LinkStats]")
+{
+    auto stats = LinkStats{};
+    stats.failed(-FI_EIO, false);
+    stats.failed(-FI_EIO, false);
+
+    // Every code seen first gets an entry, the ones beyond the table only count in the total.
+    for (auto code = 1; code <= MXL_FABRICS_MAX_ERROR_CODES; ++code)
+    {
+        stats.failed(1000 + code, false);
+    }
+
+    auto const values = stats.values();
+    REQUIRE(values.errors == MXL_FABRICS_MAX_ERROR_CODES + 2);
+    REQUIRE(values.errorCodes[0].code == -FI_EIO);
+    REQUIRE(values.errorCodes[0].count == 2);
+    for (auto i = 1; i < MXL_FABRICS_MAX_ERROR_CODES; ++i)
+    {
+        REQUIRE(values.errorCodes[i].code == 1000 + i);
+        REQUIRE(values.errorCodes[i].count == 1);
+    }
+}
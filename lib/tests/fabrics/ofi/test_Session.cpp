@@ -0,0 +1,707 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <array>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "mxl/fabrics.h"
+#include "mxl/flow.h"
+#include "mxl/mxl.h"
+#include "mxl/time.h"
+#include "../../Utils.hpp"
+
+namespace
+{
+    /** The ids of the flows a loopback can mirror. */
+    constexpr auto FlowIds = std::array{
+        "9f1c2a3e-6c1d-4b7a-8e5f-0a1b2c3d4e5f",
+        "9f1c2a3e-6c1d-4b7a-8e5f-0a1b2c3d4e60",
+        "9f1c2a3e-6c1d-4b7a-8e5f-0a1b2c3d4e61",
+    };
+
+    std::string flowDef(char const* id)
+    {
+        return std::string{R"({
+        "description": "Fabrics session loopback test",
+        "format": "urn:x-nmos:format:data",
+        "label": "Fabrics session loopback test",
+        "version": "1453880607:123995943",
+        "parents": [],
+        "source_id": "0e635152-e501-4d4e-bb87-9f3fe05eb79a",
+        "device_id": "9126cc2f-4c26-4c9b-a6cd-93c4381c9be5",
+        "id": ")"} + id + R"(",
+        "media_type": "video/smpte291",
+        "grain_rate": {"numerator": 30000, "denominator": 1001}
+    })";
+    }
+
+    /** Instance options that give the flows a ring of about 30 grains, so that several grains can be in flight. */
+    constexpr auto InstanceOptions = R"({"urn:x-mxl:option:history_duration/v1.0": 1000000000})";
+
+    /** How long a test waits for the sessions to make a step of progress. */
+    constexpr auto ProgressTimeout = std::chrono::seconds{5};
+
+    /** The settings of the sessions of a loopback. */
+    struct LoopbackOptions
+    {
+        std::size_t flows = 1; /**< Number of flows mirrored over the sessions, up to the number of FlowIds. */
+        std::uint32_t creditWindow = 0;
+        mxlCompletionQueueConfig completionQueue = {};
+        std::vector<char const*> targetRails = {};    /**< The services of the extra rails of the target session. */
+        std::vector<char const*> initiatorRails = {}; /**< The services of the extra rails of the initiator session, as many. */
+    };
+
+    /** Flows mirrored from a source domain to a target domain, through an initiator and a target session on the tcp provider. */
+    class Loopback
+    {
+    public:
+        Loopback(char const* targetService, char const* initiatorService, LoopbackOptions const& options = {})
+            : _sourceDomain{mxl::tests::makeTempDomain()}
+            , _targetDomain{mxl::tests::makeTempDomain()}
+            , _targetService{targetService}
+            , _options{options}
+        {
+            for (auto const service : _options.targetRails)
+            {
+                _targetRails.push_back(mxlEndpointAddress{.node = "127.0.0.1", .service = service});
+            }
+            for (auto const service : _options.initiatorRails)
+            {
+                _initiatorRails.push_back(mxlEndpointAddress{.node = "127.0.0.1", .service = service});
+            }
+
+            _source = mxlCreateInstance(_sourceDomain.string().c_str(), InstanceOptions);
+            REQUIRE(_source != nullptr);
+            _target = mxlCreateInstance(_targetDomain.string().c_str(), InstanceOptions);
+            REQUIRE(_target != nullptr);
+
+            REQUIRE(_options.flows <= FlowIds.size());
+            for (auto i = std::size_t{0}; i < _options.flows; ++i)
+            {
+                auto& flow = _flows.emplace_back();
+                flow.id = FlowIds[i];
+                auto const def = flowDef(flow.id);
+                auto configInfo = mxlFlowConfigInfo{};
+                REQUIRE(mxlCreateFlow(_source, def.c_str(), nullptr, &configInfo) == MXL_STATUS_OK);
+                REQUIRE(mxlCreateFlowWriter(_source, flow.id, "", &flow.sourceWriter) == MXL_STATUS_OK);
+                REQUIRE(mxlCreateFlowReader(_source, flow.id, "", &flow.sourceReader) == MXL_STATUS_OK);
+                REQUIRE(mxlCreateFlow(_target, def.c_str(), nullptr, &configInfo) == MXL_STATUS_OK);
+                REQUIRE(mxlCreateFlowWriter(_target, flow.id, "", &flow.targetWriter) == MXL_STATUS_OK);
+            }
+
+            REQUIRE(mxlFabricsCreateInstance(_source, &_initiatorFabrics) == MXL_STATUS_OK);
+            REQUIRE(mxlFabricsCreateInstance(_target, &_targetFabrics) == MXL_STATUS_OK);
+
+            auto config = sessionConfig(initiatorService, _initiatorRails);
+            config.creditWindow = _options.creditWindow;
+            config.supervision = {.enabled = true, .retryIntervalMs = 20, .catchUpGrains = 0};
+            REQUIRE(mxlFabricsCreateInitiatorSession(_initiatorFabrics, &config, &_initiator) == MXL_STATUS_OK);
+
+            startTarget();
+            connect();
+        }
+
+        ~Loopback()
+        {
+            if (_targetInfo != nullptr)
+            {
+                mxlFabricsFreeTargetInfo(_targetInfo);
+            }
+            mxlFabricsDestroyInitiatorSession(_initiatorFabrics, _initiator);
+            stopTarget();
+            mxlFabricsDestroyInstance(_initiatorFabrics);
+            mxlFabricsDestroyInstance(_targetFabrics);
+
+            for (auto const& flow : _flows)
+            {
+                mxlReleaseFlowReader(_source, flow.sourceReader);
+                mxlReleaseFlowWriter(_source, flow.sourceWriter);
+                mxlReleaseFlowWriter(_target, flow.targetWriter);
+                mxlDestroyFlow(_source, flow.id);
+                mxlDestroyFlow(_target, flow.id);
+            }
+            mxlDestroyInstance(_source);
+            mxlDestroyInstance(_target);
+
+            auto error = std::error_code{};
+            std::filesystem::remove_all(_sourceDomain, error);
+            std::filesystem::remove_all(_targetDomain, error);
+        }
+
+        /** Create the target session and add the flows of the target domain to it, in order. */
+        void startTarget()
+        {
+            auto const config = sessionConfig(_targetService, _targetRails);
+            REQUIRE(mxlFabricsCreateTargetSession(_targetFabrics, &config, &_targetSession) == MXL_STATUS_OK);
+
+            for (auto& flow : _flows)
+            {
+                auto regions = mxlRegions{};
+                REQUIRE(mxlFabricsRegionsForFlowWriter(flow.targetWriter, &regions) == MXL_STATUS_OK);
+                auto const status = mxlFabricsTargetSessionAddFlow(_targetSession, regions, &flow.targetId);
+                mxlFabricsRegionsFree(regions);
+                REQUIRE(status == MXL_STATUS_OK);
+            }
+        }
+
+        void stopTarget()
+        {
+            if (_targetSession != nullptr)
+            {
+                mxlFabricsDestroyTargetSession(_targetFabrics, _targetSession);
+                _targetSession = nullptr;
+            }
+        }
+
+        /** Add the target session and the flows to the initiator session, with the current target info of the target session. The flows
+         * are added in the reverse order, so that their ids in the two sessions differ.
+         */
+        void connect()
+        {
+            if (_targetInfo != nullptr)
+            {
+                mxlFabricsFreeTargetInfo(_targetInfo);
+                _targetInfo = nullptr;
+            }
+            REQUIRE(mxlFabricsTargetSessionGetInfo(_targetSession, &_targetInfo) == MXL_STATUS_OK);
+
+            for (auto flow = _flows.rbegin(); flow != _flows.rend(); ++flow)
+            {
+                auto regions = mxlRegions{};
+                REQUIRE(mxlFabricsRegionsForFlowReader(flow->sourceReader, &regions) == MXL_STATUS_OK);
+                auto const status = mxlFabricsInitiatorSessionAddFlow(_initiator, _targetInfo, flow->targetId, regions, &flow->initiatorId);
+                mxlFabricsRegionsFree(regions);
+                REQUIRE(status == MXL_STATUS_OK);
+            }
+            REQUIRE(mxlFabricsInitiatorSessionConnect(_initiator, _targetInfo) == MXL_STATUS_OK);
+
+            REQUIRE(waitFor([&]() { return linkStatus().state == MXL_FABRICS_LINK_STATE_UP; }));
+        }
+
+        void disconnect()
+        {
+            REQUIRE(mxlFabricsInitiatorSessionDisconnect(_initiator, _targetInfo) == MXL_STATUS_OK);
+        }
+
+        /** Write a grain of a source flow, filled with a pattern derived from its index and the flow. */
+        void writeGrain(std::uint64_t index, std::size_t flow = 0)
+        {
+            auto info = mxlGrainInfo{};
+            auto payload = static_cast<std::uint8_t*>(nullptr);
+            REQUIRE(mxlFlowWriterOpenGrain(_flows.at(flow).sourceWriter, index, &info, &payload) == MXL_STATUS_OK);
+            for (auto i = std::uint32_t{0}; i < info.grainSize; ++i)
+            {
+                payload[i] = pattern(index + flow, i);
+            }
+            info.validSlices = info.totalSlices;
+            REQUIRE(mxlFlowWriterCommitGrain(_flows.at(flow).sourceWriter, &info) == MXL_STATUS_OK);
+        }
+
+        [[nodiscard]]
+        mxlStatus transferGrain(std::uint64_t index, std::size_t flow = 0)
+        {
+            return mxlFabricsInitiatorSessionTransferGrain(_initiator, _flows.at(flow).initiatorId, index);
+        }
+
+        /** Check that a grain was received in the right flow and holds the payload written to the source flow, then commit it to the
+         * target flow.
+         */
+        void requireReceived(std::uint64_t index, std::size_t flow = 0)
+        {
+            auto const& received = _flows.at(flow).received;
+            REQUIRE(waitFor([&]() { return std::ranges::find(received, index) != received.end(); }));
+            requirePayload(index, flow);
+        }
+
+        /** Check that a grain of a target flow holds the payload written to the source flow, then commit it. */
+        void requirePayload(std::uint64_t index, std::size_t flow = 0)
+        {
+            auto const writer = _flows.at(flow).targetWriter;
+            auto header = mxlGrainInfo{};
+            REQUIRE(mxlFlowWriterGetGrainInfo(writer, index, &header) == MXL_STATUS_OK);
+            REQUIRE(header.index == index);
+
+            auto info = mxlGrainInfo{};
+            auto payload = static_cast<std::uint8_t*>(nullptr);
+            REQUIRE(mxlFlowWriterOpenGrain(writer, index, &info, &payload) == MXL_STATUS_OK);
+            auto mismatches = std::size_t{0};
+            for (auto i = std::uint32_t{0}; i < info.grainSize; ++i)
+            {
+                mismatches += (payload[i] != pattern(index + flow, i)) ? 1U : 0U;
+            }
+            REQUIRE(mxlFlowWriterCommitGrain(writer, &header) == MXL_STATUS_OK);
+            REQUIRE(mismatches == 0);
+        }
+
+        void releaseGrains(std::uint64_t index, std::size_t flow = 0)
+        {
+            REQUIRE(mxlFabricsTargetSessionReleaseGrains(_targetSession, _flows.at(flow).targetId, index) == MXL_STATUS_OK);
+        }
+
+        /** Make progress on both sessions until a condition holds, or the progress timeout expires. */
+        bool waitFor(std::function<bool()> const& condition)
+        {
+            auto const deadline = std::chrono::steady_clock::now() + ProgressTimeout;
+            while (!condition())
+            {
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    return false;
+                }
+                pump();
+            }
+            return true;
+        }
+
+        /** Make a step of progress on both sessions, and collect the grains the target session received. */
+        void pump()
+        {
+            static_cast<void>(mxlFabricsInitiatorSessionMakeProgressBlocking(_initiator, 1));
+            if (_targetSession == nullptr)
+            {
+                return;
+            }
+
+            auto grain = mxlSessionGrain{};
+            while (mxlFabricsTargetSessionTryNewGrain(_targetSession, &grain) == MXL_STATUS_OK)
+            {
+                auto const flow = std::ranges::find(_flows, grain.flowId, &MirroredFlow::targetId);
+                REQUIRE(flow != _flows.end());
+                flow->received.push_back(grain.index);
+            }
+        }
+
+        /** The indices of the grains the target session received in a flow, in the order it reported them. */
+        [[nodiscard]]
+        std::vector<std::uint64_t> const& received(std::size_t flow = 0) const
+        {
+            return _flows.at(flow).received;
+        }
+
+        [[nodiscard]]
+        mxlFabricsInstance initiatorFabrics() const noexcept
+        {
+            return _initiatorFabrics;
+        }
+
+        [[nodiscard]]
+        mxlFabricsInstance targetFabrics() const noexcept
+        {
+            return _targetFabrics;
+        }
+
+        [[nodiscard]]
+        mxlFlowReader sourceReader(std::size_t flow) const
+        {
+            return _flows.at(flow).sourceReader;
+        }
+
+        [[nodiscard]]
+        mxlFlowWriter targetWriter(std::size_t flow) const
+        {
+            return _flows.at(flow).targetWriter;
+        }
+
+        /** The id of a flow in the initiator session. */
+        [[nodiscard]]
+        std::uint16_t initiatorFlowId(std::size_t flow) const
+        {
+            return _flows.at(flow).initiatorId;
+        }
+
+        /** The id of a flow in the target session. */
+        [[nodiscard]]
+        std::uint16_t targetFlowId(std::size_t flow) const
+        {
+            return _flows.at(flow).targetId;
+        }
+
+        [[nodiscard]]
+        mxlFabricsLinkStatus linkStatus() const
+        {
+            auto status = mxlFabricsLinkStatus{};
+            REQUIRE(mxlFabricsInitiatorSessionGetLinkStatus(_initiator, _targetInfo, &status) == MXL_STATUS_OK);
+            return status;
+        }
+
+        [[nodiscard]]
+        mxlFabricsLinkStats initiatorStats() const
+        {
+            auto stats = mxlFabricsLinkStats{};
+            REQUIRE(mxlFabricsInitiatorSessionGetStats(_initiator, _targetInfo, &stats) == MXL_STATUS_OK);
+            return stats;
+        }
+
+        [[nodiscard]]
+        mxlFabricsLinkStats targetStats() const
+        {
+            auto stats = mxlFabricsLinkStats{};
+            REQUIRE(mxlFabricsTargetSessionGetStats(_targetSession, &stats) == MXL_STATUS_OK);
+            return stats;
+        }
+
+        [[nodiscard]]
+        mxlStatus setFlowPacing(mxlFlowPacingConfig const& config, std::size_t flow = 0)
+        {
+            return mxlFabricsInitiatorSessionSetFlowPacing(_initiator, _flows.at(flow).initiatorId, &config);
+        }
+
+        [[nodiscard]]
+        mxlFlowPacingStats pacingStats(std::size_t flow = 0) const
+        {
+            auto stats = mxlFlowPacingStats{};
+            REQUIRE(mxlFabricsInitiatorSessionGetFlowPacingStats(_initiator, _flows.at(flow).initiatorId, &stats) == MXL_STATUS_OK);
+            return stats;
+        }
+
+    private:
+        static std::uint8_t pattern(std::uint64_t index, std::uint32_t offset) noexcept
+        {
+            return static_cast<std::uint8_t>((index * 31U) + offset);
+        }
+
+        [[nodiscard]]
+        mxlSessionConfig sessionConfig(char const* service, std::vector<mxlEndpointAddress> const& extraRails) const
+        {
+            return mxlSessionConfig{
+                .endpointAddress = {.node = "127.0.0.1", .service = service},
+                .provider = MXL_SHARING_PROVIDER_TCP,
+                .deviceSupport = false,
+                .completionQueue = _options.completionQueue,
+                .endpointType = MXL_FABRICS_ENDPOINT_TYPE_CONNECTED,
+                .extraRails = extraRails.data(),
+                .extraRailCount = static_cast<std::uint32_t>(extraRails.size()),
+                .creditWindow = 0,
+                .supervision = {},
+            };
+        }
+
+    private:
+        /** A flow of the source domain and its mirror in the target domain. */
+        struct MirroredFlow
+        {
+            char const* id{nullptr};
+            mxlFlowWriter sourceWriter{nullptr};
+            mxlFlowReader sourceReader{nullptr};
+            mxlFlowWriter targetWriter{nullptr};
+            std::uint16_t targetId{0};           /**< The id of the flow in the target session. */
+            std::uint16_t initiatorId{0};        /**< The id of the flow in the initiator session. */
+            std::vector<std::uint64_t> received; /**< The grains the target session reported, in order. */
+        };
+
+        std::filesystem::path _sourceDomain;
+        std::filesystem::path _targetDomain;
+        char const* _targetService;
+        LoopbackOptions _options;
+        std::vector<mxlEndpointAddress> _targetRails;
+        std::vector<mxlEndpointAddress> _initiatorRails;
+
+        mxlInstance _source{nullptr};
+        mxlInstance _target{nullptr};
+        std::vector<MirroredFlow> _flows;
+
+        mxlFabricsInstance _initiatorFabrics{nullptr};
+        mxlFabricsInstance _targetFabrics{nullptr};
+        mxlFabricsInitiatorSession _initiator{nullptr};
+        mxlFabricsTargetSession _targetSession{nullptr};
+        mxlTargetInfo _targetInfo{nullptr};
+    };
+
+    std::uint64_t currentIndex()
+    {
+        auto const rate = mxlRational{30000, 1001};
+        return mxlGetCurrentIndex(&rate);
+    }
+}
+
+TEST_CASE("ofi: Session transfers grains over tcp loopback", "[ofi][Session]")
+{
+    auto loopback = Loopback{"9190", "9191"};
+    auto const first = currentIndex();
+
+    for (auto index = first; index < first + 3U; ++index)
+    {
+        loopback.writeGrain(index);
+        REQUIRE(loopback.transferGrain(index) == MXL_STATUS_OK);
+    }
+    for (auto index = first; index < first + 3U; ++index)
+    {
+        loopback.requireReceived(index);
+    }
+
+    REQUIRE(loopback.waitFor([&]() { return loopback.initiatorStats().inFlight == 0; }));
+    REQUIRE(loopback.initiatorStats().grains == 3);
+    REQUIRE(loopback.initiatorStats().errors == 0);
+    REQUIRE(loopback.targetStats().grains == 3);
+}
+
+TEST_CASE("ofi: Session flows have their own ids in each session", "[ofi][Session]")
+{
+    auto loopback = Loopback{"9204", "9205", {.flows = 2}};
+    auto const first = currentIndex();
+
+    // The initiator added the flows in the reverse order, it writes them to the target flows with other ids.
+    REQUIRE(loopback.initiatorFlowId(0) == loopback.targetFlowId(1));
+    REQUIRE(loopback.initiatorFlowId(1) == loopback.targetFlowId(0));
+
+    loopback.writeGrain(first, 0);
+    loopback.writeGrain(first + 1U, 1);
+    REQUIRE(loopback.transferGrain(first, 0) == MXL_STATUS_OK);
+    REQUIRE(loopback.transferGrain(first + 1U, 1) == MXL_STATUS_OK);
+    loopback.requireReceived(first, 0);
+    loopback.requireReceived(first + 1U, 1);
+    REQUIRE(loopback.received(0).size() == 1);
+    REQUIRE(loopback.received(1).size() == 1);
+}
+
+TEST_CASE("ofi: Session stripes grains across rails", "[ofi][Session][Stripe]")
+{
+    auto loopback = Loopback{"9198", "9199", {.targetRails = {"9200", "9201"}, .initiatorRails = {"9202", "9203"}}};
+    auto const first = currentIndex();
+
+    // Every grain is written as one stripe per rail, the target session reports it once the three stripes arrived.
+    for (auto index = first; index < first + 5U; ++index)
+    {
+        loopback.writeGrain(index);
+        REQUIRE(loopback.transferGrain(index) == MXL_STATUS_OK);
+    }
+    for (auto index = first; index < first + 5U; ++index)
+    {
+        loopback.requireReceived(index);
+    }
+
+    REQUIRE(loopback.waitFor([&]() { return loopback.initiatorStats().inFlight == 0; }));
+    REQUIRE(loopback.received().size() == 5);
+    REQUIRE(loopback.initiatorStats().writes == 15);
+    REQUIRE(loopback.initiatorStats().grains == 5);
+    REQUIRE(loopback.targetStats().writes == 15);
+    REQUIRE(loopback.targetStats().grains == 5);
+}
+
+TEST_CASE("ofi: Session flow control waits for released grains", "[ofi][Session]")
+{
+    auto loopback = Loopback{"9192", "9193", {.creditWindow = 2}};
+    auto const first = currentIndex();
+
+    // The window covers two grains from the first one written, until the consumers release some.
+    for (auto index = first; index < first + 3U; ++index)
+    {
+        loopback.writeGrain(index);
+    }
+    REQUIRE(loopback.transferGrain(first) == MXL_STATUS_OK);
+    REQUIRE(loopback.transferGrain(first + 1U) == MXL_STATUS_OK);
+    loopback.requireReceived(first);
+    loopback.requireReceived(first + 1U);
+
+    REQUIRE(loopback.transferGrain(first + 2U) == MXL_ERR_NOT_READY);
+    for (auto attempt = 0; attempt < 20; ++attempt)
+    {
+        loopback.pump();
+        REQUIRE(loopback.transferGrain(first + 2U) == MXL_ERR_NOT_READY);
+    }
+
+    // Once the first grain is released, the initiator reads the new credits and the window moves on.
+    loopback.releaseGrains(first);
+    REQUIRE(loopback.waitFor([&]() { return loopback.transferGrain(first + 2U) == MXL_STATUS_OK; }));
+    loopback.requireReceived(first + 2U);
+}
+
+TEST_CASE("ofi: Session reports a restarted target session stale until it is added again", "[ofi][Session]")
+{
+    auto loopback = Loopback{"9194", "9195"};
+    auto const first = currentIndex();
+
+    loopback.writeGrain(first);
+    REQUIRE(loopback.transferGrain(first) == MXL_STATUS_OK);
+    loopback.requireReceived(first);
+
+    // The supervised link fails when the target session goes away, and is retried until a session listens again.
+    loopback.stopTarget();
+    REQUIRE(loopback.waitFor([&]() { return loopback.linkStatus().state == MXL_FABRICS_LINK_STATE_RECOVERING; }));
+    REQUIRE(loopback.linkStatus().outages == 1);
+
+    // A new target session has new remote keys, the link is reported stale rather than written to.
+    loopback.startTarget();
+    REQUIRE(loopback.waitFor([&]() { return loopback.linkStatus().state == MXL_FABRICS_LINK_STATE_STALE; }));
+    loopback.writeGrain(first + 1U);
+    REQUIRE(loopback.transferGrain(first + 1U) == MXL_ERR_NOT_READY);
+
+    // Supervision can't recover the new remote keys by itself. Added again by the application with its new target info, the target
+    // session gets the grains that follow, and the flow keeps its id in the initiator session.
+    auto const flowId = loopback.initiatorFlowId(0);
+    loopback.disconnect();
+    loopback.connect();
+    REQUIRE(loopback.initiatorFlowId(0) == flowId);
+    REQUIRE(loopback.transferGrain(first + 1U) == MXL_STATUS_OK);
+    loopback.requireReceived(first + 1U);
+}
+
+TEST_CASE("ofi: Session reads completions in batches", "[ofi][Session][CompletionQueue]")
+{
+    // Fewer completions are read at once than there are grains in flight, from queues without a wait object that are polled.
+    auto const completionQueue = mxlCompletionQueueConfig{
+        .depth = 0, .batchSize = 4, .waitObject = MXL_FABRICS_WAIT_OBJECT_NONE, .pinInterrupts = false, .signalingVector = 0};
+    auto loopback = Loopback{"9196", "9197", {.completionQueue = completionQueue}};
+    auto const first = currentIndex();
+
+    for (auto index = first; index < first + 10U; ++index)
+    {
+        loopback.writeGrain(index);
+        REQUIRE(loopback.transferGrain(index) == MXL_STATUS_OK);
+    }
+    for (auto index = first; index < first + 10U; ++index)
+    {
+        loopback.requireReceived(index);
+    }
+
+    // The grains of a batch are reported in the order they completed.
+    REQUIRE(std::ranges::is_sorted(loopback.received()));
+    REQUIRE(loopback.received().size() == 10);
+    REQUIRE(loopback.waitFor([&]() { return loopback.initiatorStats().inFlight == 0; }));
+    REQUIRE(loopback.initiatorStats().errors == 0);
+}
+
+TEST_CASE("ofi: Session paces the bursts of a grain over the grain period", "[ofi][Session][Pacing]")
+{
+    auto loopback = Loopback{"9212", "9213"};
+    auto const first = currentIndex();
+
+    // The 4096 slices of a grain go out in 4 bursts, spread over 90% of the 33.4 ms grain period: one every 7.5 ms.
+    auto const status = loopback.setFlowPacing({.grainRate = {30000, 1001}, .activePercent = 90, .slicesPerBurst = 1024});
+    if (status == MXL_ERR_INVALID_STATE)
+    {
+        // Without FI_ORDER_WAW the flow can't be paced, and its grains are still written at once.
+        loopback.writeGrain(first);
+        REQUIRE(loopback.transferGrain(first) == MXL_STATUS_OK);
+        loopback.requireReceived(first);
+        REQUIRE(loopback.waitFor([&]() { return loopback.initiatorStats().inFlight == 0; }));
+        REQUIRE(loopback.initiatorStats().writes == 1);
+        REQUIRE(loopback.pacingStats().bursts == 0);
+        return;
+    }
+    REQUIRE(status == MXL_STATUS_OK);
+
+    for (auto index = first; index < first + 2U; ++index)
+    {
+        loopback.writeGrain(index);
+        auto const start = mxlGetTime();
+        REQUIRE(loopback.transferGrain(index) == MXL_STATUS_OK);
+
+        // The target session reports the grain once its last burst landed, which wasn't posted before its due time.
+        loopback.requireReceived(index);
+        REQUIRE(mxlGetTime() - start >= 20'000'000U);
+    }
+
+    REQUIRE(loopback.waitFor([&]() { return loopback.initiatorStats().inFlight == 0; }));
+    auto const pacing = loopback.pacingStats();
+    REQUIRE(pacing.grains == 2);
+    REQUIRE(pacing.bursts == 8);
+
+    // Only the last burst of a grain carries the completion data, the grain is counted once.
+    REQUIRE(loopback.initiatorStats().writes == 8);
+    REQUIRE(loopback.initiatorStats().grains == 2);
+    REQUIRE(loopback.initiatorStats().errors == 0);
+    REQUIRE(loopback.targetStats().grains == 2);
+}
+
+TEST_CASE("ofi: Session multiplexes flows over one connection", "[ofi][Session]")
+{
+    auto loopback = Loopback{"9210", "9211", {.flows = 3}};
+    auto const first = currentIndex();
+
+    // The grains of the flows are interleaved, and the grains of a flow share their slots with the grains of the others.
+    for (auto index = first; index < first + 4U; ++index)
+    {
+        for (auto flow = std::size_t{0}; flow < 3; ++flow)
+        {
+            loopback.writeGrain(index, flow);
+            REQUIRE(loopback.transferGrain(index, flow) == MXL_STATUS_OK);
+        }
+    }
+
+    // Every grain is reported in the flow it was written to, with the payload of its source flow.
+    for (auto flow = std::size_t{0}; flow < 3; ++flow)
+    {
+        INFO("flow: " << flow);
+        for (auto index = first; index < first + 4U; ++index)
+        {
+            loopback.requireReceived(index, flow);
+        }
+        REQUIRE(loopback.received(flow).size() == 4);
+    }
+
+    REQUIRE(loopback.waitFor([&]() { return loopback.initiatorStats().inFlight == 0; }));
+    REQUIRE(loopback.initiatorStats().grains == 12);
+    REQUIRE(loopback.targetStats().grains == 12);
+}
+
+TEST_CASE("ofi: Single-flow targets and initiators transfer grains over tcp loopback", "[ofi][Session]")
+{
+    // The loopback provides the flows, its own sessions stay idle.
+    auto loopback = Loopback{"9206", "9207"};
+    auto const first = currentIndex();
+
+    auto target = mxlFabricsTarget{nullptr};
+    auto index = std::uint64_t{0};
+    REQUIRE(mxlFabricsCreateTarget(loopback.targetFabrics(), &target) == MXL_STATUS_OK);
+    REQUIRE(mxlFabricsTargetTryNewGrain(target, &index) == MXL_ERR_INVALID_STATE);
+
+    auto regions = mxlRegions{};
+    auto info = mxlTargetInfo{nullptr};
+    REQUIRE(mxlFabricsRegionsForFlowWriter(loopback.targetWriter(0), &regions) == MXL_STATUS_OK);
+    auto targetConfig = mxlTargetConfig{
+        .endpointAddress = {.node = "127.0.0.1", .service = "9208"},
+        .provider = MXL_SHARING_PROVIDER_TCP,
+        .regions = regions,
+        .deviceSupport = false,
+    };
+    auto status = mxlFabricsTargetSetup(target, &targetConfig, &info);
+    mxlFabricsRegionsFree(regions);
+    REQUIRE(status == MXL_STATUS_OK);
+
+    auto initiator = mxlFabricsInitiator{nullptr};
+    REQUIRE(mxlFabricsCreateInitiator(loopback.initiatorFabrics(), &initiator) == MXL_STATUS_OK);
+    REQUIRE(mxlFabricsRegionsForFlowReader(loopback.sourceReader(0), &regions) == MXL_STATUS_OK);
+    auto const initiatorConfig = mxlInitiatorConfig{
+        .endpointAddress = {.node = "127.0.0.1", .service = "9209"},
+        .provider = MXL_SHARING_PROVIDER_TCP,
+        .regions = regions,
+        .deviceSupport = false,
+    };
+    status = mxlFabricsInitiatorSetup(initiator, &initiatorConfig);
+    mxlFabricsRegionsFree(regions);
+    REQUIRE(status == MXL_STATUS_OK);
+
+    // Grains can only be written once a target was added, and once it accepted the connection.
+    loopback.writeGrain(first);
+    REQUIRE(mxlFabricsInitiatorTransferGrain(initiator, first) == MXL_ERR_NOT_READY);
+    REQUIRE(mxlFabricsInitiatorAddTarget(initiator, info) == MXL_STATUS_OK);
+
+    auto const waitFor = [&](auto const& condition) {
+        auto const deadline = std::chrono::steady_clock::now() + ProgressTimeout;
+        while (!condition() && (std::chrono::steady_clock::now() < deadline))
+        {
+            static_cast<void>(mxlFabricsInitiatorMakeProgressBlocking(initiator, 1));
+        }
+        return condition();
+    };
+    REQUIRE(waitFor([&]() { return mxlFabricsInitiatorTransferGrain(initiator, first) == MXL_STATUS_OK; }));
+    REQUIRE(waitFor([&]() { return mxlFabricsTargetTryNewGrain(target, &index) == MXL_STATUS_OK; }));
+    REQUIRE(index == first);
+    loopback.requirePayload(first);
+
+    REQUIRE(waitFor([&]() { return mxlFabricsInitiatorMakeProgressNonBlocking(initiator) == MXL_STATUS_OK; }));
+    REQUIRE(mxlFabricsInitiatorRemoveTarget(initiator, info) == MXL_STATUS_OK);
+    REQUIRE(mxlFabricsDestroyInitiator(loopback.initiatorFabrics(), initiator) == MXL_STATUS_OK);
+    REQUIRE(mxlFabricsDestroyTarget(loopback.targetFabrics(), target) == MXL_STATUS_OK);
+    mxlFabricsFreeTargetInfo(info);
+}
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstddef>
+#include <cstdint>
+#include <catch2/catch_test_macros.hpp>
+#include <mxl-internal/Flow.hpp>
+#include "mxl/fabrics.h"
+#include "mxl/flow.h"
+#include "ImmediateData.hpp"
+#include "Stripe.hpp"
+
+using namespace mxl::lib::fabrics::ofi;
+using mxl::lib::GrainHeader;
+using mxl::lib::MXL_GRAIN_PAYLOAD_OFFSET;
+
+namespace
+{
+    mxlGrainInfo makeHeader(std::uint32_t totalSlices, std::uint32_t sliceSize)
+    {
+        auto header = mxlGrainInfo{};
+        header.totalSlices = totalSlices;
+        header.grainSize = totalSlices * sliceSize;
+        return header;
+    }
+
+    /** Check that the stripes of every rail are contiguous and not empty. */
+    void requireStripes(StripeBounds const& bounds, std::size_t rails)
+    {
+        for (auto rail = std::size_t{0}; rail < rails; ++rail)
+        {
+            INFO("rail: " << rail);
+            REQUIRE(bounds[rail] < bounds[rail + 1U]);
+        }
+    }
+}
+
+TEST_CASE("ofi: Stripe sliceable grains", "[ofi][Stripe]")
+{
+    auto const header = makeHeader(1080, 5120);
+    auto const length = MXL_GRAIN_PAYLOAD_OFFSET + header.grainSize;
+
+    REQUIRE(sliceable(header, length, 1));
+    REQUIRE(sliceable(header, length, MXL_FABRICS_SESSION_MAX_RAILS));
+
+    // The transfer must cover the whole payload.
+    REQUIRE_FALSE(sliceable(header, length - 1U, 2));
+    REQUIRE_FALSE(sliceable(header, sizeof(GrainHeader), 2));
+
+    // Every rail must get at least one slice.
+    REQUIRE_FALSE(sliceable(makeHeader(3, 5120), MXL_GRAIN_PAYLOAD_OFFSET + 3U * 5120U, 4));
+
+    // The payload must divide in slices of equal size.
+    auto uneven = header;
+    ++uneven.grainSize;
+    REQUIRE_FALSE(sliceable(uneven, length + 1U, 2));
+}
+
+TEST_CASE("ofi: Stripe bounds on slice boundaries", "[ofi][Stripe]")
+{
+    // 1081 slices don't divide evenly across 3 rails, the remainder goes to the last ones. The grain is padded after the payload.
+    auto const header = makeHeader(1081, 5120);
+    auto const length = MXL_GRAIN_PAYLOAD_OFFSET + header.grainSize + 4096U;
+
+    auto const bounds = stripeBounds(header, length, 3);
+    REQUIRE(bounds[0] == 0);
+    REQUIRE(bounds[1] == MXL_GRAIN_PAYLOAD_OFFSET + 360U * 5120U);
+    REQUIRE(bounds[2] == MXL_GRAIN_PAYLOAD_OFFSET + 720U * 5120U);
+    REQUIRE(bounds[3] == length);
+
+    // A single rail carries the whole grain.
+    auto const single = stripeBounds(header, length, 1);
+    REQUIRE(single[0] == 0);
+    REQUIRE(single[1] == length);
+
+    auto const most = stripeBounds(header, length, MXL_FABRICS_SESSION_MAX_RAILS);
+    requireStripes(most, MXL_FABRICS_SESSION_MAX_RAILS);
+    for (auto rail = std::size_t{1}; rail < MXL_FABRICS_SESSION_MAX_RAILS; ++rail)
+    {
+        REQUIRE((most[rail] - MXL_GRAIN_PAYLOAD_OFFSET) % 5120U == 0);
+    }
+}
+
+TEST_CASE("ofi: Stripe bounds of grains that aren't sliceable", "[ofi][Stripe]")
+{
+    // Repeated grains only transfer their header, which is split evenly on aligned boundaries.
+    auto const header = makeHeader(1080, 5120);
+    for (auto rails = std::size_t{1}; rails <= MXL_FABRICS_SESSION_MAX_RAILS; ++rails)
+    {
+        INFO("rails: " << rails);
+        auto const bounds = stripeBounds(header, sizeof(GrainHeader), rails);
+        REQUIRE(bounds[0] == 0);
+        REQUIRE(bounds[rails] == sizeof(GrainHeader));
+        requireStripes(bounds, rails);
+        for (auto rail = std::size_t{1}; rail < rails; ++rail)
+        {
+            REQUIRE(bounds[rail] % StripeAlignment == 0);
+        }
+    }
+
+    // A payload that doesn't divide in slices is split evenly too.
+    auto uneven = header;
+    ++uneven.grainSize;
+    auto const length = MXL_GRAIN_PAYLOAD_OFFSET + uneven.grainSize;
+    auto const bounds = stripeBounds(uneven, length, 3);
+    REQUIRE(bounds[0] == 0);
+    REQUIRE(bounds[3] == length);
+    requireStripes(bounds, 3);
+}
+
+TEST_CASE("ofi: Burst bounds cover the grain", "[ofi][Stripe]")
+{
+    // 1081 slices in 7 bursts on 3 rails: neither the bursts nor the rails divide the slices evenly.
+    auto const header = makeHeader(1081, 5120);
+    auto const length = MXL_GRAIN_PAYLOAD_OFFSET + header.grainSize + 4096U;
+    auto const rails = std::size_t{3};
+    auto const bursts = std::size_t{7};
+
+    auto end = std::size_t{0};
+    for (auto burst = std::size_t{0}; burst < bursts; ++burst)
+    {
+        INFO("burst: " << burst);
+        auto const first = burst * header.totalSlices / bursts;
+        auto const last = (burst + 1U) * header.totalSlices / bursts;
+        auto const bounds = burstBounds(header, length, first, last, rails);
+
+        // Every burst starts where the previous one ended, the first carries the header and the last the padding.
+        REQUIRE(bounds[0] == end);
+        requireStripes(bounds, rails);
+        for (auto rail = std::size_t{1}; rail < rails; ++rail)
+        {
+            REQUIRE((bounds[rail] - MXL_GRAIN_PAYLOAD_OFFSET) % 5120U == 0);
+        }
+        end = bounds[rails];
+    }
+    REQUIRE(end == length);
+
+    // A single burst is striped like the whole grain.
+    REQUIRE(burstBounds(header, length, 0, header.totalSlices, rails) == stripeBounds(header, length, rails));
+}
+
+TEST_CASE("ofi: StripeCounter completes grains once every rail delivered", "[ofi][Stripe]")
+{
+    // 10 slots tell 102 turns of the ring buffer apart.
+    auto counter = StripeCounter{10, 3};
+    auto const position = ImmediateData::positionOf(1'000'003U, 10);
+
+    REQUIRE_FALSE(counter.count(position));
+    REQUIRE_FALSE(counter.count(position));
+    REQUIRE(counter.count(position));
+
+    // A single rail completes every grain with its only stripe.
+    auto single = StripeCounter{10, 1};
+    REQUIRE(single.count(position));
+    REQUIRE(single.count(position));
+}
+
+TEST_CASE("ofi: StripeCounter drops the stripes of incomplete grains", "[ofi][Stripe]")
+{
+    auto counter = StripeCounter{10, 2};
+    auto const first = ImmediateData::positionOf(1'000'003U, 10);
+    auto const next = ImmediateData::positionOf(1'000'013U, 10);
+    REQUIRE((first % 10U) == (next % 10U));
+
+    // The rail that carried the second stripe of the first grain was dropped. The stripes of the next grain in the slot don't complete
+    // it early.
+    REQUIRE_FALSE(counter.count(first));
+    REQUIRE_FALSE(counter.count(next));
+    REQUIRE(counter.count(next));
+
+    // A stripe of the first grain that arrives late neither completes it nor counts for the grains that follow.
+    auto const after = ImmediateData::positionOf(1'000'023U, 10);
+    REQUIRE_FALSE(counter.count(after));
+    REQUIRE_FALSE(counter.count(first));
+    REQUIRE(counter.count(after));
+}
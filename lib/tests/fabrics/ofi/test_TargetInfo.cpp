@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Address.hpp"
+#include "Exception.hpp"
+#include "TargetInfo.hpp"
+
+using namespace mxl::lib::fabrics::ofi;
+
+namespace
+{
+    /** A target info of two rails and two flows, with values that don't fit in a double. */
+    TargetInfo makeTargetInfo()
+    {
+        auto addresses = std::vector<FabricAddress>{FabricAddress::fromBase64("AQIDBAU="), FabricAddress::fromBase64("BgcICQ==")};
+
+        auto video = TargetInfo::Flow{
+            .id = 0,
+            .regions = {{RemoteRegion{.addr = 0xFFFF'FFFF'FFFF'F000ULL, .len = 4096, .rkey = 0x8000'0000'0000'0001ULL},
+                            RemoteRegion{.addr = 0xFFFF'FFFF'FFFF'E000ULL, .len = 4096, .rkey = 0x8000'0000'0000'0001ULL}},
+                {RemoteRegion{.addr = 0x1000, .len = 4096, .rkey = 7}, RemoteRegion{.addr = 0x2000, .len = 4096, .rkey = 7}}},
+            .header = std::nullopt,
+        };
+        auto audio = TargetInfo::Flow{
+            .id = 42,
+            .regions = {{RemoteRegion{.addr = 0x3000, .len = 256, .rkey = 9}}, {RemoteRegion{.addr = 0x4000, .len = 256, .rkey = 10}}},
+            .header = RemoteRegion{.addr = 0x5000, .len = 2048, .rkey = 11},
+        };
+
+        return {std::move(addresses),
+            {video, audio},
+            RemoteRegion{.addr = 0x6000, .len = 3 * sizeof(std::uint64_t), .rkey = 12},
+            0xDEAD'BEEF'CAFE'F00DULL};
+    }
+}
+
+TEST_CASE("ofi: TargetInfo string round trip", "[ofi][TargetInfo]")
+{
+    auto const info = makeTargetInfo();
+    auto const parsed = TargetInfo::fromString(info.toString());
+
+    REQUIRE(parsed.addresses() == info.addresses());
+    REQUIRE(parsed.addresses()[0].toBase64() == "AQIDBAU=");
+    REQUIRE(parsed.addresses()[1].toBase64() == "BgcICQ==");
+
+    REQUIRE(parsed.flows().size() == 2);
+    for (auto const& flow : info.flows())
+    {
+        auto const& parsedFlow = parsed.flow(flow.id);
+        REQUIRE(parsedFlow.regions == flow.regions);
+        REQUIRE(parsedFlow.header == flow.header);
+    }
+
+    REQUIRE(parsed.credits() == info.credits());
+    REQUIRE(parsed.instance() == info.instance());
+
+    // The serialization is stable, so infos can be compared as strings.
+    REQUIRE(parsed.toString() == info.toString());
+}
+
+TEST_CASE("ofi: TargetInfo optional fields", "[ofi][TargetInfo]")
+{
+    auto const info = TargetInfo{{FabricAddress::fromBase64("AQIDBAU=")}, {}, std::nullopt, 0};
+    auto const parsed = TargetInfo::fromString(info.toString());
+
+    REQUIRE(parsed.addresses().size() == 1);
+    REQUIRE(parsed.flows().empty());
+    REQUIRE_FALSE(parsed.credits().has_value());
+    REQUIRE(parsed.instance() == 0);
+    REQUIRE_THROWS_AS(parsed.flow(0), Exception);
+}
+
+TEST_CASE("ofi: TargetInfo rejects malformed strings", "[ofi][TargetInfo]")
+{
+    REQUIRE_THROWS_AS(TargetInfo::fromString(""), Exception);
+    REQUIRE_THROWS_AS(TargetInfo::fromString("[]"), Exception);
+    REQUIRE_THROWS_AS(TargetInfo::fromString(R"({"flows":[]})"), Exception);
+
+    // Every target info has at least one address.
+    REQUIRE_THROWS_AS(TargetInfo::fromString(R"({"addresses":[],"flows":[]})"), Exception);
+
+    // Every flow has regions on every rail.
+    REQUIRE_THROWS_AS(TargetInfo::fromString(R"({"addresses":["AQIDBAU=","BgcICQ=="],"flows":[{"id":0,"regions":[[]]}]})"), Exception);
+
+    // 64 bit values are carried as decimal strings.
+    REQUIRE_THROWS_AS(
+        TargetInfo::fromString(R"({"addresses":["AQIDBAU="],"flows":[{"id":0,"regions":[[{"addr":1,"len":"1","rkey":"1"}]]}]})"), Exception);
+    REQUIRE_THROWS_AS(
+        TargetInfo::fromString(R"({"addresses":["AQIDBAU="],"flows":[{"id":0,"regions":[[{"addr":"x","len":"1","rkey":"1"}]]}]})"),
+        Exception);
+}
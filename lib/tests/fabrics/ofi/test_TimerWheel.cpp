@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "Exception.hpp"
+#include "TimerWheel.hpp"
+
+using namespace mxl::lib::fabrics::ofi;
+
+TEST_CASE("ofi: TimerWheel rejects an empty geometry", "[ofi][TimerWheel]")
+{
+    REQUIRE_THROWS_AS(TimerWheel(0, 8, 0), Exception);
+    REQUIRE_THROWS_AS(TimerWheel(100, 0, 0), Exception);
+}
+
+TEST_CASE("ofi: TimerWheel expires timers on their tick", "[ofi][TimerWheel]")
+{
+    // Ticks of 100 ns on a wheel of 8 slots, starting at tick 10.
+    auto wheel = TimerWheel{100, 8, 1'000};
+    auto expired = std::vector<std::uint64_t>{};
+    REQUIRE(wheel.empty());
+
+    wheel.schedule(1'250, 1);
+    wheel.schedule(1'300, 2);
+    REQUIRE_FALSE(wheel.empty());
+
+    // Nothing is due before tick 12.
+    wheel.advance(1'199, expired);
+    REQUIRE(expired.empty());
+
+    wheel.advance(1'200, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1});
+
+    // Moving back in time doesn't expire anything, nor rewinds the wheel.
+    wheel.advance(1'000, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1});
+
+    wheel.advance(1'399, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1, 2});
+    REQUIRE(wheel.empty());
+}
+
+TEST_CASE("ofi: TimerWheel expires overdue timers on the next tick", "[ofi][TimerWheel]")
+{
+    auto wheel = TimerWheel{100, 8, 1'000};
+    auto expired = std::vector<std::uint64_t>{};
+
+    // Timers due at or before the current tick were missed, and expire on the next one.
+    wheel.schedule(0, 1);
+    wheel.schedule(1'050, 2);
+
+    wheel.advance(1'099, expired);
+    REQUIRE(expired.empty());
+
+    wheel.advance(1'100, expired);
+    REQUIRE(expired.size() == 2);
+    REQUIRE(wheel.empty());
+}
+
+TEST_CASE("ofi: TimerWheel expires timers in the order of their ticks", "[ofi][TimerWheel]")
+{
+    auto wheel = TimerWheel{100, 8, 0};
+    auto expired = std::vector<std::uint64_t>{};
+
+    wheel.schedule(500, 5);
+    wheel.schedule(100, 1);
+    wheel.schedule(300, 3);
+    wheel.schedule(200, 2);
+    wheel.schedule(400, 4);
+
+    // A single call over several ticks visits the slots in order.
+    wheel.advance(550, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1, 2, 3, 4, 5});
+}
+
+TEST_CASE("ofi: TimerWheel keeps timers due after more than one turn", "[ofi][TimerWheel]")
+{
+    auto wheel = TimerWheel{100, 4, 0};
+    auto expired = std::vector<std::uint64_t>{};
+
+    // Ticks 2 and 10 share a slot of the 4 slot wheel, the second timer stays for two more turns.
+    wheel.schedule(200, 1);
+    wheel.schedule(1'000, 2);
+
+    wheel.advance(200, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1});
+
+    wheel.advance(600, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1});
+    REQUIRE_FALSE(wheel.empty());
+
+    // A call that jumps over several turns still expires the timer, once.
+    wheel.advance(5'000, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1, 2});
+    REQUIRE(wheel.empty());
+
+    wheel.advance(10'000, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1, 2});
+}
+
+TEST_CASE("ofi: TimerWheel expires the timers of a tick in the order they were scheduled", "[ofi][TimerWheel]")
+{
+    auto wheel = TimerWheel{100, 4, 0};
+    auto expired = std::vector<std::uint64_t>{};
+
+    // Tick 10 shares the slot of tick 2, and its timer is scheduled between those of tick 2.
+    wheel.schedule(250, 1);
+    wheel.schedule(1'050, 2);
+    wheel.schedule(210, 3);
+    wheel.schedule(290, 4);
+
+    wheel.advance(299, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1, 3, 4});
+
+    wheel.advance(1'000, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1, 3, 4, 2});
+    REQUIRE(wheel.empty());
+}
+
+TEST_CASE("ofi: TimerWheel expires overdue timers in the order of their ticks after a long gap", "[ofi][TimerWheel]")
+{
+    auto wheel = TimerWheel{100, 4, 0};
+    auto expired = std::vector<std::uint64_t>{};
+
+    // Ticks 1, 2, 3 and 10 fall in slots 1, 2, 3 and 2. A call that jumps over several turns visits each slot once, in slot order.
+    wheel.schedule(300, 3);
+    wheel.schedule(100, 1);
+    wheel.schedule(1'000, 10);
+    wheel.schedule(200, 2);
+    wheel.schedule(150, 11);
+
+    wheel.advance(5'000, expired);
+    REQUIRE(expired == std::vector<std::uint64_t>{1, 11, 2, 3, 10});
+    REQUIRE(wheel.empty());
+}
@@ -16,9 +16,13 @@
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <array>
+#include <atomic>
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <thread>
+#include <vector>
 #include <uuid.h>
 #include <catch2/catch_test_macros.hpp>
 #include <picojson/picojson.h>
@@ -316,6 +320,713 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Invalid
     mxlDestroyInstance(instanceWriter);
 }
 
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : History archive", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    // Configure an archive directory for the domain. The ring buffers keep the default history duration (100ms).
+    auto const archiveDir = domain.parent_path() / "mxl_archive";
+    fs::create_directories(archiveDir);
+    {
+        picojson::object domainOpts;
+        domainOpts["urn:x-mxl:option:archive_directory/v1.0"] = picojson::value{archiveDir.string()};
+        auto out = std::ofstream{domain / "options.json"};
+        out << picojson::value(domainOpts).serialize();
+    }
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    // The archive must be deeper than the ring buffer.
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), R"({"archiveDuration": 50000000})", &configInfo) == MXL_ERR_INVALID_ARG);
+
+    // Keep one second worth of grains in the archive.
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), R"({"archiveDuration": 1000000000})", &configInfo) == MXL_STATUS_OK);
+    REQUIRE(configInfo.discrete.archiveGrainCount == 59U);
+    REQUIRE(configInfo.discrete.archiveGrainCount > configInfo.discrete.grainCount);
+    REQUIRE(fs::exists(archiveDir / (std::string{flowId} + ".mxl-archive")));
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const firstIndex = mxlTimestampToIndex(&rate, mxlGetTime());
+    REQUIRE(firstIndex != MXL_UNDEFINED_INDEX);
+
+    // Write 4 times as many grains as the ring buffer can hold.
+    auto const grainsToWrite = std::uint64_t{4U * configInfo.discrete.grainCount};
+    for (auto index = firstIndex; index < firstIndex + grainsToWrite; ++index)
+    {
+        mxlGrainInfo gInfo;
+        uint8_t* buffer = nullptr;
+        REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+        buffer[0] = static_cast<uint8_t>(index);
+        buffer[gInfo.grainSize - 1] = static_cast<uint8_t>(~index);
+        gInfo.validSlices = gInfo.totalSlices;
+        REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+        // Give the archiver some time to keep up.
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    // The first grain has left the ring buffer a long time ago, but should be served from the archive.
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    auto status = MXL_ERR_OUT_OF_RANGE_TOO_LATE;
+    for (auto attempt = 0; (attempt < 100) && (status != MXL_STATUS_OK); ++attempt)
+    {
+        status = mxlFlowReaderGetGrain(reader, firstIndex, 0, &gInfo, &buffer);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(status == MXL_STATUS_OK);
+    REQUIRE(gInfo.index == firstIndex);
+    REQUIRE(gInfo.validSlices == gInfo.totalSlices);
+    REQUIRE(buffer[0] == static_cast<uint8_t>(firstIndex));
+    REQUIRE(buffer[gInfo.grainSize - 1] == static_cast<uint8_t>(~firstIndex));
+
+    // Grains that were never written are neither in the ring buffer nor in the archive.
+    REQUIRE(mxlFlowReaderGetGrain(reader, firstIndex - 1U, 0, &gInfo, &buffer) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+
+    // Destroying the flow also removes its archive.
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+    REQUIRE(!fs::exists(archiveDir / (std::string{flowId} + ".mxl-archive")));
+
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+    fs::remove_all(archiveDir);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Flow options : Unsupported options", "[mxl flows]")
+{
+    auto const videoFlowDef = mxl::tests::readFile("data/v210_flow.json");
+    auto const audioFlowDef = mxl::tests::readFile("data/audio_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    // Options that are malformed or not supported for the flow are invalid arguments, not internal failures.
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, videoFlowDef.c_str(), R"({"checksum": true})", &configInfo) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlCreateFlow(instance, videoFlowDef.c_str(), R"({"archiveDuration": "1s"})", &configInfo) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlCreateFlow(instance, audioFlowDef.c_str(), R"({"checksum": "crc32c"})", &configInfo) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlCreateFlow(instance, audioFlowDef.c_str(), R"({"archiveDuration": 1000000000})", &configInfo) == MXL_ERR_INVALID_ARG);
+
+    // The domain has no archive directory.
+    REQUIRE(mxlCreateFlow(instance, videoFlowDef.c_str(), R"({"archiveDuration": 1000000000})", &configInfo) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlCreateFlow(instance, videoFlowDef.c_str(), "{", &configInfo) == MXL_ERR_INVALID_ARG);
+
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Grain checksum", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), R"({"checksum": "md5"})", &configInfo) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), R"({"checksum": "crc32c"})", &configInfo) == MXL_STATUS_OK);
+    REQUIRE((configInfo.common.flags & MXL_FLOW_FLAG_GRAIN_CHECKSUM) != 0);
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+
+    // A partial grain does not carry a checksum yet.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    std::memset(buffer, 0x5A, gInfo.grainSize);
+    gInfo.validSlices = gInfo.totalSlices / 2;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+    uint8_t* readBuffer = nullptr;
+    REQUIRE(mxlFlowReaderGetGrainSlice(reader, index, gInfo.validSlices, 16, &gInfo, &readBuffer) == MXL_STATUS_OK);
+    REQUIRE((gInfo.flags & MXL_GRAIN_FLAG_CHECKSUM) == 0);
+    REQUIRE(mxlFlowReaderVerifyGrain(reader, &gInfo, readBuffer) == MXL_ERR_INVALID_ARG);
+
+    // Once complete, the writer computes the checksum and the grain verifies.
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderGetGrain(reader, index, 16, &gInfo, &readBuffer) == MXL_STATUS_OK);
+    REQUIRE((gInfo.flags & MXL_GRAIN_FLAG_CHECKSUM) != 0);
+    REQUIRE(mxlFlowReaderVerifyGrain(reader, &gInfo, readBuffer) == MXL_STATUS_OK);
+
+    // Corrupt the grain in place, without the writer moving on to another grain.
+    mxlGrainInfo writerInfo;
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &writerInfo, &buffer) == MXL_STATUS_OK);
+    buffer[writerInfo.grainSize / 2] ^= 0x01;
+    REQUIRE(mxlFlowWriterCancelGrain(writer) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderVerifyGrain(reader, &gInfo, readBuffer) == MXL_ERR_CHECKSUM_MISMATCH);
+
+    // A grain that is being overwritten by a lapping writer is reported as such.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index + configInfo.discrete.grainCount, &writerInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderVerifyGrain(reader, &gInfo, readBuffer) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+    REQUIRE(mxlFlowWriterCancelGrain(writer) == MXL_STATUS_OK);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Repeated grains", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), "", &configInfo) == MXL_STATUS_OK);
+    auto const grainCount = std::uint64_t{configInfo.discrete.grainCount};
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+
+    // Write a regular grain.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    std::memset(buffer, 0x11, gInfo.grainSize);
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+    // Repeat it twice without touching the payload. The second repeat references the first one.
+    for (auto const sourceIndex : {index, index + 1U})
+    {
+        REQUIRE(mxlFlowWriterOpenGrain(writer, sourceIndex + 1U, &gInfo, &buffer) == MXL_STATUS_OK);
+        gInfo.flags |= MXL_GRAIN_FLAG_REPEAT;
+        gInfo.sourceIndex = sourceIndex;
+        REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    }
+
+    // A grain cannot repeat itself or a grain from the future.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index + 3U, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.flags |= MXL_GRAIN_FLAG_REPEAT;
+    gInfo.sourceIndex = index + 3U;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowWriterCancelGrain(writer) == MXL_STATUS_OK);
+
+    // Readers are redirected to the payload of the source grain, and the chain of repeats is resolved.
+    uint8_t* sourceBuffer = nullptr;
+    REQUIRE(mxlFlowReaderGetGrain(reader, index, 16, &gInfo, &sourceBuffer) == MXL_STATUS_OK);
+    for (auto const repeatIndex : {index + 1U, index + 2U})
+    {
+        REQUIRE(mxlFlowReaderGetGrain(reader, repeatIndex, 16, &gInfo, &buffer) == MXL_STATUS_OK);
+        REQUIRE(gInfo.index == repeatIndex);
+        REQUIRE((gInfo.flags & MXL_GRAIN_FLAG_REPEAT) != 0);
+        REQUIRE(gInfo.sourceIndex == index);
+        REQUIRE(gInfo.validSlices == gInfo.totalSlices);
+        REQUIRE(buffer == sourceBuffer);
+        REQUIRE(buffer[0] == 0x11);
+    }
+
+    // A grain that is only partially written cannot be repeated, since repeated grains are published as complete.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index + 3U, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.validSlices = 1;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index + 4U, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.flags |= MXL_GRAIN_FLAG_REPEAT;
+    gInfo.sourceIndex = index + 3U;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+    REQUIRE(mxlFlowWriterCancelGrain(writer) == MXL_STATUS_OK);
+
+    // Once the source grain has been overwritten, the repeated grains cannot be served anymore.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index + grainCount, &gInfo, &buffer) == MXL_STATUS_OK);
+    std::memset(buffer, 0x22, gInfo.grainSize);
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderGetGrain(reader, index + 1U, 16, &gInfo, &buffer) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+
+    // ... and cannot be repeated anymore either.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index + grainCount + 1U, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.flags |= MXL_GRAIN_FLAG_REPEAT;
+    gInfo.sourceIndex = index;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+    REQUIRE(mxlFlowWriterCancelGrain(writer) == MXL_STATUS_OK);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Commit invalid range", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), "", &configInfo) == MXL_STATUS_OK);
+    auto const grainCount = std::uint64_t{configInfo.discrete.grainCount};
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+    REQUIRE(mxlFlowWriterCommitInvalidRange(writer, index + 3U, index + 1U) == MXL_ERR_INVALID_ARG);
+
+    // The writer stalled for 3 grains. The grain it had already opened is part of the gap.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index + 1U, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterCommitInvalidRange(writer, index + 1U, index + 3U) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_ERR_INVALID_ARG);
+
+    mxlFlowRuntimeInfo runtimeInfo;
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo) == MXL_STATUS_OK);
+    REQUIRE(runtimeInfo.headIndex == index + 3U);
+
+    REQUIRE(mxlFlowReaderGetGrain(reader, index, 16, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE((gInfo.flags & MXL_GRAIN_FLAG_INVALID) == 0);
+    for (auto i = index + 1U; i <= index + 3U; ++i)
+    {
+        REQUIRE(mxlFlowReaderGetGrain(reader, i, 16, &gInfo, &buffer) == MXL_STATUS_OK);
+        REQUIRE(gInfo.index == i);
+        REQUIRE((gInfo.flags & MXL_GRAIN_FLAG_INVALID) != 0);
+    }
+
+    // A gap longer than the ring buffer only stamps the grains that are still reachable.
+    auto const lastIndex = index + 4U + 3U * grainCount;
+    REQUIRE(mxlFlowWriterCommitInvalidRange(writer, index + 4U, lastIndex) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderGetGrain(reader, lastIndex - grainCount, 16, &gInfo, &buffer) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+    for (auto i = lastIndex - grainCount + 1U; i <= lastIndex; ++i)
+    {
+        REQUIRE(mxlFlowReaderGetGrain(reader, i, 16, &gInfo, &buffer) == MXL_STATUS_OK);
+        REQUIRE(gInfo.index == i);
+        REQUIRE((gInfo.flags & MXL_GRAIN_FLAG_INVALID) != 0);
+    }
+
+    // A late gap never overwrites newer grains nor moves the head backwards.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, lastIndex + 1U, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterCommitInvalidRange(writer, lastIndex - grainCount - 3U, lastIndex + 1U - grainCount) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+    REQUIRE(mxlFlowWriterCommitInvalidRange(writer, lastIndex - grainCount, lastIndex) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo) == MXL_STATUS_OK);
+    REQUIRE(runtimeInfo.headIndex == lastIndex + 1U);
+    REQUIRE(mxlFlowReaderGetGrain(reader, lastIndex + 1U, 16, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(gInfo.index == lastIndex + 1U);
+    REQUIRE((gInfo.flags & MXL_GRAIN_FLAG_INVALID) == 0);
+
+    // Neither does a late grain.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, lastIndex, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.flags = 0;
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo) == MXL_STATUS_OK);
+    REQUIRE(runtimeInfo.headIndex == lastIndex + 1U);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Runtime view", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), "", &configInfo) == MXL_STATUS_OK);
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    REQUIRE(mxlFlowReaderGetRuntimeView(reader, nullptr) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowReaderGetRuntimeView(nullptr, nullptr) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowReaderGetHeadIndex(reader, nullptr) == MXL_ERR_INVALID_ARG);
+
+    mxlFlowRuntimeView view;
+    REQUIRE(mxlFlowReaderGetRuntimeView(reader, &view) == MXL_STATUS_OK);
+    REQUIRE(view.runtime != nullptr);
+    REQUIRE(view.syncCounter != nullptr);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+    auto const syncCounter = __atomic_load_n(view.syncCounter, __ATOMIC_ACQUIRE);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.validSlices = gInfo.totalSlices;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+    // The view is updated in place, without having to query the reader again.
+    REQUIRE(__atomic_load_n(&view.runtime->headIndex, __ATOMIC_ACQUIRE) == index);
+    REQUIRE(__atomic_load_n(&view.runtime->lastWriteTime, __ATOMIC_RELAXED) != 0U);
+    REQUIRE(__atomic_load_n(view.syncCounter, __ATOMIC_ACQUIRE) != syncCounter);
+
+    auto headIndex = std::uint64_t{MXL_UNDEFINED_INDEX};
+    REQUIRE(mxlFlowReaderGetHeadIndex(reader, &headIndex) == MXL_STATUS_OK);
+    REQUIRE(headIndex == index);
+
+    mxlFlowRuntimeInfo runtimeInfo;
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo) == MXL_STATUS_OK);
+    REQUIRE(runtimeInfo.headIndex == headIndex);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Slice cursor", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), "", &configInfo) == MXL_STATUS_OK);
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+
+    mxlGrainSliceCursor cursor;
+    REQUIRE(mxlFlowReaderOpenSliceCursor(reader, index, nullptr) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowReaderOpenSliceCursor(reader, index, &cursor) == MXL_STATUS_OK);
+    REQUIRE(cursor.index == index);
+    REQUIRE(cursor.nextSlice == 0U);
+
+    std::uint16_t firstSlice;
+    std::uint16_t lastSlice;
+    REQUIRE(mxlFlowReaderGetNextSlices(reader, &cursor, 1000, nullptr, &lastSlice) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowReaderGetNextSlices(reader, &cursor, 1000, &firstSlice, &lastSlice) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index, &gInfo, &buffer) == MXL_STATUS_OK);
+    auto const totalSlices = gInfo.totalSlices;
+
+    // Every batch committed by the writer is handed out as a single range.
+    auto const batches = std::array<std::uint16_t, 3>{10U, 25U, totalSlices};
+    auto expectedFirstSlice = std::uint16_t{0};
+    for (auto const batchEnd : batches)
+    {
+        gInfo.validSlices = batchEnd;
+        REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+
+        REQUIRE(mxlFlowReaderGetNextSlices(reader, &cursor, 1000, &firstSlice, &lastSlice) == MXL_STATUS_OK);
+        REQUIRE(firstSlice == expectedFirstSlice);
+        REQUIRE(lastSlice == batchEnd);
+        REQUIRE(cursor.nextSlice == batchEnd);
+        REQUIRE(cursor.totalSlices == totalSlices);
+        REQUIRE(cursor.payload == buffer);
+        expectedFirstSlice = batchEnd;
+
+        if (batchEnd != totalSlices)
+        {
+            REQUIRE(mxlFlowReaderGetNextSlices(reader, &cursor, 1000, &firstSlice, &lastSlice) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+        }
+    }
+
+    // All the slices of the grain have been handed out.
+    REQUIRE(mxlFlowReaderGetNextSlices(reader, &cursor, 1000, &firstSlice, &lastSlice) == MXL_ERR_INVALID_ARG);
+
+    // An invalid grain hands out all of its slices at once.
+    REQUIRE(mxlFlowReaderOpenSliceCursor(reader, index + 1U, &cursor) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterCommitInvalidRange(writer, index + 1U, index + 1U) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderGetNextSlices(reader, &cursor, 1000, &firstSlice, &lastSlice) == MXL_STATUS_OK);
+    REQUIRE(firstSlice == 0U);
+    REQUIRE(lastSlice == totalSlices);
+    REQUIRE((cursor.flags & MXL_GRAIN_FLAG_INVALID) != 0);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Latest grain", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), "", &configInfo) == MXL_STATUS_OK);
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowReaderGetLatestGrain(reader, UINT16_MAX, nullptr, &buffer) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlFlowReaderGetLatestGrain(reader, UINT16_MAX, &gInfo, &buffer) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+
+    auto const rate = mxlRational{60000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+    for (auto i = index; i < index + 3U; ++i)
+    {
+        REQUIRE(mxlFlowWriterOpenGrain(writer, i, &gInfo, &buffer) == MXL_STATUS_OK);
+        gInfo.validSlices = gInfo.totalSlices;
+        REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    }
+
+    // The grain at the head of the flow is still being written.
+    REQUIRE(mxlFlowWriterOpenGrain(writer, index + 3U, &gInfo, &buffer) == MXL_STATUS_OK);
+    gInfo.validSlices = gInfo.totalSlices / 2U;
+    REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    auto const partialSlices = gInfo.validSlices;
+
+    REQUIRE(mxlFlowReaderGetLatestGrain(reader, UINT16_MAX, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(gInfo.index == index + 2U);
+    REQUIRE(gInfo.validSlices == gInfo.totalSlices);
+    REQUIRE(buffer != nullptr);
+
+    REQUIRE(mxlFlowReaderGetLatestGrain(reader, partialSlices, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(gInfo.index == index + 3U);
+    REQUIRE(gInfo.validSlices == partialSlices);
+
+    // Invalid grains are returned like any other grain.
+    REQUIRE(mxlFlowWriterCommitInvalidRange(writer, index + 4U, index + 4U) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowReaderGetLatestGrain(reader, UINT16_MAX, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(gInfo.index == index + 4U);
+    REQUIRE((gInfo.flags & MXL_GRAIN_FLAG_INVALID) != 0);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Read at a foreign edit rate", "[mxl flows]")
+{
+    auto const flowId = "5fbec3b1-1b0f-417d-9059-8b94a47197ed";
+    auto flowDef = mxl::tests::readFile("data/v210_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), "", &configInfo) == MXL_STATUS_OK);
+    auto const flowRate = configInfo.common.grainRate;
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const index = mxlGetCurrentIndex(&flowRate);
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    std::array<uint8_t*, 2> payloads{};
+    for (auto i = 0U; i < payloads.size(); ++i)
+    {
+        REQUIRE(mxlFlowWriterOpenGrain(writer, index + i, &gInfo, &buffer) == MXL_STATUS_OK);
+        payloads[i] = buffer;
+        gInfo.validSlices = gInfo.totalSlices;
+        REQUIRE(mxlFlowWriterCommitGrain(writer, &gInfo) == MXL_STATUS_OK);
+    }
+
+    // On a timeline running twice as fast as the flow, every grain is presented twice, in place.
+    auto const editRate = mxlRational{flowRate.numerator * 2, flowRate.denominator};
+    auto const timelineIndex = mxlConvertIndex(&flowRate, index, &editRate);
+    for (auto i = 0U; i < 2U * payloads.size(); ++i)
+    {
+        REQUIRE(mxlFlowReaderGetGrainAtRate(reader, &editRate, timelineIndex + i, 0, &gInfo, &buffer) == MXL_STATUS_OK);
+        REQUIRE(gInfo.index == index + i / 2U);
+        REQUIRE(buffer == payloads[i / 2U]);
+    }
+    REQUIRE(mxlFlowReaderGetGrainAtRate(reader, &editRate, timelineIndex + 4U, 0, &gInfo, &buffer) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+
+    auto const badRate = mxlRational{0, 0};
+    REQUIRE(mxlFlowReaderGetGrainAtRate(reader, &badRate, timelineIndex, 0, &gInfo, &buffer) == MXL_ERR_INVALID_ARG);
+
+    mxlWrappedMultiBufferSlice samples;
+    REQUIRE(mxlFlowReaderGetSamplesAtRate(reader, &editRate, timelineIndex, 0, &samples, nullptr) == MXL_ERR_INVALID_FLOW_READER);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Data Flow : Multiple producers", "[mxl flows]")
+{
+    auto const flowId = "db3bd465-2772-484f-8fac-830b0471258b";
+    auto flowDef = mxl::tests::readFile("data/data_flow.json");
+
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    // Multiple producers are only supported for data flows and are exclusive with per grain processing.
+    mxlFlowConfigInfo configInfo;
+    auto const videoFlowDef = mxl::tests::readFile("data/v210_flow.json");
+    REQUIRE(mxlCreateFlow(instance, videoFlowDef.c_str(), R"({"multiProducer": true})", &configInfo) != MXL_STATUS_OK);
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), R"({"multiProducer": 1})", &configInfo) != MXL_STATUS_OK);
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), R"({"multiProducer": true, "checksum": "crc32c"})", &configInfo) != MXL_STATUS_OK);
+
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), R"({"multiProducer": true})", &configInfo) == MXL_STATUS_OK);
+    REQUIRE((configInfo.common.flags & MXL_FLOW_FLAG_MULTI_PRODUCER) != 0);
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId, "", &reader) == MXL_STATUS_OK);
+
+    auto const rate = mxlRational{30000, 1001};
+    auto const index = mxlGetCurrentIndex(&rate);
+
+    // Every producer appends a number of records carrying its id to the same grain.
+    constexpr auto producerCount = 4U;
+    constexpr auto recordsPerProducer = 16U;
+    constexpr auto recordSize = std::uint32_t{13};
+    auto failures = std::atomic<unsigned>{0};
+    auto producers = std::vector<std::thread>{};
+    for (auto producer = 0U; producer < producerCount; ++producer)
+    {
+        producers.emplace_back(
+            [writer, index, producer, &failures]()
+            {
+                for (auto i = 0U; i < recordsPerProducer; ++i)
+                {
+                    mxlDataRecord record;
+                    if ((mxlFlowWriterClaimRecord(writer, index, recordSize, &record) != MXL_STATUS_OK) || (record.index != index))
+                    {
+                        ++failures;
+                        continue;
+                    }
+                    std::memset(record.data, static_cast<int>('A' + producer), record.size);
+                    if (mxlFlowWriterCommitRecord(writer, &record) != MXL_STATUS_OK)
+                    {
+                        ++failures;
+                    }
+                }
+            });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    REQUIRE(failures == 0U);
+
+    mxlGrainInfo gInfo;
+    uint8_t* buffer = nullptr;
+    REQUIRE(mxlFlowReaderGetGrainSliceNonBlocking(reader, index, 1, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(gInfo.index == index);
+
+    // Walk the records and make sure none of them was lost or torn.
+    auto recordCounts = std::array<std::size_t, producerCount>{};
+    auto offset = std::size_t{0};
+    while (offset < gInfo.validSlices)
+    {
+        mxlDataRecordHeader header;
+        std::memcpy(&header, buffer + offset, sizeof header);
+        REQUIRE(header.size == recordSize);
+
+        auto const data = buffer + offset + sizeof header;
+        auto const producer = static_cast<std::size_t>(data[0] - 'A');
+        REQUIRE(producer < producerCount);
+        for (auto i = std::size_t{1}; i < header.size; ++i)
+        {
+            REQUIRE(data[i] == data[0]);
+        }
+        ++recordCounts[producer];
+
+        offset += sizeof header + ((header.size + 3U) & ~3U);
+    }
+    REQUIRE(offset == gInfo.validSlices);
+    for (auto const count : recordCounts)
+    {
+        REQUIRE(count == recordsPerProducer);
+    }
+
+    mxlFlowRuntimeInfo runtimeInfo;
+    REQUIRE(mxlFlowReaderGetRuntimeInfo(reader, &runtimeInfo) == MXL_STATUS_OK);
+    REQUIRE(runtimeInfo.headIndex == index);
+
+    // Fill the rest of the grain. Records that do not fit anymore are rejected.
+    auto const recordFootprint = sizeof(mxlDataRecordHeader) + 16U;
+    mxlDataRecord record;
+    for (auto remaining = gInfo.grainSize - gInfo.validSlices; remaining >= recordFootprint; remaining -= recordFootprint)
+    {
+        REQUIRE(mxlFlowWriterClaimRecord(writer, index, 16U, &record) == MXL_STATUS_OK);
+        REQUIRE(mxlFlowWriterCommitRecord(writer, &record) == MXL_STATUS_OK);
+    }
+    REQUIRE(mxlFlowWriterClaimRecord(writer, index, 16U, &record) == MXL_ERR_CONFLICT);
+
+    // Records claimed for the next grain open it, after which the previous grain can't be reopened through the same ring buffer entry.
+    REQUIRE(mxlFlowWriterClaimRecord(writer, index + configInfo.discrete.grainCount, 16U, &record) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterCommitRecord(writer, &record) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterClaimRecord(writer, index, 16U, &record) == MXL_ERR_OUT_OF_RANGE_TOO_LATE);
+    REQUIRE(mxlFlowReaderGetGrainSliceNonBlocking(reader, index + configInfo.discrete.grainCount, 1, &gInfo, &buffer) == MXL_STATUS_OK);
+    REQUIRE(gInfo.validSlices == recordFootprint);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+
+    // Records can't be claimed in flows with a single producer.
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), "", &configInfo) == MXL_STATUS_OK);
+    REQUIRE(mxlCreateFlowWriter(instance, flowId, "", &writer) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterClaimRecord(writer, index, 16U, &record) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
 TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Invalid flow definitions", "[mxl flows]")
 {
     // Create the instance
@@ -546,18 +1257,18 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Video Flow : Options
     optsObj["maxCommitBatchSizeHint"] = picojson::value{0.0}; // Invalid value
 
     auto optsStr = picojson::value(optsObj).serialize();
-    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_UNKNOWN);
+    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_INVALID_ARG);
 
     optsObj.clear();
     optsObj["maxSyncBatchSizeHint"] = picojson::value{-1.0}; // Invalid value
     optsStr = picojson::value(optsObj).serialize();
-    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_UNKNOWN);
+    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_INVALID_ARG);
 
     optsObj.clear();
     optsObj["maxCommitBatchSizeHint"] = picojson::value{5.0};
     optsObj["maxSyncBatchSizeHint"] = picojson::value{6.0}; // Not a multiple of maxCommitBatchSizeHint
     optsStr = picojson::value(optsObj).serialize();
-    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_UNKNOWN);
+    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_INVALID_ARG);
 
     optsObj.clear();
     optsObj["maxCommitBatchSizeHint"] = picojson::value{5.0};
@@ -865,6 +1576,46 @@ std::vector<BatchIndexAndSize> planAudioBatches(std::size_t numOfBatches, std::s
     return result;
 }
 
+TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Read at a foreign edit rate", "[mxl flows]")
+{
+    auto instance = mxlCreateInstance(domain.string().c_str(), "");
+    REQUIRE(instance != nullptr);
+
+    auto flowDef = mxl::tests::readFile("data/audio_flow.json");
+    mxlFlowConfigInfo configInfo;
+    REQUIRE(mxlCreateFlow(instance, flowDef.c_str(), "", &configInfo) == MXL_STATUS_OK);
+    auto const flowId = uuids::to_string(configInfo.common.id);
+    auto const sampleRate = configInfo.common.grainRate;
+    REQUIRE(configInfo.continuous.bufferLength >= 8U);
+
+    // A timeline with exactly 4 samples per frame.
+    auto const editRate = mxlRational{sampleRate.numerator, sampleRate.denominator * 4};
+    auto const frame = mxlGetCurrentIndex(&editRate);
+    auto const lastSample = mxlConvertIndex(&editRate, frame + 1U, &sampleRate) - 1U;
+
+    mxlFlowWriter writer;
+    REQUIRE(mxlCreateFlowWriter(instance, flowId.c_str(), "", &writer) == MXL_STATUS_OK);
+    mxlMutableWrappedMultiBufferSlice writeSlices;
+    REQUIRE(mxlFlowWriterOpenSamples(writer, lastSample, 4U, &writeSlices) == MXL_STATUS_OK);
+    REQUIRE(mxlFlowWriterCommitSamples(writer) == MXL_STATUS_OK);
+
+    mxlFlowReader reader;
+    REQUIRE(mxlCreateFlowReader(instance, flowId.c_str(), "", &reader) == MXL_STATUS_OK);
+
+    mxlWrappedMultiBufferSlice readSlices;
+    auto count = std::size_t{0};
+    REQUIRE(mxlFlowReaderGetSamplesAtRate(reader, &editRate, frame, 0, &readSlices, &count) == MXL_STATUS_OK);
+    REQUIRE(count == 4U);
+    REQUIRE(readSlices.base.fragments[0].pointer == writeSlices.base.fragments[0].pointer);
+    REQUIRE((readSlices.base.fragments[0].size + readSlices.base.fragments[1].size) == 4U * sizeof(float));
+    REQUIRE(mxlFlowReaderGetSamplesAtRate(reader, &editRate, frame + 1U, 0, &readSlices, &count) == MXL_ERR_OUT_OF_RANGE_TOO_EARLY);
+
+    REQUIRE(mxlReleaseFlowReader(instance, reader) == MXL_STATUS_OK);
+    REQUIRE(mxlReleaseFlowWriter(instance, writer) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyFlow(instance, flowId.c_str()) == MXL_STATUS_OK);
+    REQUIRE(mxlDestroyInstance(instance) == MXL_STATUS_OK);
+}
+
 TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Different writer / reader batch size", "[mxl flows]")
 {
     auto const opts = "{}";
@@ -950,18 +1701,18 @@ TEST_CASE_PERSISTENT_FIXTURE(mxl::tests::mxlDomainFixture, "Audio Flow : Options
     optsObj["maxCommitBatchSizeHint"] = picojson::value{-1.0}; // Invalid value
 
     auto optsStr = picojson::value(optsObj).serialize();
-    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_UNKNOWN);
+    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_INVALID_ARG);
 
     optsObj.clear();
     optsObj["maxSyncBatchSizeHint"] = picojson::value{0.0}; // Invalid value
     optsStr = picojson::value(optsObj).serialize();
-    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_UNKNOWN);
+    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_INVALID_ARG);
 
     optsObj.clear();
     optsObj["maxCommitBatchSizeHint"] = picojson::value{10.0};
     optsObj["maxSyncBatchSizeHint"] = picojson::value{2.0}; // Not a multiple of maxCommitBatchSizeHint
     optsStr = picojson::value(optsObj).serialize();
-    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_UNKNOWN);
+    REQUIRE(mxlCreateFlow(instanceWriter, flowDef.c_str(), optsStr.c_str(), &configInfo) == MXL_ERR_INVALID_ARG);
 
     optsObj.clear();
     optsObj["maxCommitBatchSizeHint"] = picojson::value{5.0};
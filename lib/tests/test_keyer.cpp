@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <mxl/keyer.h>
+#include <mxl/mxl.h>
+
+namespace
+{
+    /** Length in bytes of a v210 line, padded to a multiple of 48 pixels. */
+    std::size_t v210LineLength(std::uint32_t width)
+    {
+        return (width + 47U) / 48U * 128U;
+    }
+
+    /** Length in bytes of a line of the 10 bit alpha format of v210a (3 samples per 32 bit word). */
+    std::size_t alphaLineLength(std::uint32_t width)
+    {
+        return (width + 2U) / 3U * 4U;
+    }
+
+    /** Extract the 10 bit sample at the specified position of a buffer that packs 3 samples per 32 bit word. */
+    std::uint32_t sampleAt(std::uint8_t const* data, std::size_t sample)
+    {
+        auto word = std::uint32_t{};
+        std::memcpy(&word, data + 4U * (sample / 3U), sizeof word);
+        return (word >> (10U * (sample % 3U))) & 0x3FFU;
+    }
+
+    /** Check whether the first samples of two lines are equal, ignoring the unused top bits of their words. */
+    bool sameSamples(std::uint8_t const* lhs, std::uint8_t const* rhs, std::size_t count)
+    {
+        for (auto sample = std::size_t{0}; sample < count; ++sample)
+        {
+            if (sampleAt(lhs, sample) != sampleAt(rhs, sample))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** A video/v210a grain: the fill lines followed by the key lines. */
+    std::vector<std::uint8_t> makeForeground(mxlKeyerConfig const& config, std::uint32_t keyValue, std::mt19937& generator)
+    {
+        auto const fillLength = v210LineLength(config.width) * config.height;
+        auto result = std::vector<std::uint8_t>(fillLength + alphaLineLength(config.width) * config.height);
+        for (auto i = std::size_t{0}; i < fillLength; ++i)
+        {
+            result[i] = static_cast<std::uint8_t>(generator());
+        }
+
+        auto const word = keyValue | (keyValue << 10) | (keyValue << 20);
+        for (auto offset = fillLength; offset + 4U <= result.size(); offset += 4U)
+        {
+            std::memcpy(result.data() + offset, &word, sizeof word);
+        }
+        return result;
+    }
+}
+
+TEST_CASE("Keyer : Invalid arguments", "[keyer]")
+{
+    auto generator = std::mt19937{42};
+    auto config = mxlKeyerConfig{7U, 4U, MXL_KEY_MODE_STRAIGHT, 1U};
+    auto const foreground = makeForeground(config, 1023U, generator);
+    auto const background = std::vector<std::uint8_t>(v210LineLength(config.width) * config.height);
+    auto output = background;
+
+    REQUIRE(mxlKeyV210a(nullptr, foreground.data(), background.data(), output.data(), 0U, 4U) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlKeyV210a(&config, nullptr, background.data(), output.data(), 0U, 4U) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlKeyV210a(&config, foreground.data(), nullptr, output.data(), 0U, 4U) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlKeyV210a(&config, foreground.data(), background.data(), nullptr, 0U, 4U) == MXL_ERR_INVALID_ARG);
+
+    // The range of lines must be ordered and within the grain.
+    REQUIRE(mxlKeyV210a(&config, foreground.data(), background.data(), output.data(), 3U, 2U) == MXL_ERR_INVALID_ARG);
+    REQUIRE(mxlKeyV210a(&config, foreground.data(), background.data(), output.data(), 0U, 5U) == MXL_ERR_INVALID_ARG);
+
+    auto invalid = config;
+    invalid.width = 0U;
+    REQUIRE(mxlKeyV210a(&invalid, foreground.data(), background.data(), output.data(), 0U, 4U) == MXL_ERR_INVALID_ARG);
+    invalid = config;
+    invalid.mode = static_cast<mxlKeyMode>(2);
+    REQUIRE(mxlKeyV210a(&invalid, foreground.data(), background.data(), output.data(), 0U, 4U) == MXL_ERR_INVALID_ARG);
+
+    // An empty range is valid and leaves the output untouched.
+    REQUIRE(mxlKeyV210a(&config, foreground.data(), background.data(), output.data(), 2U, 2U) == MXL_STATUS_OK);
+    REQUIRE(output == background);
+}
+
+TEST_CASE("Keyer : Composite a range of lines", "[keyer]")
+{
+    auto generator = std::mt19937{42};
+
+    // A width that is not a multiple of 48 pixels exercises the padding of the lines, and of the key after the fill.
+    auto const config = mxlKeyerConfig{100U, 6U, MXL_KEY_MODE_STRAIGHT, 0U};
+    auto const lineLength = v210LineLength(config.width);
+    auto const samples = std::size_t{config.width} * 2U;
+
+    auto background = std::vector<std::uint8_t>(lineLength * config.height);
+    for (auto& b : background)
+    {
+        b = static_cast<std::uint8_t>(generator());
+    }
+
+    // A fully opaque key replaces the background with the fill, on the requested lines only.
+    auto const opaque = makeForeground(config, 940U, generator);
+    auto output = std::vector<std::uint8_t>(background.size(), 0xA5U);
+    auto const untouched = output;
+    REQUIRE(mxlKeyV210a(&config, opaque.data(), background.data(), output.data(), 2U, 5U) == MXL_STATUS_OK);
+    for (auto line = std::size_t{0}; line < config.height; ++line)
+    {
+        INFO("line: " << line);
+        auto const offset = line * lineLength;
+        if ((line >= 2U) && (line < 5U))
+        {
+            REQUIRE(sameSamples(output.data() + offset, opaque.data() + offset, samples));
+        }
+        else
+        {
+            REQUIRE(std::memcmp(output.data() + offset, untouched.data() + offset, lineLength) == 0);
+        }
+    }
+
+    // A fully transparent key composited in place leaves the background untouched.
+    auto const transparent = makeForeground(config, 64U, generator);
+    auto const original = background;
+    REQUIRE(mxlKeyV210a(&config, transparent.data(), background.data(), background.data(), 0U, config.height) == MXL_STATUS_OK);
+    for (auto line = std::size_t{0}; line < config.height; ++line)
+    {
+        INFO("line: " << line);
+        auto const offset = line * lineLength;
+        REQUIRE(sameSamples(background.data() + offset, original.data() + offset, samples));
+    }
+}
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include <sched.h>
+#include <mxl/mxl.h>
+#include <mxl/realtime.h>
+
+TEST_CASE("Invalid thread scheduling settings", "[realtime]")
+{
+    REQUIRE(mxlSetCurrentThreadScheduling(nullptr) == MXL_ERR_INVALID_ARG);
+
+    // Run on a scratch thread, so that the settings of the test runner are left alone. Assertions on other threads must not throw.
+    auto thread = std::thread{[]()
+        {
+            auto const unchanged = mxlThreadSchedulingConfig{-1, 0};
+            CHECK(mxlSetCurrentThreadScheduling(&unchanged) == MXL_STATUS_OK);
+
+            auto const badPriority = mxlThreadSchedulingConfig{-1, 1000};
+            CHECK(mxlSetCurrentThreadScheduling(&badPriority) == MXL_ERR_INVALID_ARG);
+
+            auto const badCpu = mxlThreadSchedulingConfig{1 << 20, 0};
+            CHECK(mxlSetCurrentThreadScheduling(&badCpu) != MXL_STATUS_OK);
+        }};
+    thread.join();
+}
+
+#ifdef __linux__
+TEST_CASE("Pin thread to a CPU", "[realtime]")
+{
+    auto thread = std::thread{[]()
+        {
+            // Pick a CPU that is part of the cpuset of the test runner.
+            auto const cpu = ::sched_getcpu();
+            auto const config = mxlThreadSchedulingConfig{cpu, 0};
+            CHECK(mxlSetCurrentThreadScheduling(&config) == MXL_STATUS_OK);
+            for (auto i = 0; i < 100; ++i)
+            {
+                std::this_thread::yield();
+                CHECK(::sched_getcpu() == cpu);
+            }
+        }};
+    thread.join();
+}
+#endif
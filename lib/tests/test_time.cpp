@@ -77,3 +77,52 @@ TEST_CASE("Index <-> Timestamp roundtrip (others)", "[time]")
         REQUIRE(i == rti);
     }
 }
+
+TEST_CASE("Index conversion between edit rates", "[time]")
+{
+    auto const badRate = mxlRational{0, 0};
+    auto const rate50 = mxlRational{50, 1};
+    auto const rate5994 = mxlRational{60000, 1001};
+    auto const rate48k = mxlRational{48000, 1};
+
+    REQUIRE(mxlConvertIndex(&badRate, 10, &rate50) == MXL_UNDEFINED_INDEX);
+    REQUIRE(mxlConvertIndex(&rate50, 10, &badRate) == MXL_UNDEFINED_INDEX);
+    REQUIRE(mxlConvertIndex(nullptr, 10, &rate50) == MXL_UNDEFINED_INDEX);
+    REQUIRE(mxlConvertIndex(&rate50, MXL_UNDEFINED_INDEX, &rate50) == MXL_UNDEFINED_INDEX);
+
+    auto const negativeRate = mxlRational{-50, 1};
+    auto const negativeDenominatorRate = mxlRational{50, -1};
+    REQUIRE(mxlConvertIndex(&negativeRate, 10, &rate50) == MXL_UNDEFINED_INDEX);
+    REQUIRE(mxlConvertIndex(&rate50, 10, &negativeRate) == MXL_UNDEFINED_INDEX);
+    REQUIRE(mxlConvertIndex(&negativeDenominatorRate, 10, &rate50) == MXL_UNDEFINED_INDEX);
+    REQUIRE(mxlConvertIndex(&rate50, 10, &negativeDenominatorRate) == MXL_UNDEFINED_INDEX);
+
+    auto const now = mxlGetTime();
+    auto const first = mxlTimestampToIndex(&rate5994, now);
+    REQUIRE(mxlConvertIndex(&rate5994, first, &rate5994) == first);
+
+    // Every 50 Hz grain is shown once or twice on a 59.94 Hz timeline, and the pattern never drifts: after
+    // 60000 frames of 59.94 Hz (1001 seconds) exactly 50050 grains of 50 Hz have been shown.
+    auto const start = (first / 60000U) * 60000U;
+    auto shown = std::uint64_t{0};
+    auto previous = mxlConvertIndex(&rate5994, start, &rate50);
+    for (auto i = start + 1U; i <= start + 60000U; ++i)
+    {
+        auto const current = mxlConvertIndex(&rate5994, i, &rate50);
+        REQUIRE(current - previous <= 1U);
+        shown += current - previous;
+        previous = current;
+    }
+    REQUIRE(shown == 50050U);
+
+    // 48 kHz audio on a 59.94 Hz timeline comes in windows of 800 or 801 samples, 4004 samples every 5 frames.
+    auto const frame = (first / 5U) * 5U;
+    auto total = std::uint64_t{0};
+    for (auto i = frame; i < frame + 5U; ++i)
+    {
+        auto const window = mxlConvertIndex(&rate5994, i + 1U, &rate48k) - mxlConvertIndex(&rate5994, i, &rate48k);
+        REQUIRE(((window == 800U) || (window == 801U)));
+        total += window;
+    }
+    REQUIRE(total == 4004U);
+}
@@ -23,6 +23,10 @@ pub enum Error {
     InvalidArg,
     #[error("Conflict")]
     Conflict,
+    #[error("Flow invalid")]
+    FlowInvalid,
+    #[error("Checksum mismatch")]
+    ChecksumMismatch,
     /// The error is not defined in the MXL API, but it is used to wrap other errors.
     #[error("Other error: {0}")]
     Other(String),
@@ -47,6 +51,8 @@ impl Error {
             mxl_sys::MXL_ERR_TIMEOUT => Err(Error::Timeout),
             mxl_sys::MXL_ERR_INVALID_ARG => Err(Error::InvalidArg),
             mxl_sys::MXL_ERR_CONFLICT => Err(Error::Conflict),
+            mxl_sys::MXL_ERR_FLOW_INVALID => Err(Error::FlowInvalid),
+            mxl_sys::MXL_ERR_CHECKSUM_MISMATCH => Err(Error::ChecksumMismatch),
             other => Err(Error::Unknown(other)),
         }
     }
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "RealtimeOptions.hpp"
+#include <cstdint>
+#include <mxl/realtime.h>
+#include "mxl-internal/Logging.hpp"
+#include "mxl-internal/Realtime.hpp"
+
+namespace mxl::tools
+{
+    void addRealtimeOptions(CLI::App& app, RealtimeOptions& options)
+    {
+        app.add_option("--cpu",
+               options.cpus,
+               "CPUs to pin the MXL loops to. The loops of a tool are assigned to the listed CPUs round robin. Default is not to pin.")
+            ->delimiter(',');
+        app.add_option("--rt-priority", options.rtPriority, "Run the MXL loops with the SCHED_FIFO policy at this priority (1-99).")
+            ->check(CLI::Range(1, 99));
+        app.add_flag("--mlock", options.lockMemory, "Lock all the memory of the process, including the flows it opens, to avoid page faults.");
+        app.add_flag("--isolate-irq-hints",
+            options.isolateIrqHints,
+            "Report the system settings that are likely to disturb the MXL loops on the CPUs selected with --cpu.");
+    }
+
+    bool applyProcessRealtimeOptions(RealtimeOptions const& options)
+    {
+        if (options.isolateIrqHints)
+        {
+            if (options.cpus.empty())
+            {
+                MXL_WARN("--isolate-irq-hints has no effect without --cpu.");
+            }
+            for (auto const cpu : options.cpus)
+            {
+                for (auto const& hint : mxl::lib::cpuIsolationHints(cpu))
+                {
+                    MXL_WARN("{}", hint);
+                }
+            }
+        }
+
+        if (options.lockMemory)
+        {
+            if (auto const status = mxlLockProcessMemory(); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to lock the process memory with status '{}'", static_cast<int>(status));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool applyThreadRealtimeOptions(RealtimeOptions const& options, std::size_t loopIndex)
+    {
+        auto const config = mxlThreadSchedulingConfig{
+            .cpu = options.cpus.empty() ? -1 : static_cast<std::int32_t>(options.cpus[loopIndex % options.cpus.size()]),
+            .rtPriority = options.rtPriority,
+        };
+
+        if (auto const status = mxlSetCurrentThreadScheduling(&config); status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to apply the scheduling settings of MXL loop {} (cpu: {}, rt-priority: {}) with status '{}'",
+                loopIndex,
+                config.cpu,
+                config.rtPriority,
+                static_cast<int>(status));
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <CLI/CLI.hpp>
+
+namespace mxl::tools
+{
+    /**
+     * Scheduling and memory settings for the MXL loops of a tool, as selected
+     * on its command line.
+     */
+    struct RealtimeOptions
+    {
+        /** The CPUs to pin the MXL loops to. Loops are assigned to them round robin. */
+        std::vector<unsigned int> cpus;
+        /** The SCHED_FIFO priority of the MXL loops, or 0 to keep the default scheduling policy. */
+        int rtPriority = 0;
+        /** Lock the memory of the process, including the flows it opens. */
+        bool lockMemory = false;
+        /** Report what may disturb the MXL loops on the selected CPUs. */
+        bool isolateIrqHints = false;
+    };
+
+    /**
+     * Register the --cpu, --rt-priority, --mlock and --isolate-irq-hints
+     * options with a command line parser.
+     */
+    void addRealtimeOptions(CLI::App& app, RealtimeOptions& options);
+
+    /**
+     * Apply the process wide settings. Must be called once, after parsing the
+     * command line and before opening any flows.
+     *
+     * \return true on success, false if a requested setting could not be applied.
+     */
+    bool applyProcessRealtimeOptions(RealtimeOptions const& options);
+
+    /**
+     * Apply the per thread settings to the calling thread, which is about to
+     * run an MXL loop.
+     *
+     * \param[in] options The options selected on the command line.
+     * \param[in] loopIndex The index of the loop run by the calling thread,
+     *      which selects the CPU the thread is pinned to.
+     * \return true on success, false if a requested setting could not be applied.
+     */
+    bool applyThreadRealtimeOptions(RealtimeOptions const& options, std::size_t loopIndex);
+}
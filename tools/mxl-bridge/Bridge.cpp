@@ -0,0 +1,674 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Bridge.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <uuid.h>
+#include <fmt/format.h>
+#include <mxl/time.h>
+#include "mxl-internal/Base64.hpp"
+#include "mxl-internal/Crc32c.hpp"
+#include "mxl-internal/FlowParser.hpp"
+#include "mxl-internal/Logging.hpp"
+#include "mxl-internal/PathUtils.hpp"
+
+namespace mxl::tools
+{
+    namespace
+    {
+        /** How long a bridge waits for the other one during a handshake. */
+        constexpr auto const CONTROL_TIMEOUT = std::chrono::seconds{5};
+
+        /** How often the sender checks its link to the receiver, or tries to reach it again, and how often the statistics are published. */
+        constexpr auto const LINK_CHECK_INTERVAL = std::chrono::seconds{1};
+
+        /*
+            The control protocol, one message per line:
+
+                sender   -> receiver  FLOW <base64 flow definition>      (once per flow)
+                sender   -> receiver  DONE
+                receiver -> sender    FLOW <id of the flow in the target session>      (once per flow, in the same order)
+                receiver -> sender    TARGET <base64 target info>
+                receiver -> sender    ERROR <message>      (instead of the above if a flow can't be mirrored)
+        */
+        constexpr auto const FLOW_MESSAGE = std::string_view{"FLOW "};
+        constexpr auto const DONE_MESSAGE = std::string_view{"DONE"};
+        constexpr auto const TARGET_MESSAGE = std::string_view{"TARGET "};
+        constexpr auto const ERROR_MESSAGE = std::string_view{"ERROR "};
+
+        void check(mxlStatus in_status, std::string_view in_what)
+        {
+            if (in_status != MXL_STATUS_OK)
+            {
+                throw std::runtime_error{fmt::format("Failed to {} with status '{}'", in_what, static_cast<int>(in_status))};
+            }
+        }
+
+        /** The two-call pattern of the functions that return strings. The returned size includes the null terminator. */
+        template<typename F>
+        std::string getString(F&& in_get, std::string_view in_what)
+        {
+            auto size = std::size_t{0};
+            if (auto const status = in_get(nullptr, &size); (status != MXL_STATUS_OK) && (status != MXL_ERR_INVALID_ARG))
+            {
+                check(status, in_what);
+            }
+
+            auto result = std::string(size, '\0');
+            check(in_get(result.data(), &size), in_what);
+            result.resize(size - 1U);
+            return result;
+        }
+
+        /** Map the fabrics statistics of a flow. The bridge keeps running without them if they can't be created. */
+        mxl::lib::SharedMemoryInstance<mxl::lib::FabricsStats> openStats(std::string const& in_domain, std::string const& in_id)
+        {
+            auto const path = mxl::lib::makeFlowFabricsFilePath(mxl::lib::makeFlowDirectoryName(in_domain, in_id));
+            try
+            {
+                return {path.string().c_str(), mxl::lib::AccessMode::CREATE_READ_WRITE, 0U};
+            }
+            catch (std::exception const& e)
+            {
+                MXL_WARN("Failed to create the fabrics statistics of flow {}: {}", in_id, e.what());
+                return {};
+            }
+        }
+
+        mxl::lib::FabricsValues toValues(mxlFabricsLinkStats const& in_stats, std::uint32_t in_role, std::string_view in_peer)
+        {
+            auto values = mxl::lib::FabricsValues{};
+            values.version = mxl::lib::FABRICS_STATS_VERSION;
+            values.role = in_role;
+            values.updateTime = mxlGetTime();
+            in_peer.copy(values.peer, std::min(in_peer.size(), mxl::lib::FABRICS_MAX_PEER_SIZE - 1U));
+            values.linkFailures = in_stats.linkFailures;
+            values.reconnects = in_stats.reconnects;
+            values.inFlight = in_stats.inFlight;
+            values.maxInFlight = in_stats.maxInFlight;
+            values.bytes = in_stats.bytes;
+            values.grains = in_stats.grains;
+            values.writes = in_stats.writes;
+            std::copy(std::begin(in_stats.latencyHistogram), std::end(in_stats.latencyHistogram), std::begin(values.latencyHistogram));
+            values.totalLatencyNs = in_stats.totalLatencyNs;
+            values.maxLatencyNs = in_stats.maxLatencyNs;
+            values.errors = in_stats.errors;
+            for (auto i = std::size_t{0}; i < mxl::lib::FABRICS_MAX_ERROR_CODES; ++i)
+            {
+                values.errorCodes[i] = in_stats.errorCodes[i].code;
+                values.errorCounts[i] = in_stats.errorCodes[i].count;
+            }
+            return values;
+        }
+
+        mxlSessionConfig sessionConfig(BridgeSettings const& in_settings)
+        {
+            return mxlSessionConfig{
+                .endpointAddress = {.node = in_settings.node ? in_settings.node->c_str() : nullptr,
+                                    .service = in_settings.service ? in_settings.service->c_str() : nullptr},
+                .provider = in_settings.provider,
+                .deviceSupport = false,
+                .completionQueue = {},
+                .endpointType = in_settings.endpointType,
+                .extraRails = nullptr,
+                .extraRailCount = 0,
+                .creditWindow = 0,
+                .supervision = {.enabled = true, .retryIntervalMs = 0, .catchUpGrains = 0},
+            };
+        }
+    }
+
+    BridgeReceiver::BridgeReceiver(BridgeSettings in_settings)
+        : _settings{std::move(in_settings)}
+        , _instance{nullptr}
+        , _fabricsInstance{nullptr}
+        , _session{nullptr}
+    {}
+
+    BridgeReceiver::~BridgeReceiver()
+    {
+        if (_session != nullptr)
+        {
+            if (auto const status = mxlFabricsDestroyTargetSession(_fabricsInstance, _session); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy target session with status '{}'", static_cast<int>(status));
+            }
+        }
+
+        if (_fabricsInstance != nullptr)
+        {
+            if (auto const status = mxlFabricsDestroyInstance(_fabricsInstance); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy fabrics instance with status '{}'", static_cast<int>(status));
+            }
+        }
+
+        for (auto const& [sessionId, flow] : _flows)
+        {
+            if (auto const status = mxlReleaseFlowWriter(_instance, flow.writer); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to release the writer of flow {} with status '{}'", flow.id, static_cast<int>(status));
+            }
+            if (flow.created)
+            {
+                if (auto const status = mxlDestroyFlow(_instance, flow.id.c_str()); status != MXL_STATUS_OK)
+                {
+                    MXL_ERROR("Failed to destroy flow {} with status '{}'", flow.id, static_cast<int>(status));
+                }
+            }
+        }
+
+        if (_instance != nullptr)
+        {
+            if (auto const status = mxlDestroyInstance(_instance); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy instance with status '{}'", static_cast<int>(status));
+            }
+        }
+    }
+
+    void BridgeReceiver::setup(std::string const& in_controlNode, std::string const& in_controlService)
+    {
+        _instance = mxlCreateInstance(_settings.domain.c_str(), "");
+        if (_instance == nullptr)
+        {
+            throw std::runtime_error{"Failed to create MXL instance"};
+        }
+        check(mxlFabricsCreateInstance(_instance, &_fabricsInstance), "create fabrics instance");
+
+        auto const config = sessionConfig(_settings);
+        check(mxlFabricsCreateTargetSession(_fabricsInstance, &config, &_session), "create target session");
+
+        _listener.emplace(in_controlNode, in_controlService);
+        MXL_INFO("Waiting for sending bridges on {}:{}", in_controlNode, in_controlService);
+    }
+
+    void BridgeReceiver::run(std::sig_atomic_t volatile const& in_exitRequested)
+    {
+        auto nextStats = std::chrono::steady_clock::now();
+        while (!in_exitRequested)
+        {
+            if (auto const now = std::chrono::steady_clock::now(); now >= nextStats)
+            {
+                nextStats = now + LINK_CHECK_INTERVAL;
+                publishStats();
+            }
+
+            // Waiting for grains also accepts the connections of the initiator sessions of the senders.
+            auto grain = mxlSessionGrain{};
+            auto const status = mxlFabricsTargetSessionWaitForNewGrain(_session, &grain, 10);
+            if (status == MXL_STATUS_OK)
+            {
+                try
+                {
+                    commit(grain);
+                }
+                catch (std::exception const& e)
+                {
+                    MXL_ERROR("Failed to commit grain {} of session flow {}: {}", grain.index, grain.flowId, e.what());
+                }
+            }
+            else if (status == MXL_ERR_INTERRUPTED)
+            {
+                return;
+            }
+            else if (status != MXL_ERR_NOT_READY)
+            {
+                check(status, "wait for new grains");
+            }
+
+            if (auto channel = _listener->accept(std::chrono::milliseconds{0}); channel)
+            {
+                try
+                {
+                    handshake(*channel);
+                }
+                catch (std::exception const& e)
+                {
+                    MXL_ERROR("Failed to set up a sending bridge: {}", e.what());
+                    try
+                    {
+                        channel->send(fmt::format("{}{}", ERROR_MESSAGE, e.what()));
+                    }
+                    catch (std::exception const&)
+                    {
+                        // The sender is gone already.
+                    }
+                }
+            }
+        }
+    }
+
+    void BridgeReceiver::handshake(ControlChannel& io_channel)
+    {
+        auto flowDefs = std::vector<std::string>{};
+        for (auto line = io_channel.receive(CONTROL_TIMEOUT); line != DONE_MESSAGE; line = io_channel.receive(CONTROL_TIMEOUT))
+        {
+            if (!line.starts_with(FLOW_MESSAGE))
+            {
+                throw std::runtime_error{"Unexpected control message"};
+            }
+            flowDefs.push_back(base64::from_base64(std::string_view{line}.substr(FLOW_MESSAGE.size())));
+        }
+
+        // All the flows are added before answering, the target info only covers the flows that were added when it was obtained.
+        auto sessionIds = std::vector<std::uint16_t>{};
+        for (auto const& flowDef : flowDefs)
+        {
+            sessionIds.push_back(addFlow(flowDef));
+        }
+
+        auto targetInfo = mxlTargetInfo{nullptr};
+        check(mxlFabricsTargetSessionGetInfo(_session, &targetInfo), "get target info");
+        auto targetInfoString = std::string{};
+        try
+        {
+            targetInfoString = getString(
+                [&](char* out_string, std::size_t* io_size) { return mxlFabricsTargetInfoToString(targetInfo, out_string, io_size); },
+                "convert target info");
+        }
+        catch (...)
+        {
+            mxlFabricsFreeTargetInfo(targetInfo);
+            throw;
+        }
+        mxlFabricsFreeTargetInfo(targetInfo);
+
+        for (auto const sessionId : sessionIds)
+        {
+            io_channel.send(fmt::format("{}{}", FLOW_MESSAGE, sessionId));
+        }
+        io_channel.send(fmt::format("{}{}", TARGET_MESSAGE, base64::to_base64(targetInfoString)));
+        MXL_INFO("A sending bridge mirrors {} flows", sessionIds.size());
+    }
+
+    std::uint16_t BridgeReceiver::addFlow(std::string const& in_flowDef)
+    {
+        auto const id = uuids::to_string(mxl::lib::FlowParser{in_flowDef}.getId());
+        if (auto const it = _sessionIds.find(id); it != _sessionIds.end())
+        {
+            return it->second;
+        }
+
+        // The flow may exist already, for instance if it was mirrored before the receiver restarted.
+        auto configInfo = mxlFlowConfigInfo{};
+        auto const created = (mxlCreateFlow(_instance, in_flowDef.c_str(), nullptr, &configInfo) == MXL_STATUS_OK);
+        if (!created)
+        {
+            MXL_WARN("Failed to create flow {}, writing to the existing flow", id);
+        }
+
+        auto writer = mxlFlowWriter{nullptr};
+        check(mxlCreateFlowWriter(_instance, id.c_str(), "", &writer), "create flow writer");
+
+        auto regions = mxlRegions{nullptr};
+        auto sessionId = std::uint16_t{0};
+        auto status = mxlFabricsRegionsForFlowWriter(writer, &regions);
+        if (status == MXL_STATUS_OK)
+        {
+            status = mxlFabricsTargetSessionAddFlow(_session, regions, &sessionId);
+            mxlFabricsRegionsFree(regions);
+        }
+        if (status != MXL_STATUS_OK)
+        {
+            mxlReleaseFlowWriter(_instance, writer);
+            if (created)
+            {
+                mxlDestroyFlow(_instance, id.c_str());
+            }
+            check(status, fmt::format("add flow {} to the target session", id));
+        }
+
+        _flows.emplace(sessionId, Flow{.id = id, .writer = writer, .created = created, .stats = openStats(_settings.domain, id)});
+        _sessionIds.emplace(id, sessionId);
+        MXL_INFO("Mirroring flow {} as session flow {}", id, sessionId);
+        return sessionId;
+    }
+
+    void BridgeReceiver::commit(mxlSessionGrain const& in_grain)
+    {
+        auto const it = _flows.find(in_grain.flowId);
+        if (it == _flows.end())
+        {
+            MXL_WARN("Received a grain of unknown session flow {}", in_grain.flowId);
+            return;
+        }
+        auto const writer = it->second.writer;
+
+        // The header was written by the sender. It is read before opening the grain, which clears the repeat flag.
+        auto grainInfo = mxlGrainInfo{};
+        check(mxlFlowWriterGetGrainInfo(writer, in_grain.index, &grainInfo), "get grain info");
+
+        auto openedInfo = mxlGrainInfo{};
+        auto payload = static_cast<std::uint8_t*>(nullptr);
+        check(mxlFlowWriterOpenGrain(writer, in_grain.index, &openedInfo, &payload), "open grain");
+
+        if ((grainInfo.flags & MXL_GRAIN_FLAG_REPEAT) == 0)
+        {
+            grainInfo.validSlices = in_grain.validSlices;
+
+            // The writer checksums the payload again on commit, so a grain damaged in transit is verified against the checksum of the
+            // sender first, and committed as invalid rather than with a checksum of the damaged payload.
+            if (((grainInfo.flags & MXL_GRAIN_FLAG_CHECKSUM) != 0) && (grainInfo.validSlices == grainInfo.totalSlices) &&
+                (mxl::lib::crc32c(payload, openedInfo.grainSize) != grainInfo.checksum))
+            {
+                MXL_WARN("Grain {} of flow {} doesn't match the checksum of the sender, committing it as invalid", in_grain.index, it->second.id);
+                grainInfo.flags = (grainInfo.flags & ~MXL_GRAIN_FLAG_CHECKSUM) | MXL_GRAIN_FLAG_INVALID;
+            }
+        }
+        check(mxlFlowWriterCommitGrain(writer, &grainInfo), "commit grain");
+        check(mxlFabricsTargetSessionReleaseGrains(_session, in_grain.flowId, in_grain.index), "release grains");
+    }
+
+    void BridgeReceiver::publishStats()
+    {
+        auto stats = mxlFabricsLinkStats{};
+        if (mxlFabricsTargetSessionGetStats(_session, &stats) != MXL_STATUS_OK)
+        {
+            return;
+        }
+
+        // The senders are not known by address, the counters cover all of them.
+        auto const values = toValues(stats, mxl::lib::FABRICS_ROLE_RECEIVER, {});
+        for (auto& [sessionId, flow] : _flows)
+        {
+            if (auto const shared = flow.stats.get(); shared != nullptr)
+            {
+                mxl::lib::publishFabricsStats(*shared, values);
+            }
+        }
+    }
+
+    BridgeSender::BridgeSender(BridgeSettings in_settings, std::vector<std::string> in_flowIds)
+        : _settings{std::move(in_settings)}
+        , _flowIds{std::move(in_flowIds)}
+        , _instance{nullptr}
+        , _fabricsInstance{nullptr}
+        , _session{nullptr}
+        , _targetInfo{nullptr}
+    {}
+
+    BridgeSender::~BridgeSender()
+    {
+        if (_targetInfo != nullptr)
+        {
+            mxlFabricsFreeTargetInfo(_targetInfo);
+        }
+
+        if (_session != nullptr)
+        {
+            if (auto const status = mxlFabricsDestroyInitiatorSession(_fabricsInstance, _session); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy initiator session with status '{}'", static_cast<int>(status));
+            }
+        }
+
+        if (_fabricsInstance != nullptr)
+        {
+            if (auto const status = mxlFabricsDestroyInstance(_fabricsInstance); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy fabrics instance with status '{}'", static_cast<int>(status));
+            }
+        }
+
+        for (auto const& flow : _flows)
+        {
+            if (auto const status = mxlReleaseFlowReader(_instance, flow.reader); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to release the reader of flow {} with status '{}'", flow.id, static_cast<int>(status));
+            }
+        }
+
+        if (_instance != nullptr)
+        {
+            if (auto const status = mxlDestroyInstance(_instance); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy instance with status '{}'", static_cast<int>(status));
+            }
+        }
+    }
+
+    void BridgeSender::setup(std::sig_atomic_t volatile const& in_exitRequested)
+    {
+        _instance = mxlCreateInstance(_settings.domain.c_str(), "");
+        if (_instance == nullptr)
+        {
+            throw std::runtime_error{"Failed to create MXL instance"};
+        }
+        check(mxlFabricsCreateInstance(_instance, &_fabricsInstance), "create fabrics instance");
+
+        auto const config = sessionConfig(_settings);
+        check(mxlFabricsCreateInitiatorSession(_fabricsInstance, &config, &_session), "create initiator session");
+
+        // The flows may be created after the bridge was started, so the domain is watched until all of them exist.
+        for (auto const& id : _flowIds)
+        {
+            auto reader = mxlFlowReader{nullptr};
+            auto waiting = false;
+            while (mxlCreateFlowReader(_instance, id.c_str(), "", &reader) != MXL_STATUS_OK)
+            {
+                if (in_exitRequested)
+                {
+                    throw std::runtime_error{"Interrupted while waiting for the flows"};
+                }
+                if (!std::exchange(waiting, true))
+                {
+                    MXL_INFO("Waiting for flow {} to appear in the domain", id);
+                }
+                std::this_thread::sleep_for(LINK_CHECK_INTERVAL);
+            }
+            _flows.push_back(Flow{
+                .id = id,
+                .reader = reader,
+                .sessionId = std::nullopt,
+                .nextIndex = MXL_UNDEFINED_INDEX,
+                .stats = openStats(_settings.domain, id),
+            });
+        }
+    }
+
+    void BridgeSender::run(std::string const& in_peerNode, std::string const& in_peerService, std::sig_atomic_t volatile const& in_exitRequested)
+    {
+        auto const peer = fmt::format("{}:{}", in_peerNode, in_peerService);
+        auto nextLinkCheck = std::chrono::steady_clock::now();
+        while (!in_exitRequested)
+        {
+            if (auto const now = std::chrono::steady_clock::now(); now >= nextLinkCheck)
+            {
+                nextLinkCheck = now + LINK_CHECK_INTERVAL;
+                if (_targetInfo != nullptr)
+                {
+                    // The session re-establishes lost links by itself, only a restarted receiver needs the flows again.
+                    auto link = mxlFabricsLinkStatus{};
+                    if ((mxlFabricsInitiatorSessionGetLinkStatus(_session, _targetInfo, &link) == MXL_STATUS_OK) &&
+                        (link.state == MXL_FABRICS_LINK_STATE_STALE))
+                    {
+                        MXL_WARN("The receiving bridge was restarted, handing it the flows again");
+                        disconnect();
+                    }
+                }
+
+                if (_targetInfo == nullptr)
+                {
+                    try
+                    {
+                        handshake(in_peerNode, in_peerService);
+                    }
+                    catch (std::exception const& e)
+                    {
+                        MXL_WARN("Failed to reach the receiving bridge: {}", e.what());
+                        disconnect();
+                    }
+                }
+
+                publishStats(peer);
+            }
+
+            // One grain per flow and per iteration, so that a busy flow doesn't hold the others back. The transfers are pipelined, they
+            // complete while the next grains are read.
+            auto transferred = false;
+            if (_targetInfo != nullptr)
+            {
+                for (auto& flow : _flows)
+                {
+                    transferred = transferNext(flow) || transferred;
+                }
+            }
+
+            auto const status = transferred ? mxlFabricsInitiatorSessionMakeProgressNonBlocking(_session)
+                                            : mxlFabricsInitiatorSessionMakeProgressBlocking(_session, 1);
+            if (status == MXL_ERR_INTERRUPTED)
+            {
+                return;
+            }
+            if ((status != MXL_STATUS_OK) && (status != MXL_ERR_NOT_READY))
+            {
+                check(status, "make progress");
+            }
+        }
+    }
+
+    void BridgeSender::handshake(std::string const& in_peerNode, std::string const& in_peerService)
+    {
+        auto channel = ControlChannel::connect(in_peerNode, in_peerService);
+        for (auto const& flow : _flows)
+        {
+            auto const flowDef = getString(
+                [&](char* out_buffer, std::size_t* io_size) { return mxlGetFlowDef(_instance, flow.id.c_str(), out_buffer, io_size); },
+                "get flow definition");
+            channel.send(fmt::format("{}{}", FLOW_MESSAGE, base64::to_base64(flowDef)));
+        }
+        channel.send(DONE_MESSAGE);
+
+        auto sessionIds = std::vector<std::uint16_t>{};
+        auto line = channel.receive(CONTROL_TIMEOUT);
+        for (; line.starts_with(FLOW_MESSAGE); line = channel.receive(CONTROL_TIMEOUT))
+        {
+            sessionIds.push_back(static_cast<std::uint16_t>(std::stoul(line.substr(FLOW_MESSAGE.size()))));
+        }
+        if (line.starts_with(ERROR_MESSAGE))
+        {
+            throw std::runtime_error{fmt::format("The receiving bridge refused the flows: {}", line.substr(ERROR_MESSAGE.size()))};
+        }
+        if (!line.starts_with(TARGET_MESSAGE) || (sessionIds.size() != _flows.size()))
+        {
+            throw std::runtime_error{"Unexpected control message"};
+        }
+
+        auto const targetInfoString = base64::from_base64(std::string_view{line}.substr(TARGET_MESSAGE.size()));
+        check(mxlFabricsTargetInfoFromString(targetInfoString.c_str(), &_targetInfo), "parse target info");
+
+        for (auto i = std::size_t{0}; i < _flows.size(); ++i)
+        {
+            auto& flow = _flows[i];
+            flow.nextIndex = MXL_UNDEFINED_INDEX;
+
+            // The receiver gave the flow its own id, the session gives it another one.
+            auto regions = mxlRegions{nullptr};
+            auto sessionId = std::uint16_t{0};
+            check(mxlFabricsRegionsForFlowReader(flow.reader, &regions), "get flow regions");
+            auto const status = mxlFabricsInitiatorSessionAddFlow(_session, _targetInfo, sessionIds[i], regions, &sessionId);
+            mxlFabricsRegionsFree(regions);
+            check(status, fmt::format("add flow {} to the initiator session", flow.id));
+            flow.sessionId = sessionId;
+        }
+
+        check(mxlFabricsInitiatorSessionConnect(_session, _targetInfo), "connect to the receiving bridge");
+        MXL_INFO("Mirroring {} flows to {}:{}", _flows.size(), in_peerNode, in_peerService);
+    }
+
+    void BridgeSender::disconnect()
+    {
+        if (_targetInfo == nullptr)
+        {
+            return;
+        }
+
+        for (auto& flow : _flows)
+        {
+            if (flow.sessionId)
+            {
+                mxlFabricsInitiatorSessionRemoveFlow(_session, *flow.sessionId);
+                flow.sessionId.reset();
+            }
+        }
+        mxlFabricsInitiatorSessionDisconnect(_session, _targetInfo);
+        mxlFabricsFreeTargetInfo(_targetInfo);
+        _targetInfo = nullptr;
+    }
+
+    void BridgeSender::publishStats(std::string const& in_peer)
+    {
+        // There are no counters while there is no link to the receiver, the last ones published remain.
+        auto stats = mxlFabricsLinkStats{};
+        auto link = mxlFabricsLinkStatus{};
+        if ((_targetInfo == nullptr) || (mxlFabricsInitiatorSessionGetStats(_session, _targetInfo, &stats) != MXL_STATUS_OK) ||
+            (mxlFabricsInitiatorSessionGetLinkStatus(_session, _targetInfo, &link) != MXL_STATUS_OK))
+        {
+            return;
+        }
+
+        auto values = toValues(stats, mxl::lib::FABRICS_ROLE_SENDER, in_peer);
+        values.linkState = static_cast<std::uint32_t>(link.state);
+        for (auto& flow : _flows)
+        {
+            if (auto const shared = flow.stats.get(); shared != nullptr)
+            {
+                mxl::lib::publishFabricsStats(*shared, values);
+            }
+        }
+    }
+
+    bool BridgeSender::transferNext(Flow& io_flow)
+    {
+        if (io_flow.nextIndex == MXL_UNDEFINED_INDEX)
+        {
+            // Mirroring starts with the grain being written when the link comes up.
+            if ((mxlFlowReaderGetHeadIndex(io_flow.reader, &io_flow.nextIndex) != MXL_STATUS_OK) || (io_flow.nextIndex == MXL_UNDEFINED_INDEX))
+            {
+                io_flow.nextIndex = MXL_UNDEFINED_INDEX;
+                return false;
+            }
+        }
+
+        // Only complete grains are transferred, a grain is written to the receiver once.
+        auto grainInfo = mxlGrainInfo{};
+        auto payload = static_cast<std::uint8_t*>(nullptr);
+        auto status = mxlFlowReaderGetGrainSliceNonBlocking(io_flow.reader, io_flow.nextIndex, UINT16_MAX, &grainInfo, &payload);
+        if (status == MXL_ERR_OUT_OF_RANGE_TOO_EARLY)
+        {
+            return false;
+        }
+        if (status == MXL_ERR_OUT_OF_RANGE_TOO_LATE)
+        {
+            MXL_WARN("Flow {} fell behind at grain {}, skipping to its head", io_flow.id, io_flow.nextIndex);
+            io_flow.nextIndex = MXL_UNDEFINED_INDEX;
+            return false;
+        }
+        if (status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to read grain {} of flow {} with status '{}'", io_flow.nextIndex, io_flow.id, static_cast<int>(status));
+            ++io_flow.nextIndex;
+            return false;
+        }
+
+        status = mxlFabricsInitiatorSessionTransferGrain(_session, *io_flow.sessionId, io_flow.nextIndex);
+        if (status == MXL_ERR_NOT_READY)
+        {
+            // The link is not up yet, or the work queue is full. The grain is tried again on the next iteration.
+            return false;
+        }
+        if (status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to transfer grain {} of flow {} with status '{}'", io_flow.nextIndex, io_flow.id, static_cast<int>(status));
+        }
+        ++io_flow.nextIndex;
+        return true;
+    }
+}
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include <mxl/fabrics.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include "mxl-internal/FabricsStats.hpp"
+#include "mxl-internal/SharedMemory.hpp"
+#include "ControlChannel.hpp"
+
+namespace mxl::tools
+{
+    /** The settings shared by both sides of a bridge. */
+    struct BridgeSettings
+    {
+        /** The local MXL domain. */
+        std::string domain;
+        mxlFabricsProvider provider;
+        mxlFabricsEndpointType endpointType;
+        /** The address of the fabric endpoint of the bridge. */
+        std::optional<std::string> node;
+        std::optional<std::string> service;
+    };
+
+    /**
+     * The receiving side of a bridge.
+     *
+     * Sending bridges connect to its control address and list the flows they
+     * mirror. The receiver creates a local flow for each of them with the same
+     * definition, adds it to its target session, and answers with its target
+     * info. Every grain written by a sender is then committed to the local flow,
+     * so that unmodified readers on this host consume it like any local flow.
+     * The counters of the target session are published next to every flow.
+     */
+    class BridgeReceiver
+    {
+    public:
+        explicit BridgeReceiver(BridgeSettings in_settings);
+
+        BridgeReceiver(BridgeReceiver const&) = delete;
+        BridgeReceiver& operator=(BridgeReceiver const&) = delete;
+
+        /** Release the writers, and destroy the flows the receiver created. */
+        ~BridgeReceiver();
+
+        /**
+         * Create the target session, and listen for sending bridges on the control address.
+         * \throws std::runtime_error on failure.
+         */
+        void setup(std::string const& in_controlNode, std::string const& in_controlService);
+
+        /**
+         * Accept sending bridges and commit the grains they write, until an exit is requested.
+         * \throws std::runtime_error if the target session fails.
+         */
+        void run(std::sig_atomic_t volatile const& in_exitRequested);
+
+    private:
+        /** A local flow written by sending bridges. */
+        struct Flow
+        {
+            std::string id;
+            mxlFlowWriter writer;
+            /** Whether the receiver created the flow, and destroys it on exit. */
+            bool created;
+            /** The fabrics statistics published next to the flow, unmapped if they couldn't be created. */
+            mxl::lib::SharedMemoryInstance<mxl::lib::FabricsStats> stats;
+        };
+
+        /** Agree on the flows of a sending bridge, and send it the target info. */
+        void handshake(ControlChannel& io_channel);
+
+        /** Create the local flow of a flow definition unless it exists, and return its id in the target session. */
+        std::uint16_t addFlow(std::string const& in_flowDef);
+
+        /** Commit a grain written by a sending bridge to its local flow. */
+        void commit(mxlSessionGrain const& in_grain);
+
+        /** Publish the counters of the target session next to every flow. */
+        void publishStats();
+
+    private:
+        BridgeSettings _settings;
+
+        mxlInstance _instance;
+        mxlFabricsInstance _fabricsInstance;
+        mxlFabricsTargetSession _session;
+        std::optional<ControlListener> _listener;
+
+        /** The flows of the session, by their id in the session. */
+        std::map<std::uint16_t, Flow> _flows;
+        /** The id in the session of the flows, by flow id. Flows keep their id when a sending bridge comes back. */
+        std::map<std::string, std::uint16_t> _sessionIds;
+    };
+
+    /**
+     * The sending side of a bridge.
+     *
+     * The sender waits for the flows it mirrors to appear in the local domain,
+     * sends their definitions to the receiving bridge, and then transfers every
+     * complete grain of every flow as soon as it is committed. Transfers of all
+     * the flows are pipelined through a single initiator session. When the link
+     * to the receiver is lost, the session re-establishes it, and a restarted
+     * receiver is handed the flows again. The counters of the link to the
+     * receiver are published next to every flow.
+     */
+    class BridgeSender
+    {
+    public:
+        BridgeSender(BridgeSettings in_settings, std::vector<std::string> in_flowIds);
+
+        BridgeSender(BridgeSender const&) = delete;
+        BridgeSender& operator=(BridgeSender const&) = delete;
+
+        ~BridgeSender();
+
+        /**
+         * Create the initiator session, and open a reader for every flow once it exists.
+         * \throws std::runtime_error on failure, or if an exit was requested before the flows appeared.
+         */
+        void setup(std::sig_atomic_t volatile const& in_exitRequested);
+
+        /**
+         * Mirror the flows to the receiving bridge at the given control address, until an exit is requested.
+         * \throws std::runtime_error if the initiator session fails.
+         */
+        void run(std::string const& in_peerNode, std::string const& in_peerService, std::sig_atomic_t volatile const& in_exitRequested);
+
+    private:
+        /** A local flow mirrored to the receiver. */
+        struct Flow
+        {
+            std::string id;
+            mxlFlowReader reader;
+            /** The id of the flow in the initiator session, once it was added to it. */
+            std::optional<std::uint16_t> sessionId;
+            /** The next grain to transfer, or MXL_UNDEFINED_INDEX until the flow has a head. */
+            std::uint64_t nextIndex;
+            /** The fabrics statistics published next to the flow, unmapped if they couldn't be created. */
+            mxl::lib::SharedMemoryInstance<mxl::lib::FabricsStats> stats;
+        };
+
+        /** Hand the flows to the receiver, add them to the session and connect to the receiver. */
+        void handshake(std::string const& in_peerNode, std::string const& in_peerService);
+
+        /** Remove the flows from the session and disconnect from the receiver. */
+        void disconnect();
+
+        /** Transfer the next grain of a flow if it is complete. Returns whether a grain was transferred. */
+        bool transferNext(Flow& io_flow);
+
+        /** Publish the counters of the link to the receiver next to every flow. */
+        void publishStats(std::string const& in_peer);
+
+    private:
+        BridgeSettings _settings;
+        std::vector<std::string> _flowIds;
+
+        mxlInstance _instance;
+        mxlFabricsInstance _fabricsInstance;
+        mxlFabricsInitiatorSession _session;
+        /** The target info of the receiver, or nullptr while there is no link to it. */
+        mxlTargetInfo _targetInfo;
+
+        std::vector<Flow> _flows;
+    };
+}
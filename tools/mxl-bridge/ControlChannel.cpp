@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ControlChannel.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fmt/format.h>
+#include <sys/socket.h>
+
+namespace mxl::tools
+{
+    namespace
+    {
+        /** Maximum length of a control line. Flow definitions and target infos are a few kilobytes at most. */
+        constexpr auto const MAX_LINE_SIZE = std::size_t{1} << 20;
+
+        struct AddressInfoDeleter
+        {
+            void operator()(::addrinfo* in_info) const noexcept
+            {
+                ::freeaddrinfo(in_info);
+            }
+        };
+
+        std::unique_ptr<::addrinfo, AddressInfoDeleter> resolve(std::string const& in_node, std::string const& in_service, bool in_passive)
+        {
+            auto hints = ::addrinfo{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            hints.ai_flags = in_passive ? AI_PASSIVE : 0;
+
+            ::addrinfo* result = nullptr;
+            auto const node = in_node.empty() ? nullptr : in_node.c_str();
+            if (auto const error = ::getaddrinfo(node, in_service.c_str(), &hints, &result); error != 0)
+            {
+                throw std::runtime_error{fmt::format("Failed to resolve '{}:{}': {}", in_node, in_service, ::gai_strerror(error))};
+            }
+            return std::unique_ptr<::addrinfo, AddressInfoDeleter>{result};
+        }
+
+        /** Wait for a socket to become readable. Returns false on timeout. */
+        bool waitReadable(int in_fd, std::chrono::milliseconds in_timeout)
+        {
+            auto pollFd = ::pollfd{.fd = in_fd, .events = POLLIN, .revents = 0};
+            auto const result = ::poll(&pollFd, 1, static_cast<int>(in_timeout.count()));
+            if ((result < 0) && (errno != EINTR))
+            {
+                throw std::runtime_error{fmt::format("Failed to poll the control connection: {}", std::strerror(errno))};
+            }
+            return result > 0;
+        }
+    }
+
+    ControlChannel ControlChannel::connect(std::string const& in_node, std::string const& in_service)
+    {
+        auto const addresses = resolve(in_node, in_service, false);
+        for (auto address = addresses.get(); address != nullptr; address = address->ai_next)
+        {
+            auto const fd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+            if (fd < 0)
+            {
+                continue;
+            }
+            if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0)
+            {
+                return ControlChannel{fd};
+            }
+            ::close(fd);
+        }
+        throw std::runtime_error{fmt::format("Failed to connect to the bridge at '{}:{}'", in_node, in_service)};
+    }
+
+    ControlChannel::ControlChannel(int in_fd) noexcept
+        : _fd{in_fd}
+    {}
+
+    ControlChannel::ControlChannel(ControlChannel&& other) noexcept
+        : _fd{std::exchange(other._fd, -1)}
+        , _buffer{std::move(other._buffer)}
+    {}
+
+    ControlChannel& ControlChannel::operator=(ControlChannel&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (_fd >= 0)
+            {
+                ::close(_fd);
+            }
+            _fd = std::exchange(other._fd, -1);
+            _buffer = std::move(other._buffer);
+        }
+        return *this;
+    }
+
+    ControlChannel::~ControlChannel()
+    {
+        if (_fd >= 0)
+        {
+            ::close(_fd);
+        }
+    }
+
+    void ControlChannel::send(std::string_view in_line)
+    {
+        auto data = std::string{in_line};
+        data.push_back('\n');
+
+        auto sent = std::size_t{0};
+        while (sent < data.size())
+        {
+            auto const result = ::send(_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::runtime_error{fmt::format("Failed to send on the control connection: {}", std::strerror(errno))};
+            }
+            sent += static_cast<std::size_t>(result);
+        }
+    }
+
+    std::string ControlChannel::receive(std::chrono::milliseconds in_timeout)
+    {
+        auto const deadline = std::chrono::steady_clock::now() + in_timeout;
+        for (;;)
+        {
+            if (auto const end = _buffer.find('\n'); end != std::string::npos)
+            {
+                auto line = _buffer.substr(0, end);
+                _buffer.erase(0, end + 1);
+                return line;
+            }
+            if (_buffer.size() > MAX_LINE_SIZE)
+            {
+                throw std::runtime_error{"The control line received is too long"};
+            }
+
+            auto const remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if ((remaining.count() <= 0) || !waitReadable(_fd, remaining))
+            {
+                throw std::runtime_error{"Timed out waiting for the other bridge"};
+            }
+
+            char chunk[4096];
+            auto const result = ::recv(_fd, chunk, sizeof(chunk), 0);
+            if (result == 0)
+            {
+                throw std::runtime_error{"The other bridge closed the control connection"};
+            }
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::runtime_error{fmt::format("Failed to receive on the control connection: {}", std::strerror(errno))};
+            }
+            _buffer.append(chunk, static_cast<std::size_t>(result));
+        }
+    }
+
+    ControlListener::ControlListener(std::string const& in_node, std::string const& in_service)
+        : _fd{-1}
+    {
+        auto const addresses = resolve(in_node, in_service, true);
+        for (auto address = addresses.get(); address != nullptr; address = address->ai_next)
+        {
+            auto const fd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+            if (fd < 0)
+            {
+                continue;
+            }
+
+            // Lets a restarted bridge listen again while the connections of the previous one linger.
+            auto const reuse = 1;
+            ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            if ((::bind(fd, address->ai_addr, address->ai_addrlen) == 0) && (::listen(fd, SOMAXCONN) == 0))
+            {
+                _fd = fd;
+                return;
+            }
+            ::close(fd);
+        }
+        throw std::runtime_error{fmt::format("Failed to listen on '{}:{}'", in_node, in_service)};
+    }
+
+    ControlListener::~ControlListener()
+    {
+        ::close(_fd);
+    }
+
+    std::optional<ControlChannel> ControlListener::accept(std::chrono::milliseconds in_timeout)
+    {
+        if (!waitReadable(_fd, in_timeout))
+        {
+            return std::nullopt;
+        }
+
+        auto const fd = ::accept4(_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return std::nullopt;
+        }
+        return ControlChannel{fd};
+    }
+}
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mxl::tools
+{
+    /**
+     * A line-based TCP connection between two bridges.
+     *
+     * Bridges only use it to agree on the flows they mirror and to exchange the
+     * target info of the receiving bridge. Grains never go through it.
+     */
+    class ControlChannel
+    {
+    public:
+        /**
+         * Connect to a listening bridge.
+         * \throws std::runtime_error if the bridge can't be reached.
+         */
+        static ControlChannel connect(std::string const& in_node, std::string const& in_service);
+
+        /** Take ownership of a connected socket. */
+        explicit ControlChannel(int in_fd) noexcept;
+
+        ControlChannel(ControlChannel&& other) noexcept;
+        ControlChannel& operator=(ControlChannel&& other) noexcept;
+        ControlChannel(ControlChannel const&) = delete;
+        ControlChannel& operator=(ControlChannel const&) = delete;
+
+        ~ControlChannel();
+
+        /**
+         * Send a line. The newline is appended.
+         * \throws std::runtime_error if the connection failed.
+         */
+        void send(std::string_view in_line);
+
+        /**
+         * Receive the next line, without its newline.
+         * \throws std::runtime_error if the connection failed, or no line was received before the timeout.
+         */
+        std::string receive(std::chrono::milliseconds in_timeout);
+
+    private:
+        int _fd;
+        /** Bytes received past the last line handed out. */
+        std::string _buffer;
+    };
+
+    /** The listening socket of a receiving bridge. */
+    class ControlListener
+    {
+    public:
+        /**
+         * Listen for bridges on the given address.
+         * \throws std::runtime_error if the address can't be bound.
+         */
+        ControlListener(std::string const& in_node, std::string const& in_service);
+
+        ControlListener(ControlListener const&) = delete;
+        ControlListener& operator=(ControlListener const&) = delete;
+
+        ~ControlListener();
+
+        /** Accept the next bridge that connects before the timeout, if any. */
+        std::optional<ControlChannel> accept(std::chrono::milliseconds in_timeout);
+
+    private:
+        int _fd;
+    };
+}
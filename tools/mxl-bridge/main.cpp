@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include <fmt/format.h>
+#include <mxl/fabrics.h>
+#include "mxl-internal/Logging.hpp"
+#include "Bridge.hpp"
+#include "RealtimeOptions.hpp"
+
+/*
+    Mirror flows of a host to another host, where unmodified readers consume them like local flows:
+
+        1- On the receiving host: ./mxl-bridge -d <tmpfs folder> --listen 0.0.0.0:5000 --node 2.2.2.2 --provider verbs
+        2- On the sending host: ./mxl-bridge -d <tmpfs folder> --peer 2.2.2.2:5000 -f <flow id> -f <flow id> --node 1.1.1.1 --provider verbs
+
+    The options can also be read from a configuration file, see --config.
+*/
+
+namespace
+{
+    std::sig_atomic_t volatile g_exit_requested = 0;
+
+    void signal_handler(int)
+    {
+        g_exit_requested = 1;
+    }
+
+    /** Split a 'node:service' address at its last colon. The node may be empty, or a bracketed IPv6 address. */
+    std::pair<std::string, std::string> splitAddress(std::string const& in_address)
+    {
+        auto const separator = in_address.rfind(':');
+        if ((separator == std::string::npos) || (separator + 1U == in_address.size()))
+        {
+            throw std::runtime_error{fmt::format("The address '{}' is not of the form 'node:service'", in_address)};
+        }
+
+        auto node = in_address.substr(0, separator);
+        if ((node.size() >= 2U) && node.front() == '[' && node.back() == ']')
+        {
+            node = node.substr(1, node.size() - 2U);
+        }
+        return {node, in_address.substr(separator + 1U)};
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::signal(SIGINT, &signal_handler);
+    std::signal(SIGTERM, &signal_handler);
+
+    CLI::App app("mxl-bridge");
+    app.set_config("--config", "", "Read the options from a TOML or INI file, for instance the flows and the peer of a sending bridge.");
+
+    std::string domain;
+    auto domainOpt = app.add_option("-d,--domain", domain, "The MXL domain directory")->required();
+    domainOpt->check(CLI::ExistingDirectory);
+
+    std::string listen;
+    auto listenOpt = app.add_option("--listen",
+        listen,
+        "Run as a receiving bridge, waiting for sending bridges on this 'node:port' control address. The flows they mirror are created in "
+        "the domain.");
+
+    std::string peer;
+    auto peerOpt = app.add_option("--peer", peer, "Run as a sending bridge, mirroring the flows to the receiving bridge at this 'node:port'.");
+    listenOpt->excludes(peerOpt);
+    peerOpt->excludes(listenOpt);
+
+    std::vector<std::string> flowIds;
+    auto flowOpt = app.add_option("-f,--flow", flowIds, "The flows a sending bridge mirrors. May be repeated.")->delimiter(',');
+    flowOpt->needs(peerOpt);
+
+    std::optional<std::string> node;
+    app.add_option("-n,--node", node, "The interface identifier or address the fabrics endpoint binds to.")->default_val(std::nullopt);
+
+    std::optional<std::string> service;
+    app.add_option("--service", service, "The service identifier or port the fabrics endpoint binds to.")->default_val(std::nullopt);
+
+    std::string provider;
+    app.add_option("-p,--provider", provider, "The fabrics provider. One of (tcp, verbs or efa). Default is 'tcp'.")->default_val("tcp");
+
+    std::string endpointType;
+    app.add_option("--endpoint-type", endpointType, "Type of the fabrics endpoints. One of (connected or rdm). Must match the other bridge.")
+        ->default_val("connected");
+
+    mxl::tools::RealtimeOptions realtimeOptions;
+    mxl::tools::addRealtimeOptions(app, realtimeOptions);
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (listen.empty() == peer.empty())
+    {
+        MXL_ERROR("Exactly one of --listen or --peer is required");
+        return EXIT_FAILURE;
+    }
+    if (!peer.empty() && flowIds.empty())
+    {
+        MXL_ERROR("A sending bridge needs at least one flow to mirror");
+        return EXIT_FAILURE;
+    }
+
+    if (!mxl::tools::applyProcessRealtimeOptions(realtimeOptions))
+    {
+        return EXIT_FAILURE;
+    }
+
+    auto settings = mxl::tools::BridgeSettings{.domain = domain, .provider = {}, .endpointType = {}, .node = node, .service = service};
+    if (mxlFabricsProviderFromString(provider.c_str(), &settings.provider) != MXL_STATUS_OK)
+    {
+        MXL_ERROR("Failed to parse provider '{}'", provider);
+        return EXIT_FAILURE;
+    }
+
+    auto const endpointTypes = std::map<std::string, mxlFabricsEndpointType>{
+        {"connected", MXL_FABRICS_ENDPOINT_TYPE_CONNECTED        },
+        {"rdm",       MXL_FABRICS_ENDPOINT_TYPE_RELIABLE_DATAGRAM},
+    };
+    auto const endpointTypeValue = endpointTypes.find(endpointType);
+    if (endpointTypeValue == endpointTypes.end())
+    {
+        MXL_ERROR("Failed to parse endpoint type '{}'", endpointType);
+        return EXIT_FAILURE;
+    }
+    settings.endpointType = endpointTypeValue->second;
+
+    try
+    {
+        if (!listen.empty())
+        {
+            auto const [controlNode, controlService] = splitAddress(listen);
+            auto receiver = mxl::tools::BridgeReceiver{std::move(settings)};
+            receiver.setup(controlNode, controlService);
+            if (!mxl::tools::applyThreadRealtimeOptions(realtimeOptions, 0))
+            {
+                return EXIT_FAILURE;
+            }
+            receiver.run(g_exit_requested);
+        }
+        else
+        {
+            auto const [peerNode, peerService] = splitAddress(peer);
+            auto sender = mxl::tools::BridgeSender{std::move(settings), flowIds};
+            sender.setup(g_exit_requested);
+            if (!mxl::tools::applyThreadRealtimeOptions(realtimeOptions, 0))
+            {
+                return EXIT_FAILURE;
+            }
+            sender.run(peerNode, peerService, g_exit_requested);
+        }
+    }
+    catch (std::exception const& e)
+    {
+        MXL_ERROR("{}", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
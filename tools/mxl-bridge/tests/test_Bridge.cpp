@@ -0,0 +1,295 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <mxl/fabrics.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include <mxl/time.h>
+#include "mxl-internal/Base64.hpp"
+#include "Bridge.hpp"
+#include "ControlChannel.hpp"
+#include "Utils.hpp"
+
+using namespace mxl::tools;
+using namespace std::chrono_literals;
+
+namespace
+{
+    constexpr auto FlowId = "4b1d6f0e-8a53-4c2e-9d7f-3e2a1b0c9d8e";
+
+    constexpr auto FlowDef = R"({
+        "description": "Bridge loopback test",
+        "format": "urn:x-nmos:format:data",
+        "label": "Bridge loopback test",
+        "version": "1453880607:123995943",
+        "parents": [],
+        "source_id": "0e635152-e501-4d4e-bb87-9f3fe05eb79a",
+        "device_id": "9126cc2f-4c26-4c9b-a6cd-93c4381c9be5",
+        "id": "4b1d6f0e-8a53-4c2e-9d7f-3e2a1b0c9d8e",
+        "media_type": "video/smpte291",
+        "grain_rate": {"numerator": 30000, "denominator": 1001}
+    })";
+
+    /** How long a test waits for the bridges to mirror a grain, which includes the handshake and the connection of the sessions. */
+    constexpr auto MirrorTimeout = std::chrono::seconds{10};
+
+    BridgeSettings settings(std::filesystem::path const& domain, char const* service)
+    {
+        return BridgeSettings{
+            .domain = domain.string(),
+            .provider = MXL_SHARING_PROVIDER_TCP,
+            .endpointType = MXL_FABRICS_ENDPOINT_TYPE_CONNECTED,
+            .node = "127.0.0.1",
+            .service = service,
+        };
+    }
+
+    /** A flow of a source domain mirrored to a target domain by a sending and a receiving bridge on the tcp provider, each run by a
+     * thread of its own.
+     */
+    class BridgeLoopback
+    {
+    public:
+        /** The ports of the control connection, of the target session and of the initiator session. */
+        BridgeLoopback(char const* controlService, char const* targetService, char const* initiatorService)
+            : _sourceDomain{mxl::tests::makeTempDomain()}
+            , _targetDomain{mxl::tests::makeTempDomain()}
+            , _controlService{controlService}
+        {
+            _source = mxlCreateInstance(_sourceDomain.string().c_str(), "");
+            REQUIRE(_source != nullptr);
+            _target = mxlCreateInstance(_targetDomain.string().c_str(), "");
+            REQUIRE(_target != nullptr);
+
+            // The source flow carries grain checksums, which the receiver checks the grains it commits against.
+            auto configInfo = mxlFlowConfigInfo{};
+            REQUIRE(mxlCreateFlow(_source, FlowDef, R"({"checksum": "crc32c"})", &configInfo) == MXL_STATUS_OK);
+            REQUIRE(mxlCreateFlowWriter(_source, FlowId, "", &_sourceWriter) == MXL_STATUS_OK);
+
+            _receiver.emplace(settings(_targetDomain, targetService));
+            _receiver->setup("127.0.0.1", _controlService);
+            _sender.emplace(settings(_sourceDomain, initiatorService), std::vector<std::string>{FlowId});
+        }
+
+        ~BridgeLoopback()
+        {
+            stop();
+            if (_targetReader != nullptr)
+            {
+                mxlReleaseFlowReader(_target, _targetReader);
+            }
+            _sender.reset();
+            _receiver.reset();
+
+            mxlReleaseFlowWriter(_source, _sourceWriter);
+            mxlDestroyFlow(_source, FlowId);
+            mxlDestroyInstance(_source);
+            mxlDestroyInstance(_target);
+
+            auto error = std::error_code{};
+            std::filesystem::remove_all(_sourceDomain, error);
+            std::filesystem::remove_all(_targetDomain, error);
+        }
+
+        /** Run the receiving bridge, which accepts sending bridges on the control port. */
+        void startReceiver()
+        {
+            _receiverThread = std::thread{[this]() { _receiver->run(_exitRequested); }};
+        }
+
+        /** Run the sending bridge, which mirrors the flow from the grain at its head. */
+        void startSender()
+        {
+            _sender->setup(_exitRequested);
+            _senderThread = std::thread{[this]() { _sender->run("127.0.0.1", _controlService, _exitRequested); }};
+        }
+
+        void stop()
+        {
+            _exitRequested = 1;
+            for (auto* thread : {&_senderThread, &_receiverThread})
+            {
+                if (thread->joinable())
+                {
+                    thread->join();
+                }
+            }
+        }
+
+        /** Write a complete grain of the source flow, filled with a pattern derived from its index. */
+        void writeGrain(std::uint64_t index)
+        {
+            auto info = mxlGrainInfo{};
+            auto payload = static_cast<std::uint8_t*>(nullptr);
+            REQUIRE(mxlFlowWriterOpenGrain(_sourceWriter, index, &info, &payload) == MXL_STATUS_OK);
+            for (auto i = std::uint32_t{0}; i < info.grainSize; ++i)
+            {
+                payload[i] = pattern(index, i);
+            }
+            info.validSlices = info.totalSlices;
+            REQUIRE(mxlFlowWriterCommitGrain(_sourceWriter, &info) == MXL_STATUS_OK);
+        }
+
+        /** Change a byte of a grain of the source flow after it was committed, so that it no longer matches its checksum. */
+        void damageGrain(std::uint64_t index)
+        {
+            auto info = mxlGrainInfo{};
+            auto payload = static_cast<std::uint8_t*>(nullptr);
+            REQUIRE(mxlFlowWriterOpenGrain(_sourceWriter, index, &info, &payload) == MXL_STATUS_OK);
+            payload[0] = static_cast<std::uint8_t>(~payload[0]);
+            REQUIRE(mxlFlowWriterCancelGrain(_sourceWriter) == MXL_STATUS_OK);
+        }
+
+        /** Wait for the receiving bridge to commit a grain to the target flow, and return its header and payload. */
+        mxlGrainInfo receiveGrain(std::uint64_t index, std::uint8_t** payload)
+        {
+            // The receiver creates the target flow during the handshake with the sender.
+            auto const deadline = std::chrono::steady_clock::now() + MirrorTimeout;
+            while ((_targetReader == nullptr) && (mxlCreateFlowReader(_target, FlowId, "", &_targetReader) != MXL_STATUS_OK))
+            {
+                REQUIRE(std::chrono::steady_clock::now() < deadline);
+                std::this_thread::sleep_for(10ms);
+            }
+
+            auto info = mxlGrainInfo{};
+            auto const timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(MirrorTimeout).count();
+            REQUIRE(mxlFlowReaderGetGrain(_targetReader, index, static_cast<std::uint64_t>(timeout), &info, payload) == MXL_STATUS_OK);
+            return info;
+        }
+
+        /** Check that a grain of the target flow was committed complete, with the payload written to the source flow. */
+        void requireMirrored(std::uint64_t index)
+        {
+            auto payload = static_cast<std::uint8_t*>(nullptr);
+            auto const info = receiveGrain(index, &payload);
+            REQUIRE(info.index == index);
+            REQUIRE((info.flags & MXL_GRAIN_FLAG_INVALID) == 0);
+            REQUIRE(info.validSlices == info.totalSlices);
+
+            auto mismatches = std::size_t{0};
+            for (auto i = std::uint32_t{0}; i < info.grainSize; ++i)
+            {
+                mismatches += (payload[i] != pattern(index, i)) ? 1U : 0U;
+            }
+            REQUIRE(mismatches == 0);
+        }
+
+    private:
+        static std::uint8_t pattern(std::uint64_t index, std::uint32_t offset) noexcept
+        {
+            return static_cast<std::uint8_t>((index * 31U) + offset);
+        }
+
+    private:
+        std::filesystem::path _sourceDomain;
+        std::filesystem::path _targetDomain;
+        std::string _controlService;
+
+        mxlInstance _source{nullptr};
+        mxlInstance _target{nullptr};
+        mxlFlowWriter _sourceWriter{nullptr};
+        mxlFlowReader _targetReader{nullptr};
+
+        std::optional<BridgeReceiver> _receiver;
+        std::optional<BridgeSender> _sender;
+        std::sig_atomic_t volatile _exitRequested{0};
+        std::thread _receiverThread;
+        std::thread _senderThread;
+    };
+
+    std::uint64_t currentIndex()
+    {
+        auto const rate = mxlRational{30000, 1001};
+        return mxlGetCurrentIndex(&rate);
+    }
+}
+
+TEST_CASE("bridge: Receiver answers the handshake of a sending bridge", "[bridge][Bridge]")
+{
+    auto loopback = BridgeLoopback{"9320", "9321", "9322"};
+    loopback.startReceiver();
+
+    // The sender lists the definitions of its flows, the receiver answers with their ids in its target session and its target info.
+    auto const handshake = [](ControlChannel& channel)
+    {
+        channel.send(std::string{"FLOW "} + base64::to_base64(FlowDef));
+        channel.send("DONE");
+
+        auto const flow = channel.receive(5s);
+        REQUIRE(flow.starts_with("FLOW "));
+        auto const target = channel.receive(5s);
+        REQUIRE(target.starts_with("TARGET "));
+
+        auto info = mxlTargetInfo{nullptr};
+        auto const targetInfo = base64::from_base64(std::string_view{target}.substr(7));
+        REQUIRE(mxlFabricsTargetInfoFromString(targetInfo.c_str(), &info) == MXL_STATUS_OK);
+        mxlFabricsFreeTargetInfo(info);
+        return std::stoul(flow.substr(5));
+    };
+
+    auto first = ControlChannel::connect("127.0.0.1", "9320");
+    auto const flowId = handshake(first);
+
+    // A sending bridge that comes back finds its flow under the same id.
+    auto again = ControlChannel::connect("127.0.0.1", "9320");
+    REQUIRE(handshake(again) == flowId);
+
+    // A flow that can't be mirrored is refused.
+    auto refused = ControlChannel::connect("127.0.0.1", "9320");
+    refused.send(std::string{"FLOW "} + base64::to_base64("{}"));
+    refused.send("DONE");
+    REQUIRE(refused.receive(5s).starts_with("ERROR "));
+}
+
+TEST_CASE("bridge: Sender and receiver mirror a flow", "[bridge][Bridge]")
+{
+    auto loopback = BridgeLoopback{"9323", "9324", "9325"};
+    auto const first = currentIndex();
+
+    // The sender starts mirroring from the head of the flow once the link to the receiver is up.
+    loopback.writeGrain(first);
+    loopback.startReceiver();
+    loopback.startSender();
+    loopback.requireMirrored(first);
+
+    // The grains written after that follow as soon as they are committed.
+    for (auto index = first + 1U; index < first + 4U; ++index)
+    {
+        loopback.writeGrain(index);
+        loopback.requireMirrored(index);
+    }
+}
+
+TEST_CASE("bridge: Receiver commits a grain that doesn't match the checksum of the sender as invalid", "[bridge][Bridge]")
+{
+    auto loopback = BridgeLoopback{"9326", "9327", "9328"};
+    auto const first = currentIndex();
+
+    // The grain at the head of the source flow carries the checksum of its original payload, it is damaged before the sender reads it.
+    loopback.writeGrain(first);
+    loopback.damageGrain(first);
+    loopback.startReceiver();
+    loopback.startSender();
+
+    auto payload = static_cast<std::uint8_t*>(nullptr);
+    auto const info = loopback.receiveGrain(first, &payload);
+    REQUIRE(info.index == first);
+    REQUIRE((info.flags & MXL_GRAIN_FLAG_INVALID) != 0);
+    REQUIRE((info.flags & MXL_GRAIN_FLAG_CHECKSUM) == 0);
+
+    // The grains that follow are mirrored intact.
+    loopback.writeGrain(first + 1U);
+    loopback.requireMirrored(first + 1U);
+}
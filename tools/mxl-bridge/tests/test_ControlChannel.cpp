@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include "ControlChannel.hpp"
+
+using namespace mxl::tools;
+using namespace std::chrono_literals;
+
+TEST_CASE("bridge: ControlChannel exchanges lines", "[bridge][ControlChannel]")
+{
+    auto listener = ControlListener{"127.0.0.1", "9310"};
+    REQUIRE_FALSE(listener.accept(0ms).has_value());
+
+    auto sender = ControlChannel::connect("127.0.0.1", "9310");
+    auto accepted = listener.accept(5s);
+    REQUIRE(accepted.has_value());
+    auto& receiver = *accepted;
+
+    // Lines sent back to back arrive in order, however the bytes were split by the connection.
+    sender.send("FLOW first");
+    sender.send("FLOW second");
+    sender.send("DONE");
+    REQUIRE(receiver.receive(5s) == "FLOW first");
+    REQUIRE(receiver.receive(5s) == "FLOW second");
+    REQUIRE(receiver.receive(5s) == "DONE");
+
+    // Long lines are received whole.
+    auto const line = std::string(100'000, 'x');
+    receiver.send(line);
+    REQUIRE(sender.receive(5s) == line);
+}
+
+TEST_CASE("bridge: ControlChannel reports a silent or closed peer", "[bridge][ControlChannel]")
+{
+    auto listener = ControlListener{"127.0.0.1", "9311"};
+    auto sender = std::optional{ControlChannel::connect("127.0.0.1", "9311")};
+    auto accepted = listener.accept(5s);
+    REQUIRE(accepted.has_value());
+
+    REQUIRE_THROWS_AS(accepted->receive(50ms), std::runtime_error);
+
+    // A line sent before the peer closed the connection is still received, the end of the connection is reported after it.
+    sender->send("DONE");
+    sender.reset();
+    REQUIRE(accepted->receive(5s) == "DONE");
+    REQUIRE_THROWS_AS(accepted->receive(5s), std::runtime_error);
+}
+
+TEST_CASE("bridge: ControlChannel fails to reach an address nobody listens on", "[bridge][ControlChannel]")
+{
+    REQUIRE_THROWS_AS(ControlChannel::connect("127.0.0.1", "9312"), std::runtime_error);
+}
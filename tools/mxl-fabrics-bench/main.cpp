@@ -0,0 +1,538 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include <mxl-internal/Flow.hpp>
+#include <mxl-internal/Logging.hpp>
+#include <mxl/fabrics.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include "RealtimeOptions.hpp"
+
+/*
+    Measure the completion rate of a target and an initiator session looped back through a provider:
+
+        ./mxl-fabrics-bench -d <tmpfs folder> --node 127.0.0.1 --service 1234 --provider tcp --cq-batch 64
+*/
+
+std::sig_atomic_t volatile g_exit_requested = 0;
+
+void signal_handler(int)
+{
+    g_exit_requested = 1;
+}
+
+struct BenchmarkConfig
+{
+    // endpoint configuration
+    std::optional<std::string> node;
+    std::optional<std::string> service;
+    mxlFabricsProvider provider;
+    mxlFabricsEndpointType endpointType;
+    std::uint32_t rails;
+    std::uint32_t creditWindow;
+    mxlLinkSupervisionConfig supervision;
+    mxlFlowPacingConfig pacing;
+
+    // completion queue configuration
+    mxlCompletionQueueConfig completionQueue;
+
+    std::uint32_t grains;
+    std::size_t payloadSize;
+    std::uint32_t slices;
+    std::chrono::seconds duration;
+};
+
+/** Loop a target and an initiator session back through the configured provider, and measure how many grain completions per second the
+ *  target receives when grains are posted as fast as the initiator accepts them.
+ */
+class AppBenchmark
+{
+public:
+    AppBenchmark(BenchmarkConfig config)
+        : _config(std::move(config))
+        , _grainSize(mxl::lib::MXL_GRAIN_PAYLOAD_OFFSET + _config.payloadSize)
+        , _targetBuffer(_config.grains * _grainSize)
+        , _initiatorBuffer(_config.grains * _grainSize)
+    {}
+
+    ~AppBenchmark()
+    {
+        mxlStatus status;
+
+        if (_targetInfo != nullptr)
+        {
+            if (status = mxlFabricsFreeTargetInfo(_targetInfo); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to free target info with status '{}'", static_cast<int>(status));
+            }
+        }
+
+        if (_initiator != nullptr)
+        {
+            if (status = mxlFabricsDestroyInitiatorSession(_fabricsInstance, _initiator); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy initiator session with status '{}'", static_cast<int>(status));
+            }
+        }
+
+        if (_target != nullptr)
+        {
+            if (status = mxlFabricsDestroyTargetSession(_fabricsInstance, _target); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy target session with status '{}'", static_cast<int>(status));
+            }
+        }
+
+        if (_fabricsInstance != nullptr)
+        {
+            if (status = mxlFabricsDestroyInstance(_fabricsInstance); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy fabrics instance with status '{}'", static_cast<int>(status));
+            }
+        }
+
+        if (_instance != nullptr)
+        {
+            if (status = mxlDestroyInstance(_instance); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to destroy instance with status '{}'", static_cast<int>(status));
+            }
+        }
+    }
+
+    mxlStatus setup(std::string const& domain)
+    {
+        _instance = mxlCreateInstance(domain.c_str(), "");
+        if (_instance == nullptr)
+        {
+            MXL_ERROR("Failed to create MXL instance");
+            return MXL_ERR_INVALID_ARG;
+        }
+
+        auto status = mxlFabricsCreateInstance(_instance, &_fabricsInstance);
+        if (status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to create fabrics instance with status '{}'", static_cast<int>(status));
+            return status;
+        }
+
+        auto sessionConfig = mxlSessionConfig{
+            .endpointAddress = {.node = _config.node ? _config.node.value().c_str() : nullptr,
+                                .service = _config.service ? _config.service.value().c_str() : nullptr},
+            .provider = _config.provider,
+            .deviceSupport = false,
+            .completionQueue = _config.completionQueue,
+            .endpointType = _config.endpointType,
+            .extraRails = nullptr,
+            .extraRailCount = 0,
+            .creditWindow = _config.creditWindow,
+            .supervision = _config.supervision,
+        };
+
+        // The extra rails of the target listen on the same node, on ports picked by the provider. Their addresses are part of the target
+        // info. The initiator binds all its rails to any local address.
+        auto const extraTargetRails =
+            std::vector<mxlEndpointAddress>(_config.rails - 1U, {.node = sessionConfig.endpointAddress.node, .service = nullptr});
+        auto const extraInitiatorRails = std::vector<mxlEndpointAddress>(_config.rails - 1U, {.node = nullptr, .service = nullptr});
+        sessionConfig.extraRails = extraTargetRails.data();
+        sessionConfig.extraRailCount = _config.rails - 1U;
+
+        status = mxlFabricsCreateTargetSession(_fabricsInstance, &sessionConfig, &_target);
+        if (status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to create target session with status '{}'", static_cast<int>(status));
+            return status;
+        }
+
+        sessionConfig.endpointAddress = {.node = nullptr, .service = nullptr};
+        sessionConfig.extraRails = extraInitiatorRails.data();
+        status = mxlFabricsCreateInitiatorSession(_fabricsInstance, &sessionConfig, &_initiator);
+        if (status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to create initiator session with status '{}'", static_cast<int>(status));
+            return status;
+        }
+
+        std::uint16_t flowId;
+        if (status = addFlow(_targetBuffer, [&](mxlRegions regions) { return mxlFabricsTargetSessionAddFlow(_target, regions, &flowId); });
+            status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to add the flow to the target session with status '{}'", static_cast<int>(status));
+            return status;
+        }
+        _targetFlowId = flowId;
+
+        status = mxlFabricsTargetSessionGetInfo(_target, &_targetInfo);
+        if (status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to get target info with status '{}'", static_cast<int>(status));
+            return status;
+        }
+
+        if (status = addFlow(_initiatorBuffer,
+                [&](mxlRegions regions) { return mxlFabricsInitiatorSessionAddFlow(_initiator, _targetInfo, _targetFlowId, regions, &_flowId); });
+            status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to add the flow to the initiator session with status '{}'", static_cast<int>(status));
+            return status;
+        }
+
+        if (_config.pacing.grainRate.numerator != 0)
+        {
+            if (status = mxlFabricsInitiatorSessionSetFlowPacing(_initiator, _flowId, &_config.pacing); status != MXL_STATUS_OK)
+            {
+                MXL_ERROR("Failed to pace the flow of the initiator session with status '{}'", static_cast<int>(status));
+                return status;
+            }
+        }
+
+        status = mxlFabricsInitiatorSessionConnect(_initiator, _targetInfo);
+        if (status != MXL_STATUS_OK)
+        {
+            MXL_ERROR("Failed to connect the initiator session with status '{}'", static_cast<int>(status));
+            return status;
+        }
+
+        // The target accepts the connection while it polls for grains.
+        mxlSessionGrain grain;
+        do
+        {
+            if (g_exit_requested)
+            {
+                return MXL_ERR_INTERRUPTED;
+            }
+
+            if (auto ret = mxlFabricsTargetSessionTryNewGrain(_target, &grain); ret != MXL_ERR_NOT_READY)
+            {
+                MXL_ERROR("Unexpected grain or error while connecting, status '{}'", static_cast<int>(ret));
+                return MXL_ERR_UNKNOWN;
+            }
+
+            status = mxlFabricsInitiatorSessionMakeProgressNonBlocking(_initiator);
+        }
+        while (status == MXL_ERR_NOT_READY);
+
+        return status;
+    }
+
+    mxlStatus run()
+    {
+        auto posted = std::uint64_t{0};
+        auto received = std::uint64_t{0};
+        auto grainIndex = std::uint64_t{0};
+        mxlSessionGrain grain;
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const end = start + _config.duration;
+        while (!g_exit_requested && (std::chrono::steady_clock::now() < end))
+        {
+            // Post as many writes as the initiator accepts.
+            for (;;)
+            {
+                auto& header = *reinterpret_cast<mxlGrainInfo*>(_initiatorBuffer.data() + (grainIndex % _config.grains) * _grainSize);
+                header.index = grainIndex;
+                header.grainSize = static_cast<std::uint32_t>(_config.payloadSize);
+                header.totalSlices = static_cast<std::uint16_t>(_config.slices);
+                header.validSlices = static_cast<std::uint16_t>(_config.slices);
+
+                auto status = mxlFabricsInitiatorSessionTransferGrain(_initiator, _flowId, grainIndex);
+                if (status == MXL_ERR_NOT_READY)
+                {
+                    break;
+                }
+                if (status != MXL_STATUS_OK)
+                {
+                    MXL_ERROR("Failed to transfer grain with status '{}'", static_cast<int>(status));
+                    return status;
+                }
+                ++grainIndex;
+                ++posted;
+            }
+
+            if (auto status = mxlFabricsInitiatorSessionMakeProgressNonBlocking(_initiator);
+                (status != MXL_STATUS_OK) && (status != MXL_ERR_NOT_READY))
+            {
+                MXL_ERROR("Failed to make progress with status '{}'", static_cast<int>(status));
+                return status;
+            }
+
+            while (mxlFabricsTargetSessionTryNewGrain(_target, &grain) == MXL_STATUS_OK)
+            {
+                // Received grains are consumed immediately, which grants the initiator credits with flow control.
+                mxlFabricsTargetSessionReleaseGrains(_target, grain.flowId, grain.index);
+                ++received;
+            }
+        }
+
+        auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        MXL_INFO("Posted {} grains of {} bytes, received {} completions in {:.2f} s: {:.0f} completions/s, {:.2f} Gbit/s",
+            posted,
+            _grainSize,
+            received,
+            elapsed,
+            static_cast<double>(received) / elapsed,
+            static_cast<double>(received * _grainSize) * 8.0 / elapsed / 1e9);
+
+        if (_config.supervision.enabled)
+        {
+            mxlFabricsLinkStatus link;
+            if (auto status = mxlFabricsInitiatorSessionGetLinkStatus(_initiator, _targetInfo, &link); status == MXL_STATUS_OK)
+            {
+                MXL_INFO("The link to the target had {} outages, {:.1f} ms in total", link.outages, static_cast<double>(link.totalOutageNs) / 1e6);
+            }
+        }
+
+        if (_config.pacing.grainRate.numerator != 0)
+        {
+            mxlFlowPacingStats pacing;
+            if (auto status = mxlFabricsInitiatorSessionGetFlowPacingStats(_initiator, _flowId, &pacing); status == MXL_STATUS_OK)
+            {
+                MXL_INFO("Paced {} grains in {} bursts, {} late, of {} bytes at most: {:.2f} Gbit/s while a grain is sent",
+                    pacing.grains,
+                    pacing.bursts,
+                    pacing.lateBursts,
+                    pacing.maxBurstBytes,
+                    static_cast<double>(pacing.achievedRate) * 8.0 / 1e9);
+            }
+        }
+
+        return MXL_STATUS_OK;
+    }
+
+private:
+    template<typename F>
+    mxlStatus addFlow(std::vector<std::uint8_t>& buffer, F&& add)
+    {
+        auto grains = std::vector<mxlFabricsMemoryRegion>{};
+        for (auto i = std::uint32_t{0}; i < _config.grains; ++i)
+        {
+            grains.push_back({
+                .addr = reinterpret_cast<std::uintptr_t>(buffer.data() + i * _grainSize),
+                .size = _grainSize,
+                .loc = {.type = MXL_PAYLOAD_LOCATION_HOST_MEMORY, .deviceId = 0},
+            });
+        }
+
+        mxlRegions regions;
+        auto status = mxlFabricsRegionsFromUserBuffers(grains.data(), grains.size(), &regions);
+        if (status != MXL_STATUS_OK)
+        {
+            return status;
+        }
+
+        status = add(regions);
+        mxlFabricsRegionsFree(regions);
+        return status;
+    }
+
+private:
+    BenchmarkConfig _config;
+    std::size_t _grainSize;
+    std::vector<std::uint8_t> _targetBuffer;
+    std::vector<std::uint8_t> _initiatorBuffer;
+
+    mxlInstance _instance{nullptr};
+    mxlFabricsInstance _fabricsInstance{nullptr};
+    mxlFabricsTargetSession _target{nullptr};
+    mxlFabricsInitiatorSession _initiator{nullptr};
+    mxlTargetInfo _targetInfo{nullptr};
+    std::uint16_t _targetFlowId{0};
+    std::uint16_t _flowId{0};
+};
+
+int main(int argc, char** argv)
+{
+    std::signal(SIGINT, &signal_handler);
+    std::signal(SIGTERM, &signal_handler);
+
+    CLI::App app("mxl-fabrics-bench");
+
+    std::string domain;
+    auto domainOpt = app.add_option("-d,--domain", domain, "The MXL domain directory");
+    domainOpt->required(true);
+    domainOpt->check(CLI::ExistingDirectory);
+
+    std::optional<std::string> node;
+    auto nodeOpt = app.add_option("-n,--node",
+        node,
+        "This corresponds to the interface identifier of the fabrics endpoint of the target, it can also be a logical address. This can be seen "
+        "as the bind address when using sockets.");
+    nodeOpt->default_val(std::nullopt);
+
+    std::optional<std::string> service;
+    auto serviceOpt = app.add_option("--service",
+        service,
+        "This corresponds to a service identifier for the fabrics endpoint of the target. This can be seen as the bind port when using sockets.");
+    serviceOpt->default_val(std::nullopt);
+
+    std::string provider;
+    auto providerOpt = app.add_option("-p,--provider", provider, "The fabrics provider. One of (tcp, verbs or efa). Default is 'tcp'.");
+    providerOpt->default_val("tcp");
+
+    std::uint32_t benchmarkDuration;
+    auto benchmarkDurationOpt = app.add_option("--duration", benchmarkDuration, "Duration of the benchmark in seconds.");
+    benchmarkDurationOpt->default_val(10);
+
+    std::uint32_t benchmarkGrains;
+    auto benchmarkGrainsOpt = app.add_option("--grains", benchmarkGrains, "Number of grains of the benchmark flow.");
+    benchmarkGrainsOpt->default_val(64);
+    benchmarkGrainsOpt->check(CLI::Range(1, 1024));
+
+    std::size_t benchmarkPayloadSize;
+    auto benchmarkPayloadSizeOpt = app.add_option("--payload-size", benchmarkPayloadSize, "Payload size of the benchmark grains in bytes.");
+    benchmarkPayloadSizeOpt->default_val(0);
+
+    std::uint32_t benchmarkSlices;
+    auto benchmarkSlicesOpt = app.add_option("--slices", benchmarkSlices, "Number of slices of the benchmark grains, it divides the payload size.");
+    benchmarkSlicesOpt->default_val(1);
+    benchmarkSlicesOpt->check(CLI::Range(1, 65535));
+
+    std::uint32_t cqDepth;
+    auto cqDepthOpt = app.add_option("--cq-depth", cqDepth, "Depth of the completion queues of the sessions. 0 selects the provider default.");
+    cqDepthOpt->default_val(0);
+
+    std::uint32_t cqBatch;
+    auto cqBatchOpt = app.add_option("--cq-batch", cqBatch, "Maximum number of completions read at once. 0 selects the default (64).");
+    cqBatchOpt->default_val(0);
+
+    std::string cqWait;
+    auto cqWaitOpt = app.add_option("--cq-wait", cqWait, "Wait object of the completion queues. One of (default, none, fd or yield).");
+    cqWaitOpt->default_val("default");
+
+    std::optional<std::uint32_t> cqCpu;
+    auto cqCpuOpt = app.add_option("--cq-cpu", cqCpu, "CPU core the interrupts of the completion queues should target. Default is not to pin.");
+    cqCpuOpt->default_val(std::nullopt);
+
+    std::string endpointType;
+    auto endpointTypeOpt = app.add_option("--endpoint-type", endpointType, "Type of the endpoints of the sessions. One of (connected or rdm).");
+    endpointTypeOpt->default_val("connected");
+
+    std::uint32_t rails;
+    auto railsOpt = app.add_option("--rails", rails, "Number of rails of the sessions, the grains are striped across all of them.");
+    railsOpt->default_val(1);
+    railsOpt->check(CLI::Range(1, MXL_FABRICS_SESSION_MAX_RAILS));
+
+    std::uint32_t creditWindow;
+    auto creditWindowOpt = app.add_option("--credit-window", creditWindow, "Flow control window of the initiator in grains. 0 disables it.");
+    creditWindowOpt->default_val(0);
+
+    bool reconnect;
+    auto reconnectOpt = app.add_flag("--reconnect", reconnect, "Re-establish the link of the initiator to the target when it fails.");
+    reconnectOpt->default_val(false);
+
+    std::uint32_t catchUp;
+    auto catchUpOpt = app.add_option("--catch-up", catchUp, "Newest grains written again once a link is restored, with --reconnect.");
+    catchUpOpt->default_val(0);
+
+    std::uint32_t paceRate;
+    auto paceRateOpt = app.add_option("--pace-rate", paceRate, "Grain rate of the paced benchmark flow per second. 0 disables pacing.");
+    paceRateOpt->default_val(0);
+
+    std::uint32_t pacePercent;
+    auto pacePercentOpt = app.add_option("--pace-percent", pacePercent, "Share of the grain period the bursts of a paced grain are spread over.");
+    pacePercentOpt->default_val(90);
+    pacePercentOpt->check(CLI::Range(1, 100));
+
+    mxl::tools::RealtimeOptions realtimeOptions;
+    mxl::tools::addRealtimeOptions(app, realtimeOptions);
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (!mxl::tools::applyProcessRealtimeOptions(realtimeOptions))
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+
+    mxlFabricsProvider mxlProvider;
+    auto status = mxlFabricsProviderFromString(provider.c_str(), &mxlProvider);
+    if (status != MXL_STATUS_OK)
+    {
+        MXL_ERROR("Failed to parse provider '{}'", provider);
+        return status;
+    }
+
+    auto const waitObjects = std::map<std::string, mxlFabricsWaitObject>{
+        {"default", MXL_FABRICS_WAIT_OBJECT_DEFAULT},
+        {"none",    MXL_FABRICS_WAIT_OBJECT_NONE   },
+        {"fd",      MXL_FABRICS_WAIT_OBJECT_FD     },
+        {"yield",   MXL_FABRICS_WAIT_OBJECT_YIELD  },
+    };
+    auto const waitObject = waitObjects.find(cqWait);
+    if (waitObject == waitObjects.end())
+    {
+        MXL_ERROR("Failed to parse wait object '{}'", cqWait);
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    auto const endpointTypes = std::map<std::string, mxlFabricsEndpointType>{
+        {"connected", MXL_FABRICS_ENDPOINT_TYPE_CONNECTED        },
+        {"rdm",       MXL_FABRICS_ENDPOINT_TYPE_RELIABLE_DATAGRAM},
+    };
+    auto const endpointTypeValue = endpointTypes.find(endpointType);
+    if (endpointTypeValue == endpointTypes.end())
+    {
+        MXL_ERROR("Failed to parse endpoint type '{}'", endpointType);
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    if ((benchmarkPayloadSize % benchmarkSlices) != 0)
+    {
+        MXL_ERROR("The payload size {} can't be divided in {} slices", benchmarkPayloadSize, benchmarkSlices);
+        return MXL_ERR_INVALID_ARG;
+    }
+
+    auto const completionQueue = mxlCompletionQueueConfig{
+        .depth = cqDepth,
+        .batchSize = cqBatch,
+        .waitObject = waitObject->second,
+        .pinInterrupts = cqCpu.has_value(),
+        .signalingVector = cqCpu.value_or(0),
+    };
+
+    auto benchmark = AppBenchmark{
+        BenchmarkConfig{
+                        .node = node,
+                        .service = service,
+                        .provider = mxlProvider,
+                        .endpointType = endpointTypeValue->second,
+                        .rails = rails,
+                        .creditWindow = creditWindow,
+                        .supervision = {.enabled = reconnect, .retryIntervalMs = 0, .catchUpGrains = catchUp},
+                        .pacing = {.grainRate = {.numerator = paceRate, .denominator = 1}, .activePercent = pacePercent, .slicesPerBurst = 0},
+                        .completionQueue = completionQueue,
+                        .grains = benchmarkGrains,
+                        .payloadSize = benchmarkPayloadSize,
+                        .slices = benchmarkSlices,
+                        .duration = std::chrono::seconds{benchmarkDuration},
+                        },
+    };
+
+    if (status = benchmark.setup(domain); status != MXL_STATUS_OK)
+    {
+        MXL_ERROR("Failed to setup the benchmark with status '{}'", static_cast<int>(status));
+        return status;
+    }
+
+    if (!mxl::tools::applyThreadRealtimeOptions(realtimeOptions, 0))
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+
+    if (status = benchmark.run(); status != MXL_STATUS_OK)
+    {
+        MXL_ERROR("Failed to run the benchmark with status '{}'", static_cast<int>(status));
+        return status;
+    }
+
+    return MXL_STATUS_OK;
+}
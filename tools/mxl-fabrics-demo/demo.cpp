@@ -10,6 +10,7 @@
 #include <uuid.h>
 #include <sys/types.h>
 #include <CLI/CLI.hpp>
+#include <mxl-internal/Base64.hpp>
 #include <mxl-internal/FlowParser.hpp>
 #include <mxl-internal/Logging.hpp>
 #include <mxl/fabrics.h>
@@ -17,7 +18,7 @@
 #include <mxl/mxl.h>
 #include <mxl/time.h>
 #include "CLI/CLI.hpp"
-#include "../../lib/fabrics/ofi/src/internal/Base64.hpp"
+#include "RealtimeOptions.hpp"
 
 /*
     Example how to use:
@@ -567,8 +568,16 @@ int main(int argc, char** argv)
         "The target information. This is used when configured as an initiator . This is the target information to send to."
         "You first start the target and it will print the targetInfo that you paste to this argument");
 
+    mxl::tools::RealtimeOptions realtimeOptions;
+    mxl::tools::addRealtimeOptions(app, realtimeOptions);
+
     CLI11_PARSE(app, argc, argv);
 
+    if (!mxl::tools::applyProcessRealtimeOptions(realtimeOptions))
+    {
+        return MXL_ERR_UNKNOWN;
+    }
+
     mxlFabricsProvider mxlProvider;
     auto status = mxlFabricsProviderFromString(provider.c_str(), &mxlProvider);
     if (status != MXL_STATUS_OK)
@@ -597,6 +606,12 @@ int main(int argc, char** argv)
             return status;
         }
 
+        // Applied after setup, so that the threads started by the fabrics provider don't inherit the settings of the MXL loop.
+        if (!mxl::tools::applyThreadRealtimeOptions(realtimeOptions, 0))
+        {
+            return MXL_ERR_UNKNOWN;
+        }
+
         if (status = app.run(); status != MXL_STATUS_OK)
         {
             MXL_ERROR("Failed to run initiator with status '{}'", static_cast<int>(status));
@@ -640,6 +655,12 @@ int main(int argc, char** argv)
             return status;
         }
 
+        // Applied after setup, so that the threads started by the fabrics provider don't inherit the settings of the MXL loop.
+        if (!mxl::tools::applyThreadRealtimeOptions(realtimeOptions, 0))
+        {
+            return MXL_ERR_UNKNOWN;
+        }
+
         if (status = app.run(); status != MXL_STATUS_OK)
         {
             MXL_ERROR("Failed to run target with status '{}'", static_cast<int>(status));
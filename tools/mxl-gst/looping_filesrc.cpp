@@ -18,6 +18,7 @@
 #include <mxl/mxl.h>
 #include <mxl/time.h>
 #include "mxl-internal/Logging.hpp"
+#include "RealtimeOptions.hpp"
 
 namespace fs = std::filesystem;
 
@@ -37,8 +38,9 @@ void signal_handler(int in_signal)
 class LoopingFilePlayer
 {
 public:
-    LoopingFilePlayer(std::string in_domain)
+    LoopingFilePlayer(std::string in_domain, mxl::tools::RealtimeOptions in_realtimeOptions)
         : domain(std::move(in_domain))
+        , realtimeOptions(std::move(in_realtimeOptions))
     {
         // Create the MXL domain directory if it doesn't exist
         if (!fs::exists(domain))
@@ -347,6 +349,12 @@ private:
 
     void videoThread()
     {
+        if (!mxl::tools::applyThreadRealtimeOptions(realtimeOptions, 0))
+        {
+            running = false;
+            return;
+        }
+
         while (running)
         {
             auto sample = gst_app_sink_try_pull_sample(GST_APP_SINK(appSinkVideo), 100'000'000);
@@ -424,6 +432,8 @@ private:
     std::unique_ptr<std::thread> videoThreadPtr;
     // The MXL domain
     std::string domain;
+    // Scheduling settings of the video processing thread
+    mxl::tools::RealtimeOptions realtimeOptions;
     // Video flow writer allocated by the MXL instance
     ::mxlFlowWriter flowWriterVideo = nullptr;
     // The MXL instance
@@ -461,8 +471,16 @@ int main(int argc, char* argv[])
     inputOpt->required(true);
     inputOpt->check(CLI::ExistingFile);
 
+    mxl::tools::RealtimeOptions realtimeOptions;
+    mxl::tools::addRealtimeOptions(cli, realtimeOptions);
+
     CLI11_PARSE(cli, argc, argv);
 
+    if (!mxl::tools::applyProcessRealtimeOptions(realtimeOptions))
+    {
+        return -1;
+    }
+
     //
     // Initialize GStreamer
     //
@@ -475,7 +493,7 @@ int main(int argc, char* argv[])
     //
     // Create the Player and open the input uri
     //
-    auto player = std::make_unique<LoopingFilePlayer>(domain);
+    auto player = std::make_unique<LoopingFilePlayer>(domain, realtimeOptions);
     if (!player->open(inputFile))
     {
         MXL_ERROR("Failed to open input file: {}", inputFile);
@@ -25,6 +25,7 @@
 #include "mxl-internal/FlowParser.hpp"
 #include "mxl-internal/Logging.hpp"
 #include "mxl-internal/PathUtils.hpp"
+#include "RealtimeOptions.hpp"
 
 #ifdef __APPLE__
 #   include <TargetConditionals.h>
@@ -351,10 +352,17 @@ namespace
             }
         }
 
-        int run(GstreamerPipeline& gstPipeline, std::int64_t readDelay, bool timeoutMode)
+        int run(GstreamerPipeline& gstPipeline, std::int64_t readDelay, bool timeoutMode, mxl::tools::RealtimeOptions const& realtimeOptions,
+            std::size_t loopIndex)
         {
             gstPipeline.start();
 
+            // Only tune the MXL loop once the pipeline started, so that the GStreamer threads don't inherit its settings.
+            if (!mxl::tools::applyThreadRealtimeOptions(realtimeOptions, loopIndex))
+            {
+                return EXIT_FAILURE;
+            }
+
             if (mxlIsDiscreteDataFormat(_flowInfo.config.common.format))
             {
                 return runDiscreteFlow(dynamic_cast<GstreamerVideoPipeline&>(gstPipeline), readDelay, timeoutMode);
@@ -405,15 +413,17 @@ namespace
                 if (ret == MXL_ERR_OUT_OF_RANGE_TOO_EARLY)
                 {
                     // We are too early somehow, keep trying the same grain index
-                    mxlFlowReaderGetInfo(_reader, &_flowInfo);
-                    MXL_WARN("Failed to get samples at index {}: TOO EARLY. Last published {}", requestedIndex, _flowInfo.runtime.headIndex);
+                    auto headIndex = std::uint64_t{MXL_UNDEFINED_INDEX};
+                    mxlFlowReaderGetHeadIndex(_reader, &headIndex);
+                    MXL_WARN("Failed to get samples at index {}: TOO EARLY. Last published {}", requestedIndex, headIndex);
 
                     continue;
                 }
                 else if (ret == MXL_ERR_OUT_OF_RANGE_TOO_LATE)
                 {
-                    mxlFlowReaderGetInfo(_reader, &_flowInfo);
-                    MXL_WARN("Failed to get grain at index {}: TOO LATE. Last published {}", requestedIndex, _flowInfo.runtime.headIndex);
+                    auto headIndex = std::uint64_t{MXL_UNDEFINED_INDEX};
+                    mxlFlowReaderGetHeadIndex(_reader, &headIndex);
+                    MXL_WARN("Failed to get grain at index {}: TOO LATE. Last published {}", requestedIndex, headIndex);
 
                     // Grain expired. Realign to current index. GStreamer repeats the last valid frame for missing data; consuming applications
                     // should do the same.
@@ -483,16 +493,18 @@ namespace
                 if (ret == MXL_ERR_OUT_OF_RANGE_TOO_EARLY)
                 {
                     // We are too early somehow, keep trying the same index
-                    mxlFlowReaderGetInfo(_reader, &_flowInfo);
-                    MXL_WARN("Failed to get samples at index {}: TOO EARLY. Last published {}", requestedIndex, _flowInfo.runtime.headIndex);
+                    auto headIndex = std::uint64_t{MXL_UNDEFINED_INDEX};
+                    mxlFlowReaderGetHeadIndex(_reader, &headIndex);
+                    MXL_WARN("Failed to get samples at index {}: TOO EARLY. Last published {}", requestedIndex, headIndex);
                     continue;
                 }
                 else if (ret == MXL_ERR_OUT_OF_RANGE_TOO_LATE)
                 {
                     // Samples expired. Realign to current index. GStreamer will generate silence for missing samples. Consuming applications
                     // should handle this better by inserting silence with a micro fades to prevent clicks and pops.
-                    mxlFlowReaderGetInfo(_reader, &_flowInfo);
-                    MXL_WARN("Failed to get samples at index {}: TOO LATE. Last published {}", requestedIndex, _flowInfo.runtime.headIndex);
+                    auto headIndex = std::uint64_t{MXL_UNDEFINED_INDEX};
+                    mxlFlowReaderGetHeadIndex(_reader, &headIndex);
+                    MXL_WARN("Failed to get samples at index {}: TOO LATE. Last published {}", requestedIndex, headIndex);
 
                     index = mxlGetCurrentIndex(&rate);
                     continue;
@@ -654,8 +666,16 @@ namespace
             "this mode and --video-offset is used for both the timeout value and playback offset.");
         timeoutModeOpt->default_val(false);
 
+        mxl::tools::RealtimeOptions realtimeOptions;
+        mxl::tools::addRealtimeOptions(app, realtimeOptions);
+
         CLI11_PARSE(app, argc, argv);
 
+        if (!mxl::tools::applyProcessRealtimeOptions(realtimeOptions))
+        {
+            return EXIT_FAILURE;
+        }
+
         gst_init(nullptr, nullptr);
 
         std::vector<std::thread> threads;
@@ -683,7 +703,7 @@ namespace
                     };
 
                     auto pipeline = GstreamerVideoPipeline(videoConfig);
-                    reader.run(pipeline, videoReadDelay, timeoutMode);
+                    reader.run(pipeline, videoReadDelay, timeoutMode, realtimeOptions, 0);
 
                     MXL_INFO("Video pipeline finished");
                     return 0;
@@ -708,7 +728,7 @@ namespace
                     };
 
                     auto pipeline = GstreamerAudioPipeline(audioConfig);
-                    reader.run(pipeline, audioReadDelay, false);
+                    reader.run(pipeline, audioReadDelay, false, realtimeOptions, 1);
 
                     MXL_INFO("Audio pipeline finished");
                     return 0;
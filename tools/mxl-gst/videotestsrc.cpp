@@ -3,6 +3,7 @@
 
 #include <chrono>
 #include <csignal>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <uuid.h>
@@ -16,6 +17,7 @@
 #include "mxl-internal/FlowOptionsParser.hpp"
 #include "mxl-internal/FlowParser.hpp"
 #include "mxl-internal/Logging.hpp"
+#include "RealtimeOptions.hpp"
 
 std::sig_atomic_t volatile g_exit_requested = 0;
 
@@ -422,10 +424,16 @@ public:
         return _configInfo.common.maxCommitBatchSizeHint;
     }
 
-    int run(GstreamerPipeline& gst_pipeline, std::int64_t offset)
+    int run(GstreamerPipeline& gst_pipeline, std::int64_t offset, mxl::tools::RealtimeOptions const& realtimeOptions, std::size_t loopIndex)
     {
         gst_pipeline.start();
 
+        // Only tune the MXL loop once the pipeline started, so that the GStreamer threads don't inherit its settings.
+        if (!mxl::tools::applyThreadRealtimeOptions(realtimeOptions, loopIndex))
+        {
+            return EXIT_FAILURE;
+        }
+
         if (mxlIsDiscreteDataFormat(_configInfo.common.format))
         {
             return runDiscreteFlow(dynamic_cast<VideoPipeline&>(gst_pipeline), offset);
@@ -749,8 +757,16 @@ int main(int argc, char** argv)
     auto textOverlayOpt = app.add_option("-t,--overlay-text", textOverlay, "Change the text overlay of the test source");
     textOverlayOpt->default_val("EBU DMF MXL");
 
+    mxl::tools::RealtimeOptions realtimeOptions;
+    mxl::tools::addRealtimeOptions(app, realtimeOptions);
+
     CLI11_PARSE(app, argc, argv);
 
+    if (!mxl::tools::applyProcessRealtimeOptions(realtimeOptions))
+    {
+        return EXIT_FAILURE;
+    }
+
     gst_init(nullptr, nullptr);
 
     std::vector<std::thread> threads;
@@ -807,7 +823,7 @@ int main(int argc, char** argv)
 
                 VideoPipeline gst_pipeline(gst_config);
 
-                mxlWriter.run(gst_pipeline, videoOffset);
+                mxlWriter.run(gst_pipeline, videoOffset, realtimeOptions, 0);
 
                 MXL_INFO("Video pipeline finished");
                 return 0;
@@ -851,7 +867,7 @@ int main(int argc, char** argv)
 
                 AudioPipeline gst_pipeline(gst_config);
 
-                mxlWriter.run(gst_pipeline, audioOffset);
+                mxlWriter.run(gst_pipeline, audioOffset, realtimeOptions, 1);
 
                 MXL_INFO("Audio pipeline finished");
                 return 0;
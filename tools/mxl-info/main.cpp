@@ -3,11 +3,14 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <unistd.h>
 #include <uuid.h>
 #include <sys/file.h>
@@ -19,7 +22,10 @@
 #include <mxl/flow.h>
 #include <mxl/mxl.h>
 #include <mxl/time.h>
+#include "mxl-internal/FabricsStats.hpp"
 #include "mxl-internal/PathUtils.hpp"
+#include "mxl-internal/Probe.hpp"
+#include "mxl-internal/SharedMemory.hpp"
 
 namespace
 {
@@ -187,6 +193,143 @@ namespace
         return EXIT_SUCCESS;
     }
 
+    // Print the latest results of mxl-probe for a flow, if the flow is being probed.
+    void printProbeStats(std::string const& in_domain, std::string const& in_id)
+    {
+        auto const path = mxl::lib::makeFlowProbeFilePath(mxl::lib::makeFlowDirectoryName(in_domain, in_id));
+        if (!exists(path))
+        {
+            return;
+        }
+
+        auto values = mxl::lib::ProbeValues{};
+        try
+        {
+            auto const stats = mxl::lib::SharedMemoryInstance<mxl::lib::ProbeStats>{path.string().c_str(), mxl::lib::AccessMode::READ_ONLY, 0U};
+            if (!mxl::lib::readProbeStats(*stats.get(), values) || (values.version != mxl::lib::PROBE_STATS_VERSION))
+            {
+                return;
+            }
+        }
+        catch (std::exception const&)
+        {
+            return;
+        }
+
+        auto flags = std::string{};
+        for (auto const& [flag, name] : {std::pair{mxl::lib::PROBE_FLAG_BLACK, "black"},
+                 std::pair{mxl::lib::PROBE_FLAG_FROZEN, "frozen"},
+                 std::pair{mxl::lib::PROBE_FLAG_SILENT, "silent"}})
+        {
+            if ((values.flags & flag) != 0U)
+            {
+                flags += flags.empty() ? name : fmt::format(", {}", name);
+            }
+        }
+
+        std::cout << '\t' << fmt::format("{: >18}: {}", "Probe index", values.index) << std::endl;
+        std::cout << '\t' << fmt::format("{: >18}: {}", "Probe age (ms)", (mxlGetTime() - values.updateTime) / 1'000'000U) << std::endl;
+        std::cout << '\t' << fmt::format("{: >18}: {}", "Probe alarms", flags.empty() ? "none" : flags) << std::endl;
+        if (values.channelCount == 0U)
+        {
+            std::cout << '\t' << fmt::format("{: >18}: {:.1f}", "Average luma", values.averageLuma) << std::endl;
+            std::cout << '\t' << fmt::format("{: >18}: {:.1f}%", "Black samples", 100.0f * values.blackRatio) << std::endl;
+            std::cout << '\t' << fmt::format("{: >18}: {:.2f}", "Picture change", values.difference) << std::endl;
+            std::cout << '\t' << fmt::format("{: >18}: {}", "Black grains", values.blackGrains) << std::endl;
+            std::cout << '\t' << fmt::format("{: >18}: {}", "Frozen grains", values.frozenGrains) << std::endl;
+        }
+        else
+        {
+            for (auto channel = std::uint32_t{0}; channel < std::min<std::uint32_t>(values.channelCount, mxl::lib::PROBE_MAX_CHANNELS); ++channel)
+            {
+                std::cout << '\t'
+                          << fmt::format("{: >18}: {:.1f} dBFS RMS, {:.1f} dBFS peak, {:.1f} dBTP",
+                                 fmt::format("Channel {}", channel),
+                                 values.rms[channel],
+                                 values.peak[channel],
+                                 values.truePeak[channel])
+                          << std::endl;
+            }
+            std::cout << '\t' << fmt::format("{: >18}: {:.1f} LUFS", "Momentary", values.momentaryLoudness) << std::endl;
+            std::cout << '\t' << fmt::format("{: >18}: {:.1f} LUFS", "Short-term", values.shortTermLoudness) << std::endl;
+            std::cout << '\t' << fmt::format("{: >18}: {}", "Silent samples", values.silentSamples) << std::endl;
+        }
+    }
+
+    // Print the counters of the fabrics link a flow is transferred over, if an application publishes them.
+    void printFabricsStats(std::string const& in_domain, std::string const& in_id)
+    {
+        auto const path = mxl::lib::makeFlowFabricsFilePath(mxl::lib::makeFlowDirectoryName(in_domain, in_id));
+        if (!exists(path))
+        {
+            return;
+        }
+
+        auto values = mxl::lib::FabricsValues{};
+        try
+        {
+            auto const stats = mxl::lib::SharedMemoryInstance<mxl::lib::FabricsStats>{path.string().c_str(), mxl::lib::AccessMode::READ_ONLY, 0U};
+            if (!mxl::lib::readFabricsStats(*stats.get(), values) || (values.version != mxl::lib::FABRICS_STATS_VERSION))
+            {
+                return;
+            }
+        }
+        catch (std::exception const&)
+        {
+            return;
+        }
+        values.peer[mxl::lib::FABRICS_MAX_PEER_SIZE - 1U] = '\0';
+
+        auto const sender = (values.role == mxl::lib::FABRICS_ROLE_SENDER);
+        auto const peer = (values.peer[0] != '\0') ? values.peer : "unknown peer";
+        std::cout << '\t' << fmt::format("{: >18}: {} {}", "Fabrics link", sender ? "to" : "from", peer) << std::endl;
+        std::cout << '\t' << fmt::format("{: >18}: {}", "Fabrics age (ms)", (mxlGetTime() - values.updateTime) / 1'000'000U) << std::endl;
+        if (sender)
+        {
+            // The values of mxlFabricsLinkState.
+            constexpr char const* states[] = {"connecting", "up", "recovering", "down", "stale"};
+            auto const state = (values.linkState < std::size(states)) ? states[values.linkState] : "unknown";
+            std::cout << '\t' << fmt::format("{: >18}: {}", "Link state", state) << std::endl;
+        }
+        std::cout << '\t' << fmt::format("{: >18}: {} failures, {} reconnects", "Link outages", values.linkFailures, values.reconnects) << std::endl;
+        std::cout << '\t' << fmt::format("{: >18}: {} grains, {} bytes, {} writes", "Transferred", values.grains, values.bytes, values.writes)
+                  << std::endl;
+        std::cout << '\t' << fmt::format("{: >18}: {} (max {})", "In flight", values.inFlight, values.maxInFlight) << std::endl;
+
+        auto completed = std::uint64_t{0};
+        for (auto const count : values.latencyHistogram)
+        {
+            completed += count;
+        }
+        if (completed != 0U)
+        {
+            // The latency under which 99% of the writes completed, rounded up to the bound of its bucket. The last bucket has no bound.
+            auto bucket = std::size_t{0};
+            for (auto seen = values.latencyHistogram[0]; (seen * 100U < completed * 99U) && (bucket + 1U < mxl::lib::FABRICS_LATENCY_BUCKETS);)
+            {
+                seen += values.latencyHistogram[++bucket];
+            }
+            std::cout << '\t'
+                      << fmt::format("{: >18}: {:.1f} mean, {:.1f} max, p99 {} {}",
+                             "Latency (us)",
+                             static_cast<double>(values.totalLatencyNs) / static_cast<double>(completed) / 1e3,
+                             static_cast<double>(values.maxLatencyNs) / 1e3,
+                             (bucket + 1U < mxl::lib::FABRICS_LATENCY_BUCKETS) ? "<" : ">",
+                             std::uint64_t{1} << std::min(bucket, mxl::lib::FABRICS_LATENCY_BUCKETS - 2U))
+                      << std::endl;
+        }
+
+        auto codes = std::string{};
+        for (auto i = std::size_t{0}; i < mxl::lib::FABRICS_MAX_ERROR_CODES; ++i)
+        {
+            if (values.errorCounts[i] != 0U)
+            {
+                codes += fmt::format(", fi_errno {}: {}", values.errorCodes[i], values.errorCounts[i]);
+            }
+        }
+        std::cout << '\t' << fmt::format("{: >18}: {}{}", "Errors", values.errors, codes) << std::endl;
+    }
+
     int printFlow(std::string const& in_domain, std::string const& in_id)
     {
         int ret = EXIT_SUCCESS;
@@ -233,6 +376,9 @@ namespace
                 std::cout << '\t' << fmt::format("{: >18}: {}", "Active", active) << std::endl;
             }
 
+            printProbeStats(in_domain, in_id);
+            printFabricsStats(in_domain, in_id);
+
             ret = EXIT_SUCCESS;
         }
 
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Compositor.hpp"
+#include <cstring>
+#include <algorithm>
+#include <latch>
+#include <stdexcept>
+
+namespace mxl::tools
+{
+    namespace
+    {
+        /** Number of pixels in a v210 block. */
+        constexpr auto const V210_BLOCK_PIXELS = std::size_t{6};
+
+        /** Size in bytes of a v210 block. */
+        constexpr auto const V210_BLOCK_SIZE = std::size_t{16};
+
+        /** Mask of the band in Compositor::_work. */
+        constexpr auto const BAND_MASK = std::uint64_t{0xFFFF'FFFF};
+
+        /** Paint a number of v210 blocks of a line black (video range). */
+        void paintBlack(std::uint8_t* out_line, std::size_t in_blocks) noexcept
+        {
+            // Cb Y Cr | Y Cb Y | Cr Y Cb | Y Cr Y
+            constexpr auto chromaFirst = std::uint32_t{512U | (64U << 10) | (512U << 20)};
+            constexpr auto lumaFirst = std::uint32_t{64U | (512U << 10) | (64U << 20)};
+            constexpr std::uint32_t const block[4] = {chromaFirst, lumaFirst, chromaFirst, lumaFirst};
+
+            for (auto i = std::size_t{0}; i < in_blocks; ++i)
+            {
+                std::memcpy(out_line + i * V210_BLOCK_SIZE, block, sizeof block);
+            }
+        }
+    }
+
+    Compositor::Compositor(std::size_t in_width, std::size_t in_height, std::size_t in_columns, std::size_t in_rows, std::size_t in_threads,
+        std::size_t in_bandHeight, std::function<void(std::size_t)> const& in_onWorkerStart)
+        : _width{in_width}
+        , _height{in_height}
+        , _columns{in_columns}
+        , _rows{in_rows}
+        , _tileWidth{(in_columns > 0U) ? (in_width / in_columns / V210_BLOCK_PIXELS * V210_BLOCK_PIXELS) : 0U}
+        , _tileHeight{(in_rows > 0U) ? (in_height / in_rows) : 0U}
+        , _bandHeight{std::max<std::size_t>(in_bandHeight, 1U)}
+        , _bandCount{(in_height + _bandHeight - 1U) / _bandHeight}
+        , _tiles(in_columns * in_rows)
+        , _picture{nullptr}
+        , _stride{0}
+        , _generation{0}
+        , _stopping{false}
+        , _work{0}
+        , _completed{std::make_unique<std::atomic<std::uint64_t>[]>(_bandCount)}
+    {
+        // Tiles start and end on v210 blocks, so that workers never write to the same block.
+        if ((_tileWidth == 0U) || (_tileHeight == 0U))
+        {
+            throw std::invalid_argument{"The multiviewer tiles must be at least 6 pixels wide and 1 line high."};
+        }
+
+        auto const threads = std::max<std::size_t>(in_threads, 1U);
+        auto started = std::latch{static_cast<std::ptrdiff_t>(threads)};
+        for (auto i = std::size_t{0}; i < threads; ++i)
+        {
+            _workers.emplace_back(
+                [this, i, &started, &in_onWorkerStart]()
+                {
+                    if (in_onWorkerStart)
+                    {
+                        in_onWorkerStart(i);
+                    }
+                    started.count_down();
+                    runWorker();
+                });
+        }
+        started.wait();
+    }
+
+    Compositor::~Compositor()
+    {
+        {
+            auto const lock = std::lock_guard{_mutex};
+            _stopping = true;
+        }
+        _wakeUp.notify_all();
+
+        for (auto& worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    void Compositor::setSource(std::size_t in_tile, Source const& in_source)
+    {
+        auto& tile = _tiles.at(in_tile);
+        if ((in_source.payload != nullptr) &&
+            (!tile.scaler || (tile.scaler->sourceWidth() != in_source.width) || (tile.scaler->sourceHeight() != in_source.height)))
+        {
+            // Show a black tile rather than a stale picture if the new one can't be scaled.
+            tile.source = Source{};
+            tile.scaler.emplace(in_source.width, in_source.height, _tileWidth, _tileHeight);
+        }
+        tile.source = in_source;
+    }
+
+    void Compositor::composite(std::uint8_t* out_picture, std::size_t in_stride, std::function<void(std::size_t)> const& in_onLinesComplete)
+    {
+        auto generation = std::uint64_t{};
+        {
+            auto const lock = std::lock_guard{_mutex};
+            _picture = out_picture;
+            _stride = in_stride;
+            generation = ++_generation;
+            _work.store(generation << 32, std::memory_order_release);
+        }
+        _wakeUp.notify_all();
+
+        for (auto band = std::size_t{0}; band < _bandCount; ++band)
+        {
+            auto& completed = _completed[band];
+            for (auto value = completed.load(std::memory_order_acquire); value != generation; value = completed.load(std::memory_order_acquire))
+            {
+                completed.wait(value, std::memory_order_acquire);
+            }
+            in_onLinesComplete(std::min((band + 1U) * _bandHeight, _height));
+        }
+    }
+
+    void Compositor::runWorker()
+    {
+        auto scratch = std::vector<std::uint32_t>{};
+        auto generation = std::uint64_t{0};
+        while (true)
+        {
+            {
+                auto lock = std::unique_lock{_mutex};
+                _wakeUp.wait(lock, [&]() { return _stopping || (_generation != generation); });
+                if (_stopping)
+                {
+                    return;
+                }
+                generation = _generation;
+            }
+
+            // Claim bands until all of them are taken. The generation is part of the claim, so that a worker that
+            // is late to notice the end of a picture can never claim a band of the next one.
+            auto work = _work.load(std::memory_order_acquire);
+            while (((work >> 32) == (generation & BAND_MASK)) && ((work & BAND_MASK) < _bandCount))
+            {
+                if (_work.compare_exchange_weak(work, work + 1U, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    auto const band = static_cast<std::size_t>(work & BAND_MASK);
+                    processBand(band, scratch);
+                    _completed[band].store(generation, std::memory_order_release);
+                    _completed[band].notify_all();
+                    work = _work.load(std::memory_order_acquire);
+                }
+            }
+        }
+    }
+
+    void Compositor::processBand(std::size_t in_band, std::vector<std::uint32_t>& io_scratch)
+    {
+        auto const first = in_band * _bandHeight;
+        auto const last = std::min(first + _bandHeight, _height);
+
+        for (auto row = first / _tileHeight; (row < _rows) && ((row * _tileHeight) < last); ++row)
+        {
+            auto const top = row * _tileHeight;
+            auto const firstLine = std::max(first, top) - top;
+            auto const lastLine = std::min(last, top + _tileHeight) - top;
+
+            for (auto column = std::size_t{0}; column < _columns; ++column)
+            {
+                auto const& tile = _tiles[row * _columns + column];
+                auto const target = _picture + top * _stride + column * _tileWidth / V210_BLOCK_PIXELS * V210_BLOCK_SIZE;
+                if (tile.source.payload != nullptr)
+                {
+                    tile.scaler->scaleLines(tile.source.payload, tile.source.stride, target, _stride, firstLine, lastLine, io_scratch);
+                }
+                else
+                {
+                    for (auto line = firstLine; line < lastLine; ++line)
+                    {
+                        paintBlack(target + line * _stride, _tileWidth / V210_BLOCK_PIXELS);
+                    }
+                }
+            }
+        }
+
+        // Paint whatever is not covered by the tiles, which is at most a few pixels on the right and a few lines at the bottom.
+        auto const lineBlocks = (_width + V210_BLOCK_PIXELS - 1U) / V210_BLOCK_PIXELS;
+        auto const tileBlocks = _columns * _tileWidth / V210_BLOCK_PIXELS;
+        for (auto line = first; line < last; ++line)
+        {
+            auto const covered = (line < _rows * _tileHeight) ? tileBlocks : std::size_t{0};
+            paintBlack(_picture + line * _stride + covered * V210_BLOCK_SIZE, lineBlocks - covered);
+        }
+    }
+}
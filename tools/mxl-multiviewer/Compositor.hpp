@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "mxl-internal/V210Scaler.hpp"
+
+namespace mxl::tools
+{
+    /**
+     * Composites many v210 pictures into the tiles of a grid, downscaling each
+     * of them on the way.
+     *
+     * The output picture is split into bands of lines that are spread across a
+     * pool of worker threads. Every worker scales the part of all the tiles that
+     * falls within its band directly into the output picture, so the sources are
+     * read in place and nothing is copied in between.
+     */
+    class Compositor
+    {
+    public:
+        /** A v210 picture to show in a tile. */
+        struct Source
+        {
+            /** The first line of the picture, or nullptr to show a black tile. */
+            std::uint8_t const* payload = nullptr;
+            std::size_t width = 0;
+            std::size_t height = 0;
+            /** The distance in bytes between two lines of the picture. */
+            std::size_t stride = 0;
+        };
+
+        /**
+         * \param[in] in_width The width of the output pictures in pixels.
+         * \param[in] in_height The height of the output pictures in lines.
+         * \param[in] in_columns The number of columns of tiles.
+         * \param[in] in_rows The number of rows of tiles.
+         * \param[in] in_threads The number of worker threads.
+         * \param[in] in_bandHeight The number of lines of the bands handed out to the workers.
+         * \param[in] in_onWorkerStart Called on every worker thread, with its index, before it processes any band. The
+         *      constructor returns once it was called by all the workers.
+         * \throws std::invalid_argument if the tiles would be less than 6 pixels wide or 1 line high.
+         */
+        Compositor(std::size_t in_width, std::size_t in_height, std::size_t in_columns, std::size_t in_rows, std::size_t in_threads,
+            std::size_t in_bandHeight, std::function<void(std::size_t)> const& in_onWorkerStart);
+
+        Compositor(Compositor const&) = delete;
+        Compositor& operator=(Compositor const&) = delete;
+
+        ~Compositor();
+
+        [[nodiscard]]
+        std::size_t tileCount() const noexcept
+        {
+            return _tiles.size();
+        }
+
+        [[nodiscard]]
+        std::size_t tileWidth() const noexcept
+        {
+            return _tileWidth;
+        }
+
+        [[nodiscard]]
+        std::size_t tileHeight() const noexcept
+        {
+            return _tileHeight;
+        }
+
+        /**
+         * Select the picture shown in a tile by the next call to composite().
+         * \throws std::invalid_argument if the picture is smaller than the tile.
+         */
+        void setSource(std::size_t in_tile, Source const& in_source);
+
+        /**
+         * Composite the sources of all tiles into an output picture.
+         *
+         * \param[out] out_picture The first line of the output picture.
+         * \param[in] in_stride The distance in bytes between two lines of the output picture.
+         * \param[in] in_onLinesComplete Called on the calling thread every time more lines of the output picture
+         *      are complete, with the number of complete lines. Lines complete in order.
+         */
+        void composite(std::uint8_t* out_picture, std::size_t in_stride, std::function<void(std::size_t)> const& in_onLinesComplete);
+
+    private:
+        struct Tile
+        {
+            Source source;
+            std::optional<mxl::lib::V210Scaler> scaler;
+        };
+
+        void runWorker();
+        void processBand(std::size_t in_band, std::vector<std::uint32_t>& io_scratch);
+
+        std::size_t _width;
+        std::size_t _height;
+        std::size_t _columns;
+        std::size_t _rows;
+        std::size_t _tileWidth;
+        std::size_t _tileHeight;
+        std::size_t _bandHeight;
+        std::size_t _bandCount;
+        std::vector<Tile> _tiles;
+
+        /** The output picture of the current call to composite(). */
+        std::uint8_t* _picture;
+        std::size_t _stride;
+
+        std::mutex _mutex;
+        std::condition_variable _wakeUp;
+        /** Incremented by every call to composite(). */
+        std::uint64_t _generation;
+        bool _stopping;
+        /** The low 32 bits of the generation in the high half, and the next band to process in the low half. */
+        std::atomic<std::uint64_t> _work;
+        /** The generation for which every band was last completed. */
+        std::unique_ptr<std::atomic<std::uint64_t>[]> _completed;
+        std::vector<std::thread> _workers;
+    };
+}
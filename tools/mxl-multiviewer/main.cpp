@@ -0,0 +1,344 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <uuid.h>
+#include <CLI/CLI.hpp>
+#include <fmt/format.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include <mxl/time.h>
+#include "mxl-internal/FlowParser.hpp"
+#include "mxl-internal/Logging.hpp"
+#include "mxl-internal/PathUtils.hpp"
+#include "Compositor.hpp"
+#include "RealtimeOptions.hpp"
+
+namespace
+{
+    std::sig_atomic_t volatile g_exit_requested = 0;
+
+    void signal_handler(int)
+    {
+        g_exit_requested = 1;
+    }
+
+    std::string readFile(std::filesystem::path const& path)
+    {
+        auto file = std::ifstream{path, std::ios::in | std::ios::binary};
+        if (!file)
+        {
+            throw std::runtime_error{fmt::format("Failed to open file '{}'.", path.string())};
+        }
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    /** Check that a flow carries progressive v210 pictures, which is all the compositor understands. */
+    void checkVideoFlow(mxl::lib::FlowParser const& parser, bool allowAlpha)
+    {
+        auto const mediaType = parser.get<std::string>("media_type");
+        if ((mediaType != "video/v210") && (!allowAlpha || (mediaType != "video/v210a")))
+        {
+            throw std::invalid_argument{fmt::format("Unsupported media type '{}'.", mediaType)};
+        }
+        if (parser.get<std::string>("interlace_mode") != "progressive")
+        {
+            throw std::invalid_argument{"This application does not support interlaced flows."};
+        }
+    }
+
+    /** An input of the multiviewer. Grains of video/v210a flows start with their fill, the key is ignored. */
+    struct Input
+    {
+        std::string id;
+        mxlFlowReader reader = nullptr;
+        std::size_t width = 0;
+        std::size_t height = 0;
+        std::size_t stride = 0;
+    };
+
+    class Multiviewer
+    {
+    public:
+        Multiviewer(std::string const& domain, std::vector<std::string> const& inputIds, std::string const& outputFlowDef,
+            std::string const& outputOptions)
+        {
+            _instance = mxlCreateInstance(domain.c_str(), "");
+            if (_instance == nullptr)
+            {
+                throw std::runtime_error{"Failed to create MXL instance"};
+            }
+
+            for (auto const& id : inputIds)
+            {
+                auto const parser = mxl::lib::FlowParser{readFile(mxl::lib::makeFlowDescriptorFilePath(domain, id))};
+                checkVideoFlow(parser, true);
+
+                auto& input = _inputs.emplace_back(Input{.id = id});
+                if (auto const status = mxlCreateFlowReader(_instance, id.c_str(), "", &input.reader); status != MXL_STATUS_OK)
+                {
+                    throw std::runtime_error{fmt::format("Failed to create a reader for flow '{}' with status '{}'", id, static_cast<int>(status))};
+                }
+                input.width = static_cast<std::size_t>(parser.get<double>("frame_width"));
+                input.height = static_cast<std::size_t>(parser.get<double>("frame_height"));
+                input.stride = parser.getPayloadSliceLengths()[0];
+            }
+
+            auto const parser = mxl::lib::FlowParser{outputFlowDef};
+            checkVideoFlow(parser, false);
+            _width = static_cast<std::size_t>(parser.get<double>("frame_width"));
+            _height = static_cast<std::size_t>(parser.get<double>("frame_height"));
+            _stride = parser.getPayloadSliceLengths()[0];
+            _rate = parser.getGrainRate();
+
+            if (auto const status = mxlCreateFlow(_instance, outputFlowDef.c_str(), outputOptions.c_str(), &_outputConfig); status != MXL_STATUS_OK)
+            {
+                throw std::runtime_error{fmt::format("Failed to create the output flow with status '{}'", static_cast<int>(status))};
+            }
+            _outputId = uuids::to_string(uuids::uuid(_outputConfig.common.id));
+            if (auto const status = mxlCreateFlowWriter(_instance, _outputId.c_str(), "", &_writer); status != MXL_STATUS_OK)
+            {
+                throw std::runtime_error{fmt::format("Failed to create the output flow writer with status '{}'", static_cast<int>(status))};
+            }
+        }
+
+        ~Multiviewer()
+        {
+            for (auto const& input : _inputs)
+            {
+                if (input.reader != nullptr)
+                {
+                    mxlReleaseFlowReader(_instance, input.reader);
+                }
+            }
+            if (_writer != nullptr)
+            {
+                mxlReleaseFlowWriter(_instance, _writer);
+            }
+            if (!_outputId.empty())
+            {
+                MXL_INFO("Destroying flow -> {}", _outputId);
+                mxlDestroyFlow(_instance, _outputId.c_str());
+            }
+            if (_instance != nullptr)
+            {
+                mxlDestroyInstance(_instance);
+            }
+        }
+
+        int run(mxl::tools::Compositor& compositor)
+        {
+            for (auto const& input : _inputs)
+            {
+                if ((input.width < compositor.tileWidth()) || (input.height < compositor.tileHeight()))
+                {
+                    MXL_ERROR("Flow '{}' ({}x{}) is smaller than the tiles ({}x{}), which is not supported.",
+                        input.id,
+                        input.width,
+                        input.height,
+                        compositor.tileWidth(),
+                        compositor.tileHeight());
+                    return EXIT_FAILURE;
+                }
+            }
+
+            MXL_INFO("Compositing {} flows into {} tiles of {}x{} in flow {}",
+                _inputs.size(),
+                compositor.tileCount(),
+                compositor.tileWidth(),
+                compositor.tileHeight(),
+                _outputId);
+
+            auto index = mxlGetCurrentIndex(&_rate);
+            while (!g_exit_requested)
+            {
+                // Monitoring only needs the most recent picture of every input, which is read in place. Inputs
+                // that have nothing to show, or are not part of the grid, are shown as black tiles.
+                for (auto tile = std::size_t{0}; tile < compositor.tileCount(); ++tile)
+                {
+                    auto source = mxl::tools::Compositor::Source{};
+                    if (tile < _inputs.size())
+                    {
+                        auto const& input = _inputs[tile];
+                        auto grainInfo = mxlGrainInfo{};
+                        auto payload = static_cast<std::uint8_t*>(nullptr);
+                        if ((mxlFlowReaderGetLatestGrain(input.reader, static_cast<std::uint16_t>(input.height), &grainInfo, &payload) ==
+                                MXL_STATUS_OK) &&
+                            ((grainInfo.flags & MXL_GRAIN_FLAG_INVALID) == 0))
+                        {
+                            source = {.payload = payload, .width = input.width, .height = input.height, .stride = input.stride};
+                        }
+                    }
+                    compositor.setSource(tile, source);
+                }
+
+                auto grainInfo = mxlGrainInfo{};
+                auto payload = static_cast<std::uint8_t*>(nullptr);
+                if (mxlFlowWriterOpenGrain(_writer, index, &grainInfo, &payload) != MXL_STATUS_OK)
+                {
+                    MXL_ERROR("Failed to open grain at index '{}'", index);
+                    return EXIT_FAILURE;
+                }
+
+                // Commit the slices as soon as the bands they belong to are complete, so that downstream readers
+                // can start working on the top of the picture early.
+                grainInfo.flags = 0;
+                grainInfo.validSlices = 0;
+                auto committed = true;
+                compositor.composite(payload,
+                    _stride,
+                    [&](std::size_t lines)
+                    {
+                        grainInfo.validSlices = static_cast<std::uint16_t>(lines);
+                        committed = committed && (mxlFlowWriterCommitGrain(_writer, &grainInfo) == MXL_STATUS_OK);
+                    });
+                if (!committed)
+                {
+                    MXL_ERROR("Failed to commit grain at index '{}'", index);
+                    return EXIT_FAILURE;
+                }
+
+                mxlSleepForNs(mxlGetNsUntilIndex(index + 1U, &_rate));
+                if (auto const current = mxlGetCurrentIndex(&_rate); current > (index + 1U))
+                {
+                    MXL_WARN("Compositing is running late, skipping {} grains.", current - index - 1U);
+                    index = current;
+                }
+                else
+                {
+                    index = index + 1U;
+                }
+            }
+            return EXIT_SUCCESS;
+        }
+
+        [[nodiscard]]
+        std::size_t width() const noexcept
+        {
+            return _width;
+        }
+
+        [[nodiscard]]
+        std::size_t height() const noexcept
+        {
+            return _height;
+        }
+
+    private:
+        mxlInstance _instance = nullptr;
+        std::vector<Input> _inputs;
+        mxlFlowConfigInfo _outputConfig = {};
+        std::string _outputId;
+        mxlFlowWriter _writer = nullptr;
+        std::size_t _width = 0;
+        std::size_t _height = 0;
+        std::size_t _stride = 0;
+        mxlRational _rate = {};
+    };
+}
+
+int main(int argc, char** argv)
+{
+    std::signal(SIGINT, &signal_handler);
+    std::signal(SIGTERM, &signal_handler);
+
+    CLI::App app("mxl-multiviewer");
+
+    std::string domain;
+    auto domainOpt = app.add_option("-d,--domain", domain, "The MXL domain directory")->required();
+    domainOpt->check(CLI::ExistingDirectory);
+
+    std::vector<std::string> inputIds;
+    app.add_option("-i,--input-flow-id", inputIds, "The video flows to show, in the order of the tiles (left to right, top to bottom).")
+        ->required()
+        ->delimiter(',');
+
+    std::string outputConfigFile;
+    app.add_option("-o,--output-config-file", outputConfigFile, "The json file which contains the NMOS Flow definition of the output video flow.")
+        ->required()
+        ->check(CLI::ExistingFile);
+
+    std::string outputOptionsFile;
+    app.add_option("--output-options-file", outputOptionsFile, "The json file which contains the output flow options.")->check(CLI::ExistingFile);
+
+    std::size_t columns = 0;
+    app.add_option("--columns", columns, "Number of columns of tiles. Default is a square grid that fits all the inputs.");
+
+    std::size_t rows = 0;
+    app.add_option("--rows", rows, "Number of rows of tiles. Default is as many as needed to fit all the inputs.");
+
+    std::size_t threads = std::max(std::thread::hardware_concurrency() / 2U, 1U);
+    app.add_option("--threads", threads, "Number of compositing worker threads.")->check(CLI::Range(1, 256))->capture_default_str();
+
+    std::size_t bandHeight = 32;
+    app.add_option("--band-height", bandHeight, "Number of output lines handed to a worker at a time.")
+        ->check(CLI::Range(1, 4096))
+        ->capture_default_str();
+
+    mxl::tools::RealtimeOptions realtimeOptions;
+    mxl::tools::addRealtimeOptions(app, realtimeOptions);
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (columns == 0U)
+    {
+        columns = (rows == 0U) ? static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(inputIds.size()))))
+                               : (inputIds.size() + rows - 1U) / rows;
+    }
+    if (rows == 0U)
+    {
+        rows = (inputIds.size() + columns - 1U) / columns;
+    }
+
+    if (!mxl::tools::applyProcessRealtimeOptions(realtimeOptions))
+    {
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        auto multiviewer = Multiviewer{domain,
+            inputIds,
+            readFile(outputConfigFile),
+            outputOptionsFile.empty() ? std::string{} : readFile(outputOptionsFile)};
+
+        // The compositing loop runs on MXL loop 0, the workers on the following ones.
+        auto workersReady = std::atomic<bool>{true};
+        auto compositor = mxl::tools::Compositor{multiviewer.width(),
+            multiviewer.height(),
+            columns,
+            rows,
+            threads,
+            bandHeight,
+            [&](std::size_t worker)
+            {
+                if (!mxl::tools::applyThreadRealtimeOptions(realtimeOptions, worker + 1U))
+                {
+                    workersReady = false;
+                }
+            }};
+
+        if (!workersReady || !mxl::tools::applyThreadRealtimeOptions(realtimeOptions, 0))
+        {
+            return EXIT_FAILURE;
+        }
+        return multiviewer.run(compositor);
+    }
+    catch (std::exception const& e)
+    {
+        MXL_ERROR("{}", e.what());
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,423 @@
+// SPDX-FileCopyrightText: 2025 Contributors to the Media eXchange Layer project.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <uuid.h>
+#include <sys/stat.h>
+#include <CLI/CLI.hpp>
+#include <fmt/format.h>
+#include <mxl/flow.h>
+#include <mxl/mxl.h>
+#include <mxl/time.h>
+#include "mxl-internal/AudioMeter.hpp"
+#include "mxl-internal/FlowParser.hpp"
+#include "mxl-internal/Logging.hpp"
+#include "mxl-internal/PathUtils.hpp"
+#include "mxl-internal/Probe.hpp"
+#include "mxl-internal/SharedMemory.hpp"
+
+namespace
+{
+    std::sig_atomic_t volatile g_exit_requested = 0;
+
+    void signal_handler(int)
+    {
+        g_exit_requested = 1;
+    }
+
+    /** Level reported for channels that are digital silence, in dBFS. */
+    constexpr auto const SILENCE_FLOOR_DB = -144.0f;
+
+    std::string readFile(std::filesystem::path const& path)
+    {
+        auto file = std::ifstream{path, std::ios::in | std::ios::binary};
+        if (!file)
+        {
+            throw std::runtime_error{fmt::format("Failed to open file '{}'.", path.string())};
+        }
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    /**
+     * The inode of the data file of a flow, which changes when the flow is deleted and created again.
+     * \return 0 if the flow doesn't exist.
+     */
+    ::ino_t flowInode(std::filesystem::path const& domain, std::string const& id)
+    {
+        struct ::stat st;
+        return (::stat(mxl::lib::makeFlowDataFilePath(domain, id).c_str(), &st) == 0) ? st.st_ino : 0;
+    }
+
+    float toDecibels(double power)
+    {
+        return (power > 0.0) ? std::max(static_cast<float>(10.0 * std::log10(power)), SILENCE_FLOOR_DB) : SILENCE_FLOOR_DB;
+    }
+
+    struct ProbeSettings
+    {
+        std::size_t lineStep = 4;
+        std::uint32_t blackLevel = 80;
+        double blackRatio = 0.98;
+        double freezeThreshold = 0.0;
+        double silenceThreshold = -60.0;
+        /** Time between two updates of the audio levels, in nanoseconds. */
+        std::uint64_t meterInterval = 100'000'000;
+    };
+
+    /** Analyses the grains or samples of a flow as they are written, and publishes the results next to the flow. */
+    class FlowProbe
+    {
+    public:
+        FlowProbe(mxlInstance instance, std::filesystem::path const& domain, std::string id, ProbeSettings const& settings)
+            : _instance{instance}
+            , _domain{domain}
+            , _id{std::move(id)}
+            , _settings{settings}
+            , _inode{flowInode(_domain, _id)}
+        {
+            if (_inode == 0)
+            {
+                throw std::runtime_error{"The flow doesn't exist."};
+            }
+
+            auto const parser = mxl::lib::FlowParser{readFile(mxl::lib::makeFlowDescriptorFilePath(domain, _id))};
+            auto const mediaType = parser.get<std::string>("media_type");
+            if ((mediaType == "video/v210") || (mediaType == "video/v210a"))
+            {
+                if (parser.get<std::string>("interlace_mode") != "progressive")
+                {
+                    throw std::invalid_argument{"Interlaced flows are not supported."};
+                }
+                _video = true;
+                _width = static_cast<std::size_t>(parser.get<double>("frame_width"));
+                _height = static_cast<std::size_t>(parser.get<double>("frame_height"));
+                _stride = parser.getPayloadSliceLengths()[0];
+            }
+            else if (mediaType != "audio/float32")
+            {
+                throw std::invalid_argument{fmt::format("Unsupported media type '{}'.", mediaType)};
+            }
+
+            if (auto const status = mxlCreateFlowReader(_instance, _id.c_str(), "", &_reader); status != MXL_STATUS_OK)
+            {
+                throw std::runtime_error{fmt::format("Failed to create a reader with status '{}'", static_cast<int>(status))};
+            }
+
+            auto config = mxlFlowConfigInfo{};
+            if (auto const status = mxlFlowReaderGetConfigInfo(_reader, &config); status != MXL_STATUS_OK)
+            {
+                mxlReleaseFlowReader(_instance, _reader);
+                throw std::runtime_error{fmt::format("Failed to get the flow configuration with status '{}'", static_cast<int>(status))};
+            }
+            if (!_video)
+            {
+                auto const sampleRate = static_cast<double>(config.common.grainRate.numerator) / config.common.grainRate.denominator;
+                _meter.emplace(config.continuous.channelCount, sampleRate);
+                _channelCount = std::min<std::size_t>(config.continuous.channelCount, mxl::lib::PROBE_MAX_CHANNELS);
+                _maxSamples = config.continuous.bufferLength / 2U;
+            }
+
+            auto const statsPath = mxl::lib::makeFlowProbeFilePath(mxl::lib::makeFlowDirectoryName(domain, _id));
+            _stats = mxl::lib::SharedMemoryInstance<mxl::lib::ProbeStats>{statsPath.string().c_str(), mxl::lib::AccessMode::CREATE_READ_WRITE, 0U};
+
+            _values.version = mxl::lib::PROBE_STATS_VERSION;
+            _values.index = MXL_UNDEFINED_INDEX;
+            _values.channelCount = static_cast<std::uint32_t>(_channelCount);
+        }
+
+        ~FlowProbe()
+        {
+            mxlReleaseFlowReader(_instance, _reader);
+        }
+
+        FlowProbe(FlowProbe const&) = delete;
+        FlowProbe& operator=(FlowProbe const&) = delete;
+
+        /**
+         * Analyse whatever was written to the flow since the previous call.
+         * \return false if the flow was deleted or created again since the probe was created.
+         */
+        bool poll()
+        {
+            // Readers keep reporting the last grains of a deleted flow, so its data file is checked explicitly.
+            if (flowInode(_domain, _id) != _inode)
+            {
+                return false;
+            }
+            return _video ? pollVideo() : pollAudio();
+        }
+
+    private:
+        bool pollVideo()
+        {
+            // Only complete grains are analysed, and only the most recent one. Probes don't need to see every grain to
+            // detect conditions that last for a while.
+            auto grainInfo = mxlGrainInfo{};
+            auto payload = static_cast<std::uint8_t*>(nullptr);
+            auto const status = mxlFlowReaderGetLatestGrain(_reader, static_cast<std::uint16_t>(_height), &grainInfo, &payload);
+            if ((status != MXL_STATUS_OK) || (grainInfo.index == _values.index) || ((grainInfo.flags & MXL_GRAIN_FLAG_INVALID) != 0))
+            {
+                return true;
+            }
+
+            auto const luma = mxl::lib::analyzeV210Luma(payload, _stride, _width, _height, _settings.lineStep, _settings.blackLevel);
+            auto const grains = (_values.index == MXL_UNDEFINED_INDEX) ? 1U : static_cast<std::uint32_t>(grainInfo.index - _values.index);
+            auto const previousFlags = _values.flags;
+
+            _values.averageLuma = (luma.samples != 0U) ? static_cast<float>(static_cast<double>(luma.sum) / luma.samples) : 0.0f;
+            _values.blackRatio = (luma.samples != 0U) ? static_cast<float>(static_cast<double>(luma.blackSamples) / luma.samples) : 0.0f;
+            _values.blackGrains = (_values.blackRatio >= _settings.blackRatio) ? _values.blackGrains + grains : 0U;
+
+            if (_previousLuma)
+            {
+                _values.difference = static_cast<float>(mxl::lib::signatureDifference(luma, *_previousLuma));
+                _values.frozenGrains = (_values.difference <= _settings.freezeThreshold) ? _values.frozenGrains + grains : 0U;
+            }
+            _previousLuma = luma;
+
+            _values.flags = ((_values.blackGrains != 0U) ? mxl::lib::PROBE_FLAG_BLACK : 0U) |
+                            ((_values.frozenGrains != 0U) ? mxl::lib::PROBE_FLAG_FROZEN : 0U);
+            publish(grainInfo.index, previousFlags);
+            return true;
+        }
+
+        bool pollAudio()
+        {
+            auto headIndex = std::uint64_t{};
+            auto const status = mxlFlowReaderGetHeadIndex(_reader, &headIndex);
+            if ((status != MXL_STATUS_OK) || (headIndex == MXL_UNDEFINED_INDEX) || (headIndex == _values.index))
+            {
+                return true;
+            }
+
+            // Samples that were overwritten since the previous call are skipped, the first call only records the head.
+            auto const previousHead = _values.index;
+            _values.index = headIndex;
+            if ((previousHead == MXL_UNDEFINED_INDEX) || (headIndex < previousHead))
+            {
+                return true;
+            }
+            auto const count = std::min<std::uint64_t>(headIndex - previousHead, _maxSamples);
+
+            auto slices = mxlWrappedMultiBufferSlice{};
+            if (mxlFlowReaderGetSamplesNonBlocking(_reader, headIndex, count, &slices) != MXL_STATUS_OK)
+            {
+                return true;
+            }
+
+            // Every sample goes through the meter, which keeps the state of its filters, but levels are only published at
+            // the meter rate.
+            _meter->process(slices);
+            _meteredSamples += count;
+
+            auto const now = mxlGetTime();
+            if (now < _nextMeterTime)
+            {
+                return true;
+            }
+            _nextMeterTime = now + _settings.meterInterval;
+
+            auto const previousFlags = _values.flags;
+            auto silent = true;
+            for (auto channel = std::size_t{0}; channel < _channelCount; ++channel)
+            {
+                auto const rms = _meter->rms(channel);
+                auto const peak = _meter->peak(channel);
+                auto const truePeak = _meter->truePeak(channel);
+                _values.rms[channel] = toDecibels(rms * rms);
+                _values.peak[channel] = toDecibels(peak * peak);
+                _values.truePeak[channel] = toDecibels(truePeak * truePeak);
+                silent = silent && (_values.peak[channel] < _settings.silenceThreshold);
+            }
+            _values.momentaryLoudness = static_cast<float>(std::max(_meter->momentaryLoudness(), static_cast<double>(SILENCE_FLOOR_DB)));
+            _values.shortTermLoudness = static_cast<float>(std::max(_meter->shortTermLoudness(), static_cast<double>(SILENCE_FLOOR_DB)));
+            _meter->resetLevels();
+
+            _values.silentSamples = silent ? _values.silentSamples + _meteredSamples : 0U;
+            _values.flags = silent ? mxl::lib::PROBE_FLAG_SILENT : 0U;
+            _meteredSamples = 0U;
+            publish(headIndex, previousFlags);
+            return true;
+        }
+
+        void publish(std::uint64_t index, std::uint32_t previousFlags)
+        {
+            _values.index = index;
+            _values.updateTime = mxlGetTime();
+            mxl::lib::publishProbeStats(*_stats.get(), _values);
+
+            for (auto const& [flag, name] : {std::pair{mxl::lib::PROBE_FLAG_BLACK, "black"},
+                     std::pair{mxl::lib::PROBE_FLAG_FROZEN, "frozen"},
+                     std::pair{mxl::lib::PROBE_FLAG_SILENT, "silent"}})
+            {
+                if (((_values.flags ^ previousFlags) & flag) != 0U)
+                {
+                    MXL_INFO("Flow {} is {}{} at index {}", _id, ((_values.flags & flag) != 0U) ? "" : "no longer ", name, index);
+                }
+            }
+        }
+
+        mxlInstance _instance;
+        std::filesystem::path _domain;
+        std::string _id;
+        ProbeSettings _settings;
+        /** The inode of the data file of the probed flow. */
+        ::ino_t _inode;
+        mxlFlowReader _reader = nullptr;
+        mxl::lib::SharedMemoryInstance<mxl::lib::ProbeStats> _stats;
+        mxl::lib::ProbeValues _values = {};
+
+        bool _video = false;
+        std::size_t _width = 0;
+        std::size_t _height = 0;
+        std::size_t _stride = 0;
+        std::optional<mxl::lib::LumaStats> _previousLuma;
+
+        std::optional<mxl::lib::AudioMeter> _meter;
+        std::size_t _channelCount = 0;
+        std::size_t _maxSamples = 0;
+        std::uint64_t _meteredSamples = 0;
+        std::uint64_t _nextMeterTime = 0;
+    };
+
+    /** List the flows of a domain. */
+    std::vector<std::string> listFlows(std::filesystem::path const& domain)
+    {
+        auto result = std::vector<std::string>{};
+        auto ec = std::error_code{};
+        for (auto const& entry : std::filesystem::directory_iterator{domain, ec})
+        {
+            if (entry.is_directory(ec) && (entry.path().extension() == mxl::lib::FLOW_DIRECTORY_NAME_SUFFIX))
+            {
+                if (auto const id = entry.path().stem().string(); uuids::uuid::from_string(id).has_value())
+                {
+                    result.push_back(id);
+                }
+            }
+        }
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::signal(SIGINT, &signal_handler);
+    std::signal(SIGTERM, &signal_handler);
+
+    CLI::App app("mxl-probe");
+
+    std::string domain;
+    auto domainOpt = app.add_option("-d,--domain", domain, "The MXL domain directory")->required();
+    domainOpt->check(CLI::ExistingDirectory);
+
+    std::vector<std::string> flowIds;
+    app.add_option("-f,--flow-id", flowIds, "The flows to probe. Default is every video and audio flow of the domain.")->delimiter(',');
+
+    auto settings = ProbeSettings{};
+    app.add_option("--line-step", settings.lineStep, "Analyse one picture line out of this many.")->check(CLI::Range(1, 64))->capture_default_str();
+    app.add_option("--black-level", settings.blackLevel, "Luma samples at or below this 10 bit level are black.")
+        ->check(CLI::Range(0, 1023))
+        ->capture_default_str();
+    app.add_option("--black-ratio", settings.blackRatio, "A picture is black if at least this ratio of its luma samples are black.")
+        ->check(CLI::Range(0.0, 1.0))
+        ->capture_default_str();
+    app.add_option("--freeze-threshold",
+           settings.freezeThreshold,
+           "A picture is frozen if its signature differs from the previous one by at most this many 10 bit levels.")
+        ->check(CLI::Range(0.0, 1023.0))
+        ->capture_default_str();
+    app.add_option("--silence-threshold", settings.silenceThreshold, "Audio is silent if the peak level of every channel is below this level in dBFS.")
+        ->check(CLI::Range(-144.0, 0.0))
+        ->capture_default_str();
+
+    double meterRate = 10.0;
+    app.add_option("--meter-rate", meterRate, "Number of updates of the audio levels per second.")->check(CLI::Range(1.0, 100.0))->capture_default_str();
+
+    std::uint64_t intervalMs = 10;
+    app.add_option("--interval", intervalMs, "Time between two polls of the flows in milliseconds.")->check(CLI::Range(1, 1000))->capture_default_str();
+
+    CLI11_PARSE(app, argc, argv);
+
+    settings.meterInterval = static_cast<std::uint64_t>(1e9 / meterRate);
+
+    auto instance = mxlCreateInstance(domain.c_str(), "");
+    if (instance == nullptr)
+    {
+        MXL_ERROR("Failed to create MXL instance");
+        return EXIT_FAILURE;
+    }
+
+    MXL_INFO("Probing flows with the {} implementation, metering audio with the {} implementation",
+        mxl::lib::probeImplementation(),
+        mxl::lib::audioMeterImplementation());
+
+    // Flows that can't be probed are remembered until they disappear from the domain or are created again, so that they
+    // are not retried every time the domain is scanned.
+    auto probes = std::map<std::string, std::unique_ptr<FlowProbe>>{};
+    auto ignored = std::map<std::string, ::ino_t>{};
+    auto const watchDomain = flowIds.empty();
+    auto nextScan = std::uint64_t{0};
+
+    while (!g_exit_requested)
+    {
+        auto const now = mxlGetTime();
+        if (now >= nextScan)
+        {
+            nextScan = now + 1'000'000'000ULL;
+            auto const ids = watchDomain ? listFlows(domain) : flowIds;
+            std::erase_if(ignored,
+                [&](auto const& entry)
+                { return (std::find(ids.begin(), ids.end(), entry.first) == ids.end()) || (flowInode(domain, entry.first) != entry.second); });
+            for (auto const& id : ids)
+            {
+                if ((probes.count(id) == 0U) && (ignored.count(id) == 0U))
+                {
+                    try
+                    {
+                        probes.emplace(id, std::make_unique<FlowProbe>(instance, domain, id, settings));
+                        MXL_INFO("Probing flow {}", id);
+                    }
+                    catch (std::exception const& e)
+                    {
+                        MXL_INFO("Not probing flow {}: {}", id, e.what());
+                        ignored.emplace(id, flowInode(domain, id));
+                    }
+                }
+            }
+        }
+
+        for (auto it = probes.begin(); it != probes.end();)
+        {
+            if (it->second->poll())
+            {
+                ++it;
+            }
+            else
+            {
+                // Releasing the probe unmaps the deleted flow, a flow that was created again is probed from the next scan on.
+                MXL_INFO("Flow {} is gone or was created again", it->first);
+                it = probes.erase(it);
+                nextScan = 0;
+            }
+        }
+
+        mxlSleepForNs(intervalMs * 1'000'000ULL);
+    }
+
+    probes.clear();
+    mxlDestroyInstance(instance);
+    return EXIT_SUCCESS;
+}